@@ -72,6 +72,8 @@ INT32 nBurnSoundRate = 0;				// sample rate of sound or zero for no sound
 INT32 nBurnSoundLen = 0;				// length in samples per frame
 INT16* pBurnSoundOut = NULL;		// pointer to output buffer
 
+INT32 bBurnSoundOnly = 0;				// no video output for this session, see BurnDrvRenderWav()
+
 INT32 nInterpolation = 1;				// Desired interpolation level for ADPCM/PCM sound
 INT32 nFMInterpolation = 0;			// Desired interpolation level for FM sound
 
@@ -89,6 +91,9 @@ UINT32 *pBurnDrvPalette;
 static char** pszShortName = NULL;
 static wchar_t** pszFullName = NULL;
 
+static INT32* pDrvNameHash = NULL;			// short name -> driver index, open addressing, -1 = empty
+static UINT32 nDrvNameHashMask = 0;
+
 bool BurnCheckMMXSupport()
 {
 #if defined BUILD_X86_ASM
@@ -161,8 +166,15 @@ extern "C" INT32 BurnLibExit()
 		free(pszFullName);
 	}
 
+	if (NULL != pDrvNameHash) {
+		free(pDrvNameHash);
+		pDrvNameHash = NULL;
+	}
+
 	nBurnDrvCount = 0;
 
+	BurnPoolExit();
+
 	return 0;
 }
 
@@ -554,14 +566,69 @@ static void BurnLocalisationSetNameEx()
 #endif
 }
 
-extern "C" INT32 BurnDrvGetIndex(char* szName)
+UINT64 BurnHash(const void* pData, INT32 nLen, UINT64 nHash)
 {
-	if (NULL == szName) return -1;
+	const UINT8* p = (const UINT8*)pData;
+
+	for (INT32 i = 0; i < nLen; i++) {
+		nHash ^= p[i];
+		nHash *= 0x100000001b3ULL;
+	}
+
+	return nHash;
+}
+
+UINT32 BurnHashString(const char* szString)
+{
+	return (UINT32)BurnHash(szString, strlen(szString), BURN_HASH_INIT);
+}
+
+// Built on first use, and again after a short name changes (BurnDrvSetZipName)
+static INT32 BurnDrvNameHashBuild()
+{
+	UINT32 nSize = 1;
+	while (nSize < nBurnDrvCount * 2) nSize <<= 1;
+
+	pDrvNameHash = (INT32*)malloc(nSize * sizeof(INT32));
+	if (NULL == pDrvNameHash) return 1;
+
+	memset(pDrvNameHash, 0xff, nSize * sizeof(INT32));
+	nDrvNameHashMask = nSize - 1;
 
 	for (UINT32 i = 0; i < nBurnDrvCount; i++) {
-		if (0 == strcmp(szName, pDriver[i]->szShortName)) {
+		UINT32 j = BurnHashString(pDriver[i]->szShortName) & nDrvNameHashMask;
+
+		// a name can only be found once, same as the linear search
+		while (pDrvNameHash[j] != -1) {
+			if (0 == strcmp(pDriver[i]->szShortName, pDriver[pDrvNameHash[j]]->szShortName)) break;
+			j = (j + 1) & nDrvNameHashMask;
+		}
+
+		if (pDrvNameHash[j] == -1) pDrvNameHash[j] = i;
+	}
+
+	return 0;
+}
+
+extern "C" INT32 BurnDrvGetIndex(const char* szName)
+{
+	if (NULL == szName) return -1;
+
+	if (NULL == pDrvNameHash && BurnDrvNameHashBuild()) {
+		// out of memory, search the slow way
+		for (UINT32 i = 0; i < nBurnDrvCount; i++) {
+			if (0 == strcmp(szName, pDriver[i]->szShortName)) {
+				return i;
+			}
+		}
+
+		return -1;
+	}
+
+	for (UINT32 j = BurnHashString(szName) & nDrvNameHashMask; pDrvNameHash[j] != -1; j = (j + 1) & nDrvNameHashMask) {
+		if (0 == strcmp(szName, pDriver[pDrvNameHash[j]]->szShortName)) {
 //			nBurnDrvActive = i;
-			return i;
+			return pDrvNameHash[j];
 		}
 	}
 
@@ -589,6 +656,11 @@ extern "C" INT32 BurnDrvSetZipName(char* szName, INT32 i)
 
 	strcpy(pszShortName[i], szName);
 
+	if (NULL != pDrvNameHash) {			// rebuilt on the next lookup
+		free(pDrvNameHash);
+		pDrvNameHash = NULL;
+	}
+
 	return 0;
 }
 
@@ -824,6 +896,8 @@ extern "C" INT32 BurnDrvInit()
 	}
 #endif
 
+	BurnProfileBegin();
+
 	BurnSetMouseDivider(1);
 
 	BurnSetRefreshRate(60.0);
@@ -854,6 +928,10 @@ extern "C" INT32 BurnDrvInit()
 
 	nCurrentFrame = 0;
 
+	if (nReturnValue) {
+		BurnProfileEnd();							// no first frame coming
+	}
+
 #if defined (FBNEO_DEBUG)
 	if (!nReturnValue) {
 		starttime = clock();
@@ -884,6 +962,8 @@ extern "C" INT32 BurnDrvExit()
 	}
 #endif
 
+	BurnProfileEnd();	// exited before the first frame
+
 	HiscoreExit(); // must come before CheatExit() (uses cheat cpu-registry)
 	CheatExit();
 	CheatSearchExit();
@@ -917,6 +997,7 @@ extern "C" INT32 BurnDrvExit()
 
 	nBurnDrvSubActive = -1;	// Rest to -1;
 
+	BurnLazyExit();
 	BurnExitMemoryManager();
 #if defined FBNEO_DEBUG
 	DebugTrackerExit();
@@ -963,14 +1044,31 @@ INT32 BurnDrvCartridgeSetup(BurnCartrigeCommand nCommand)
 // Do one frame of game emulation
 extern "C" INT32 BurnDrvFrame()
 {
+	if (bBurnSoundOnly) {
+		pBurnDraw = NULL;							// the driver skips its drawing
+	}
+
 	CheatApply();									// Apply cheats (if any)
 	HiscoreApply();
+
+	if (BurnProfileRunning()) {						// the first frame ends the boot profile
+		BurnProfileStart(BURN_PROFILE_FRAME);
+		INT32 nRet = pDriver[nBurnDrvActive]->Frame();
+		BurnProfileStop();
+		BurnProfileEnd();
+		return nRet;
+	}
+
 	return pDriver[nBurnDrvActive]->Frame();		// Forward to drivers function
 }
 
 // Force redraw of the screen
 extern "C" INT32 BurnDrvRedraw()
 {
+	if (bBurnSoundOnly) {
+		return 1;									// nothing to redraw
+	}
+
 	if (pDriver[nBurnDrvActive]->Redraw) {
 		return pDriver[nBurnDrvActive]->Redraw();	// Forward to drivers function
 	}
@@ -978,6 +1076,86 @@ extern "C" INT32 BurnDrvRedraw()
 	return 1;										// No funtion provide, so simply return
 }
 
+// Sound-only mode: run the driver as fast as possible and write its audio to a .wav file
+// nBurnSoundRate must be set (and bBurnSoundOnly, optionally) before BurnDrvInit()
+static void BurnWavPut32(UINT8 *p, UINT32 v)
+{
+	p[0] = v; p[1] = v >> 8; p[2] = v >> 16; p[3] = v >> 24;
+}
+
+INT32 BurnDrvRenderWav(const TCHAR *szFilename, INT32 nSeconds)
+{
+	if (nBurnDrvActive >= nBurnDrvCount || nBurnSoundRate <= 0 || nBurnFPS <= 0 || nSeconds <= 0) {
+		return 1;
+	}
+
+	FILE *fp = _tfopen(szFilename, _T("wb"));
+	if (fp == NULL) {
+		bprintf(PRINT_ERROR, _T("BurnDrvRenderWav: couldn't create %s\n"), szFilename);
+		return 1;
+	}
+
+	UINT8 header[44] = {
+		'R', 'I', 'F', 'F', 0, 0, 0, 0, 'W', 'A', 'V', 'E',
+		'f', 'm', 't', ' ', 16, 0, 0, 0, 1, 0, 2, 0,	// PCM, 2 channels
+		0, 0, 0, 0, 0, 0, 0, 0, 4, 0, 16, 0,			// 4 bytes per frame, 16 bits
+		'd', 'a', 't', 'a', 0, 0, 0, 0
+	};
+	BurnWavPut32(header + 24, nBurnSoundRate);
+	BurnWavPut32(header + 28, nBurnSoundRate * 4);
+	fwrite(header, sizeof(header), 1, fp);
+
+	INT16 *pSoundOutSave = pBurnSoundOut;
+	INT32 nSoundLenSave = nBurnSoundLen;
+	UINT8 *pDrawSave = pBurnDraw;
+
+	nBurnSoundLen = (nBurnSoundRate * 100 + (nBurnFPS >> 1)) / nBurnFPS;
+
+	INT16 *pBuffer = (INT16*)malloc(nBurnSoundLen * 2 * sizeof(INT16));
+	INT32 nFrames = (INT32)(((INT64)nSeconds * nBurnFPS + 99) / 100);
+	UINT32 nBytes = 0;
+	INT32 nRet = (pBuffer == NULL) ? 1 : 0;
+
+	pBurnDraw = NULL;
+
+	for (INT32 i = 0; i < nFrames && nRet == 0; i++) {
+		pBurnSoundOut = pBuffer;
+		BurnDrvFrame();
+
+#ifndef LSB_FIRST
+		for (INT32 j = 0; j < nBurnSoundLen * 2; j++) {
+			pBuffer[j] = BURN_ENDIAN_SWAP_INT16(pBuffer[j]);
+		}
+#endif
+
+		if (fwrite(pBuffer, nBurnSoundLen * 2 * sizeof(INT16), 1, fp) != 1) {
+			nRet = 1;
+			break;
+		}
+		nBytes += nBurnSoundLen * 2 * sizeof(INT16);
+	}
+
+	// now the sizes are known
+	BurnWavPut32(header + 4, nBytes + 36);
+	BurnWavPut32(header + 40, nBytes);
+	if (fseek(fp, 0, SEEK_SET) || fwrite(header, sizeof(header), 1, fp) != 1) {
+		nRet = 1;
+	}
+	if (fclose(fp)) {
+		nRet = 1;
+	}
+
+	if (pBuffer) {
+		free(pBuffer);
+	}
+
+	pBurnSoundOut = pSoundOutSave;
+	nBurnSoundLen = nSoundLenSave;
+	pBurnDraw = pDrawSave;
+
+	return nRet;
+}
+
 // Refresh Palette
 extern "C" INT32 BurnRecalcPal()
 {
@@ -1134,6 +1312,8 @@ void BurnNibbleExpand(UINT8 *source, UINT8 *dst, INT32 length, INT32 swap, UINT8
 
 // Application-defined rom loading function:
 INT32 (__cdecl *BurnExtLoadRom)(UINT8 *Dest, INT32 *pnWrote, INT32 i) = NULL;
+INT32 (__cdecl *BurnExtLoadRomPart)(UINT8 *Dest, INT32 *pnWrote, INT32 i, INT32 nOffset, INT32 nLen) = NULL;
+INT32 (__cdecl *BurnExtRomCrc)(UINT32 *pnCrc, INT32 i) = NULL;
 
 // Application-defined colour conversion function
 static UINT32 __cdecl BurnHighColFiller(INT32, INT32, INT32, INT32) { return (UINT32)(~0); }
@@ -1156,6 +1336,12 @@ INT32 BurnAreaScan(INT32 nAction, INT32* pnMin)
 		nRet = BurnStateMAMEScan(nAction, pnMin);
 	}
 
+	// A savestate can be in the middle of using any part of the roms (nvram
+	// loads at boot don't count, or every lazy region would load on every boot)
+	if ((nAction & (ACB_VOLATILE | ACB_WRITE)) == (ACB_VOLATILE | ACB_WRITE)) {
+		BurnLazyLoadAll(NULL);
+	}
+
 	// Forward to the driver
 	if (pDriver[nBurnDrvActive]->AreaScan) {
 		nRet |= pDriver[nBurnDrvActive]->AreaScan(nAction, pnMin);
@@ -29,6 +29,7 @@ extern TCHAR szAppSamplesPath[MAX_PATH];
 extern TCHAR szAppHDDPath[MAX_PATH];
 extern TCHAR szAppBlendPath[MAX_PATH];
 extern TCHAR szAppEEPROMPath[MAX_PATH];
+extern TCHAR szBurnCachePath[MAX_PATH];		// burn_cache.cpp, the frontend may change it (empty = no cache)
 
 // Macro to determine the size of a struct up to and including "member"
 #define STRUCT_SIZE_HELPER(type, member) offsetof(type, member) + sizeof(((type*)0)->member)
@@ -100,6 +101,12 @@ enum BurnCartrigeCommand { CART_INIT_START, CART_INIT_END, CART_EXIT };
 // Application-defined rom loading function
 extern INT32 (__cdecl *BurnExtLoadRom)(UINT8* Dest, INT32* pnWrote, INT32 i);
 
+// Application-defined partial rom loading function (optional, lets drivers load big roms on demand)
+extern INT32 (__cdecl *BurnExtLoadRomPart)(UINT8* Dest, INT32* pnWrote, INT32 i, INT32 nOffset, INT32 nLen);
+
+// Application-defined function giving the crc rom i really has in the romset (optional, 0 = found; keys the rom caches)
+extern INT32 (__cdecl *BurnExtRomCrc)(UINT32* pnCrc, INT32 i);
+
 // Application-defined progress indicator functions
 extern INT32 (__cdecl *BurnExtProgressRangeCallback)(double dProgressRange);
 extern INT32 (__cdecl *BurnExtProgressUpdateCallback)(double dProgress, const TCHAR* pszText, bool bAbs);
@@ -320,6 +327,11 @@ extern INT32 nBurnSoundRate;					// Samplerate of sound
 extern INT32 nBurnSoundLen;					// Length in samples per frame
 extern INT16* pBurnSoundOut;				// Pointer to output buffer
 
+extern INT32 bBurnSoundOnly;					// set before BurnDrvInit(): no video output, drivers may skip their video work
+extern INT32 bBurnShareRoms;					// set before BurnDrvInit(): big rom regions are backed by shared cache files
+extern INT32 bBurnLazyRoms;					// set before BurnDrvInit(): big rom regions may be loaded on demand (needs BurnExtLoadRomPart)
+extern INT32 bBurnBootProfile;				// set before BurnDrvInit(): print where the time to the first frame went
+
 extern INT32 nInterpolation;					// Desired interpolation level for ADPCM/PCM sound
 extern INT32 nFMInterpolation;				// Desired interpolation level for FM sound
 
@@ -354,6 +366,32 @@ INT32 BurnDrvCartridgeSetup(BurnCartrigeCommand nCommand);
 
 INT32 BurnDrvFrame();
 INT32 BurnDrvRedraw();
+INT32 BurnDrvRenderWav(const TCHAR *szFilename, INT32 nSeconds);
+
+// burn_pool.cpp
+extern INT32 nBurnPoolThreads;					// set before first use, 0 = one per cpu core
+INT32 BurnPoolGetThreads();
+void BurnPoolRun(void (*pJob)(INT32 nJob, void *pParam), void *pParam, INT32 nJobs);
+void BurnPoolFor(void (*pRange)(INT32 nStart, INT32 nEnd, void *pParam), void *pParam, INT32 nStart, INT32 nEnd, INT32 nGrain);
+void BurnPoolExit();
+
+// burn_profile.cpp
+enum {
+	BURN_PROFILE_OTHER = 0,		// whatever the driver does between the phases below
+	BURN_PROFILE_PREFETCH,		// the frontend reading the romset ahead of BurnDrvInit()
+	BURN_PROFILE_ROMLOAD,
+	BURN_PROFILE_DECRYPT,
+	BURN_PROFILE_GFXDECODE,
+	BURN_PROFILE_MALLOC,
+	BURN_PROFILE_CPUINIT,
+	BURN_PROFILE_SOUNDINIT,
+	BURN_PROFILE_FRAME,
+	BURN_PROFILE_PHASES
+};
+
+void BurnProfileBegin();						// call before the rom prefetch so it's counted, BurnDrvInit() calls it otherwise
+void BurnProfileStart(INT32 nPhase);
+void BurnProfileStop();
 INT32 BurnRecalcPal();
 INT32 BurnDrvGetPaletteEntries();
 
@@ -372,6 +410,22 @@ void BurnRandomSetSeed(UINT64 nSeed);               // Set the seed - useful for
 INT32 BurnSynchroniseStream(INT32 nSoundRate);
 double BurnGetTime();
 
+// Sound core benchmark (snd/snd_bench.cpp), runs a core with no driver loaded
+struct BurnSoundBenchInfo {
+	const char *szName;			// Name of the sound core
+	INT32 nSamples;				// Number of (stereo) samples rendered
+	double dSeconds;			// CPU time taken
+	UINT32 nChecksum;			// Checksum of the rendered output
+};
+
+INT32 BurnSoundBenchCount();
+INT32 BurnSoundBenchRun(INT32 nCore, INT32 nRate, INT32 nSeconds, BurnSoundBenchInfo *pInfo);
+
+// fnv-1a hash of nLen bytes, carrying on from nHash (BURN_HASH_INIT for a new one), for hash tables and cache keys
+#define BURN_HASH_INIT		0xcbf29ce484222325ULL
+UINT64 BurnHash(const void* pData, INT32 nLen, UINT64 nHash);
+UINT32 BurnHashString(const char* szString);
+
 // Handy debug binary-file dumper
 #if defined (FBNEO_DEBUG)
 void BurnDump_(char *filename, UINT8 *buffer, INT32 bufsize, INT32 append);
@@ -412,7 +466,7 @@ TCHAR* BurnDrvGetText(UINT32 i);
 char* BurnDrvGetTextA(UINT32 i);
 wchar_t* BurnDrvGetFullNameW(UINT32 i);
 
-INT32 BurnDrvGetIndex(char* szName);
+INT32 BurnDrvGetIndex(const char* szName);
 INT32 BurnDrvGetZipName(char** pszName, UINT32 i);
 INT32 BurnDrvSetZipName(char* szName, INT32 i);
 INT32 BurnDrvGetRomInfo(struct BurnRomInfo *pri, UINT32 i);
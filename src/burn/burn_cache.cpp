@@ -0,0 +1,302 @@
+// FB Neo read-only file cache
+//
+// Keeps data that is expensive to derive (decoded samples and the like) in
+// files under szBurnCachePath. The files are mapped read-only, so several
+// running instances end up sharing the same physical pages instead of each
+// holding a private copy. Files are written to a temporary name and renamed
+// into place, a reader never sees a half-written file. The cache is off until
+// the frontend points szBurnCachePath at a directory.
+
+#include "burnint.h"
+
+#if defined(_WIN32)
+ #include <windows.h>
+ #include <process.h>
+ #define BURN_CACHE_MAP_WIN32
+#elif defined(__linux__) || defined(__APPLE__) || defined(__unix__)
+ #include <sys/mman.h>
+ #include <sys/stat.h>
+ #include <fcntl.h>
+ #include <unistd.h>
+ #define BURN_CACHE_MAP_POSIX
+#endif
+
+TCHAR szBurnCachePath[MAX_PATH] = _T("");
+INT32 bBurnShareRoms = 0;
+
+char* TCHARToANSI(const TCHAR* pszInString, char* pszOutString, INT32 nOutSize);
+
+static INT32 BurnCacheMakePath(char *szPath, INT32 nLen, const char *szName)
+{
+	if (szBurnCachePath[0] == 0 || szName == NULL) return 1;
+
+	char szBase[MAX_PATH];
+	TCHARToANSI(szBurnCachePath, szBase, sizeof(szBase));
+
+	if (snprintf(szPath, nLen, "%s%s", szBase, szName) >= nLen) return 1;
+
+	return 0;
+}
+
+// bCopy: copy-on-write, the pages stay shared until someone writes to them
+static void *BurnCacheMapFile(const char *szName, INT32 *pnSize, INT32 bCopy)
+{
+	char szPath[MAX_PATH];
+
+	if (pnSize) *pnSize = 0;
+	if (BurnCacheMakePath(szPath, sizeof(szPath), szName)) return NULL;
+
+#if defined(BURN_CACHE_MAP_WIN32)
+	HANDLE hFile = CreateFileA(szPath, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (hFile == INVALID_HANDLE_VALUE) return NULL;
+
+	LARGE_INTEGER nSize;
+	if (!GetFileSizeEx(hFile, &nSize) || nSize.QuadPart <= 0 || nSize.QuadPart > 0x7fffffff) {
+		CloseHandle(hFile);
+		return NULL;
+	}
+
+	HANDLE hMap = CreateFileMappingA(hFile, NULL, bCopy ? PAGE_WRITECOPY : PAGE_READONLY, 0, 0, NULL);
+	CloseHandle(hFile);
+	if (hMap == NULL) return NULL;
+
+	void *pMem = MapViewOfFile(hMap, bCopy ? FILE_MAP_COPY : FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(hMap); // the view keeps the mapping alive
+	if (pMem == NULL) return NULL;
+
+	if (pnSize) *pnSize = (INT32)nSize.QuadPart;
+
+	return pMem;
+#elif defined(BURN_CACHE_MAP_POSIX)
+	INT32 fd = open(szPath, O_RDONLY);
+	if (fd < 0) return NULL;
+
+	struct stat st;
+	if (fstat(fd, &st) || st.st_size <= 0 || st.st_size > 0x7fffffff) {
+		close(fd);
+		return NULL;
+	}
+
+	void *pMem = mmap(NULL, st.st_size, bCopy ? (PROT_READ | PROT_WRITE) : PROT_READ, bCopy ? MAP_PRIVATE : MAP_SHARED, fd, 0);
+	close(fd); // the mapping keeps the file alive
+	if (pMem == MAP_FAILED) return NULL;
+
+	if (pnSize) *pnSize = (INT32)st.st_size;
+
+	return pMem;
+#else
+	return NULL; // no way to map files, the cache is disabled
+#endif
+}
+
+void *BurnCacheMap(const char *szName, INT32 *pnSize)
+{
+	return BurnCacheMapFile(szName, pnSize, 0);
+}
+
+void BurnCacheUnmap(void *pMem, INT32 nSize)
+{
+	if (pMem == NULL) return;
+
+#if defined(BURN_CACHE_MAP_WIN32)
+	UnmapViewOfFile(pMem);
+#elif defined(BURN_CACHE_MAP_POSIX)
+	munmap(pMem, nSize);
+#endif
+}
+
+INT32 BurnCacheWrite(const char *szName, const void *pHeader, INT32 nHeaderLen, const void *pData, INT32 nLen)
+{
+#if defined(BURN_CACHE_MAP_WIN32) || defined(BURN_CACHE_MAP_POSIX)
+	char szPath[MAX_PATH];
+	char szTemp[MAX_PATH + 32];
+
+	if (BurnCacheMakePath(szPath, sizeof(szPath), szName)) return 1;
+
+#if defined(BURN_CACHE_MAP_WIN32)
+	snprintf(szTemp, sizeof(szTemp), "%s.%d.tmp", szPath, _getpid());
+#else
+	snprintf(szTemp, sizeof(szTemp), "%s.%d.tmp", szPath, (INT32)getpid());
+#endif
+
+	FILE *fp = fopen(szTemp, "wb");
+
+	if (fp == NULL) {
+		// first write, try to create the cache directory (and its parents)
+		char szBase[MAX_PATH];
+		TCHARToANSI(szBurnCachePath, szBase, sizeof(szBase));
+
+		for (char *p = szBase + 1; *p; p++) {
+			if (*p != '/' && *p != '\\') continue;
+
+			char c = *p;
+			*p = 0;
+#if defined(BURN_CACHE_MAP_WIN32)
+			CreateDirectoryA(szBase, NULL);
+#else
+			mkdir(szBase, 0755);
+#endif
+			*p = c;
+		}
+#if defined(BURN_CACHE_MAP_WIN32)
+		CreateDirectoryA(szBase, NULL);
+#else
+		mkdir(szBase, 0755);
+#endif
+		fp = fopen(szTemp, "wb");
+		if (fp == NULL) return 1;
+	}
+
+	INT32 nRet = 0;
+	if (nHeaderLen && fwrite(pHeader, nHeaderLen, 1, fp) != 1) nRet = 1;
+	if (nLen && fwrite(pData, nLen, 1, fp) != 1) nRet = 1;
+	if (fclose(fp)) nRet = 1;
+
+	if (nRet == 0) {
+#if defined(BURN_CACHE_MAP_WIN32)
+		// fails if another instance got there first, theirs is just as good
+		nRet = MoveFileExA(szTemp, szPath, MOVEFILE_REPLACE_EXISTING) ? 0 : 1;
+#else
+		nRet = rename(szTemp, szPath) ? 1 : 0;
+#endif
+	}
+
+	if (nRet) {
+		remove(szTemp);
+		bprintf(0, _T("BurnCacheWrite: couldn't write %S\n"), szPath);
+	}
+
+	return nRet;
+#else
+	return 1;
+#endif
+}
+
+// Derived assets: the result of some expensive load-and-transform step (rom
+// decryption, graphics unpacking...) stored under the driver's name. The key
+// covers the crc and length of every rom that goes into it plus the version
+// of the transform, so a changed romset or a fixed decoder makes a new one.
+
+#define BURN_ASSET_MAGIC	"FBDA"
+
+struct burn_asset_header {
+	char magic[4];
+	UINT32 length;
+	UINT64 key;
+};
+
+UINT64 BurnCacheRomKey(INT32 nFirst, INT32 nCount, UINT32 nVersion)
+{
+	if (szBurnCachePath[0] == 0 || bDoIpsPatch) return 0; // ips patches change the data, not the crcs
+
+	// the key is made from the crcs the roms really have, so a bad dump can't
+	// end up cached under the good set's key (or be hidden by its cache)
+	if (BurnExtRomCrc == NULL) return 0;
+
+	UINT64 nKey = BURN_HASH_INIT;
+
+	UINT32 nData[3] = { nVersion, 0, 0 };
+	struct BurnRomInfo ri;
+
+	for (INT32 i = nFirst; nCount < 0 || i < nFirst + nCount; i++) {
+		if (BurnDrvGetRomInfo(&ri, i)) {
+			if (nCount < 0) break;
+			return 0;
+		}
+
+		if (ri.nLen == 0 || (ri.nType & BRF_NODUMP)) continue;
+
+		UINT32 nCrc = 0;
+		if (BurnExtRomCrc(&nCrc, i)) {
+			if (ri.nType & BRF_OPT) continue;
+			return 0; // missing or the wrong size
+		}
+
+		nData[1] = nCrc;
+		nData[2] = ri.nLen;
+
+		nKey = BurnHash(nData, sizeof(nData), nKey);
+	}
+
+	return nKey ? nKey : 1;
+}
+
+static void BurnCacheAssetName(char *szName, INT32 nLen, const char *szAsset)
+{
+	snprintf(szName, nLen, "%s.%s.dac", BurnDrvGetTextA(DRV_NAME), szAsset);
+}
+
+INT32 BurnCacheLoadAsset(const char *szAsset, UINT64 nKey, UINT8 *pDest, INT32 nLen)
+{
+	if (nKey == 0 || pDest == NULL || nLen <= 0) return 1;
+
+	char szName[256];
+	INT32 nSize = 0;
+
+	BurnCacheAssetName(szName, sizeof(szName), szAsset);
+
+	UINT8 *pMap = (UINT8*)BurnCacheMap(szName, &nSize);
+	if (pMap == NULL) return 1;
+
+	burn_asset_header *hdr = (burn_asset_header*)pMap;
+
+	if (nSize != (INT32)sizeof(burn_asset_header) + nLen || memcmp(hdr->magic, BURN_ASSET_MAGIC, 4) ||
+		hdr->length != (UINT32)nLen || hdr->key != nKey)
+	{
+		BurnCacheUnmap(pMap, nSize);
+		return 1;
+	}
+
+	memcpy(pDest, pMap + sizeof(burn_asset_header), nLen);
+
+	BurnCacheUnmap(pMap, nSize);
+
+	bprintf(0, _T("BurnCache: %S from cache.\n"), szName);
+
+	return 0;
+}
+
+// copy-on-write mapping of an asset, returns its data (NULL if it isn't there).
+// *ppMap and *pnMapSize are what BurnCacheUnmap() wants back.
+UINT8 *BurnCacheMapAsset(const char *szAsset, UINT64 nKey, INT32 nLen, void **ppMap, INT32 *pnMapSize)
+{
+	if (nKey == 0 || nLen <= 0) return NULL;
+
+	char szName[256];
+	INT32 nSize = 0;
+
+	BurnCacheAssetName(szName, sizeof(szName), szAsset);
+
+	UINT8 *pMap = (UINT8*)BurnCacheMapFile(szName, &nSize, 1);
+	if (pMap == NULL) return NULL;
+
+	burn_asset_header *hdr = (burn_asset_header*)pMap;
+
+	if (nSize != (INT32)sizeof(burn_asset_header) + nLen || memcmp(hdr->magic, BURN_ASSET_MAGIC, 4) ||
+		hdr->length != (UINT32)nLen || hdr->key != nKey)
+	{
+		BurnCacheUnmap(pMap, nSize);
+		return NULL;
+	}
+
+	*ppMap = pMap;
+	*pnMapSize = nSize;
+
+	return pMap + sizeof(burn_asset_header);
+}
+
+INT32 BurnCacheSaveAsset(const char *szAsset, UINT64 nKey, const UINT8 *pSrc, INT32 nLen)
+{
+	if (nKey == 0 || pSrc == NULL || nLen <= 0) return 1;
+
+	char szName[256];
+	burn_asset_header hdr;
+
+	BurnCacheAssetName(szName, sizeof(szName), szAsset);
+
+	memcpy(hdr.magic, BURN_ASSET_MAGIC, 4);
+	hdr.length = nLen;
+	hdr.key = nKey;
+
+	return BurnCacheWrite(szName, &hdr, sizeof(hdr), pSrc, nLen);
+}
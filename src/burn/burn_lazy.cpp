@@ -0,0 +1,179 @@
+// FB Neo lazily loaded rom regions
+//
+// A driver can leave a big region (sample roms and the like) empty at init and
+// register it here instead of loading it. The region is then filled a chunk at a
+// time, the first time the driver touches that part of it (BurnLazyTouch()).
+// Memory from BurnMalloc() isn't backed by real pages until it's written to, so
+// the parts a session never uses cost neither load time nor memory.
+//
+// Only active when the frontend sets bBurnLazyRoms and supplies
+// BurnExtLoadRomPart(), not with IPS patches (they need the whole rom) and not
+// with bBurnShareRoms (the shared copy has to be complete).
+
+#include "burnint.h"
+
+#define LAZY_MAX_REGIONS	8
+#define LAZY_MAX_ROMS		64
+#define LAZY_CHUNK_SHIFT	16			// 64KB
+
+INT32 bBurnLazyRoms = 0;
+
+struct lazy_region {
+	UINT8 *pMem;
+	INT32 nLen;
+	INT32 (*pLoad)(UINT8 *pDest, INT32 nOffset, INT32 nLen, void *pParam);
+	void *pParam;
+	UINT8 *pLoaded;						// one byte per chunk, 1 = loaded
+
+	// BurnLazyAddRoms()
+	INT32 nRomCount;
+	INT32 nRom[LAZY_MAX_ROMS];
+	INT32 nRomOffset[LAZY_MAX_ROMS];
+	INT32 nRomLen[LAZY_MAX_ROMS];
+};
+
+static lazy_region Regions[LAZY_MAX_REGIONS];
+static INT32 nRegions = 0;
+
+static INT32 BurnLazyAvailable()
+{
+	return bBurnLazyRoms && BurnExtLoadRomPart != NULL && !bDoIpsPatch && !bBurnShareRoms;
+}
+
+INT32 BurnLazyAdd(UINT8 *pMem, INT32 nLen, INT32 (*pLoad)(UINT8 *pDest, INT32 nOffset, INT32 nLen, void *pParam), void *pParam)
+{
+	if (!BurnLazyAvailable() || pMem == NULL || nLen <= 0 || pLoad == NULL) return 1;
+	if (nRegions >= LAZY_MAX_REGIONS) return 1;
+
+	lazy_region *r = &Regions[nRegions];
+	memset(r, 0, sizeof(lazy_region));
+
+	r->pLoaded = (UINT8*)BurnMalloc((nLen >> LAZY_CHUNK_SHIFT) + 1);
+	if (r->pLoaded == NULL) return 1;
+
+	r->pMem = pMem;
+	r->nLen = nLen;
+	r->pLoad = pLoad;
+	r->pParam = pParam;
+
+	nRegions++;
+
+	return 0;
+}
+
+// loads the parts of the roms that overlap [nOffset, nOffset + nLen) of the region
+static INT32 BurnLazyLoadRoms(UINT8 *pDest, INT32 nOffset, INT32 nLen, void *pParam)
+{
+	lazy_region *r = (lazy_region*)pParam;
+	INT32 nRet = 0;
+
+	for (INT32 i = 0; i < r->nRomCount; i++) {
+		INT32 nStart = r->nRomOffset[i];
+		INT32 nEnd = nStart + r->nRomLen[i];
+
+		if (nEnd <= nOffset || nStart >= nOffset + nLen) continue;
+
+		if (nStart < nOffset) nStart = nOffset;
+		if (nEnd > nOffset + nLen) nEnd = nOffset + nLen;
+
+		nRet |= BurnLoadRomPart(pDest + (nStart - nOffset), r->nRom[i], nStart - r->nRomOffset[i], nEnd - nStart);
+	}
+
+	return nRet;
+}
+
+// nCount roms from nFirst go into the region nStride bytes apart, or one after the
+// other if nStride is 0. Returns 0 if the region is going to be loaded lazily,
+// otherwise the driver has to load it itself, as usual.
+INT32 BurnLazyAddRoms(UINT8 *pMem, INT32 nLen, INT32 nFirst, INT32 nCount, INT32 nStride)
+{
+	if (nCount <= 0 || nCount > LAZY_MAX_ROMS) return 1;
+
+	if (BurnLazyAdd(pMem, nLen, BurnLazyLoadRoms, NULL)) return 1;
+
+	lazy_region *r = &Regions[nRegions - 1];
+	r->pParam = r;
+
+	INT32 nOffset = 0;
+
+	for (INT32 i = 0; i < nCount; i++) {
+		struct BurnRomInfo ri;
+		memset(&ri, 0, sizeof(ri));
+		BurnDrvGetRomInfo(&ri, nFirst + i);
+
+		if (nStride) nOffset = nStride * i;
+
+		INT32 nRomLen = ri.nLen;
+		if (nOffset + nRomLen > nLen) nRomLen = nLen - nOffset;
+
+		if (nRomLen > 0) {
+			r->nRom[r->nRomCount] = nFirst + i;
+			r->nRomOffset[r->nRomCount] = nOffset;
+			r->nRomLen[r->nRomCount] = nRomLen;
+			r->nRomCount++;
+		}
+
+		nOffset += ri.nLen;
+	}
+
+	return 0;
+}
+
+void BurnLazyTouch(UINT8 *pMem, INT32 nOffset, INT32 nLen)
+{
+	for (INT32 i = 0; i < nRegions; i++) {
+		lazy_region *r = &Regions[i];
+
+		if (r->pMem != pMem) continue;
+
+		if (nOffset < 0) {
+			nLen += nOffset;
+			nOffset = 0;
+		}
+		if (nOffset + nLen > r->nLen) nLen = r->nLen - nOffset;
+		if (nLen <= 0) return;
+
+		INT32 nFirst = nOffset >> LAZY_CHUNK_SHIFT;
+		INT32 nLast = (nOffset + nLen - 1) >> LAZY_CHUNK_SHIFT;
+
+		for (INT32 c = nFirst; c <= nLast; c++) {
+			if (r->pLoaded[c]) continue;
+
+			// load runs of missing chunks in one go
+			INT32 nRun = c;
+			while (nRun < nLast && r->pLoaded[nRun + 1] == 0) nRun++;
+
+			INT32 nStart = c << LAZY_CHUNK_SHIFT;
+			INT32 nEnd = (nRun + 1) << LAZY_CHUNK_SHIFT;
+			if (nEnd > r->nLen) nEnd = r->nLen;
+
+			if (r->pLoad(r->pMem + nStart, nStart, nEnd - nStart, r->pParam)) {
+				bprintf(PRINT_ERROR, _T("BurnLazyTouch: couldn't load %x - %x\n"), nStart, nEnd - 1);
+			}
+
+			memset(r->pLoaded + c, 1, nRun - c + 1); // don't retry failures
+			c = nRun;
+		}
+
+		return;
+	}
+}
+
+// pMem NULL = every region
+void BurnLazyLoadAll(UINT8 *pMem)
+{
+	for (INT32 i = 0; i < nRegions; i++) {
+		if (pMem == NULL || Regions[i].pMem == pMem) {
+			BurnLazyTouch(Regions[i].pMem, 0, Regions[i].nLen);
+		}
+	}
+}
+
+void BurnLazyExit()
+{
+	for (INT32 i = 0; i < nRegions; i++) {
+		BurnFree(Regions[i].pLoaded);
+	}
+
+	nRegions = 0;
+}
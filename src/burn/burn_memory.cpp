@@ -14,6 +14,8 @@
 
 static UINT8 *memptr[MAX_MEM_PTR]; // pointer to allocated memory
 static INT32 memsize[MAX_MEM_PTR];
+static void *memmap[MAX_MEM_PTR]; // cache file mapping behind memptr (BurnShareMemory())
+static INT32 memmapsize[MAX_MEM_PTR];
 static INT32 mem_allocated;
 
 // this should be called early on... BurnDrvInit?
@@ -22,25 +24,40 @@ void BurnInitMemoryManager()
 {
 	memset (memptr, 0, sizeof(memptr));
 	memset (memsize, 0, sizeof(memsize));
+	memset (memmap, 0, sizeof(memmap));
+	memset (memmapsize, 0, sizeof(memmapsize));
 	mem_allocated = 0;
 }
 
+static void release(INT32 i)
+{
+	if (memmap[i]) {
+		BurnCacheUnmap(memmap[i], memmapsize[i]);
+		memmap[i] = NULL;
+		memmapsize[i] = 0;
+	} else {
+		free (memptr[i]);
+	}
+}
+
 // call BurnMalloc() instead of 'malloc' (see macro in burnint.h)
 UINT8 *_BurnMalloc(INT32 size, char *file, INT32 line)
 {
+	BURN_PROFILE_PHASE(MALLOC);
+	BurnProfileAddBytes(BURN_PROFILE_MALLOC, size);
+
 	for (INT32 i = 0; i < MAX_MEM_PTR; i++)
 	{
 		if (memptr[i] == NULL) {
 			INT32 spill = (OOB_CHECKER) ? OOB_CHECK : 0;
-			memptr[i] = (UINT8*)malloc(size + spill);
+			// contents are 0, big blocks aren't backed by real memory until they're written (see burn_lazy.cpp)
+			memptr[i] = (UINT8*)calloc(size + spill, 1);
 
 			if (memptr[i] == NULL) {
 				bprintf (0, _T("BurnMalloc failed to allocate %d bytes of memory!\n"), size);
 				return NULL;
 			}
 
-			memset (memptr[i], 0, size + spill); // set contents to 0
-
 			mem_allocated += size; // important: do not record "spill" here (see check_overwrite())
 			memsize[i] = size;
 
@@ -92,7 +109,15 @@ UINT8 *BurnRealloc(void *ptr, INT32 size)
 		if (memptr[i] == mptr) {
 			check_overwrite(i, MEM_REALLOC);
 			INT32 spill = (OOB_CHECKER) ? OOB_CHECK : 0;
-			memptr[i] = (UINT8*)realloc(ptr, size + spill);
+			if (memmap[i]) {
+				// shared, move it back to private memory
+				UINT8 *p = (UINT8*)malloc(size + spill);
+				if (p) memcpy(p, memptr[i], (size < memsize[i]) ? size : memsize[i]);
+				release(i);
+				memptr[i] = p;
+			} else {
+				memptr[i] = (UINT8*)realloc(ptr, size + spill);
+			}
 			if (spill) memset (memptr[i] + size, 0, spill);
 			mem_allocated -= memsize[i];
 			mem_allocated += size;
@@ -113,7 +138,7 @@ void _BurnFree(void *ptr)
 	{
 		if (mptr != NULL && memptr[i] == mptr) {
 			check_overwrite(i, MEM_FREE);
-			free (memptr[i]);
+			release(i);
 			memptr[i] = NULL;
 
 			mem_allocated -= memsize[i];
@@ -126,6 +151,51 @@ void _BurnFree(void *ptr)
 	}
 }
 
+// With bBurnShareRoms set, swap a BurnMalloc()ed region that's done being loaded
+// for a copy-on-write mapping of the same bytes in the cache, so instances running
+// the same game share the pages. The cache file is written on first use and has to
+// match the region byte for byte. Returns the region's (new) address, ptr if it
+// stays private. BurnFree() works the same on either.
+UINT8 *BurnShareMemory(void *ptr, const char *szAsset, UINT64 nKey)
+{
+	UINT8 *mptr = (UINT8*)ptr;
+
+	if (bBurnShareRoms == 0 || nKey == 0 || mptr == NULL) return mptr;
+
+	for (INT32 i = 0; i < MAX_MEM_PTR; i++)
+	{
+		if (memptr[i] == mptr) {
+			if (memmap[i]) return mptr; // already shared
+
+			INT32 size = memsize[i] + ((OOB_CHECKER) ? OOB_CHECK : 0);
+			void *pMap = NULL;
+			INT32 nMapSize = 0;
+
+			UINT8 *pData = BurnCacheMapAsset(szAsset, nKey, size, &pMap, &nMapSize);
+			if (pData == NULL) {
+				BurnCacheSaveAsset(szAsset, nKey, mptr, size);
+				pData = BurnCacheMapAsset(szAsset, nKey, size, &pMap, &nMapSize);
+				if (pData == NULL) return mptr;
+			}
+
+			if (memcmp(pData, mptr, size)) {
+				bprintf(0, _T("BurnShareMemory: cached %S doesn't match, keeping a private copy.\n"), szAsset);
+				BurnCacheUnmap(pMap, nMapSize);
+				return mptr;
+			}
+
+			free (memptr[i]);
+			memptr[i] = pData;
+			memmap[i] = pMap;
+			memmapsize[i] = nMapSize;
+
+			return pData;
+		}
+	}
+
+	return mptr;
+}
+
 // Swap contents of src with dst
 void BurnSwapMemBlock(UINT8 *src, UINT8 *dst, INT32 size)
 {
@@ -149,7 +219,7 @@ void BurnExitMemoryManager()
 #if defined FBNEO_DEBUG
 			bprintf(PRINT_ERROR, _T("BurnExitMemoryManager had to free mem pointer %i (%d bytes)\n"), i, memsize[i]);
 #endif
-			free (memptr[i]);
+			release(i);
 			memptr[i] = NULL;
 
 			mem_allocated -= memsize[i];
@@ -0,0 +1,333 @@
+// FB Neo worker pool
+//
+// A fixed set of threads, started on first use, which run batches of
+// independent jobs for BurnPoolRun(). The calling thread works on the batch as
+// well and only returns once every job is done. A batch started while another
+// one is running (from a second thread, or from inside a job) simply runs on
+// the calling thread, as does everything on platforms without threads.
+
+#include "burnint.h"
+
+#if defined(_WIN32)
+ #include <windows.h>
+ #define BURN_POOL_WIN32
+#elif defined(__linux__) || defined(__APPLE__) || defined(__unix__)
+ #include <pthread.h>
+ #include <stdint.h>
+ #include <unistd.h>
+ #define BURN_POOL_PTHREAD
+#endif
+
+#define BURN_POOL_MAX		16
+
+INT32 nBurnPoolThreads = 0;			// 0 = one per cpu core
+
+static void (*pPoolJob)(INT32, void*) = NULL;
+static void *pPoolParam = NULL;
+static INT32 nPoolCount = 0;
+static INT32 nPoolWorkers = 0;		// threads started, not counting the caller
+static volatile INT32 bPoolInited = 0;
+static volatile INT32 bPoolExit = 0;
+
+#if defined(BURN_POOL_WIN32)
+static volatile LONG bPoolInitLock = 0;
+static volatile LONG nPoolNext = 0;
+static volatile LONG bPoolBusy = 0;
+static HANDLE hPoolThread[BURN_POOL_MAX];
+static HANDLE hPoolStart = NULL;
+static HANDLE hPoolDone = NULL;
+#elif defined(BURN_POOL_PTHREAD)
+static volatile INT32 nPoolNext = 0;
+static INT32 bPoolBusy = 0;
+static UINT32 nPoolGeneration = 0;
+static INT32 nPoolRunning = 0;
+static pthread_t PoolThread[BURN_POOL_MAX];
+static pthread_mutex_t PoolMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t PoolInitMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t PoolStart = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t PoolDone = PTHREAD_COND_INITIALIZER;
+#else
+static INT32 nPoolNext = 0;
+#endif
+
+static void BurnPoolWork()
+{
+	while (1) {
+#if defined(BURN_POOL_WIN32)
+		INT32 nJob = InterlockedIncrement(&nPoolNext) - 1;
+#elif defined(BURN_POOL_PTHREAD)
+		INT32 nJob = __sync_fetch_and_add(&nPoolNext, 1);
+#else
+		INT32 nJob = nPoolNext++;
+#endif
+		if (nJob >= nPoolCount) break;
+
+		pPoolJob(nJob, pPoolParam);
+	}
+}
+
+#if defined(BURN_POOL_WIN32)
+static DWORD WINAPI BurnPoolProc(void *)
+{
+	while (WaitForSingleObject(hPoolStart, INFINITE) == WAIT_OBJECT_0 && bPoolExit == 0) {
+		BurnPoolWork();
+		ReleaseSemaphore(hPoolDone, 1, NULL);
+	}
+
+	return 0;
+}
+#elif defined(BURN_POOL_PTHREAD)
+static void *BurnPoolProc(void *pParam)
+{
+	UINT32 nSeen = (UINT32)(uintptr_t)pParam; // the generation when we were started
+
+	pthread_mutex_lock(&PoolMutex);
+
+	while (1) {
+		while (nPoolGeneration == nSeen && bPoolExit == 0) {
+			pthread_cond_wait(&PoolStart, &PoolMutex);
+		}
+		if (bPoolExit) break;
+
+		nSeen = nPoolGeneration;
+		pthread_mutex_unlock(&PoolMutex);
+
+		BurnPoolWork();
+
+		pthread_mutex_lock(&PoolMutex);
+		if (--nPoolRunning == 0) {
+			pthread_cond_signal(&PoolDone);
+		}
+	}
+
+	pthread_mutex_unlock(&PoolMutex);
+
+	return NULL;
+}
+#endif
+
+static void BurnPoolInit()
+{
+	bPoolExit = 0;
+	nPoolWorkers = 0;
+
+	INT32 nThreads = nBurnPoolThreads;
+
+	if (nThreads <= 0) {
+#if defined(BURN_POOL_WIN32)
+		SYSTEM_INFO info;
+		GetSystemInfo(&info);
+		nThreads = info.dwNumberOfProcessors;
+#elif defined(BURN_POOL_PTHREAD) && defined(_SC_NPROCESSORS_ONLN)
+		nThreads = sysconf(_SC_NPROCESSORS_ONLN);
+#else
+		nThreads = 1;
+#endif
+	}
+
+	nThreads--; // the caller is one of them
+	if (nThreads > BURN_POOL_MAX) nThreads = BURN_POOL_MAX;
+	if (nThreads <= 0) return;
+
+#if defined(BURN_POOL_WIN32)
+	hPoolStart = CreateSemaphore(NULL, 0, BURN_POOL_MAX, NULL);
+	hPoolDone = CreateSemaphore(NULL, 0, BURN_POOL_MAX, NULL);
+	if (hPoolStart == NULL || hPoolDone == NULL) return;
+
+	for (INT32 i = 0; i < nThreads; i++) {
+		hPoolThread[i] = CreateThread(NULL, 0, BurnPoolProc, NULL, 0, NULL);
+		if (hPoolThread[i] == NULL) break;
+		nPoolWorkers++;
+	}
+#elif defined(BURN_POOL_PTHREAD)
+	for (INT32 i = 0; i < nThreads; i++) {
+		if (pthread_create(&PoolThread[i], NULL, BurnPoolProc, (void*)(uintptr_t)nPoolGeneration)) break;
+		nPoolWorkers++;
+	}
+#endif
+
+	bprintf(0, _T("BurnPool: %d worker threads.\n"), nPoolWorkers);
+}
+
+// the first batch can come from two threads at once (e.g. poly's worker and
+// the emulation thread), only one of them may start the workers
+static void BurnPoolCheckInit()
+{
+#if defined(BURN_POOL_WIN32)
+	while (InterlockedCompareExchange(&bPoolInitLock, 1, 0) != 0) Sleep(0);
+	if (bPoolInited == 0) {
+		BurnPoolInit();
+		bPoolInited = 1;
+	}
+	InterlockedExchange(&bPoolInitLock, 0);
+#elif defined(BURN_POOL_PTHREAD)
+	pthread_mutex_lock(&PoolInitMutex);
+	if (bPoolInited == 0) {
+		BurnPoolInit();
+		bPoolInited = 1;
+	}
+	pthread_mutex_unlock(&PoolInitMutex);
+#else
+	if (bPoolInited == 0) {
+		BurnPoolInit();
+		bPoolInited = 1;
+	}
+#endif
+}
+
+void BurnPoolExit()
+{
+	if (bPoolInited == 0) return;
+
+#if defined(BURN_POOL_WIN32)
+	if (nPoolWorkers) {
+		bPoolExit = 1;
+		ReleaseSemaphore(hPoolStart, nPoolWorkers, NULL);
+		WaitForMultipleObjects(nPoolWorkers, hPoolThread, TRUE, INFINITE);
+
+		for (INT32 i = 0; i < nPoolWorkers; i++) {
+			CloseHandle(hPoolThread[i]);
+		}
+	}
+
+	if (hPoolStart) CloseHandle(hPoolStart);
+	if (hPoolDone) CloseHandle(hPoolDone);
+	hPoolStart = hPoolDone = NULL;
+#elif defined(BURN_POOL_PTHREAD)
+	pthread_mutex_lock(&PoolMutex);
+	bPoolExit = 1;
+	pthread_cond_broadcast(&PoolStart);
+	pthread_mutex_unlock(&PoolMutex);
+
+	for (INT32 i = 0; i < nPoolWorkers; i++) {
+		pthread_join(PoolThread[i], NULL);
+	}
+#endif
+
+	nPoolWorkers = 0;
+	bPoolInited = 0;
+}
+
+INT32 BurnPoolGetThreads()
+{
+	BurnPoolCheckInit();
+
+	return nPoolWorkers + 1;
+}
+
+// non-zero while a batch is running, for code that can't tell whether it's a job
+INT32 BurnPoolBusy()
+{
+#if defined(BURN_POOL_WIN32) || defined(BURN_POOL_PTHREAD)
+	return bPoolBusy;
+#else
+	return 0;
+#endif
+}
+
+void BurnPoolRun(void (*pJob)(INT32 nJob, void *pParam), void *pParam, INT32 nJobs)
+{
+	if (nJobs <= 0) return;
+
+	BurnPoolCheckInit();
+
+	// one job, no workers or the pool is already busy: just do it here
+	INT32 bSerial = (nJobs == 1 || nPoolWorkers == 0);
+
+#if defined(BURN_POOL_WIN32)
+	if (!bSerial && InterlockedCompareExchange(&bPoolBusy, 1, 0) != 0) bSerial = 1;
+#elif defined(BURN_POOL_PTHREAD)
+	if (!bSerial) {
+		pthread_mutex_lock(&PoolMutex);
+		if (bPoolBusy) {
+			bSerial = 1;
+		} else {
+			bPoolBusy = 1;
+		}
+		pthread_mutex_unlock(&PoolMutex);
+	}
+#else
+	bSerial = 1;
+#endif
+
+	if (bSerial) {
+		for (INT32 i = 0; i < nJobs; i++) {
+			pJob(i, pParam);
+		}
+		return;
+	}
+
+	pPoolJob = pJob;
+	pPoolParam = pParam;
+	nPoolCount = nJobs;
+	nPoolNext = 0;
+
+#if defined(BURN_POOL_WIN32)
+	ReleaseSemaphore(hPoolStart, nPoolWorkers, NULL);
+
+	BurnPoolWork();
+
+	for (INT32 i = 0; i < nPoolWorkers; i++) {
+		WaitForSingleObject(hPoolDone, INFINITE);
+	}
+
+	InterlockedExchange(&bPoolBusy, 0);
+#elif defined(BURN_POOL_PTHREAD)
+	pthread_mutex_lock(&PoolMutex);
+	nPoolRunning = nPoolWorkers;
+	nPoolGeneration++;
+	pthread_cond_broadcast(&PoolStart);
+	pthread_mutex_unlock(&PoolMutex);
+
+	BurnPoolWork();
+
+	pthread_mutex_lock(&PoolMutex);
+	while (nPoolRunning) {
+		pthread_cond_wait(&PoolDone, &PoolMutex);
+	}
+	bPoolBusy = 0;
+	pthread_mutex_unlock(&PoolMutex);
+#endif
+}
+
+// BurnPoolFor(): [nStart, nEnd) cut into runs of nGrain (0 = a few per thread),
+// pRange() is called once per run. Which thread gets which run varies, so the
+// runs must not depend on each other for the result to be the same every time.
+
+struct pool_for_params {
+	void (*pRange)(INT32 nStart, INT32 nEnd, void *pParam);
+	void *pParam;
+	INT32 nStart;
+	INT32 nEnd;
+	INT32 nGrain;
+};
+
+static void BurnPoolForJob(INT32 nJob, void *pParam)
+{
+	pool_for_params *p = (pool_for_params*)pParam;
+
+	INT32 nStart = p->nStart + nJob * p->nGrain;
+	INT32 nEnd = (p->nEnd - nStart > p->nGrain) ? (nStart + p->nGrain) : p->nEnd;
+
+	p->pRange(nStart, nEnd, p->pParam);
+}
+
+void BurnPoolFor(void (*pRange)(INT32 nStart, INT32 nEnd, void *pParam), void *pParam, INT32 nStart, INT32 nEnd, INT32 nGrain)
+{
+	if (nEnd <= nStart) return;
+
+	if (nGrain <= 0) {
+		INT32 nRuns = BurnPoolGetThreads() * 4;
+		nGrain = (nEnd - nStart + nRuns - 1) / nRuns;
+		if (nGrain <= 0) nGrain = 1;
+	}
+
+	pool_for_params p;
+	p.pRange = pRange;
+	p.pParam = pParam;
+	p.nStart = nStart;
+	p.nEnd = nEnd;
+	p.nGrain = nGrain;
+
+	BurnPoolRun(BurnPoolForJob, &p, (INT32)(((INT64)nEnd - nStart + nGrain - 1) / nGrain));
+}
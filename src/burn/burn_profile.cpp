@@ -0,0 +1,148 @@
+// FB Neo boot profile
+//
+// With bBurnBootProfile set, the time from BurnDrvInit() (or from the
+// frontend's BurnProfileBegin() call ahead of its rom prefetch) to the end of
+// the first frame is split into phases (rom loading, decryption, graphics
+// decoding...) and printed as a table. The places doing that kind of work mark
+// themselves with BURN_PROFILE_PHASE(). Phases nest, time goes to the innermost
+// one only, so rom loading done inside a graphics converter counts as rom
+// loading. Whatever isn't in a phase is the driver's own init. Calls made from
+// inside a worker pool batch are ignored, the batch counts for the phase that
+// started it.
+
+#include "burnint.h"
+
+#if defined(_WIN32)
+ #include <windows.h>
+#elif defined(__linux__) || defined(__APPLE__) || defined(__unix__)
+ #include <time.h>
+ #define BURN_PROFILE_POSIX
+#endif
+
+#define PROFILE_MAX_DEPTH	16
+
+INT32 bBurnBootProfile = 0;
+
+static const TCHAR *szPhaseName[BURN_PROFILE_PHASES] = {
+	_T("driver init (other)"),
+	_T("rom prefetch"),
+	_T("rom loading"),
+	_T("decryption"),
+	_T("graphics decode"),
+	_T("memory allocation"),
+	_T("cpu init"),
+	_T("sound init"),
+	_T("first frame"),
+};
+
+static INT32 bProfileActive = 0;
+static UINT64 nPhaseTime[BURN_PROFILE_PHASES];		// microseconds
+static INT32 nPhaseCalls[BURN_PROFILE_PHASES];
+static UINT64 nPhaseBytes[BURN_PROFILE_PHASES];
+static INT32 nPhaseStack[PROFILE_MAX_DEPTH];
+static INT32 nDepth = 0;
+static UINT64 nMark = 0;
+
+static UINT64 BurnProfileMicros()
+{
+#if defined(_WIN32)
+	LARGE_INTEGER nCount, nFreq;
+	QueryPerformanceCounter(&nCount);
+	QueryPerformanceFrequency(&nFreq);
+	return (UINT64)(nCount.QuadPart / nFreq.QuadPart) * 1000000 + (UINT64)(nCount.QuadPart % nFreq.QuadPart) * 1000000 / nFreq.QuadPart;
+#elif defined(BURN_PROFILE_POSIX)
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (UINT64)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+#else
+	return (UINT64)clock() * 1000000 / CLOCKS_PER_SEC;
+#endif
+}
+
+// the time since the last switch goes to the phase on top of the stack
+static void BurnProfileSwitch()
+{
+	UINT64 nNow = BurnProfileMicros();
+
+	if (nDepth > 0 && nDepth <= PROFILE_MAX_DEPTH) {
+		nPhaseTime[nPhaseStack[nDepth - 1]] += nNow - nMark;
+	}
+
+	nMark = nNow;
+}
+
+void BurnProfileStart(INT32 nPhase)
+{
+	if (!bProfileActive || BurnPoolBusy()) return;
+
+	if (nDepth < PROFILE_MAX_DEPTH) {
+		BurnProfileSwitch();
+		nPhaseStack[nDepth] = nPhase;
+		nPhaseCalls[nPhase]++;
+	}
+
+	nDepth++;
+}
+
+void BurnProfileStop()
+{
+	if (!bProfileActive || BurnPoolBusy() || nDepth <= 1) return;
+
+	if (nDepth <= PROFILE_MAX_DEPTH) {
+		BurnProfileSwitch();
+	}
+
+	nDepth--;
+}
+
+void BurnProfileAddBytes(INT32 nPhase, INT32 nBytes)
+{
+	if (!bProfileActive || BurnPoolBusy() || nBytes <= 0) return;
+
+	nPhaseBytes[nPhase] += nBytes;
+}
+
+INT32 BurnProfileRunning()
+{
+	return bProfileActive;
+}
+
+void BurnProfileBegin()
+{
+	if (bProfileActive) return;	// the frontend started it before its rom prefetch
+	if (!bBurnBootProfile) return;
+
+	memset(nPhaseTime, 0, sizeof(nPhaseTime));
+	memset(nPhaseCalls, 0, sizeof(nPhaseCalls));
+	memset(nPhaseBytes, 0, sizeof(nPhaseBytes));
+
+	nPhaseStack[0] = BURN_PROFILE_OTHER;
+	nDepth = 1;
+	nMark = BurnProfileMicros();
+
+	bProfileActive = 1;
+}
+
+void BurnProfileEnd()
+{
+	if (!bProfileActive) return;
+
+	BurnProfileSwitch();
+	bProfileActive = 0;
+
+	UINT64 nTotal = 0;
+	for (INT32 i = 0; i < BURN_PROFILE_PHASES; i++) {
+		nTotal += nPhaseTime[i];
+	}
+	if (nTotal == 0) nTotal = 1;
+
+	bprintf(PRINT_IMPORTANT, _T("Boot profile for %s (%d pool threads):\n"), BurnDrvGetText(DRV_NAME), BurnPoolGetThreads());
+	bprintf(PRINT_IMPORTANT, _T("  %-20s %10s %6s %7s %10s\n"), _T("phase"), _T("ms"), _T("%"), _T("calls"), _T("KB"));
+
+	for (INT32 i = 0; i < BURN_PROFILE_PHASES; i++) {
+		bprintf(PRINT_IMPORTANT, _T("  %-20s %10.1f %6.1f %7d %10d\n"), szPhaseName[i], nPhaseTime[i] / 1000.0,
+			nPhaseTime[i] * 100.0 / nTotal, (i == BURN_PROFILE_OTHER) ? 1 : nPhaseCalls[i], (INT32)(nPhaseBytes[i] >> 10));
+	}
+
+	bprintf(PRINT_IMPORTANT, _T("  %-20s %10.1f\n"), _T("total"), nTotal / 1000.0);
+}
@@ -0,0 +1,201 @@
+// burn_roz.cpp - shared affine (rotate/zoom) span rasterizer
+// The coordinate stepping, wrap/window test and offset calculation run 8 pixels
+// per iteration with SSE2 where available, the gather itself is scalar (SSE2 has
+// no gather). The 16-bit span writer is vectorised too, the 32-bit one looks up
+// the palette per pixel.
+
+#include "burnint.h"
+#include "burn_simd.h"
+#include "burn_roz.h"
+
+#define BURNROZ_CHUNK	256
+
+void BurnRozSetSource(BurnRozSource *pRoz, const UINT16 *pSrc, INT32 nPitch, INT32 nWidth, INT32 nHeight, INT32 nShift, INT32 bWrap)
+{
+	pRoz->pSrc = pSrc;
+	pRoz->nPitch = nPitch;
+	pRoz->nShift = nShift;
+
+	pRoz->nWrapX = bWrap ? (nWidth - 1) : ~0;
+	pRoz->nWrapY = bWrap ? (nHeight - 1) : ~0;
+
+	pRoz->nMinX = 0;
+	pRoz->nMaxX = nWidth - 1;
+	pRoz->nMinY = 0;
+	pRoz->nMaxY = nHeight - 1;
+}
+
+#if defined BURN_SIMD_SSE2
+// 32x32 -> low 32 multiply, SSE2 only has the 32x32 -> 64 one
+static inline __m128i roz_mullo_epi32(__m128i a, __m128i b)
+{
+	__m128i even = _mm_mul_epu32(a, b);
+	__m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+
+	return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+// offsets of 4 pixels, outside ones get offset 0 and the BURNROZ_OUTSIDE flag in *pFlag
+static inline __m128i roz_offsets(__m128i cx, __m128i cy, __m128i shift, __m128i wrapx, __m128i wrapy, __m128i minx, __m128i maxx, __m128i miny, __m128i maxy, __m128i pitch, __m128i *pFlag)
+{
+	__m128i x = _mm_and_si128(_mm_srl_epi32(cx, shift), wrapx);
+	__m128i y = _mm_and_si128(_mm_srl_epi32(cy, shift), wrapy);
+
+	__m128i out = _mm_or_si128(_mm_or_si128(_mm_cmplt_epi32(x, minx), _mm_cmpgt_epi32(x, maxx)), _mm_or_si128(_mm_cmplt_epi32(y, miny), _mm_cmpgt_epi32(y, maxy)));
+
+	*pFlag = _mm_and_si128(out, _mm_set1_epi32(BURNROZ_OUTSIDE));
+
+	return _mm_andnot_si128(out, _mm_add_epi32(roz_mullo_epi32(y, pitch), x));
+}
+#endif
+
+void BurnRozFetch(UINT32 *pDest, const BurnRozSource *pRoz, UINT32 cx, UINT32 cy, INT32 dxx, INT32 dxy, INT32 nCount)
+{
+	const UINT16 *pSrc = pRoz->pSrc;
+	const INT32 nShift = pRoz->nShift;
+	INT32 i = 0;
+
+#if defined BURN_SIMD_SSE2
+	const __m128i shift = _mm_cvtsi32_si128(nShift);
+	const __m128i wrapx = _mm_set1_epi32(pRoz->nWrapX);
+	const __m128i wrapy = _mm_set1_epi32(pRoz->nWrapY);
+	const __m128i minx = _mm_set1_epi32(pRoz->nMinX);
+	const __m128i maxx = _mm_set1_epi32(pRoz->nMaxX);
+	const __m128i miny = _mm_set1_epi32(pRoz->nMinY);
+	const __m128i maxy = _mm_set1_epi32(pRoz->nMaxY);
+	const __m128i pitch = _mm_set1_epi32(pRoz->nPitch);
+
+	// lanes hold pixels i + 0..3, the second set i + 4..7
+	const UINT32 ux = dxx, uy = dxy;	// steps wrap like the UINT32 coordinates
+	__m128i vx0 = _mm_add_epi32(_mm_set1_epi32(cx), _mm_set_epi32(ux * 3, ux * 2, ux, 0));
+	__m128i vy0 = _mm_add_epi32(_mm_set1_epi32(cy), _mm_set_epi32(uy * 3, uy * 2, uy, 0));
+	const __m128i stepx4 = _mm_set1_epi32(ux * 4);
+	const __m128i stepy4 = _mm_set1_epi32(uy * 4);
+	const __m128i stepx8 = _mm_set1_epi32(ux * 8);
+	const __m128i stepy8 = _mm_set1_epi32(uy * 8);
+
+	INT32 nOffs[8];
+	UINT32 nFlag[8];
+
+	for (; i + 8 <= nCount; i += 8) {
+		__m128i f0, f1;
+		__m128i o0 = roz_offsets(vx0, vy0, shift, wrapx, wrapy, minx, maxx, miny, maxy, pitch, &f0);
+		__m128i o1 = roz_offsets(_mm_add_epi32(vx0, stepx4), _mm_add_epi32(vy0, stepy4), shift, wrapx, wrapy, minx, maxx, miny, maxy, pitch, &f1);
+
+		_mm_storeu_si128((__m128i*)(nOffs + 0), o0);
+		_mm_storeu_si128((__m128i*)(nOffs + 4), o1);
+		_mm_storeu_si128((__m128i*)(nFlag + 0), f0);
+		_mm_storeu_si128((__m128i*)(nFlag + 4), f1);
+
+		for (INT32 j = 0; j < 8; j++) {
+			pDest[i + j] = pSrc[nOffs[j]] | nFlag[j];
+		}
+
+		vx0 = _mm_add_epi32(vx0, stepx8);
+		vy0 = _mm_add_epi32(vy0, stepy8);
+	}
+
+	cx += ux * i;
+	cy += uy * i;
+#endif
+
+	for (; i < nCount; i++, cx += dxx, cy += dxy) {
+		INT32 x = (cx >> nShift) & pRoz->nWrapX;
+		INT32 y = (cy >> nShift) & pRoz->nWrapY;
+
+		if (x < pRoz->nMinX || x > pRoz->nMaxX || y < pRoz->nMinY || y > pRoz->nMaxY) {
+			pDest[i] = BURNROZ_OUTSIDE;
+			continue;
+		}
+
+		pDest[i] = pSrc[y * pRoz->nPitch + x];
+	}
+}
+
+void BurnRozDrawSpan16(UINT16 *pDest, UINT8 *pPri, const BurnRozSource *pRoz, UINT32 cx, UINT32 cy, INT32 dxx, INT32 dxy, INT32 nCount, UINT32 nTransMask, UINT32 nTransPen, UINT32 nPenMask, UINT8 nPriority)
+{
+	UINT32 nPixels[BURNROZ_CHUNK];
+
+	if (nTransMask == 0) nTransPen = ~0;	// never matches
+
+	while (nCount > 0) {
+		INT32 nChunk = (nCount > BURNROZ_CHUNK) ? BURNROZ_CHUNK : nCount;
+		INT32 i = 0;
+
+		BurnRozFetch(nPixels, pRoz, cx, cy, dxx, dxy, nChunk);
+
+#if defined BURN_SIMD_SSE2
+		const __m128i tmask = _mm_set1_epi32(nTransMask);
+		const __m128i tpen = _mm_set1_epi32(nTransPen);
+		const __m128i outside = _mm_set1_epi32(BURNROZ_OUTSIDE);
+		const __m128i penmask = _mm_set1_epi32(nPenMask & 0xffff);
+		const __m128i prio = _mm_set1_epi8(nPriority);
+
+		for (; i + 8 <= nChunk; i += 8) {
+			__m128i p0 = _mm_loadu_si128((__m128i*)(nPixels + i + 0));
+			__m128i p1 = _mm_loadu_si128((__m128i*)(nPixels + i + 4));
+
+			__m128i s0 = _mm_or_si128(_mm_cmpeq_epi32(_mm_and_si128(p0, tmask), tpen), _mm_cmpeq_epi32(_mm_and_si128(p0, outside), outside));
+			__m128i s1 = _mm_or_si128(_mm_cmpeq_epi32(_mm_and_si128(p1, tmask), tpen), _mm_cmpeq_epi32(_mm_and_si128(p1, outside), outside));
+			__m128i skip = _mm_packs_epi32(s0, s1);
+
+			// sign extend the low words so the saturating pack keeps them as they are
+			p0 = _mm_srai_epi32(_mm_slli_epi32(_mm_and_si128(p0, penmask), 16), 16);
+			p1 = _mm_srai_epi32(_mm_slli_epi32(_mm_and_si128(p1, penmask), 16), 16);
+			__m128i pix = _mm_packs_epi32(p0, p1);
+
+			__m128i d = _mm_loadu_si128((__m128i*)(pDest + i));
+			_mm_storeu_si128((__m128i*)(pDest + i), _mm_or_si128(_mm_and_si128(skip, d), _mm_andnot_si128(skip, pix)));
+
+			if (pPri) {
+				__m128i skip8 = _mm_packs_epi16(skip, skip);
+				__m128i pr = _mm_loadl_epi64((__m128i*)(pPri + i));
+				_mm_storel_epi64((__m128i*)(pPri + i), _mm_or_si128(_mm_and_si128(skip8, pr), _mm_andnot_si128(skip8, prio)));
+			}
+		}
+#endif
+
+		for (; i < nChunk; i++) {
+			UINT32 p = nPixels[i];
+
+			if ((p & BURNROZ_OUTSIDE) || (p & nTransMask) == nTransPen) continue;
+
+			pDest[i] = p & nPenMask;
+			if (pPri) pPri[i] = nPriority;
+		}
+
+		pDest += nChunk;
+		if (pPri) pPri += nChunk;
+		cx += (UINT32)dxx * nChunk;
+		cy += (UINT32)dxy * nChunk;
+		nCount -= nChunk;
+	}
+}
+
+void BurnRozDrawSpan32(UINT32 *pDest, UINT8 *pPri, const UINT32 *pPal, const BurnRozSource *pRoz, UINT32 cx, UINT32 cy, INT32 dxx, INT32 dxy, INT32 nCount, UINT32 nTransMask, UINT32 nTransPen, UINT32 nPenMask, UINT8 nPriority)
+{
+	UINT32 nPixels[BURNROZ_CHUNK];
+
+	if (nTransMask == 0) nTransPen = ~0;
+
+	while (nCount > 0) {
+		INT32 nChunk = (nCount > BURNROZ_CHUNK) ? BURNROZ_CHUNK : nCount;
+
+		BurnRozFetch(nPixels, pRoz, cx, cy, dxx, dxy, nChunk);
+
+		for (INT32 i = 0; i < nChunk; i++) {
+			UINT32 p = nPixels[i];
+
+			if ((p & BURNROZ_OUTSIDE) || (p & nTransMask) == nTransPen) continue;
+
+			pDest[i] = pPal[p & nPenMask];
+			if (pPri) pPri[i] = nPriority;
+		}
+
+		pDest += nChunk;
+		if (pPri) pPri += nChunk;
+		cx += (UINT32)dxx * nChunk;
+		cy += (UINT32)dxy * nChunk;
+		nCount -= nChunk;
+	}
+}
@@ -0,0 +1,33 @@
+// burn_roz.h - shared affine (rotate/zoom) span rasterizer for the ROZ layer chips
+// (K051316, K053936, Sega Y-Board rotation...)
+//
+// A span is one destination line. Source coordinates are UINT32 fixed point with
+// nShift fractional bits, starting at (cx, cy) and stepping (dxx, dxy) per pixel.
+// Whole layers step the span start by (dyx, dyy) per line, per-line (row/line
+// scroll) layers simply set up a new start and increment for every span.
+//
+// The fetch returns the source pixel in the low 16 bits, pixels outside the
+// source window are flagged with BURNROZ_OUTSIDE and are never drawn.
+
+#define BURNROZ_OUTSIDE		0x10000
+
+struct BurnRozSource {
+	const UINT16 *pSrc;
+	INT32 nPitch;			// in pixels
+	INT32 nShift;			// fractional bits of the coordinates (1 - 16)
+	UINT32 nWrapX, nWrapY;		// coordinate masks, ~0 when not wrapping
+	INT32 nMinX, nMaxX;		// window (inclusive) the masked coordinates must fall in
+	INT32 nMinY, nMaxY;
+};
+
+// nWidth / nHeight must be powers of two when wrapping, otherwise the window is the bitmap
+void BurnRozSetSource(BurnRozSource *pRoz, const UINT16 *pSrc, INT32 nPitch, INT32 nWidth, INT32 nHeight, INT32 nShift, INT32 bWrap);
+
+// fetch nCount pixels of one span into pDest
+void BurnRozFetch(UINT32 *pDest, const BurnRozSource *pRoz, UINT32 cx, UINT32 cy, INT32 dxx, INT32 dxy, INT32 nCount);
+
+// fetch + draw one span. Pixels with (pixel & nTransMask) == nTransPen are skipped
+// (nTransMask 0 = opaque), the rest are written as (pixel & nPenMask), or through pPal
+// for 32-bit destinations. pPri (optional) is set to nPriority for every pixel written.
+void BurnRozDrawSpan16(UINT16 *pDest, UINT8 *pPri, const BurnRozSource *pRoz, UINT32 cx, UINT32 cy, INT32 dxx, INT32 dxy, INT32 nCount, UINT32 nTransMask, UINT32 nTransPen, UINT32 nPenMask, UINT8 nPriority);
+void BurnRozDrawSpan32(UINT32 *pDest, UINT8 *pPri, const UINT32 *pPal, const BurnRozSource *pRoz, UINT32 cx, UINT32 cy, INT32 dxx, INT32 dxy, INT32 nCount, UINT32 nTransMask, UINT32 nTransPen, UINT32 nPenMask, UINT8 nPriority);
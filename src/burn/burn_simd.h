@@ -0,0 +1,15 @@
+#ifndef _BURN_SIMD_H
+#define _BURN_SIMD_H
+
+// burn_simd.h - selects the vector instruction set used by the optional SIMD paths
+// Anything using this must keep a plain C path, it's what gets built when
+// nothing below is available (or when BURN_NO_SIMD is defined).
+
+#if !defined(BURN_NO_SIMD)
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define BURN_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+#endif
+
+#endif
@@ -122,6 +122,7 @@ INT32 BurnLoadRomExt(UINT8 *Dest, INT32 i, INT32 nGap, INT32 nFlags);
 INT32 BurnLoadRom(UINT8* Dest, INT32 i, INT32 nGap);
 INT32 BurnXorRom(UINT8 *Dest, INT32 i, INT32 nGap);
 INT32 BurnLoadBitField(UINT8* pDest, UINT8* pSrc, INT32 nField, INT32 nSrcLen);
+INT32 BurnLoadRomPart(UINT8 *Dest, INT32 i, INT32 nOffset, INT32 nLen); // straight copy of part of a rom, see burn_lazy.cpp
 
 // ---------------------------------------------------------------------------
 // Plotting pixels
@@ -193,8 +194,49 @@ void _BurnFree(void *ptr); // internal use only :)
 #define BurnFree(x) do {_BurnFree(x); x = NULL; } while (0)
 #define BurnMalloc(x) _BurnMalloc(x, __FILE__, __LINE__)
 void BurnSwapMemBlock(UINT8 *src, UINT8 *dst, INT32 size); // swap contents of src with dst
+UINT8 *BurnShareMemory(void *ptr, const char *szAsset, UINT64 nKey); // see bBurnShareRoms
 void BurnExitMemoryManager();
 
+// burn_cache.cpp
+void *BurnCacheMap(const char *szName, INT32 *pnSize); // read-only mapping of a cache file, NULL if it isn't there
+void BurnCacheUnmap(void *pMem, INT32 nSize);
+INT32 BurnCacheWrite(const char *szName, const void *pHeader, INT32 nHeaderLen, const void *pData, INT32 nLen);
+UINT64 BurnCacheRomKey(INT32 nFirst, INT32 nCount, UINT32 nVersion); // nCount -1 = every rom, 0 = don't cache
+INT32 BurnCacheLoadAsset(const char *szAsset, UINT64 nKey, UINT8 *pDest, INT32 nLen); // 0 = pDest filled from the cache
+INT32 BurnCacheSaveAsset(const char *szAsset, UINT64 nKey, const UINT8 *pSrc, INT32 nLen);
+UINT8 *BurnCacheMapAsset(const char *szAsset, UINT64 nKey, INT32 nLen, void **ppMap, INT32 *pnMapSize); // copy-on-write
+
+// burn_lazy.cpp
+INT32 BurnLazyAdd(UINT8 *pMem, INT32 nLen, INT32 (*pLoad)(UINT8 *pDest, INT32 nOffset, INT32 nLen, void *pParam), void *pParam); // 0 = pMem is loaded on demand
+INT32 BurnLazyAddRoms(UINT8 *pMem, INT32 nLen, INT32 nFirst, INT32 nCount, INT32 nStride); // 0 = the roms are loaded on demand
+void BurnLazyTouch(UINT8 *pMem, INT32 nOffset, INT32 nLen); // make sure this part of a region is loaded
+void BurnLazyLoadAll(UINT8 *pMem); // NULL = every region
+void BurnLazyExit();
+
+// burn_pool.cpp
+INT32 BurnPoolBusy();
+
+// for state that every pool thread needs its own copy of, must be on both the extern and the definition
+#if defined(_MSC_VER)
+ #define BURN_THREAD_LOCAL __declspec(thread)
+#elif defined(_WIN32) || defined(__linux__) || defined(__APPLE__) || defined(__unix__)
+ #define BURN_THREAD_LOCAL __thread
+#else
+ #define BURN_THREAD_LOCAL
+#endif
+
+// burn_profile.cpp (phases and BurnProfileBegin/Start/Stop() are in burn.h)
+void BurnProfileAddBytes(INT32 nPhase, INT32 nBytes);
+INT32 BurnProfileRunning();
+void BurnProfileEnd();
+
+// times the rest of the enclosing block as nPhase
+struct BurnProfileScope {
+	BurnProfileScope(INT32 nPhase) { BurnProfileStart(nPhase); }
+	~BurnProfileScope() { BurnProfileStop(); }
+};
+#define BURN_PROFILE_PHASE(n)	BurnProfileScope BurnProfileScope_##n(BURN_PROFILE_##n)
+
 // ---------------------------------------------------------------------------
 // sound routes
 #define BURN_SND_ROUTE_NONE			0
@@ -61,6 +61,7 @@ static UINT32 *m_bitmaps;
 static rectangle m_clip;
 
 static UINT64 epic12_device_blit_delay;
+static BURN_THREAD_LOCAL UINT64 m_blit_pixels; // pixels drawn, summed into epic12_device_blit_delay after each list
 static int m_blitter_busy;
 
 static int m_main_ramsize; // type D has double the main ram
@@ -72,6 +73,36 @@ static int m_burn_cycles;
 
 static INT32 sleep_on_busy = 1;
 
+// Pool blitter: gfx_exec() collects a run of operations, then draws it in bands
+// of destination lines on the worker pool. Each band goes through the run in
+// order and only draws its own lines, so every pixel sees the same operations in
+// the same order as before. Which vram each run reads and writes is kept in 64x64
+// cells, an operation that reads what the run wrote (or writes what it read) ends
+// the run first, as another band might not have got there yet.
+#define POOL_BAND_MAX		8
+#define POOL_BAND_MIN_LINES	8
+#define POOL_OPS_MAX		0x2000
+#define POOL_CELL_SHIFT		6
+#define POOL_CELLS_X		(0x2000 >> POOL_CELL_SHIFT)
+#define POOL_CELLS_Y		(0x1000 >> POOL_CELL_SHIFT)
+
+struct pool_op {
+	UINT32 addr;			// in m_ram16_copy
+	rectangle clip;			// m_clip when the operation was read
+	INT32 min_y, max_y;		// lines it draws on
+	INT32 upload;
+};
+
+static INT32 m_pool_blitter = 0;
+static pool_op *pool_ops = NULL;
+static INT32 pool_op_count;
+static INT32 pool_min_y, pool_max_y;
+static INT32 pool_bands;
+static UINT64 pool_band_pixels[POOL_BAND_MAX];
+static UINT16 *pool_written = NULL;	// cell = pool_run if the run writes to it
+static UINT16 *pool_read = NULL;	// cell = pool_run if the run reads from it
+static UINT16 pool_run;
+
 static UINT8 epic12_device_colrtable[0x20][0x40];
 static UINT8 epic12_device_colrtable_rev[0x20][0x40];
 static UINT8 epic12_device_colrtable_add[0x20][0x20];
@@ -310,6 +341,9 @@ void epic12_exit()
 
 	BurnFree(m_bitmaps);
 	BurnFree(m_ram16_copy);
+	BurnFree(pool_ops);
+	BurnFree(pool_written);
+	BurnFree(pool_read);
 
 	if (pal16) {
 		BurnFree(pal16);
@@ -333,6 +367,16 @@ void epic12_init(INT32 ram_size, UINT16 *ram, UINT8 *dippy)
 
 	m_clip.set(0, 0x2000-1, 0, 0x1000-1);
 
+	pool_ops = (pool_op*)BurnMalloc(POOL_OPS_MAX * sizeof(pool_op));
+	pool_written = (UINT16*)BurnMalloc(POOL_CELLS_X * POOL_CELLS_Y * sizeof(UINT16));
+	pool_read = (UINT16*)BurnMalloc(POOL_CELLS_X * POOL_CELLS_Y * sizeof(UINT16));
+	memset(pool_written, 0, POOL_CELLS_X * POOL_CELLS_Y * sizeof(UINT16));
+	memset(pool_read, 0, POOL_CELLS_X * POOL_CELLS_Y * sizeof(UINT16));
+	pool_op_count = 0;
+	pool_run = 1;
+
+	BurnPoolGetThreads(); // start the pool here rather than on the blitter thread
+
 	m_delay_method = 0; // accurate
 	m_delay_scale = 50;
 	m_blitter_busy = 0;
@@ -362,6 +406,11 @@ void epic12_set_blitterthreading(INT32 value)
 	thready.set_threading(value);
 }
 
+void epic12_set_blitterpool(INT32 value)
+{
+	m_pool_blitter = value;
+}
+
 void epic12_set_blitterdelay(INT32 delay, INT32 burn_cycles)
 {
 	m_delay_scale = delay;
@@ -477,7 +526,8 @@ static void gfx_upload_shadow_copy(UINT32 *addr)
 	m_blit_idle_op_bytes = 0;
 }
 
-static void gfx_upload(UINT32 *addr)
+// only lines min_y to max_y are written
+static void gfx_upload(UINT32 *addr, INT32 min_y, INT32 max_y)
 {
 	UINT32 x,y, dst_p,dst_x_start,dst_y_start, dimx,dimy;
 	UINT32 *dst;
@@ -504,6 +554,11 @@ static void gfx_upload(UINT32 *addr)
 
 	for (y = 0; y < dimy; y++)
 	{
+		if ((INT32)(dst_y_start + y) < min_y || (INT32)(dst_y_start + y) > max_y) {
+			*addr += dimx * 2;
+			continue;
+		}
+
 		//dst = &m_bitmaps->pix(dst_y_start + y, 0);
 		dst = m_bitmaps + (dst_y_start + y) * 0x2000;
 
@@ -520,7 +575,7 @@ static void gfx_upload(UINT32 *addr)
 	}
 }
 
-#define draw_params &m_clip, m_bitmaps,src_x,src_y, x,y, dimx,dimy, flipy, s_alpha, d_alpha, &tint_clr
+#define draw_params clip, m_bitmaps,src_x,src_y, x,y, dimx,dimy, flipy, s_alpha, d_alpha, &tint_clr
 
 
 
@@ -722,7 +777,7 @@ static void gfx_draw_shadow_copy(UINT32 *addr)
 	m_blit_delay_ns += num_vram_clk * EP1C_VRAM_CLK_NANOSEC;
 }
 
-static void gfx_draw(UINT32 *addr)
+static void gfx_draw(UINT32 *addr, const rectangle *clip)
 {
 	int x,y, dimx,dimy, flipx,flipy;//, src_p;
 	int trans,blend, s_mode, d_mode;
@@ -934,6 +989,185 @@ static void gfx_draw(UINT32 *addr)
 	}
 }
 
+// returns 1 if any cell under the rectangle is in this run, marks them if mark is set
+static INT32 pool_cells(UINT16 *cells, INT32 min_x, INT32 max_x, INT32 min_y, INT32 max_y, INT32 mark)
+{
+	min_x = MAX(min_x, 0);
+	min_y = MAX(min_y, 0);
+	max_x = MIN(max_x, 0x2000 - 1);
+	max_y = MIN(max_y, 0x1000 - 1);
+
+	INT32 hit = 0;
+
+	for (INT32 cy = min_y >> POOL_CELL_SHIFT; cy <= max_y >> POOL_CELL_SHIFT; cy++)
+	{
+		UINT16 *cell = cells + cy * POOL_CELLS_X;
+
+		for (INT32 cx = min_x >> POOL_CELL_SHIFT; cx <= max_x >> POOL_CELL_SHIFT; cx++)
+		{
+			if (cell[cx] == pool_run) hit = 1;
+			if (mark) cell[cx] = pool_run;
+		}
+	}
+
+	return hit;
+}
+
+static void pool_band_job(INT32 nBand, void *)
+{
+	INT32 nLines = pool_max_y - pool_min_y + 1;
+	INT32 min_y = pool_min_y + nLines * nBand / pool_bands;
+	INT32 max_y = pool_min_y + nLines * (nBand + 1) / pool_bands - 1;
+
+	UINT64 pixels = m_blit_pixels; // the job might run on the thread that started the pool
+	m_blit_pixels = 0;
+
+	for (INT32 i = 0; i < pool_op_count; i++)
+	{
+		pool_op *op = &pool_ops[i];
+
+		if (op->max_y < min_y || op->min_y > max_y) continue;
+
+		UINT32 addr = op->addr;
+
+		if (op->upload) {
+			gfx_upload(&addr, min_y, max_y);
+		} else {
+			rectangle clip = op->clip;
+			clip.min_y = MAX(clip.min_y, min_y);
+			clip.max_y = MIN(clip.max_y, max_y);
+
+			gfx_draw(&addr, &clip);
+		}
+	}
+
+	pool_band_pixels[nBand] = m_blit_pixels;
+	m_blit_pixels = pixels;
+}
+
+static void pool_flush()
+{
+	if (pool_op_count)
+	{
+		pool_bands = (pool_max_y - pool_min_y + 1) / POOL_BAND_MIN_LINES;
+		if (pool_bands > BurnPoolGetThreads()) pool_bands = BurnPoolGetThreads();
+		if (pool_bands > POOL_BAND_MAX) pool_bands = POOL_BAND_MAX;
+		if (pool_bands < 1) pool_bands = 1;
+
+		BurnPoolRun(pool_band_job, NULL, pool_bands);
+
+		for (INT32 i = 0; i < pool_bands; i++) {
+			m_blit_pixels += pool_band_pixels[i];
+		}
+
+		pool_op_count = 0;
+	}
+
+	if (++pool_run == 0) { // wrapped, forget the old runs
+		memset(pool_written, 0, POOL_CELLS_X * POOL_CELLS_Y * sizeof(UINT16));
+		memset(pool_read, 0, POOL_CELLS_X * POOL_CELLS_Y * sizeof(UINT16));
+		pool_run = 1;
+	}
+}
+
+static void pool_add_op(UINT32 addr, INT32 min_y, INT32 max_y, INT32 upload)
+{
+	if (pool_op_count == 0) {
+		pool_min_y = min_y;
+		pool_max_y = max_y;
+	} else {
+		pool_min_y = MIN(pool_min_y, min_y);
+		pool_max_y = MAX(pool_max_y, max_y);
+	}
+
+	pool_op *op = &pool_ops[pool_op_count++];
+	op->addr = addr;
+	op->clip = m_clip;
+	op->min_y = min_y;
+	op->max_y = max_y;
+	op->upload = upload;
+
+	if (pool_op_count == POOL_OPS_MAX) pool_flush();
+}
+
+static void pool_add_upload(UINT32 *addr)
+{
+	UINT32 op_addr = *addr;
+
+	*addr += 8; // 0x20000000 0x99999999
+
+	INT32 dst_x_start = READ_NEXT_WORD(addr) & 0x1fff;
+	INT32 dst_y_start = READ_NEXT_WORD(addr) & 0x0fff;
+	INT32 dimx = (READ_NEXT_WORD(addr) & 0x1fff) + 1;
+	INT32 dimy = (READ_NEXT_WORD(addr) & 0x0fff) + 1;
+
+	if (dst_x_start + dimx > 0x2000 || dst_y_start + dimy > 0x1000)
+	{
+		// runs off the end of a line (or of vram), don't split it up
+		pool_flush();
+		*addr = op_addr;
+		gfx_upload(addr, 0, 0x1fff);
+		return;
+	}
+
+	*addr += dimx * dimy * 2;
+
+	if (pool_cells(pool_read, dst_x_start, dst_x_start + dimx - 1, dst_y_start, dst_y_start + dimy - 1, 0))
+		pool_flush();
+
+	pool_cells(pool_written, dst_x_start, dst_x_start + dimx - 1, dst_y_start, dst_y_start + dimy - 1, 1);
+
+	pool_add_op(op_addr, dst_y_start, dst_y_start + dimy - 1, 1);
+}
+
+static void pool_add_draw(UINT32 addr)
+{
+	UINT32 a = addr + 4; // attr, alpha
+
+	INT32 src_x     = READ_NEXT_WORD(&a) & 0x1fff;
+	INT32 src_y     = READ_NEXT_WORD(&a) & 0x0fff;
+	UINT16 dst_x    = READ_NEXT_WORD(&a);
+	UINT16 dst_y    = READ_NEXT_WORD(&a);
+	INT32 dimx      = (READ_NEXT_WORD(&a) & 0x1fff) + 1;
+	INT32 dimy      = (READ_NEXT_WORD(&a) & 0x0fff) + 1;
+
+	INT32 x = (dst_x & 0x7fff) - (dst_x & 0x8000);
+	INT32 y = (dst_y & 0x7fff) - (dst_y & 0x8000);
+
+	INT32 min_x = MAX(x, m_clip.min_x);
+	INT32 max_x = MIN(x + dimx - 1, m_clip.max_x);
+	INT32 min_y = MAX(y, m_clip.min_y);
+	INT32 max_y = MIN(y + dimy - 1, m_clip.max_y);
+
+	if (min_x > max_x || min_y > max_y) return; // all clipped, draws nothing
+
+	// source lines wrap around the bottom of vram
+	INT32 src_max_x = src_x + dimx - 1;
+	INT32 src_max_y = src_y + dimy - 1;
+	INT32 src_wrap_y = src_max_y - 0x1000;
+
+	if (pool_cells(pool_written, src_x, src_max_x, src_y, src_max_y, 0) ||
+		(src_wrap_y >= 0 && pool_cells(pool_written, src_x, src_max_x, 0, src_wrap_y, 0)) ||
+		pool_cells(pool_read, min_x, max_x, min_y, max_y, 0))
+		pool_flush();
+
+	pool_cells(pool_written, min_x, max_x, min_y, max_y, 1);
+
+	if (pool_cells(pool_written, src_x, src_max_x, src_y, src_max_y, 0) ||
+		(src_wrap_y >= 0 && pool_cells(pool_written, src_x, src_max_x, 0, src_wrap_y, 0)))
+	{
+		// reads what it draws, the result depends on the order of the lines
+		pool_flush();
+		gfx_draw(&addr, &m_clip);
+		return;
+	}
+
+	pool_cells(pool_read, src_x, src_max_x, src_y, src_max_y, 1);
+	if (src_wrap_y >= 0) pool_cells(pool_read, src_x, src_max_x, 0, src_wrap_y, 1);
+
+	pool_add_op(addr, min_y, max_y, 0);
+}
+
 static void gfx_create_shadow_copy()
 {
 	UINT32 addr = m_gfx_addr & 0x1fffffff;
@@ -979,7 +1213,7 @@ static void gfx_create_shadow_copy()
 }
 
 
-static void gfx_exec()
+static void gfx_exec_list(INT32 pool)
 {
 	UINT32 addr = m_gfx_addr_shadowcopy & 0x1fffffff;
 	m_clip.set(m_gfx_clip_x_shadowcopy - EP1C_CLIP_MARGIN, m_gfx_clip_x_shadowcopy + 320 - 1 + EP1C_CLIP_MARGIN,
@@ -1007,12 +1241,20 @@ static void gfx_exec()
 
 			case 0x2000:
 				addr -= 2;
-				gfx_upload(&addr);
+				if (pool)
+					pool_add_upload(&addr);
+				else
+					gfx_upload(&addr, 0, 0x1fff);
 				break;
 
 			case 0x1000:
 				addr -= 2;
-				gfx_draw(&addr);
+				if (pool) {
+					pool_add_draw(addr);
+					addr += EP1C_DRAW_OPERATION_SIZE_BYTES;
+				} else {
+					gfx_draw(&addr, &m_clip);
+				}
 				break;
 
 			default:
@@ -1022,6 +1264,18 @@ static void gfx_exec()
 	}
 }
 
+static void gfx_exec()
+{
+	INT32 pool = m_pool_blitter && BurnPoolGetThreads() > 1;
+
+	m_blit_pixels = 0;
+
+	gfx_exec_list(pool);
+
+	if (pool) pool_flush();
+
+	epic12_device_blit_delay += m_blit_pixels;
+}
 
 void epic12_wait_blitterthread()
 {
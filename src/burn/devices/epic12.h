@@ -7,6 +7,7 @@ void epic12_scan(INT32 nAction, INT32 *pnMin);
 void epic12_set_blitterdelay_method(INT32 delay_method); // 0 = accurate, !0 = ancient
 void epic12_set_blitterdelay(INT32 delay, INT32 burn_cycles);
 void epic12_set_blitterthreading(INT32 value);
+void epic12_set_blitterpool(INT32 value); // draw each blit list in bands on the worker pool
 
 void epic12_set_blitter_clipping_margin(INT32 c_margin_on); // for testing
 void epic12_set_blitter_sleep_on_busy(INT32 busysleep_on); // for testing
@@ -9,6 +9,7 @@
 #include <math.h>
 #include "burnint.h"
 #include "poly.h"
+#include "thready.h"
 
 
 /***************************************************************************
@@ -33,6 +34,9 @@
 #define SCANLINES_PER_BUCKET            8
 #define CACHE_LINE_SIZE                 64          /* this is a general guess */
 #define TOTAL_BUCKETS                   (512 / SCANLINES_PER_BUCKET)
+#if TOTAL_BUCKETS > POLY_MAX_THREADS
+#error "the bucket number is passed to the scanline callbacks as threadid"
+#endif
 #define UNITS_PER_POLY                  (100 / SCANLINES_PER_BUCKET)
 
 
@@ -86,9 +90,9 @@ struct poly_section
 struct work_unit_shared
 {
 	polygon_info *      polygon;                /* pointer to polygon */
-	volatile UINT32     count_next;             /* number of scanlines and index of next item to process */
+	INT32               count_next;             /* number of scanlines */
 	INT16               scanline;               /* starting scanline and count */
-	UINT16              previtem;               /* index of previous item in the same bucket */
+	UINT16              dummy1;                 /* pad to 16 bytes */
 #ifndef PTR64
 	UINT32              dummy;                  /* pad to 16 bytes */
 #endif
@@ -167,8 +171,15 @@ struct poly_manager
 	/* misc data */
 	UINT8               flags;                  /* flags */
 
+	/* worker thread */
+	volatile UINT32     unit_queued;            /* units handed to the worker thread so far */
+	UINT32              unit_done;              /* units rendered so far */
+	volatile INT32      thread_done;            /* worker thread has run out of units */
+
 	/* buckets */
-	UINT16              unit_bucket[TOTAL_BUCKETS]; /* buckets for tracking unit usage */
+	UINT32 *            unit_order;             /* units of a batch, sorted by bucket */
+	UINT32              bucket_start[TOTAL_BUCKETS + 1]; /* first entry of each bucket in unit_order */
+	UINT8               bucket_list[TOTAL_BUCKETS]; /* buckets with work in this batch */
 
 	/* statistics */
 	UINT32              triangles;              /* number of triangles queued */
@@ -194,16 +205,20 @@ struct poly_manager
 
 static void **allocate_array(size_t *itemsize, UINT32 itemcount);
 static void free_array(void **array);
-static void *poly_item_callback(void *param, int threadid);
+static void poly_item_callback(work_unit *unit, int threadid);
+static void poly_run_units(poly_manager *poly, UINT32 startunit, UINT32 endunit);
+static void poly_thread_callback();
 //static void poly_state_presave(poly_manager *poly);
 
-static INT32 compare_exchange32(volatile INT32 *ptr, INT32 compare, INT32 exchange)
-{
-	INT32 prev = *ptr;
-	if (*ptr == compare)
-		*ptr = exchange;
-	return prev;
-}
+/* the manager the worker thread is rendering for, NULL if it's free */
+static poly_manager *poly_thread_owner = NULL;
+static INT32 poly_manager_count = 0;
+
+#if defined(_MSC_VER)
+#define poly_memory_barrier()   MemoryBarrier()
+#else
+#define poly_memory_barrier()   __sync_synchronize()
+#endif
 
 #define INLINE static inline
 
@@ -307,6 +322,37 @@ INLINE polygon_info *allocate_polygon(poly_manager *poly, int miny, int maxy)
 }
 
 
+/*-------------------------------------------------
+    queue_work_units - hand the units set up so
+    far to the worker thread, starting it if
+    it's free
+-------------------------------------------------*/
+
+INLINE void queue_work_units(poly_manager *poly)
+{
+	if (poly->flags & POLYFLAG_NO_WORK_QUEUE)
+		return;
+
+	/* units and polygon data must be in memory before the thread sees the new count */
+	poly_memory_barrier();
+	poly->unit_queued = poly->unit_next;
+
+	/* the thread is already on its way out, collect it so it can start again */
+	if (poly_thread_owner != NULL && poly_thread_owner->thread_done)
+	{
+		thready.notify_wait();
+		poly_thread_owner = NULL;
+	}
+
+	if (poly_thread_owner == NULL)
+	{
+		poly_thread_owner = poly;
+		poly->thread_done = 0;
+		thready.notify();
+	}
+}
+
+
 
 /***************************************************************************
     INITIALIZATION/TEARDOWN
@@ -344,11 +390,19 @@ poly_manager *poly_alloc(int max_polys, size_t extra_data_size, UINT8 flags)
 	poly->unit_count = MIN(poly->polygon_count * UNITS_PER_POLY, 65535);
 	poly->unit_next = 0;
 	poly->unit = (work_unit **)allocate_array(&poly->unit_size, poly->unit_count);
+	poly->unit_order = (UINT32*)BurnMalloc(sizeof(UINT32) * poly->unit_count);
 
 	/* create the work queue */
 //	if (!(flags & POLYFLAG_NO_WORK_QUEUE))
 //		poly->queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI | WORK_QUEUE_FLAG_HIGH_FREQ);
 
+	/* the first manager starts the worker thread, they all share it. the pool
+       is started first, so the worker's BurnPoolRun() never has to start it */
+	if (poly_manager_count++ == 0) {
+		BurnPoolGetThreads();
+		thready.init(poly_thread_callback);
+	}
+
 	/* request a pre-save callback for synchronization */
 	//machine.save().register_presave(save_prepost_delegate(FUNC(poly_state_presave), poly));
 	return poly;
@@ -363,6 +417,12 @@ void poly_free(poly_manager *poly)
 {
 	if (poly == NULL) return;
 
+	/* the worker thread may still be drawing for us */
+	poly_wait(poly, "poly_free");
+
+	if (--poly_manager_count == 0)
+		thready.exit();
+
 #if KEEP_STATISTICS
 {
 	int i, conflicts = 0, resolved = 0;
@@ -388,6 +448,7 @@ void poly_free(poly_manager *poly)
 	free_array(poly->extra);
 	free_array((void **)poly->polygon);
 	free_array((void **)poly->unit);
+	BurnFree(poly->unit_order);
 
 	/* free the manager itself */
 	BurnFree(poly);
@@ -413,18 +474,18 @@ void poly_wait(poly_manager *poly, const char *debug_reason)
 	//if (LOG_WAITS)
 	//	time = get_profile_ticks();
 
-	/* wait for all pending work items to complete */
-	//if (poly->queue != NULL)
-	//osd_work_queue_wait(poly->queue, osd_ticks_per_second() * 100);
-
-	/* if we don't have a queue, just run the whole list now */
-	//else
+	/* wait for the worker thread, only one manager draws at a time so the */
+	/* threadids passed to the scanline callbacks are never in use twice */
+	if (poly_thread_owner != NULL)
 	{
-		int unitnum;
-		for (unitnum = 0; unitnum < poly->unit_next; unitnum++)
-			poly_item_callback(poly->unit[unitnum], 0);
+		thready.notify_wait();
+		poly_thread_owner = NULL;
 	}
 
+	/* then run whatever it didn't get to (or everything, if it never had it) now */
+	if (poly->unit_done < poly->unit_next)
+		poly_run_units(poly, poly->unit_done, poly->unit_next);
+
 	/* log any long waits */
 	if (LOG_WAITS)
 	{
@@ -435,7 +496,7 @@ void poly_wait(poly_manager *poly, const char *debug_reason)
 
 	/* reset the state */
 	poly->polygon_next = poly->unit_next = 0;
-	memset(poly->unit_bucket, 0xff, sizeof(poly->unit_bucket));
+	poly->unit_queued = poly->unit_done = 0;
 
 	/* we need to preserve the last extra data that was supplied */
 	if (poly->extra_next > 1)
@@ -487,7 +548,6 @@ UINT32 poly_render_triangle(poly_manager *poly, void *dest, const rectangle &cli
 	INT32 v1yclip, v3yclip;
 	INT32 v1y, v3y, v1x;
 	INT32 pixels = 0;
-	UINT32 startunit;
 
 	/* first sort by Y */
 	if (v2->y < v1->y)
@@ -543,10 +603,8 @@ UINT32 poly_render_triangle(poly_manager *poly, void *dest, const rectangle &cli
 	dxdy_v2v3 = (v3->y == v2->y) ? 0.0f : (v3->x - v2->x) / (v3->y - v2->y);
 
 	/* compute the X extents for each scanline */
-	startunit = poly->unit_next;
 	for (curscan = v1yclip; curscan < v3yclip; curscan += scaninc)
 	{
-		UINT32 bucketnum = ((UINT32)curscan / SCANLINES_PER_BUCKET) % TOTAL_BUCKETS;
 		UINT32 unit_index = poly->unit_next++;
 		tri_work_unit *unit = &poly->unit[unit_index]->tri;
 		int extnum;
@@ -558,8 +616,6 @@ UINT32 poly_render_triangle(poly_manager *poly, void *dest, const rectangle &cli
 		unit->shared.polygon = polygon;
 		unit->shared.count_next = MIN(v3yclip - curscan, scaninc);
 		unit->shared.scanline = curscan;
-		unit->shared.previtem = poly->unit_bucket[bucketnum];
-		poly->unit_bucket[bucketnum] = unit_index;
 
 		/* iterate over extents */
 		for (extnum = 0; extnum < unit->shared.count_next; extnum++)
@@ -646,8 +702,7 @@ UINT32 poly_render_triangle(poly_manager *poly, void *dest, const rectangle &cli
 	}
 
 	/* enqueue the work items */
-	//if (poly->queue != NULL)
-	//osd_work_item_queue_multiple(poly->queue, poly_item_callback, poly->unit_next - startunit, poly->unit[startunit], poly->unit_size, WORK_ITEM_FLAG_AUTO_RELEASE);
+	queue_work_units(poly);
 
 	/* return the total number of pixels in the triangle */
 	poly->triangles++;
@@ -684,7 +739,6 @@ UINT32 poly_render_triangle_custom(poly_manager *poly, void *dest, const rectang
 	polygon_info *polygon;
 	INT32 v1yclip, v3yclip;
 	INT32 pixels = 0;
-	UINT32 startunit;
 
 	/* clip coordinates */
 	v1yclip = MAX(startscanline, cliprect.min_y);
@@ -704,10 +758,8 @@ UINT32 poly_render_triangle_custom(poly_manager *poly, void *dest, const rectang
 	polygon->numverts = 3;
 
 	/* compute the X extents for each scanline */
-	startunit = poly->unit_next;
 	for (curscan = v1yclip; curscan < v3yclip; curscan += scaninc)
 	{
-		UINT32 bucketnum = ((UINT32)curscan / SCANLINES_PER_BUCKET) % TOTAL_BUCKETS;
 		UINT32 unit_index = poly->unit_next++;
 		tri_work_unit *unit = &poly->unit[unit_index]->tri;
 		int extnum;
@@ -719,8 +771,6 @@ UINT32 poly_render_triangle_custom(poly_manager *poly, void *dest, const rectang
 		unit->shared.polygon = polygon;
 		unit->shared.count_next = MIN(v3yclip - curscan, scaninc);
 		unit->shared.scanline = curscan;
-		unit->shared.previtem = poly->unit_bucket[bucketnum];
-		poly->unit_bucket[bucketnum] = unit_index;
 
 		/* iterate over extents */
 		for (extnum = 0; extnum < unit->shared.count_next; extnum++)
@@ -754,8 +804,7 @@ UINT32 poly_render_triangle_custom(poly_manager *poly, void *dest, const rectang
 #endif
 
 	/* enqueue the work items */
-	//if (poly->queue != NULL)
-	//	osd_work_item_queue_multiple(poly->queue, poly_item_callback, poly->unit_next - startunit, poly->unit[startunit], poly->unit_size, WORK_ITEM_FLAG_AUTO_RELEASE);
+	queue_work_units(poly);
 
 	/* return the total number of pixels in the object */
 	poly->triangles++;
@@ -786,7 +835,6 @@ UINT32 poly_render_quad(poly_manager *poly, void *dest, const rectangle &cliprec
 	INT32 curscan, scaninc;
 	polygon_info *polygon;
 	INT32 pixels = 0;
-	UINT32 startunit;
 
 	//assert(poly->flags & POLYFLAG_ALLOW_QUADS);
 
@@ -895,10 +943,8 @@ UINT32 poly_render_quad(poly_manager *poly, void *dest, const rectangle &cliprec
 	}
 
 	/* compute the X extents for each scanline */
-	startunit = poly->unit_next;
 	for (curscan = minyclip; curscan < maxyclip; curscan += scaninc)
 	{
-		UINT32 bucketnum = ((UINT32)curscan / SCANLINES_PER_BUCKET) % TOTAL_BUCKETS;
 		UINT32 unit_index = poly->unit_next++;
 		quad_work_unit *unit = &poly->unit[unit_index]->quad;
 		int extnum;
@@ -910,8 +956,6 @@ UINT32 poly_render_quad(poly_manager *poly, void *dest, const rectangle &cliprec
 		unit->shared.polygon = polygon;
 		unit->shared.count_next = MIN(maxyclip - curscan, scaninc);
 		unit->shared.scanline = curscan;
-		unit->shared.previtem = poly->unit_bucket[bucketnum];
-		poly->unit_bucket[bucketnum] = unit_index;
 
 		/* iterate over extents */
 		for (extnum = 0; extnum < unit->shared.count_next; extnum++)
@@ -979,8 +1023,7 @@ UINT32 poly_render_quad(poly_manager *poly, void *dest, const rectangle &cliprec
 #endif
 
 	/* enqueue the work items */
-	//if (poly->queue != NULL)
-	//	osd_work_item_queue_multiple(poly->queue, poly_item_callback, poly->unit_next - startunit, poly->unit[startunit], poly->unit_size, WORK_ITEM_FLAG_AUTO_RELEASE);
+	queue_work_units(poly);
 
 	/* return the total number of pixels in the triangle */
 	poly->quads++;
@@ -1027,7 +1070,6 @@ UINT32 poly_render_polygon(poly_manager *poly, void *dest, const rectangle &clip
 	INT32 curscan, scaninc;
 	polygon_info *polygon;
 	INT32 pixels = 0;
-	UINT32 startunit;
 	int vertnum;
 
 	//assert(poly->flags & POLYFLAG_ALLOW_QUADS);
@@ -1127,10 +1169,8 @@ UINT32 poly_render_polygon(poly_manager *poly, void *dest, const rectangle &clip
 	}
 
 	/* compute the X extents for each scanline */
-	startunit = poly->unit_next;
 	for (curscan = minyclip; curscan < maxyclip; curscan += scaninc)
 	{
-		UINT32 bucketnum = ((UINT32)curscan / SCANLINES_PER_BUCKET) % TOTAL_BUCKETS;
 		UINT32 unit_index = poly->unit_next++;
 		quad_work_unit *unit = &poly->unit[unit_index]->quad;
 		int extnum;
@@ -1142,8 +1182,6 @@ UINT32 poly_render_polygon(poly_manager *poly, void *dest, const rectangle &clip
 		unit->shared.polygon = polygon;
 		unit->shared.count_next = MIN(maxyclip - curscan, scaninc);
 		unit->shared.scanline = curscan;
-		unit->shared.previtem = poly->unit_bucket[bucketnum];
-		poly->unit_bucket[bucketnum] = unit_index;
 
 		/* iterate over extents */
 		for (extnum = 0; extnum < unit->shared.count_next; extnum++)
@@ -1211,8 +1249,7 @@ UINT32 poly_render_polygon(poly_manager *poly, void *dest, const rectangle &clip
 #endif
 
 	/* enqueue the work items */
-	//if (poly->queue != NULL)
-	//	osd_work_item_queue_multiple(poly->queue, poly_item_callback, poly->unit_next - startunit, poly->unit[startunit], poly->unit_size, WORK_ITEM_FLAG_AUTO_RELEASE);
+	queue_work_units(poly);
 
 	/* return the total number of pixels in the triangle */
 	poly->quads++;
@@ -1270,7 +1307,7 @@ int poly_zclip_if_less(int numverts, const poly_vertex *v, poly_vertex *outv, in
 static void **allocate_array(size_t *itemsize, UINT32 itemcount)
 {
 	void **ptrarray;
-	int itemnum;
+	UINT32 itemnum;
 
 	/* fail if 0 */
 	if (itemcount == 0)
@@ -1312,69 +1349,106 @@ static void free_array(void **array)
     item
 -------------------------------------------------*/
 
-static void *poly_item_callback(void *param, int threadid)
+static void poly_item_callback(work_unit *unit, int threadid)
 {
-	while (1)
+	polygon_info *polygon = unit->shared.polygon;
+	int count = unit->shared.count_next;
+	int curscan;
+
+	/* iterate over extents */
+	for (curscan = 0; curscan < count; curscan++)
 	{
-		work_unit *unit = (work_unit *)param;
-		polygon_info *polygon = unit->shared.polygon;
-		int count = unit->shared.count_next & 0xffff;
-		UINT32 orig_count_next;
-		int curscan;
-
-		/* if our previous item isn't done yet, enqueue this item to the end and proceed */
-		if (unit->shared.previtem != 0xffff)
+		if (polygon->numverts == 3)
 		{
-			work_unit *prevunit = polygon->poly->unit[unit->shared.previtem];
-			if (prevunit->shared.count_next != 0)
-			{
-				UINT32 unitnum = ((UINT8 *)unit - (UINT8 *)polygon->poly->unit[0]) / polygon->poly->unit_size;
-				UINT32 new_count_next;
+			poly_extent tmpextent;
+			convert_tri_extent_to_poly_extent(&tmpextent, &unit->tri.extent[curscan], polygon, unit->shared.scanline + curscan);
+			(*polygon->callback)(polygon->dest, unit->shared.scanline + curscan, &tmpextent, polygon->extra, threadid);
+		}
+		else
+			(*polygon->callback)(polygon->dest, unit->shared.scanline + curscan, &unit->quad.extent[curscan], polygon->extra, threadid);
+	}
+}
 
-				/* attempt to atomically swap in this new value */
-				do
-				{
-					orig_count_next = prevunit->shared.count_next;
-					new_count_next = orig_count_next | (unitnum << 16);
-				} while (compare_exchange32((volatile INT32 *)&prevunit->shared.count_next, orig_count_next, new_count_next) != orig_count_next);
 
-#if KEEP_STATISTICS
-				/* track resolved conflicts */
-				polygon->poly->conflicts[threadid]++;
-				if (orig_count_next != 0)
-					polygon->poly->resolved[threadid]++;
-#endif
-				/* if we succeeded, skip out early so we can do other work */
-				if (orig_count_next != 0)
-					break;
-			}
-		}
+/*-------------------------------------------------
+    poly_bucket_job - render all units of one
+    bucket, in the order they were queued
+-------------------------------------------------*/
 
-		/* iterate over extents */
-		for (curscan = 0; curscan < count; curscan++)
-		{
-			if (polygon->numverts == 3)
-			{
-				poly_extent tmpextent;
-				convert_tri_extent_to_poly_extent(&tmpextent, &unit->tri.extent[curscan], polygon, unit->shared.scanline + curscan);
-				(*polygon->callback)(polygon->dest, unit->shared.scanline + curscan, &tmpextent, polygon->extra, threadid);
-			}
-			else
-				(*polygon->callback)(polygon->dest, unit->shared.scanline + curscan, &unit->quad.extent[curscan], polygon->extra, threadid);
-		}
+static void poly_bucket_job(INT32 nJob, void *pParam)
+{
+	poly_manager *poly = (poly_manager *)pParam;
+	int bucketnum = poly->bucket_list[nJob];
+	UINT32 ordernum;
 
-		/* set our count to 0 and re-fetch the original count value */
-		do
-		{
-			orig_count_next = unit->shared.count_next;
-		} while (compare_exchange32((volatile INT32 *)&unit->shared.count_next, orig_count_next, 0) != orig_count_next);
+	for (ordernum = poly->bucket_start[bucketnum]; ordernum < poly->bucket_start[bucketnum + 1]; ordernum++)
+		poly_item_callback(poly->unit[poly->unit_order[ordernum]], bucketnum);
+}
 
-		/* if we have no more work to do, do nothing */
-		orig_count_next >>= 16;
-		if (orig_count_next == 0)
-			break;
-		param = polygon->poly->unit[orig_count_next];
+
+/*-------------------------------------------------
+    poly_run_units - render a range of units,
+    each bucket (a band of scanlines) is a job
+    for the worker pool
+-------------------------------------------------*/
+
+static void poly_run_units(poly_manager *poly, UINT32 startunit, UINT32 endunit)
+{
+	UINT32 bucket_count[TOTAL_BUCKETS];
+	UINT32 unitnum, total = 0;
+	int bucketnum, buckets = 0;
+
+	/* sort the units by bucket, keeping the queue order within each bucket */
+	memset(bucket_count, 0, sizeof(bucket_count));
+	for (unitnum = startunit; unitnum < endunit; unitnum++)
+		bucket_count[((UINT32)poly->unit[unitnum]->shared.scanline / SCANLINES_PER_BUCKET) % TOTAL_BUCKETS]++;
+
+	for (bucketnum = 0; bucketnum < TOTAL_BUCKETS; bucketnum++)
+	{
+		poly->bucket_start[bucketnum] = total;
+		if (bucket_count[bucketnum] != 0)
+			poly->bucket_list[buckets++] = bucketnum;
+		total += bucket_count[bucketnum];
+		bucket_count[bucketnum] = poly->bucket_start[bucketnum];
 	}
-	return NULL;
+	poly->bucket_start[TOTAL_BUCKETS] = total;
+
+	for (unitnum = startunit; unitnum < endunit; unitnum++)
+		poly->unit_order[bucket_count[((UINT32)poly->unit[unitnum]->shared.scanline / SCANLINES_PER_BUCKET) % TOTAL_BUCKETS]++] = unitnum;
+
+	/* buckets never share a scanline, so they can be drawn in any order */
+	if (poly->flags & POLYFLAG_NO_WORK_QUEUE)
+	{
+		for (bucketnum = 0; bucketnum < buckets; bucketnum++)
+			poly_bucket_job(bucketnum, poly);
+	}
+	else
+		BurnPoolRun(poly_bucket_job, poly, buckets);
+
+	poly->unit_done = endunit;
 }
 
+
+/*-------------------------------------------------
+    poly_thread_callback - worker thread, renders
+    units as they are queued until it runs out
+-------------------------------------------------*/
+
+static void poly_thread_callback()
+{
+	poly_manager *poly = poly_thread_owner;
+
+	while (1)
+	{
+		UINT32 endunit = poly->unit_queued;
+
+		if (endunit == poly->unit_done)
+			break;
+
+		/* the units up to endunit are complete, see queue_work_units() */
+		poly_memory_barrier();
+		poly_run_units(poly, poly->unit_done, endunit);
+	}
+
+	poly->thread_done = 1;
+}
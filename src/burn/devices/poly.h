@@ -48,6 +48,8 @@
 #define POLYFLAG_NO_WORK_QUEUE              0x04
 #define POLYFLAG_ALLOW_QUADS                0x08
 
+#define POLY_MAX_THREADS                    64
+
 
 
 /***************************************************************************
@@ -89,6 +91,10 @@ struct poly_extent
 
 
 /* callback routine to process a batch of scanlines in a triangle */
+/* scanlines are drawn by the worker pool, possibly after poly_render_*() has returned: */
+/* the callback may only touch its own scanline of dest, and everything it reads must */
+/* stay put until poly_wait(). threadid is below POLY_MAX_THREADS and no two callbacks */
+/* run at the same time with the same threadid */
 typedef void (*poly_draw_scanline_func)(void *dest, INT32 scanline, const poly_extent *extent, const void *extradata, int threadid);
 
 
@@ -110,7 +116,7 @@ void poly_free(poly_manager *poly);
 
 /* ----- common functions ----- */
 
-/* wait until all polygons in the queue have been rendered */
+/* wait until all polygons in the queue have been rendered (the join point for the worker thread) */
 void poly_wait(poly_manager *poly, const char *debug_reason);
 
 /* get a pointer to the extra data for the next polygon */
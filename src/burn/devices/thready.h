@@ -333,9 +333,10 @@ struct threadystruct
 
 		our_callback = thread_callback;
 
-		INT32 our_thread_rv = pthread_create(&our_thread, NULL, ThreadyProc, NULL);
+		// the semaphores must be ready before the thread waits on them
 		INT32 our_event_rv = sem_init(&our_event, 0, 0);
 		INT32 wait_event_rv = sem_init(&wait_event, 0, 0);
+		INT32 our_thread_rv = pthread_create(&our_thread, NULL, ThreadyProc, NULL);
 
 		if (our_thread_rv == 0 && wait_event_rv == 0 && our_event_rv == 0) {
 			bprintf(0, _T("Thready: we're gonna git 'r dun!\n"));
@@ -433,8 +434,6 @@ struct threadystruct
 	pthread_t our_thread;
 	void (*our_callback)();
 	INT32 startup_frame;
-	char our_event_str[40];
-	char wait_event_str[40];
 
 	void init(void (*thread_callback)()) {
 		thready_ok = 0;
@@ -444,13 +443,21 @@ struct threadystruct
 
 		our_callback = thread_callback;
 
-		INT32 our_thread_rv = pthread_create(&our_thread, NULL, ThreadyProc, NULL);
-
-		sprintf(our_event_str, "/fbn_our_event%x", getpid());
-		sprintf(wait_event_str, "/fbn_wait_event%x", getpid());
+		// several threadys can run at once (ymz770 + epic12 + poly..), so the
+		// names are made unique per instance.  they're unlinked as soon as
+		// they're open, the semaphores live on until sem_close()
+		char our_event_str[32];
+		char wait_event_str[32];
+		sprintf(our_event_str, "/fbn_%x_%x_o", getpid(), (UINT32)(size_t)this);
+		sprintf(wait_event_str, "/fbn_%x_%x_w", getpid(), (UINT32)(size_t)this);
 
+		// the semaphores must be ready before the thread waits on them
 		INT32 our_event_rv = ((our_event = sem_open(our_event_str, O_CREAT, 0644, 1)) == SEM_FAILED) ? -1 : 0;
 		INT32 wait_event_rv = ((wait_event = sem_open(wait_event_str, O_CREAT, 0644, 1)) == SEM_FAILED) ? -1 : 0;
+		sem_unlink(our_event_str);
+		sem_unlink(wait_event_str);
+
+		INT32 our_thread_rv = pthread_create(&our_thread, NULL, ThreadyProc, NULL);
 
 		if (our_thread_rv == 0 && wait_event_rv == 0 && our_event_rv == 0) {
 			bprintf(0, _T("Thready: we're gonna git 'r dun!\n"));
@@ -472,9 +479,7 @@ struct threadystruct
 			pthread_join(our_thread, NULL);
 
 			sem_close(our_event);
-			sem_unlink(our_event_str);
 			sem_close(wait_event);
-			sem_unlink(wait_event_str);
 
 			thready_ok = 0;
 		}
@@ -122,6 +122,8 @@ static INT32 LoadUpSplit(UINT8** pRom, INT32* pnRomLen, INT32 nNum, INT32 nNumRo
 
 static INT32 CpsLoadOne(UINT8* Tile, INT32 nNum, INT32 nWord, INT32 nShift)
 {
+	BURN_PROFILE_PHASE(GFXDECODE);
+
 	UINT8 *Rom = NULL; INT32 nRomLen=0;
 	UINT8 *pt = NULL, *pr = NULL;
 	INT32 i;
@@ -1696,6 +1698,8 @@ inline static void Cps2Load100000(UINT8* Tile, UINT8* Sect, INT32 nShift)
 
 static INT32 Cps2LoadOne(UINT8* Tile, INT32 nNum, INT32 nWord, INT32 nShift)
 {
+	BURN_PROFILE_PHASE(GFXDECODE);
+
 	UINT8 *Rom = NULL; INT32 nRomLen = 0;
 	UINT8 *pt, *pr;
 
@@ -1816,6 +1820,8 @@ inline static void Cps2LoadBlockInterleaved(UINT8* Tile, UINT8* Sect, INT32 nShi
 
 INT32 Cps2LoadTilesInterleaved(UINT8 *Tile, UINT8 *pSrc, UINT32 nSize)
 {
+	BURN_PROFILE_PHASE(GFXDECODE);
+
 	UINT8 *pt;
 	UINT8 *pr;
 
@@ -1986,6 +1992,8 @@ INT32 Cps2LoadTilesGigaman2(UINT8 *Tile, UINT8 *pSrc)
 
 static UINT32 nGfxMaxSize;
 
+#define CPS2_GFX_CACHE_VERSION	1					// bump when the Cps2LoadTiles*() output changes
+
 static INT32 CpsGetROMs(bool bLoad)
 {
 	struct BurnRomInfo ri;
@@ -1999,10 +2007,17 @@ static INT32 CpsGetROMs(bool bLoad)
 
 	INT32 nGfxNum = 0;
 
+	UINT64 nGfxCacheKey = 0;
+	bool bGfxCached = false;
+
 	if (bLoad) {
 		if (!CpsCodeLoad || !CpsRomLoad || !CpsGfxLoad || !CpsZRomLoad || !CpsQSamLoad) {
 			return 1;
 		}
+
+		// the de-interleaved tiles come from the cache if we've seen this set before
+		nGfxCacheKey = BurnCacheRomKey(0, -1, CPS2_GFX_CACHE_VERSION | (Cps2Turbo ? 0x100 : 0));
+		bGfxCached = (BurnCacheLoadAsset("gfx", nGfxCacheKey, CpsGfx, nCpsGfxLen) == 0);
 	} else {
 		nCpsCodeLen = nCpsRomLen = nCpsGfxLen = nCpsZRomLen = nCpsQSamLen = 0;
 
@@ -2053,11 +2068,11 @@ static INT32 CpsGetROMs(bool bLoad)
 		if ((ri.nType & 0x0f) == CPS2_GFX) {
 			if (bLoad) {
 				if (Cps2Turbo) {
-					BurnLoadRom(CpsGfxLoad, i, 1);
+					if (!bGfxCached) BurnLoadRom(CpsGfxLoad, i, 1);
 
 					CpsGfxLoad += ri.nLen;
 				} else {
-					Cps2LoadTiles(CpsGfxLoad, i);
+					if (!bGfxCached) Cps2LoadTiles(CpsGfxLoad, i);
 
 					CpsGfxLoad += (nGfxMaxSize == ~0U ? ri.nLen : nGfxMaxSize) * 4;
 					nLoadedRoms = 4;
@@ -2076,7 +2091,7 @@ static INT32 CpsGetROMs(bool bLoad)
 		
 		if ((ri.nType & 0x0f) == CPS2_GFX_SIMM) {
 			if (bLoad) {
-				Cps2LoadTilesSIM(CpsGfxLoad, i);
+				if (!bGfxCached) Cps2LoadTilesSIM(CpsGfxLoad, i);
 				CpsGfxLoad += ri.nLen * 8;
 				nLoadedRoms = 8;
 			} else {
@@ -2086,7 +2101,7 @@ static INT32 CpsGetROMs(bool bLoad)
 		
 		if ((ri.nType & 0x0f) == CPS2_GFX_SPLIT4) {
 			if (bLoad) {
-				Cps2LoadTilesSplit4(CpsGfxLoad, i);
+				if (!bGfxCached) Cps2LoadTilesSplit4(CpsGfxLoad, i);
 				CpsGfxLoad += (nGfxMaxSize == ~0U ? ri.nLen : nGfxMaxSize) * 16;
 				nLoadedRoms = 16;
 			} else {
@@ -2103,7 +2118,7 @@ static INT32 CpsGetROMs(bool bLoad)
 		
 		if ((ri.nType & 0x0f) == CPS2_GFX_SPLIT8) {
 			if (bLoad) {
-				Cps2LoadTilesSplit8(CpsGfxLoad, i);
+				if (!bGfxCached) Cps2LoadTilesSplit8(CpsGfxLoad, i);
 				CpsGfxLoad += (nGfxMaxSize == ~0U ? ri.nLen : nGfxMaxSize) * 32;
 				nLoadedRoms = 32;
 			} else {
@@ -2120,7 +2135,7 @@ static INT32 CpsGetROMs(bool bLoad)
 		
 		if ((ri.nType & 0x0f) == CPS2_GFX_19XXJ) {
 			if (bLoad) {
-				Cps2LoadTiles19xxj(CpsGfxLoad, i);
+				if (!bGfxCached) Cps2LoadTiles19xxj(CpsGfxLoad, i);
 				CpsGfxLoad += (nGfxMaxSize == ~0U ? ri.nLen : nGfxMaxSize) * 20;
 				nLoadedRoms = 20;
 			} else {
@@ -2189,8 +2204,12 @@ static INT32 CpsGetROMs(bool bLoad)
 			((UINT32*)CpsCode)[i] ^= ((UINT32*)CpsRom)[i];
 		}
 #endif
-		if (Cps2Turbo) {
-			Cps2LoadTilesTurbo(CpsGfx, nCpsGfxLen);
+		if (!bGfxCached) {
+			if (Cps2Turbo) {
+				Cps2LoadTilesTurbo(CpsGfx, nCpsGfxLen);
+			}
+
+			BurnCacheSaveAsset("gfx", nGfxCacheKey, CpsGfx, nCpsGfxLen);
 		}
 
 		cps2_decrypt_game_data();
@@ -2224,6 +2243,25 @@ static INT32 CpsGetROMs(bool bLoad)
 
 // ----------------------------------------------------------------
 
+// The block allocated in CpsInit() moved, take the regions inside it along.
+// CpsCode can live outside of it (cps2_decrypt_game_data()).
+static void CpsMoveRegions(UINT8 *pOld, UINT8 *pNew)
+{
+	UINT8 *pEnd = CpsKey + nCpsKeyLen;
+
+#define CPS_MOVE(p, t) if ((UINT8*)(p) >= pOld && (UINT8*)(p) <= pEnd) p = (t)(pNew + ((UINT8*)(p) - pOld))
+	CPS_MOVE(CpsRom, UINT8*);
+	CPS_MOVE(CpsCode, UINT8*);
+	CPS_MOVE(CpsEncZRom, UINT8*);
+	CPS_MOVE(CpsZRom, UINT8*);
+	CPS_MOVE(CpsQSam, INT8*);
+	CPS_MOVE(CpsAd, UINT8*);
+	CPS_MOVE(CpsKey, UINT8*);
+#undef CPS_MOVE
+
+	CpsGfx = pNew;
+}
+
 INT32 CpsInit()
 {
 	INT32 nMemLen, i;
@@ -2330,6 +2368,13 @@ INT32 Cps2Init()
 		return 1;
 	}
 
+	// Everything is loaded and decrypted, share the block with other instances.
+	// The cps2 drivers only set flags and handlers after Cps2Init(), nothing writes to it
+	UINT8 *pShared = BurnShareMemory(CpsGfx, "rom", BurnCacheRomKey(0, -1, CPS2_GFX_CACHE_VERSION | (Cps2Turbo ? 0x100 : 0)));
+	if (pShared != CpsGfx) {
+		CpsMoveRegions(CpsGfx, pShared);
+	}
+
 	return CpsRunInit();
 }
 
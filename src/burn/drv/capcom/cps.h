@@ -304,7 +304,7 @@ extern CpsRWSoundCommandCallback CpsRWSoundCommandCallbackFunction;
 extern UINT8 CpsRecalcPal;				// Flag - If it is 1, recalc the whole palette
 extern INT32 nCpsLcReg;							// Address of layer controller register
 extern INT32 CpsLayEn[6];							// bits for layer enable
-extern INT32 nStartline, nEndline;				// specify the vertical slice of the screen to render
+extern BURN_THREAD_LOCAL INT32 nStartline, nEndline;	// specify the vertical slice of the screen to render
 extern INT32 nRasterline[MAX_RASTER + 2];			// The lines at which an interrupt occurs
 extern INT32 MaskAddr[4];
 extern INT32 CpsLayer1XOffs;
@@ -325,6 +325,7 @@ extern INT32 nCpsGlobalYOffset;
 void DrawFnInit();
 INT32  CpsDraw();
 INT32  CpsRedraw();
+void CpsDrawExit();
 
 #define BURN_SND_QSND_OUTPUT_1			0
 #define BURN_SND_QSND_OUTPUT_2			1
@@ -355,12 +356,14 @@ UINT8 QscRead();
 INT32 QscUpdate(INT32 nEnd);
 
 // cps_tile.cpp
-extern UINT32* CpstPal;
-extern UINT32 nCpstType; extern INT32 nCpstX,nCpstY;
-extern UINT32 nCpstTile; extern INT32 nCpstFlip;
-extern UINT32 nCpsBlend;
-extern short* CpstRowShift;
-extern UINT32 CpstPmsk; // Pixel mask
+// the tile drawing state is per thread, so layers can be drawn on the worker pool
+extern BURN_THREAD_LOCAL UINT32* CpstPal;
+extern BURN_THREAD_LOCAL UINT32 nCpstType; extern BURN_THREAD_LOCAL INT32 nCpstX,nCpstY;
+extern BURN_THREAD_LOCAL UINT32 nCpstTile; extern BURN_THREAD_LOCAL INT32 nCpstFlip;
+extern BURN_THREAD_LOCAL UINT32 nCpsBlend;
+extern BURN_THREAD_LOCAL short* CpstRowShift;
+extern BURN_THREAD_LOCAL UINT32 CpstPmsk; // Pixel mask
+extern BURN_THREAD_LOCAL UINT8* pCpstDraw; // Bitmap the tiles go to (usually pBurnDraw)
 
 inline static void CpstSetPal(INT32 nPal)
 {
@@ -370,14 +373,14 @@ inline static void CpstSetPal(INT32 nPal)
 }
 
 // ctv.cpp
-extern INT32 nBgHi;
+extern BURN_THREAD_LOCAL INT32 nBgHi;
 extern UINT16  ZValue;
 extern UINT16 *ZBuf;
 extern UINT16 *pZVal;
-extern UINT32    nCtvRollX,nCtvRollY;
-extern UINT8  *pCtvTile;					// Pointer to tile data
-extern INT32             nCtvTileAdd;					// Amount to add after each tile line
-extern UINT8  *pCtvLine;					// Pointer to output bitmap
+extern BURN_THREAD_LOCAL UINT32    nCtvRollX,nCtvRollY;
+extern BURN_THREAD_LOCAL UINT8  *pCtvTile;					// Pointer to tile data
+extern BURN_THREAD_LOCAL INT32             nCtvTileAdd;					// Amount to add after each tile line
+extern BURN_THREAD_LOCAL UINT8  *pCtvLine;					// Pointer to output bitmap
 typedef INT32 (*CtvDoFn)();
 typedef INT32 (*CpstOneDoFn)();
 extern CtvDoFn CtvDoX[0x20];
@@ -409,6 +412,7 @@ extern Cps1ObjDrawCallback Cps1ObjDrawCallbackFunction;
 
 INT32  CpsObjInit();
 INT32  CpsObjExit();
+INT32  CpsObjBlend();
 INT32  CpsObjGet();
 INT32 FcrashObjGet();
 INT32 KodbObjGet();
@@ -437,10 +441,10 @@ INT32 Cps2Scr1Draw(UINT8 *Base,INT32 sx,INT32 sy);
 INT32 Cps2Scr3Draw(UINT8 *Base,INT32 sx,INT32 sy);
 
 // cpsr.cpp
-extern UINT8 *CpsrBase;						// Tile data base
-extern INT32 nCpsrScrX,nCpsrScrY;						// Basic scroll info
-extern UINT16 *CpsrRows;					// Row scroll table, 0x400 words long
-extern INT32 nCpsrRowStart;							// Start of row scroll (can wrap?)
+extern BURN_THREAD_LOCAL UINT8 *CpsrBase;						// Tile data base
+extern BURN_THREAD_LOCAL INT32 nCpsrScrX,nCpsrScrY;						// Basic scroll info
+extern BURN_THREAD_LOCAL UINT16 *CpsrRows;					// Row scroll table, 0x400 words long
+extern BURN_THREAD_LOCAL INT32 nCpsrRowStart;							// Start of row scroll (can wrap?)
 
 // Information needed to draw a line
 struct CpsrLineInfo {
@@ -452,7 +456,7 @@ struct CpsrLineInfo {
 	INT16 Rows[16];									// 16 row scroll values for this line
 	INT32 nMaxLeft, nMaxRight;						// Maximum row shifts left and right
 };
-extern struct CpsrLineInfo CpsrLineInfo[32];
+extern BURN_THREAD_LOCAL struct CpsrLineInfo CpsrLineInfo[32];
 INT32 Cps1rPrepare();
 INT32 Cps2rPrepare();
 
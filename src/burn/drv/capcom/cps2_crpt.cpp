@@ -638,69 +638,40 @@ static void optimise_sboxes(struct optimised_sbox* out, const struct sbox* in)
 	}
 }
 
-static void cps2_decrypt(const UINT32 *master_key, UINT32 lower_limit, UINT32 upper_limit)
+struct cps2_decrypt_params
 {
-	UINT16 *rom = (UINT16 *)CpsRom;
-	UINT32 length = (upper_limit > 0) ? (upper_limit * 2) : nCpsRomLen;
-	if (length > nCpsRomLen) length = nCpsRomLen;
-	CpsCode = (UINT8*)BurnMalloc(length);
-	nCpsCodeLen = length;
-	UINT16 *dec = (UINT16*)CpsCode;
-
-	INT32 i;
+	const UINT32 *master_key;
 	UINT32 key1[4];
 	struct optimised_sbox sboxes1[4*4];
 	struct optimised_sbox sboxes2[4*4];
+	const UINT16 *rom;
+	UINT16 *dec;
+	UINT32 length;
+	UINT32 lower_limit;
+	UINT32 upper_limit;
+};
 
-	optimise_sboxes(&sboxes1[0*4], fn1_r1_boxes);
-	optimise_sboxes(&sboxes1[1*4], fn1_r2_boxes);
-	optimise_sboxes(&sboxes1[2*4], fn1_r3_boxes);
-	optimise_sboxes(&sboxes1[3*4], fn1_r4_boxes);
-	optimise_sboxes(&sboxes2[0*4], fn2_r1_boxes);
-	optimise_sboxes(&sboxes2[1*4], fn2_r2_boxes);
-	optimise_sboxes(&sboxes2[2*4], fn2_r3_boxes);
-	optimise_sboxes(&sboxes2[3*4], fn2_r4_boxes);
-
-
-	// expand master key to 1st FN 96-bit key
-	expand_1st_key(key1, master_key);
-
-	// add extra bits for s-boxes with less than 6 inputs
-	key1[0] ^= BIT(key1[0], 1) <<  4;
-	key1[0] ^= BIT(key1[0], 2) <<  5;
-	key1[0] ^= BIT(key1[0], 8) << 11;
-	key1[1] ^= BIT(key1[1], 0) <<  5;
-	key1[1] ^= BIT(key1[1], 8) << 11;
-	key1[2] ^= BIT(key1[2], 1) <<  5;
-	key1[2] ^= BIT(key1[2], 8) << 11;
+// every address with the same low 16 bits uses the same key, the runs of keys
+// are independent of each other
+static void cps2_decrypt_range(INT32 start, INT32 end, void *param)
+{
+	const struct cps2_decrypt_params *p = (const struct cps2_decrypt_params *)param;
+	const UINT32 *master_key = p->master_key;
+	const UINT16 *rom = p->rom;
+	UINT16 *dec = p->dec;
+	INT32 i;
 
-	for (i = 0; i < 0x10000; ++i)
+	for (i = start; i < end; ++i)
 	{
-		INT32 a;
+		UINT32 a;
 		UINT16 seed;
 		UINT32 subkey[2];
 		UINT32 key2[4];
 
-		if ((i & 0xff) == 0)
-		{
-#if 0
-			char loadingMessage[256]; // for displaying with UI
-			sprintf(loadingMessage, "Decrypting %d%%", i*100/0x10000);
-			ui_set_startup_text(loadingMessage,FALSE);
-#endif
-
-#if 1
-			TCHAR loadingMessage[256]; // for displaying with UI 
-			_stprintf(loadingMessage, _T("Decrypting 68000 ROMs with key %d %s"), (i*100/0x10000), _T("%")); 
-			BurnUpdateProgress(0.0, loadingMessage, 0); 
-#endif
-		}
-
-
 		// pass the address through FN1
 		seed = feistel(i, fn1_groupA, fn1_groupB,
-				&sboxes1[0*4], &sboxes1[1*4], &sboxes1[2*4], &sboxes1[3*4],
-				key1[0], key1[1], key1[2], key1[3]);
+				&p->sboxes1[0*4], &p->sboxes1[1*4], &p->sboxes1[2*4], &p->sboxes1[3*4],
+				p->key1[0], p->key1[1], p->key1[2], p->key1[3]);
 
 
 		// expand the result to 64-bit
@@ -723,19 +694,75 @@ static void cps2_decrypt(const UINT32 *master_key, UINT32 lower_limit, UINT32 up
 		key2[2] ^= BIT(key2[2], 7) << 11;
 		key2[3] ^= BIT(key2[3], 1) <<  5;
 
-		
+
 		// decrypt the opcodes
-		for (a = i; a < length/2; a += 0x10000)
+		for (a = i; a < p->length/2; a += 0x10000)
 		{
-			if (a >= lower_limit && a <= upper_limit) {
+			if (a >= p->lower_limit && a <= p->upper_limit) {
 				dec[a] = BURN_ENDIAN_SWAP_INT16(feistel(BURN_ENDIAN_SWAP_INT16(rom[a]), fn2_groupA, fn2_groupB,
-					&sboxes2[0 * 4], &sboxes2[1 * 4], &sboxes2[2 * 4], &sboxes2[3 * 4],
+					&p->sboxes2[0 * 4], &p->sboxes2[1 * 4], &p->sboxes2[2 * 4], &p->sboxes2[3 * 4],
 					key2[0], key2[1], key2[2], key2[3]));
 			} else {
 				dec[a] = rom[a];
 			}
 		}
 	}
+}
+
+static void cps2_decrypt(const UINT32 *master_key, UINT32 lower_limit, UINT32 upper_limit)
+{
+	BURN_PROFILE_PHASE(DECRYPT);
+
+	UINT16 *rom = (UINT16 *)CpsRom;
+	UINT32 length = (upper_limit > 0) ? (upper_limit * 2) : nCpsRomLen;
+	if (length > nCpsRomLen) length = nCpsRomLen;
+	CpsCode = (UINT8*)BurnMalloc(length);
+	nCpsCodeLen = length;
+	UINT16 *dec = (UINT16*)CpsCode;
+
+	INT32 i;
+	struct cps2_decrypt_params p;
+	UINT32 *key1 = p.key1;
+
+	p.master_key = master_key;
+	p.rom = rom;
+	p.dec = dec;
+	p.length = length;
+	p.lower_limit = lower_limit;
+	p.upper_limit = upper_limit;
+
+	optimise_sboxes(&p.sboxes1[0*4], fn1_r1_boxes);
+	optimise_sboxes(&p.sboxes1[1*4], fn1_r2_boxes);
+	optimise_sboxes(&p.sboxes1[2*4], fn1_r3_boxes);
+	optimise_sboxes(&p.sboxes1[3*4], fn1_r4_boxes);
+	optimise_sboxes(&p.sboxes2[0*4], fn2_r1_boxes);
+	optimise_sboxes(&p.sboxes2[1*4], fn2_r2_boxes);
+	optimise_sboxes(&p.sboxes2[2*4], fn2_r3_boxes);
+	optimise_sboxes(&p.sboxes2[3*4], fn2_r4_boxes);
+
+
+	// expand master key to 1st FN 96-bit key
+	expand_1st_key(key1, master_key);
+
+	// add extra bits for s-boxes with less than 6 inputs
+	key1[0] ^= BIT(key1[0], 1) <<  4;
+	key1[0] ^= BIT(key1[0], 2) <<  5;
+	key1[0] ^= BIT(key1[0], 8) << 11;
+	key1[1] ^= BIT(key1[1], 0) <<  5;
+	key1[1] ^= BIT(key1[1], 8) << 11;
+	key1[2] ^= BIT(key1[2], 1) <<  5;
+	key1[2] ^= BIT(key1[2], 8) << 11;
+
+	// the keys are shared out over the worker pool, a slice at a time so
+	// there's still some progress to show
+	for (i = 0; i < 0x10000; i += 0x1000)
+	{
+		TCHAR loadingMessage[256]; // for displaying with UI
+		_stprintf(loadingMessage, _T("Decrypting 68000 ROMs with key %d %s"), (i*100/0x10000), _T("%"));
+		BurnUpdateProgress(0.0, loadingMessage, 0);
+
+		BurnPoolFor(cps2_decrypt_range, &p, i, i + 0x1000, 0);
+	}
 #if 0
 	memory_set_decrypted_region(0, 0x000000, length - 1, dec);
 	m68k_set_encrypted_opcode_range(0,0,length);
@@ -4,7 +4,7 @@
 UINT8 CpsRecalcPal = 0;			// Flag - If it is 1, recalc the whole palette
 
 static INT32 LayerCont;
-INT32 nStartline, nEndline;
+BURN_THREAD_LOCAL INT32 nStartline, nEndline;
 INT32 nRasterline[MAX_RASTER + 2];
 
 INT32 nCpsLcReg = 0;						// Address of layer controller register
@@ -229,6 +229,277 @@ static INT32 DrawStar(INT32 nLayer)
 	return 0;
 }
 
+// Layers on the worker pool
+//
+// With a 16 or 32bpp bitmap and more than one thread, Cps1Layers() and
+// Cps2Layers() don't draw anything themselves. They make a list of what they
+// would have drawn (a scroll layer over some lines, or a range of sprite
+// levels), bottom to top. Every scroll layer in the list is then drawn to a
+// bitmap of its own by a pool job, while one job draws the sprites (they share
+// the Z buffer) to a bitmap per sprite level range, and finally each pixel gets
+// the topmost thing in the list that was drawn there. Pixels that nothing was
+// drawn to are left at a colour which isn't in the palette.
+// Blended sprites need what's under them, so they keep the old way.
+
+#define LAYER_OP_MAX		(MAX_RASTER * 3 + 8)
+#define LAYER_BITMAPS		(8 + 6)				// sprite level ranges, scroll 1-3, scroll 1-3 BgHi
+
+struct CpsLayerOp {
+	INT32 nLayer;								// 0 = sprites, 1-3 = scroll layer
+	INT32 nSlice;								// raster slice (CpsSaveReg[])
+	INT32 nBgHi;
+	INT32 nLevelFrom, nLevelTo;					// sprite levels
+	INT32 nStart, nEnd;							// lines
+	INT32 nBitmap;
+};
+
+static CpsLayerOp LayerOp[LAYER_OP_MAX];
+static INT32 nLayerOps = 0;
+static INT32 nSpriteOps = 0;
+static INT32 bLayerOpsRecord = 0;				// 0 = draw straight away
+static INT32 bLayerOpsSerial = 0;				// the list can't be drawn in parallel, so draw it in order
+
+static UINT8 *pLayerBitmap[LAYER_BITMAPS] = { NULL, };
+static INT32 nLayerBitmapSize = 0;
+static UINT32 nLayerBlank = 0;
+
+static void LayerOpDraw(CpsLayerOp *pOp, UINT8 *pDest);
+
+static void DrawLayerOp(INT32 nLayer, INT32 nSlice, INT32 nLevelFrom, INT32 nLevelTo)
+{
+	if (nLayerOps == LAYER_OP_MAX) {
+		// no room left (MAX_RASTER slices of 3 layers and 8 sprite ranges should always fit),
+		// draw what's in the list now and the rest of the frame in order after it
+		INT32 nSaveStart = nStartline, nSaveEnd = nEndline, nSaveBgHi = nBgHi;
+		UINT8 *pSaveDraw = pCpstDraw;
+
+		bLayerOpsRecord = 0;
+		for (INT32 i = 0; i < nLayerOps; i++) {
+			LayerOpDraw(&LayerOp[i], pBurnDraw);
+		}
+		bLayerOpsRecord = 1;
+
+		nStartline = nSaveStart; nEndline = nSaveEnd; nBgHi = nSaveBgHi;
+		pCpstDraw = pSaveDraw;
+
+		nLayerOps = 0;
+		bLayerOpsSerial = 1;
+	}
+
+	CpsLayerOp *pOp = &LayerOp[nLayerOps];
+
+	pOp->nLayer = nLayer;
+	pOp->nSlice = nSlice;
+	pOp->nBgHi = nBgHi;
+	pOp->nLevelFrom = nLevelFrom;
+	pOp->nLevelTo = nLevelTo;
+	pOp->nStart = (nLayer == 0 || nStartline < 0) ? 0 : nStartline;
+	pOp->nEnd = (nLayer == 0 || nEndline > nCpsScreenHeight) ? nCpsScreenHeight : nEndline;
+
+	if (nLayer == 0) {
+		pOp->nBitmap = nSpriteOps++;
+	} else {
+		pOp->nBitmap = 8 + (nLayer - 1) + (nBgHi ? 3 : 0);
+	}
+
+	// the same layer in two raster slices shares a bitmap, which is only safe if the lines don't overlap
+	for (INT32 i = 0; i < nLayerOps; i++) {
+		if (LayerOp[i].nBitmap == pOp->nBitmap && LayerOp[i].nStart < pOp->nEnd && pOp->nStart < LayerOp[i].nEnd) {
+			bLayerOpsSerial = 1;
+		}
+	}
+
+	nLayerOps++;
+}
+
+static void DrawLayer(INT32 nLayer, INT32 nSlice)
+{
+	if (bLayerOpsRecord) {
+		DrawLayerOp(nLayer, nSlice, 0, 0);
+		return;
+	}
+
+	switch (nLayer) {
+		case 1:
+			DrawScroll1(nSlice);
+			break;
+		case 2:
+			DrawScroll2Init(nSlice);
+			DrawScroll2Do();
+			DrawScroll2Exit();
+			break;
+		case 3:
+			DrawScroll3(nSlice);
+			break;
+	}
+}
+
+static void DrawSprites(INT32 nLevelFrom, INT32 nLevelTo)
+{
+	if (bLayerOpsRecord) {
+		DrawLayerOp(0, 0, nLevelFrom, nLevelTo);
+		return;
+	}
+
+	CpsObjDrawDoX(nLevelFrom, nLevelTo);
+}
+
+// pDest = NULL: draw to the op's own bitmap
+static void LayerOpDraw(CpsLayerOp *pOp, UINT8 *pDest)
+{
+	if (pDest == NULL) {
+		pDest = pLayerBitmap[pOp->nBitmap];
+
+		for (INT32 y = pOp->nStart; y < pOp->nEnd; y++) {
+			if (nBurnBpp == 4) {
+				UINT32 *pClear = (UINT32*)(pDest + y * nBurnPitch);
+				for (INT32 x = 0; x < nCpsScreenWidth; x++) {
+					pClear[x] = nLayerBlank;
+				}
+			} else {
+				UINT16 *pClear = (UINT16*)(pDest + y * nBurnPitch);
+				for (INT32 x = 0; x < nCpsScreenWidth; x++) {
+					pClear[x] = (UINT16)nLayerBlank;
+				}
+			}
+		}
+	}
+
+	pCpstDraw = pDest;
+	nStartline = pOp->nStart;
+	nEndline = pOp->nEnd;
+
+	if (pOp->nLayer == 0) {
+		CpsObjDrawDoX(pOp->nLevelFrom, pOp->nLevelTo);
+	} else {
+		nBgHi = pOp->nBgHi;
+		DrawLayer(pOp->nLayer, pOp->nSlice);
+		nBgHi = 0;
+	}
+}
+
+static void LayerOpJob(INT32 nJob, void *)
+{
+	if (nJob == 0) {
+		// all the sprites, in order
+		for (INT32 i = 0; i < nLayerOps; i++) {
+			if (LayerOp[i].nLayer == 0) {
+				LayerOpDraw(&LayerOp[i], NULL);
+			}
+		}
+		return;
+	}
+
+	if (LayerOp[nJob - 1].nLayer != 0) {
+		LayerOpDraw(&LayerOp[nJob - 1], NULL);
+	}
+}
+
+static void LayerMixRange(INT32 nStart, INT32 nEnd, void *)
+{
+	for (INT32 y = nStart; y < nEnd; y++) {
+		UINT8 *pSrc[LAYER_OP_MAX];
+		INT32 nSrc = 0;
+
+		// topmost first
+		for (INT32 i = nLayerOps - 1; i >= 0; i--) {
+			if (y >= LayerOp[i].nStart && y < LayerOp[i].nEnd) {
+				pSrc[nSrc++] = pLayerBitmap[LayerOp[i].nBitmap] + y * nBurnPitch;
+			}
+		}
+
+		if (nSrc == 0) continue;
+
+		if (nBurnBpp == 4) {
+			UINT32 *pDest = (UINT32*)(pBurnDraw + y * nBurnPitch);
+
+			for (INT32 x = 0; x < nCpsScreenWidth; x++) {
+				for (INT32 i = 0; i < nSrc; i++) {
+					UINT32 c = ((UINT32*)pSrc[i])[x];
+					if (c != nLayerBlank) {
+						pDest[x] = c;
+						break;
+					}
+				}
+			}
+		} else {
+			UINT16 *pDest = (UINT16*)(pBurnDraw + y * nBurnPitch);
+
+			for (INT32 x = 0; x < nCpsScreenWidth; x++) {
+				for (INT32 i = 0; i < nSrc; i++) {
+					UINT16 c = ((UINT16*)pSrc[i])[x];
+					if (c != (UINT16)nLayerBlank) {
+						pDest[x] = c;
+						break;
+					}
+				}
+			}
+		}
+	}
+}
+
+static INT32 LayerOpsInit()
+{
+	if (nBurnBpp != 2 && nBurnBpp != 4) return 1;
+	if (nBurnBpp == 4 && CpsObjBlend()) return 1;
+	if (BurnPoolGetThreads() < 2) return 1;
+
+	INT32 nSize = nBurnPitch * nCpsScreenHeight;
+	if (nSize != nLayerBitmapSize) {
+		CpsDrawExit();
+		nLayerBitmapSize = nSize;
+	}
+
+	// a colour the tiles can't draw (they only use the first 0x800 palette entries)
+	UINT32 nMask = (nBurnBpp == 4) ? 0xFFFFFFFF : 0xFFFF;
+	nLayerBlank = (nBurnBpp == 4) ? 0xFF000000 : 0xF81F;
+
+	for (INT32 i = 0; i < 0x800; i++) {
+		if ((CpsPal[i] & nMask) == nLayerBlank) {
+			nLayerBlank = (nLayerBlank + 1) & nMask;
+			i = -1;
+		}
+	}
+
+	nLayerOps = 0;
+	nSpriteOps = 0;
+	bLayerOpsSerial = 0;
+	bLayerOpsRecord = 1;
+
+	return 0;
+}
+
+static void LayerOpsDraw()
+{
+	bLayerOpsRecord = 0;
+
+	if (bLayerOpsSerial) {
+		for (INT32 i = 0; i < nLayerOps; i++) {
+			LayerOpDraw(&LayerOp[i], pBurnDraw);
+		}
+	} else {
+		for (INT32 i = 0; i < nLayerOps; i++) {
+			if (pLayerBitmap[LayerOp[i].nBitmap] == NULL) {
+				pLayerBitmap[LayerOp[i].nBitmap] = (UINT8*)BurnMalloc(nLayerBitmapSize);
+			}
+		}
+
+		BurnPoolRun(LayerOpJob, NULL, nLayerOps + 1);
+		BurnPoolFor(LayerMixRange, NULL, 0, nCpsScreenHeight, 0);
+	}
+
+	pCpstDraw = pBurnDraw;
+}
+
+void CpsDrawExit()
+{
+	for (INT32 i = 0; i < LAYER_BITMAPS; i++) {
+		BurnFree(pLayerBitmap[i]);
+	}
+
+	nLayerBitmapSize = 0;
+}
+
 static void Cps1Layers()
 {
   INT32 Draw[4]={-1,-1,-1,-1};
@@ -272,8 +543,8 @@ static void Cps1Layers()
 	  }
   }
 
-  // prepare layer 2
-  DrawScroll2Init(0);
+  nStartline = 0;
+  nEndline = nCpsScreenHeight;
 
   // draw layers, bottom -> top
   for (i=3;i>=0;i--)
@@ -281,19 +552,19 @@ static void Cps1Layers()
     INT32 n=Draw[i]; // Find out which layer to draw
 
     if (n==0) {
-	  if (nDrawMask & 1)  CpsObjDrawDoX(0,7);
+	  if (nDrawMask & 1)  DrawSprites(0,7);
 
 	  if (!Cps1DisableBgHi && i+1 < 4) {
 		nBgHi=1;
 		switch (Draw[i+1]) {
 			case 1:
-				if (nDrawMask & 2) 	DrawScroll1(0);
+				if (nDrawMask & 2) 	DrawLayer(1, 0);
 				break;
 			case 2:
-				if (nDrawMask & 4)  DrawScroll2Do();
+				if (nDrawMask & 4)  DrawLayer(2, 0);
 				break;
 			case 3:
-				if (nDrawMask & 8)  DrawScroll3(0);
+				if (nDrawMask & 8)  DrawLayer(3, 0);
 				break;
 		}
 		nBgHi=0;
@@ -303,18 +574,16 @@ static void Cps1Layers()
     // Then Draw the scroll layer on top
     switch (n) {
 		case 1:
-			if (nDrawMask & 2) DrawScroll1(0);
+			if (nDrawMask & 2) DrawLayer(1, 0);
 			break;
 		case 2:
-			if (nDrawMask & 4) DrawScroll2Do();
+			if (nDrawMask & 4) DrawLayer(2, 0);
 			break;
 		case 3:
-			if (nDrawMask & 8) DrawScroll3(0);
+			if (nDrawMask & 8) DrawLayer(3, 0);
 			break;
 	}
   }
-
-  DrawScroll2Exit();
 }
 
 static void Cps2Layers()
@@ -395,7 +664,7 @@ static void Cps2Layers()
 
 					// Render sprites between the previous layer and this one
 					if ((nDrawMask[0] & 1) && (nPrevPrio < nCurrPrio)) {
-						CpsObjDrawDoX(nPrevPrio + 1, nCurrPrio);
+						DrawSprites(nPrevPrio + 1, nCurrPrio);
 						nPrevPrio = nCurrPrio;
 					}
 
@@ -409,19 +678,17 @@ static void Cps2Layers()
 					switch (Draw[nSlice][i]) {
 						case 1:
 							if (nDrawMask[nSlice] & 2) {
-								DrawScroll1(nSlice);
+								DrawLayer(1, nSlice);
 							}
 							break;
 						case 2:
 							if (nDrawMask[nSlice] & 4) {
-								DrawScroll2Init(nSlice);
-								DrawScroll2Do();
-								DrawScroll2Exit();
+								DrawLayer(2, nSlice);
 							}
 							break;
 						case 3:
 							if (nDrawMask[nSlice] & 8) {
-								DrawScroll3(nSlice);
+								DrawLayer(3, nSlice);
 							}
 							break;
 					}
@@ -433,7 +700,7 @@ static void Cps2Layers()
 
 	// Render highest priority sprites
 	if ((nDrawMask[0] & 1) && (nPrevPrio < 7)) {
-		CpsObjDrawDoX(nPrevPrio + 1, 7);
+		DrawSprites(nPrevPrio + 1, 7);
 	}
 }
 
@@ -504,7 +771,14 @@ static void DoDraw(INT32 Recalc)
 
 	CpsClearScreen();
 
-	CpsLayersDoX();
+	pCpstDraw = pBurnDraw;
+
+	if (LayerOpsInit() == 0) {
+		CpsLayersDoX();
+		LayerOpsDraw();
+	} else {
+		CpsLayersDoX();
+	}
 }
 
 INT32 CpsDraw()
@@ -162,6 +162,12 @@ INT32 CpsObjExit()
 	return 0;
 }
 
+// Non-zero if some sprites are blended with what's under them (.bld table)
+INT32 CpsObjBlend()
+{
+	return (blendtable != NULL);
+}
+
 // Get CPS sprites into Obj
 INT32 CpsObjGet()
 {
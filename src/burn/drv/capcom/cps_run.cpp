@@ -207,6 +207,7 @@ INT32 CpsRunExit()
 	// Graphics exit
 	CpsObjExit();
 	CpsPalExit();
+	CpsDrawExit();
 
 	// Sprite Masking exit
 	ZBuf = NULL;
@@ -2,14 +2,14 @@
 
 // CPS Scroll2 with Row scroll support
 
-UINT8 *CpsrBase=NULL; // Tile data base
-INT32 nCpsrScrX=0,nCpsrScrY=0; // Basic scroll info
-UINT16 *CpsrRows=NULL; // Row scroll table, 0x400 words long
-int nCpsrRowStart=0; // Start of row scroll (can wrap?)
-static INT32 nShiftY=0;
-static INT32 EndLineInfo=0;
-
-struct CpsrLineInfo CpsrLineInfo[32]; // supports up to 512-y lines
+BURN_THREAD_LOCAL UINT8 *CpsrBase=NULL; // Tile data base
+BURN_THREAD_LOCAL INT32 nCpsrScrX=0,nCpsrScrY=0; // Basic scroll info
+BURN_THREAD_LOCAL UINT16 *CpsrRows=NULL; // Row scroll table, 0x400 words long
+BURN_THREAD_LOCAL int nCpsrRowStart=0; // Start of row scroll (can wrap?)
+static BURN_THREAD_LOCAL INT32 nShiftY=0;
+static BURN_THREAD_LOCAL INT32 EndLineInfo=0;
+
+BURN_THREAD_LOCAL struct CpsrLineInfo CpsrLineInfo[32]; // supports up to 512-y lines
 
 static void GetRowsRange(INT32 *pnStart,INT32 *pnWidth,INT32 nRowFrom,INT32 nRowTo)
 {
@@ -1,12 +1,12 @@
 #include "cps.h"
 
 // CPS Scroll2 with Row scroll - Draw
-static INT32 nKnowBlank=-1;	// The tile we know is blank
-static INT32 nFirstY, nLastY;
-static INT32 bVCare;
+static BURN_THREAD_LOCAL INT32 nKnowBlank=-1;	// The tile we know is blank
+static BURN_THREAD_LOCAL INT32 nFirstY, nLastY;
+static BURN_THREAD_LOCAL INT32 bVCare;
 
-static INT32 nXTiles = 0;
-static INT32 nYTiles = 0;
+static BURN_THREAD_LOCAL INT32 nXTiles = 0;
+static BURN_THREAD_LOCAL INT32 nYTiles = 0;
 
 inline static UINT16 *FindTile(INT32 fx,INT32 fy)
 {
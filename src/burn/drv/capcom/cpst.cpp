@@ -1,18 +1,19 @@
 #include "cps.h"
 
 // CPS Tiles
-UINT32 *CpstPal=NULL;
+BURN_THREAD_LOCAL UINT32 *CpstPal=NULL;
 
 // Arguments for the tile draw function
-UINT32 nCpstType = 0;
-INT32 nCpstX = 0, nCpstY = 0;
-UINT32 nCpstTile = 0;
-UINT32 nCpsBlend = 0;
-INT32 nCpstFlip = 0;
-INT16 *CpstRowShift = NULL;
-UINT32 CpstPmsk = 0;		// Pixel mask
-
-INT32 nBgHi = 0;
+BURN_THREAD_LOCAL UINT32 nCpstType = 0;
+BURN_THREAD_LOCAL INT32 nCpstX = 0, nCpstY = 0;
+BURN_THREAD_LOCAL UINT32 nCpstTile = 0;
+BURN_THREAD_LOCAL UINT32 nCpsBlend = 0;
+BURN_THREAD_LOCAL INT32 nCpstFlip = 0;
+BURN_THREAD_LOCAL INT16 *CpstRowShift = NULL;
+BURN_THREAD_LOCAL UINT32 CpstPmsk = 0;		// Pixel mask
+BURN_THREAD_LOCAL UINT8 *pCpstDraw = NULL;	// Bitmap to draw on
+
+BURN_THREAD_LOCAL INT32 nBgHi = 0;
 UINT16  ZValue = 1;
 UINT16* ZBuf = NULL;
 UINT16* pZVal = NULL;
@@ -48,7 +49,7 @@ static INT32 CpstOne()
   pCtvTile=CpsGfx+nCpstTile;
 
   // Find pLine (pointer to first pixel)
-  pCtvLine=pBurnDraw + nCpstY*nBurnPitch + nCpstX*nBurnBpp;
+  pCtvLine=pCpstDraw + nCpstY*nBurnPitch + nCpstX*nBurnBpp;
 
   if (nSize==32) nCtvTileAdd=16; else nCtvTileAdd=8;
 
@@ -90,7 +91,7 @@ static INT32 CpstOneBgHi()
   pCtvTile=CpsGfx+nCpstTile;
 
   // Find pLine (pointer to first pixel)
-  pCtvLine=pBurnDraw + nCpstY*nBurnPitch + nCpstX*nBurnBpp;
+  pCtvLine=pCpstDraw + nCpstY*nBurnPitch + nCpstX*nBurnBpp;
 
   if (nSize==32) nCtvTileAdd=16; else nCtvTileAdd=8;
 
@@ -134,7 +135,7 @@ static INT32 Cps2tOne()
   pCtvTile=CpsGfx+nCpstTile;
 
   // Find pLine (pointer to first pixel)
-  pCtvLine=pBurnDraw + nCpstY*nBurnPitch + nCpstX*nBurnBpp;
+  pCtvLine=pCpstDraw + nCpstY*nBurnPitch + nCpstX*nBurnBpp;
 
   if (nSize==32) nCtvTileAdd=16; else nCtvTileAdd=8;
 
@@ -177,7 +178,7 @@ static INT32 CpstOneObjZ()
   pCtvTile=CpsGfx+nCpstTile;
 
   // Find pLine (pointer to first pixel)
-  pCtvLine=pBurnDraw + nCpstY*nBurnPitch + nCpstX*nBurnBpp;
+  pCtvLine=pCpstDraw + nCpstY*nBurnPitch + nCpstX*nBurnBpp;
   pZVal=ZBuf + nCpstY*nCpsScreenWidth + nCpstX;
 
   if (nSize==32) nCtvTileAdd=16; else nCtvTileAdd=8;
@@ -2,13 +2,13 @@
 
 // CPS Tile Variants
 // horizontal/vertical clip rolls
-UINT32 nCtvRollX=0,nCtvRollY=0;
+BURN_THREAD_LOCAL UINT32 nCtvRollX=0,nCtvRollY=0;
 // Add 0x7fff after each pixel/line
 // If nRollX/Y&0x20004000 both == 0, you can draw the pixel
 
-UINT8 *pCtvTile=NULL; // Pointer to tile data
-INT32 nCtvTileAdd=0; // Amount to add after each tile line
-UINT8 *pCtvLine=NULL; // Pointer to output bitmap
+BURN_THREAD_LOCAL UINT8 *pCtvTile=NULL; // Pointer to tile data
+BURN_THREAD_LOCAL INT32 nCtvTileAdd=0; // Amount to add after each tile line
+BURN_THREAD_LOCAL UINT8 *pCtvLine=NULL; // Pointer to output bitmap
 
 static inline UINT32 alpha_blend(UINT32 d, UINT32 s, UINT32 p)
 {
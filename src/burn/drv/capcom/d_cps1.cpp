@@ -15,6 +15,8 @@
 #define CPS1_EXTRA_TILES_SF2B_400000		11
 #define CPS1_EXTRA_TILES_SF2MKOT_400000		12
 
+#define CPS1_GFX_CACHE_VERSION				1	// bump when the CpsLoadTiles*() output changes
+
 typedef INT32 (*Cps1Callback)(INT32);
 static Cps1Callback Cps1GfxLoadCallbackFunction = NULL;
 
@@ -17124,7 +17126,14 @@ static INT32 Cps1LoadRoms(INT32 bLoad)
 		}
 
 		// Graphics
-		if (nCpsGfxLen) {
+		// the tiles come from the cache if we've seen this set before, sets which
+		// load some of them in their init ("Handle this seperately") aren't cached
+		UINT64 nGfxCacheKey = 0;
+		if (nCpsTilesRomNum >= 4 || Cps1GfxLoadCallbackFunction) {
+			nGfxCacheKey = BurnCacheRomKey(nCps68KByteswapRomNum + nCps68KNoByteswapRomNum, nCpsTilesRomNum, CPS1_GFX_CACHE_VERSION);
+		}
+
+		if (nCpsGfxLen && BurnCacheLoadAsset("gfx", nGfxCacheKey, CpsGfx, nCpsGfxLen)) {
 			Offset = 0;
 			i = nCps68KByteswapRomNum + nCps68KNoByteswapRomNum;
 			while (i < nCps68KByteswapRomNum + nCps68KNoByteswapRomNum + nCpsTilesRomNum) {
@@ -17176,7 +17185,9 @@ static INT32 Cps1LoadRoms(INT32 bLoad)
 						}
 					}
 				}
-			}			
+			}
+
+			BurnCacheSaveAsset("gfx", nGfxCacheKey, CpsGfx, nCpsGfxLen);
 		}
 
 		// Z80 Program
@@ -134,24 +134,59 @@ static INT32 bytedecode(INT32 src,INT32 swap_key1,INT32 swap_key2,INT32 xor_key,
 	return src;
 }
 
-void kabuki_decode(UINT8 *src,UINT8 *dest_op,UINT8 *dest_data,
-		INT32 base_addr,INT32 length,INT32 swap_key1,INT32 swap_key2,INT32 addr_key,INT32 xor_key)
+struct kabuki_params
+{
+	UINT8 *src;
+	UINT8 *dest_op;
+	UINT8 *dest_data;
+	INT32 base_addr;
+	INT32 swap_key1;
+	INT32 swap_key2;
+	INT32 addr_key;
+	INT32 xor_key;
+};
+
+// each byte only depends on its own address, so runs of them can be decoded on
+// any thread. dest_data may be src: it's written after both reads of src[A]
+static void kabuki_decode_range(INT32 start, INT32 end, void *param)
 {
+	kabuki_params *p = (kabuki_params *)param;
 	INT32 A;
 	INT32 select;
 
-	for (A = 0;A < length;A++)
+	for (A = start;A < end;A++)
 	{
+		INT32 data = p->src[A];
+
 		/* decode opcodes */
-		select = (A + base_addr) + addr_key;
-		dest_op[A] = (UINT8)bytedecode(src[A],swap_key1,swap_key2,xor_key,select);
+		select = (A + p->base_addr) + p->addr_key;
+		p->dest_op[A] = (UINT8)bytedecode(data,p->swap_key1,p->swap_key2,p->xor_key,select);
 
 		/* decode data */
-		select = ((A + base_addr) ^ 0x1fc0) + addr_key + 1;
-		dest_data[A] = (UINT8)bytedecode(src[A],swap_key1,swap_key2,xor_key,select);
+		select = ((A + p->base_addr) ^ 0x1fc0) + p->addr_key + 1;
+		p->dest_data[A] = (UINT8)bytedecode(data,p->swap_key1,p->swap_key2,p->xor_key,select);
 	}
 }
 
+void kabuki_decode(UINT8 *src,UINT8 *dest_op,UINT8 *dest_data,
+		INT32 base_addr,INT32 length,INT32 swap_key1,INT32 swap_key2,INT32 addr_key,INT32 xor_key)
+{
+	BURN_PROFILE_PHASE(DECRYPT);
+
+	kabuki_params p;
+
+	p.src = src;
+	p.dest_op = dest_op;
+	p.dest_data = dest_data;
+	p.base_addr = base_addr;
+	p.swap_key1 = swap_key1;
+	p.swap_key2 = swap_key2;
+	p.addr_key = addr_key;
+	p.xor_key = xor_key;
+
+	BurnPoolFor(kabuki_decode_range, &p, 0, length, 0x1000);
+}
+
 static void cps1_decode(INT32 swap_key1,INT32 swap_key2,INT32 addr_key,INT32 xor_key)
 {
 	UINT8 *rom = CpsZRom;
@@ -13,6 +13,8 @@ static INT32 qsndTimerOver(INT32, INT32)
 
 INT32 QsndInit()
 {
+	BURN_PROFILE_PHASE(SOUNDINIT);
+
 	INT32 nRate;
 
 	// Init QSound z80
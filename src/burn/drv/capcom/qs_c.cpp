@@ -14,6 +14,7 @@
 #include <stddef.h>
 #include <string.h>	// for memset
 #include "cps.h"
+#include "pcm_mix.h"
 
 static const INT32 nQscClock = 60000000;
 static const INT32 nQscClockDivider = 2496;
@@ -106,11 +107,14 @@ struct qsound_chip {
 
 static UINT16 *register_map[256];
 static INT16 pan_tables[2][2][98];
+static INT16 pan_gains[2][2][16+3];	// pan_tables looked up for each voice's current pan
+static INT32 pan_gains_dirty;
 
 static INT16 interpolate_buffer[2][4];
 
 static void init_pan_tables();
 static void init_register_map();
+static void update_pan_gains();
 static void update_sample();
 
 static void state_init();
@@ -250,6 +254,26 @@ static void init_pan_tables()
 	}
 }
 
+// voice_pan only changes on register writes (or a reset/state load), so the
+// per-voice table lookups are done here instead of for every sample
+static void update_pan_gains()
+{
+	for(int v=0; v<19; v++)
+	{
+		UINT16 pan_index = chip.voice_pan[v]-0x110;
+		if(pan_index > 97)
+			pan_index = 97;
+
+		for(int ch=0; ch<2; ch++)
+		{
+			pan_gains[ch][PANTBL_DRY][v] = pan_tables[ch][PANTBL_DRY][pan_index];
+			pan_gains[ch][PANTBL_WET][v] = pan_tables[ch][PANTBL_WET][pan_index];
+		}
+	}
+
+	pan_gains_dirty = 0;
+}
+
 static void init_register_map()
 {
 	int i;
@@ -437,6 +461,7 @@ static void state_init()
 	chip.delay_update = 1;
 	chip.ready_flag = 0;
 	chip.state_counter = 1;
+	pan_gains_dirty = 1;
 }
 
 // Updates filter parameters for mode 1
@@ -612,6 +637,9 @@ static void state_normal_update()
 
 	echo_output = echo(&chip.echo,echo_input);
 
+	if(pan_gains_dirty)
+		update_pan_gains();
+
 	// now, we do the magic stuff
 	for(ch=0; ch<2; ch++)
 	{
@@ -621,16 +649,9 @@ static void state_normal_update()
 		INT32 dry = (ch == 0) ? echo_output<<14 : 0;
 		INT32 output = 0;
 
-		for(v=0; v<19; v++)
-		{
-			UINT16 pan_index = chip.voice_pan[v]-0x110;
-			if(pan_index > 97)
-				pan_index = 97;
-
-			// Apply different volume tables on the dry and wet inputs.
-			dry -= (chip.voice_output[v] * pan_tables[ch][PANTBL_DRY][pan_index]);
-			wet -= (chip.voice_output[v] * pan_tables[ch][PANTBL_WET][pan_index]);
-		}
+		// Apply different volume tables on the dry and wet inputs.
+		dry -= PcmMixDot(chip.voice_output, pan_gains[ch][PANTBL_DRY], 19);
+		wet -= PcmMixDot(chip.voice_output, pan_gains[ch][PANTBL_WET], 19);
 
 		// Saturate accumulated voices
 		dry = CLAMP(dry, -0x1fffffff, 0x1fffffff) << 2;
@@ -734,6 +755,7 @@ void QscReset()
 	chip.state_counter = 0;
 	nDelta = 0;
 	memset(interpolate_buffer, 0, sizeof(interpolate_buffer));
+	pan_gains_dirty = 1;
 }
 
 void QscExit()
@@ -778,6 +800,10 @@ INT32 QscScan(INT32 nAction)
 	ba.szName	= szName;
 	BurnAcb(&ba);
 
+	if (nAction & ACB_WRITE) {
+		pan_gains_dirty = 1;
+	}
+
 	return 0;
 }
 
@@ -797,6 +823,8 @@ void QscWrite(INT32 a, INT32 d)
 	QscSyncQsnd();
 	if(destination)
 		*destination = d;
+	if(destination >= chip.voice_pan && destination < chip.voice_pan + 19)
+		pan_gains_dirty = 1;
 	chip.ready_flag = 0;
 }
 
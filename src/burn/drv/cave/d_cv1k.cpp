@@ -93,6 +93,14 @@ static struct BurnDIPInfo DefaultDIPList[]=
 	{0x01, 0x01, 0x04, 0x00, "Before Exec"		},
 	{0x01, 0x01, 0x04, 0x04, "Before Draw"		},
 
+	{0   , 0xfe, 0   ,    2, "Thread Sound"		},
+	{0x01, 0x01, 0x08, 0x00, "Off"				},
+	{0x01, 0x01, 0x08, 0x08, "On"				},
+
+	{0   , 0xfe, 0   ,    2, "Pool Blitter"		},
+	{0x01, 0x01, 0x10, 0x00, "Off"				},
+	{0x01, 0x01, 0x10, 0x10, "On"				},
+
 	{0   , 0xfe, 0   ,    2, "Blitter Timing"	},
 	{0x02, 0x01, 0x20, 0x00, "Accurate (Buffis)"},
 	{0x02, 0x01, 0x20, 0x20, "Antiquity"		},
@@ -576,6 +584,8 @@ static INT32 DrvFrame()
 		epic12_set_blitterdelay_method(DrvDips[2] & 0x20);
 		epic12_set_blitterdelay((delay) ? ((delay - 1) + 50) : 0, speedhack_burn);
 		epic12_set_blitterthreading(DrvDips[1] & 1);
+		epic12_set_blitterpool(DrvDips[1] & 0x10);
+		ymz770_set_threading(DrvDips[1] & 8);
 		Sh3SetTimerGranularity(DrvDips[1] & 2);
 
 		// test stuff for el_rika
@@ -1645,7 +1645,8 @@ enum
 	CPS3_TRANSPARENCY_PEN_INDEX_BLEND
 };
 
-static void cps3_drawgfxzoom_2(UINT32 code, UINT32 pal, INT32 flipx, INT32 flipy, INT32 sx, INT32 sy, INT32 scalex, INT32 scaley, INT32 alpha, INT32 transparency)
+// only lines miny to maxy are drawn
+static void cps3_drawgfxzoom_2(UINT32 code, UINT32 pal, INT32 flipx, INT32 flipy, INT32 sx, INT32 sy, INT32 scalex, INT32 scaley, INT32 alpha, INT32 transparency, INT32 miny, INT32 maxy)
 {
 	if (!scalex || !scaley) return;
 
@@ -1683,9 +1684,9 @@ static void cps3_drawgfxzoom_2(UINT32 code, UINT32 pal, INT32 flipx, INT32 flipy
 				sx += pixels;
 				x_index_base += pixels*dx;
 			}
-			if( sy < 0 )
+			if( sy < miny )
 			{ /* clip top */
-				INT32 pixels = 0-sy;
+				INT32 pixels = miny-sy;
 				sy += pixels;
 				y_index += pixels*dy;
 			}
@@ -1694,9 +1695,9 @@ static void cps3_drawgfxzoom_2(UINT32 code, UINT32 pal, INT32 flipx, INT32 flipy
 				INT32 pixels = ex-cps3_gfx_max_x-1;
 				ex -= pixels;
 			}
-			if( ey > cps3_gfx_max_y+1 )
+			if( ey > maxy+1 )
 			{ /* clip bottom */
-				INT32 pixels = ey-cps3_gfx_max_y-1;
+				INT32 pixels = ey-maxy-1;
 				ey -= pixels;
 			}
 		}
@@ -1799,61 +1800,24 @@ static void cps3_draw_tilemapsprite_line(INT32 drawline, UINT32 * regs )
 	}
 }
 
-static INT32 WideScreenFrameDelay = 0;
-
-INT32 DrvCps3Draw()
+// Draws the sprites and tilemap lines that fall on lines nStart to nEnd - 1 of
+// RamScreen. Each pixel is only ever drawn over by the list entries in order, so
+// splitting the screen into bands and drawing them at the same time gives the
+// same picture as drawing it in one go.
+static void cps3_draw_sprites(INT32 nStart, INT32 nEnd)
 {
-	UINT32 fullscreenzoom = RamVReg[ 6 * 4 + 3 ] & 0xff;
-	UINT32 fullscreenzoomwidecheck = RamVReg[6 * 4 + 1];
-	
-	if (((fullscreenzoomwidecheck & 0xffff0000) >> 16) == 0x0265 || strcmp(BurnDrvGetTextA(DRV_NAME), "sfiii3ws") == 0) {
-		INT32 Width, Height;
-		BurnDrvGetVisibleSize(&Width, &Height);
-		
-		if (Width != 496) {
-			BurnDrvSetVisibleSize(496, 224);
-			BurnDrvSetAspect(16, 9);
-			Reinitialise();
-			WideScreenFrameDelay = GetCurrentFrame() + 1;
-		}
-	} else {
-		INT32 Width, Height;
-		BurnDrvGetVisibleSize(&Width, &Height);
-		
-		if (Width != 384) {
-			BurnDrvSetVisibleSize(384, 224);
-			BurnDrvSetAspect(4, 3);
-			Reinitialise();
-			WideScreenFrameDelay = GetCurrentFrame() + 1;
-		}
-	}
-	
-	if (fullscreenzoom > 0x80) fullscreenzoom = 0x80;
-	UINT32 fsz = (fullscreenzoom << (16 - 6));
-	
-	cps3_gfx_max_x = ((cps3_gfx_width * fsz)  >> 16) - 1;	// 384 ( 496 for SFIII2 Only)
-	cps3_gfx_max_y = ((cps3_gfx_height * fsz) >> 16) - 1;	// 224
+	INT32 nMaxY = (nEnd - 1 < cps3_gfx_max_y) ? (nEnd - 1) : cps3_gfx_max_y;
 
 	if (nBurnLayer & 1)
 	{
-		UINT32 * pscr = RamScreen;
+		UINT32 * pscr = RamScreen + nStart * 512*2;
 		INT32 clrsz = (cps3_gfx_max_x + 1) * sizeof(INT32);
-		for(INT32 yy = 0; yy<=cps3_gfx_max_y; yy++, pscr += 512*2)
+		for(INT32 yy = nStart; yy<=nMaxY; yy++, pscr += 512*2)
 			memset(pscr, 0, clrsz);
 	}
-	else
-	{
-		Cps3CurPal[0x20000] = BurnHighCol(0xff, 0x00, 0xff, 0);
-
-		INT32 i;
-		for (i = 0; i < 1024 * 448; i++) {
-			RamScreen[i] = 0x20000;
-		}
-	}
 
 	UINT32 *SprSrc = (cps3_fake_dip & 1 ? RamSpr : SprList);
 
-	// Draw Sprites
 	{
 		for (INT32 i=0x00000/4;i<0x2000/4;i+=4) {
 
@@ -1922,7 +1886,7 @@ INT32 DrvCps3Draw()
 							cury_pos -= 18;
 							cury_pos &= 0x3ff;
 
-							if (cury_pos >= 0 && cury_pos <= cps3_gfx_max_y+1)
+							if (cury_pos >= nStart && cury_pos < nEnd)
 								cps3_draw_tilemapsprite_line(cury_pos, regs);
 						}
 					}
@@ -1994,7 +1958,7 @@ INT32 DrvCps3Draw()
 								if (current_ypos&0x200) current_ypos-=0x400;
 
 								{
-									cps3_drawgfxzoom_2(tileno+count,actualpal,flipx,flipy,current_xpos,current_ypos,xscale,yscale, color_granularity, trans);
+									cps3_drawgfxzoom_2(tileno+count,actualpal,flipx,flipy,current_xpos,current_ypos,xscale,yscale, color_granularity, trans, nStart, nMaxY);
 									count++;
 								}
 							}
@@ -2004,22 +1968,94 @@ INT32 DrvCps3Draw()
 			}
 		}
 	}
+}
+
+// Bands are at least this tall, the last line a tilemap line can land on is
+// cps3_gfx_max_y + 1. A tile hanging off the left edge spills into the end of the
+// line above, past anything that is shown, so it doesn't matter which band gets
+// there first.
+#define CPS3_BAND_MAX			8
+#define CPS3_BAND_MIN_LINES		16
+
+static void cps3_draw_band(INT32 nBand, void *pParam)
+{
+	INT32 nBands = *((INT32*)pParam);
+	INT32 nLines = cps3_gfx_max_y + 2;
+
+	cps3_draw_sprites(nLines * nBand / nBands, nLines * (nBand + 1) / nBands);
+}
+
+static void cps3_render_range(INT32 nStart, INT32 nEnd, void *pParam)
+{
+	UINT32 fsz = *((UINT32*)pParam);
+	UINT16 * dstbitmap = (UINT16 * )pBurnDraw + nStart * cps3_gfx_width;
+
+	for (INT32 rendery=nStart; rendery<nEnd; rendery++) {
+		UINT32 * srcbitmap = RamScreen + ((rendery * fsz) >> 16) * 1024;
+		UINT32 srcx=0;
+		for (INT32 renderx=0; renderx<cps3_gfx_width; renderx++, dstbitmap ++) {
+			*dstbitmap = Cps3CurPal[ srcbitmap[srcx>>16] ];
+			srcx += fsz;
+		}
+	}
+}
+
+static INT32 WideScreenFrameDelay = 0;
+
+INT32 DrvCps3Draw()
+{
+	UINT32 fullscreenzoom = RamVReg[ 6 * 4 + 3 ] & 0xff;
+	UINT32 fullscreenzoomwidecheck = RamVReg[6 * 4 + 1];
 	
+	if (((fullscreenzoomwidecheck & 0xffff0000) >> 16) == 0x0265 || strcmp(BurnDrvGetTextA(DRV_NAME), "sfiii3ws") == 0) {
+		INT32 Width, Height;
+		BurnDrvGetVisibleSize(&Width, &Height);
+		
+		if (Width != 496) {
+			BurnDrvSetVisibleSize(496, 224);
+			BurnDrvSetAspect(16, 9);
+			Reinitialise();
+			WideScreenFrameDelay = GetCurrentFrame() + 1;
+		}
+	} else {
+		INT32 Width, Height;
+		BurnDrvGetVisibleSize(&Width, &Height);
+		
+		if (Width != 384) {
+			BurnDrvSetVisibleSize(384, 224);
+			BurnDrvSetAspect(4, 3);
+			Reinitialise();
+			WideScreenFrameDelay = GetCurrentFrame() + 1;
+		}
+	}
+	
+	if (fullscreenzoom > 0x80) fullscreenzoom = 0x80;
+	UINT32 fsz = (fullscreenzoom << (16 - 6));
+	
+	cps3_gfx_max_x = ((cps3_gfx_width * fsz)  >> 16) - 1;	// 384 ( 496 for SFIII2 Only)
+	cps3_gfx_max_y = ((cps3_gfx_height * fsz) >> 16) - 1;	// 224
+
+	if (~nBurnLayer & 1)
 	{
-		UINT32 srcx, srcy = 0;
-		UINT32 * srcbitmap;
-		UINT16 * dstbitmap = (UINT16 * )pBurnDraw;
-
-		for (INT32 rendery=0; rendery<224; rendery++) {
-			srcbitmap = RamScreen + (srcy >> 16) * 1024;
-			srcx=0;
-			for (INT32 renderx=0; renderx<cps3_gfx_width; renderx++, dstbitmap ++) {
-				*dstbitmap = Cps3CurPal[ srcbitmap[srcx>>16] ];
-				srcx += fsz;
-			}
-			srcy += fsz;
+		Cps3CurPal[0x20000] = BurnHighCol(0xff, 0x00, 0xff, 0);
+
+		INT32 i;
+		for (i = 0; i < 1024 * 448; i++) {
+			RamScreen[i] = 0x20000;
 		}
 	}
+
+	INT32 nBands = (cps3_gfx_max_y + 2) / CPS3_BAND_MIN_LINES;
+	if (nBands > BurnPoolGetThreads()) nBands = BurnPoolGetThreads();
+	if (nBands > CPS3_BAND_MAX) nBands = CPS3_BAND_MAX;
+
+	if (nBands <= 1) {
+		cps3_draw_sprites(0, cps3_gfx_max_y + 2);
+	} else {
+		BurnPoolRun(cps3_draw_band, &nBands, nBands);
+	}
+
+	BurnPoolFor(cps3_render_range, &fsz, 0, 224, 16);
 	
 	if (nBurnLayer & 2)
 	{
@@ -3,6 +3,7 @@
 
 #include "tiles_generic.h"
 #include "konamiic.h"
+#include "burn_roz.h"
 
 static UINT16 *K051316TileMap[3];
 static void (*K051316Callback[3])(INT32 *code,INT32 *color,INT32 *flags);
@@ -186,115 +187,24 @@ void K051316WrapEnable(INT32 chip, INT32 status)
 
 static inline void copy_roz(INT32 chip, UINT32 startx, UINT32 starty, INT32 incxx, INT32 incxy, INT32 incyx, INT32 incyy, INT32 wrap, INT32 transp, INT32 flags)
 {
-	UINT32 hshift = 512 << 16;
-	UINT32 wshift = 512 << 16;
-
 	if (flags & 0x200) transp = 0; // force opaque
 
 	INT32 priority = flags & 0xff;
 
-	if (flags & 0x100)	// indexed colors
-	{
-		UINT16 *dst = pTransDraw;
-		UINT16 *src = K051316TileMap[chip];
+	BurnRozSource roz;
+	BurnRozSetSource(&roz, K051316TileMap[chip], 512, 512, 512, 16, wrap);
 
-		for (INT32 sy = 0; sy < nScreenHeight; sy++, startx+=incyx, starty+=incyy)
+	UINT32 tmask = transp ? 0x8000 : 0;
+
+	for (INT32 sy = 0; sy < nScreenHeight; sy++, startx+=incyx, starty+=incyy)
+	{
+		if (flags & 0x100)	// indexed colors
 		{
-			UINT32 cx = startx;
-			UINT32 cy = starty;
-	
-			if (wrap) {
-				if (transp) {
-					for (INT32 x = 0; x < nScreenWidth; x++, cx+=incxx, cy+=incxy, dst++)
-					{
-						INT32 pxl = src[(((cy >> 16) & 0x1ff) << 9) | ((cx >> 16) & 0x1ff)];
-				
-						if (!(pxl & 0x8000)) {
-							*dst = pxl;
-						}
-					}
-				} else {
-					for (INT32 x = 0; x < nScreenWidth; x++, cx+=incxx, cy+=incxy, dst++) {
-						*dst = src[(((cy >> 16) & 0x1ff) << 9) | ((cx >> 16) & 0x1ff)] & 0x7fff;
-					}
-				}
-			} else {
-				if (transp) {
-					for (INT32 x = 0; x < nScreenWidth; x++, cx+=incxx, cy+=incxy, dst++)
-					{
-						if (cx < wshift && cy < hshift) {
-							INT32 pxl = src[(((cy >> 16) & 0x1ff) << 9) | ((cx >> 16) & 0x1ff)];
-							if (!(pxl & 0x8000)) {
-								*dst = pxl;
-							}
-						}
-					}
-				} else {
-					for (INT32 x = 0; x < nScreenWidth; x++, cx+=incxx, cy+=incxy, dst++)
-					{
-						UINT32 pos = ((cy >> 16) << 9) | (cx >> 16);
-	
-						if (pos >= 0x40000) continue;
-	
-						*dst = src[pos] & 0x7fff;
-					}
-				}
-			}
+			BurnRozDrawSpan16(pTransDraw + sy * nScreenWidth, NULL, &roz, startx, starty, incxx, incxy, nScreenWidth, tmask, 0x8000, 0x7fff, 0);
 		}
-	}
-	else	// 32-bit colors
-	{
-		UINT32 *dst = konami_bitmap32;
-		UINT8 *pri = konami_priority_bitmap;
-		UINT16 *src = K051316TileMap[chip];
-		UINT32 *pal = konami_palette32;
-
-		for (INT32 sy = 0; sy < nScreenHeight; sy++, startx+=incyx, starty+=incyy)
+		else	// 32-bit colors
 		{
-			UINT32 cx = startx;
-			UINT32 cy = starty;
-	
-			if (wrap) {
-				if (transp) {
-					for (INT32 x = 0; x < nScreenWidth; x++, cx+=incxx, cy+=incxy, dst++, pri++)
-					{
-						INT32 pxl = src[(((cy >> 16) & 0x1ff) << 9) | ((cx >> 16) & 0x1ff)];
-				
-						if (!(pxl & 0x8000)) {
-							*dst = pal[pxl];
-							*pri = priority;
-						}
-					}
-				} else {
-					for (INT32 x = 0; x < nScreenWidth; x++, cx+=incxx, cy+=incxy, dst++, pri++) {
-						*dst = pal[src[(((cy >> 16) & 0x1ff) << 9) | ((cx >> 16) & 0x1ff)] & 0x7fff];
-						*pri = priority;
-					}
-				}
-			} else {
-				if (transp) {
-					for (INT32 x = 0; x < nScreenWidth; x++, cx+=incxx, cy+=incxy, dst++, pri++)
-					{
-						if (cx < wshift && cy < hshift) {
-							INT32 pxl = src[(((cy >> 16) & 0x1ff) << 9) | ((cx >> 16) & 0x1ff)];
-							if (!(pxl & 0x8000)) {
-								*dst = pal[pxl];
-								*pri = priority;
-							}
-						}
-					}
-				} else {
-					for (INT32 x = 0; x < nScreenWidth; x++, cx+=incxx, cy+=incxy, dst++, pri++)
-					{
-						UINT32 pos = ((cy >> 16) << 9) | (cx >> 16);
-	
-						if (pos >= 0x40000) continue;
-	
-						*dst = pal[src[pos] & 0x7fff];
-						*pri = priority;
-					}
-				}
-			}
+			BurnRozDrawSpan32(konami_bitmap32 + sy * nScreenWidth, konami_priority_bitmap + sy * nScreenWidth, konami_palette32, &roz, startx, starty, incxx, incxy, nScreenWidth, tmask, 0x8000, 0x7fff, priority);
 		}
 	}
 }
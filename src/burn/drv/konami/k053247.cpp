@@ -5,6 +5,7 @@
 
 #include "tiles_generic.h"
 #include "konamiic.h"
+#include "burn_simd.h"
 
 #define K053247_CUSTOMSHADOW	0x20000000
 #define K053247_SHDSHIFT		20
@@ -27,6 +28,10 @@ static INT32 nBpp = 4;
 
 static INT32 K053247Flags;
 
+// rows zdrawgfxzoom32GP() may draw to on this thread, see K053247GXSetBand()
+static BURN_THREAD_LOCAL INT32 gx_band_miny = 0;
+static BURN_THREAD_LOCAL INT32 gx_band_maxy = 0x7fff;
+
 void (*K053247Callback)(INT32 *code, INT32 *color, INT32 *priority);
 
 void K053247Reset()
@@ -596,6 +601,110 @@ static inline UINT32 highlight_blend(UINT32 d)
 #define GX_ZBUFW     512
 #define GX_ZBUFH     256
 
+void K053247GXSetBand(INT32 nStart, INT32 nEnd)
+{
+	gx_band_miny = nStart;
+	gx_band_maxy = nEnd - 1;
+}
+
+#if defined BURN_SIMD_SSE2
+// zdrawgfxzoom32GP() for z-buffered objects: the pens of a row are fetched 16 at a time,
+// z-tested (or shadow z-tested) and the z-buffers updated in one go, then only the
+// pixels that passed are coloured, the same way the scalar loops do it
+static void zdrawgfxspans32GP(const UINT8 *src_base, INT32 src_fbx, INT32 src_fdx, INT32 src_fby, INT32 src_fdy, INT32 fp,
+		UINT32 *dst_ptr, INT32 dst_pitch, UINT8 *ozbuf_ptr, UINT8 *szbuf_ptr, INT32 dst_w, INT32 dst_h,
+		const UINT32 *pal_base, INT32 drawmode, INT32 shdpen, UINT8 z8, UINT8 p8, INT32 alpha, INT32 highlight_enable, INT32 shadow_bank)
+{
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i sign = _mm_set1_epi8((char)0x80);
+	const __m128i lomask = _mm_set1_epi16(0x00ff);
+	const __m128i z = _mm_set1_epi8((char)z8);
+	const __m128i p = _mm_set1_epi8((char)p8);
+	const __m128i psigned = _mm_set1_epi8((char)(p8 ^ 0x80));
+	const __m128i solidmax = _mm_set1_epi8((char)(shdpen - 1));	// drawmode 1, 3: pen < shdpen
+	const __m128i shadowmin = _mm_set1_epi8((char)shdpen);		// drawmode 4: pen >= shdpen
+	UINT8 pens[16];
+
+	for (INT32 y = 0; y < dst_h; y++, src_fby += src_fdy, dst_ptr += dst_pitch, ozbuf_ptr += GX_ZBUFW, szbuf_ptr += GX_ZBUFW << 1)
+	{
+		const UINT8 *src_ptr = src_base + ((src_fby >> fp) << 4);
+		INT32 src_fx = src_fbx;
+
+		for (INT32 x = 0; x < dst_w; x += 16)
+		{
+			INT32 n = dst_w - x;
+			if (n > 16) n = 16;
+
+			// pen 0 never passes, so the unused end of the span draws nothing
+			for (INT32 i = 0; i < n; i++, src_fx += src_fdx) pens[i] = src_ptr[src_fx >> fp];
+			for (INT32 i = n; i < 16; i++) pens[i] = 0;
+
+			__m128i pen = _mm_loadu_si128((__m128i*)pens);
+			INT32 mask;
+
+			if (drawmode < 4)
+			{
+				__m128i oz = _mm_loadu_si128((__m128i*)(ozbuf_ptr + x));
+				__m128i pass = _mm_andnot_si128(_mm_cmpeq_epi8(pen, zero), _mm_cmpeq_epi8(_mm_max_epu8(oz, z), oz));
+				if (drawmode & 1) pass = _mm_and_si128(pass, _mm_cmpeq_epi8(_mm_min_epu8(pen, solidmax), pen));
+
+				mask = _mm_movemask_epi8(pass);
+				if (!mask) continue;
+
+				_mm_storeu_si128((__m128i*)(ozbuf_ptr + x), _mm_or_si128(_mm_and_si128(pass, z), _mm_andnot_si128(pass, oz)));
+			}
+			else
+			{
+				// the shadow z-buffer is z, pri pairs
+				__m128i s0 = _mm_loadu_si128((__m128i*)(szbuf_ptr + (x << 1) +  0));
+				__m128i s1 = _mm_loadu_si128((__m128i*)(szbuf_ptr + (x << 1) + 16));
+				__m128i sz = _mm_packus_epi16(_mm_and_si128(s0, lomask), _mm_and_si128(s1, lomask));
+				__m128i sp = _mm_packus_epi16(_mm_srli_epi16(s0, 8), _mm_srli_epi16(s1, 8));
+
+				__m128i pass = _mm_and_si128(_mm_cmpeq_epi8(_mm_max_epu8(pen, shadowmin), pen), _mm_cmpeq_epi8(_mm_max_epu8(sz, z), sz));
+				pass = _mm_and_si128(pass, _mm_cmpgt_epi8(_mm_xor_si128(sp, sign), psigned));
+
+				mask = _mm_movemask_epi8(pass);
+				if (!mask) continue;
+
+				sz = _mm_or_si128(_mm_and_si128(pass, z), _mm_andnot_si128(pass, sz));
+				sp = _mm_or_si128(_mm_and_si128(pass, p), _mm_andnot_si128(pass, sp));
+				_mm_storeu_si128((__m128i*)(szbuf_ptr + (x << 1) +  0), _mm_unpacklo_epi8(sz, sp));
+				_mm_storeu_si128((__m128i*)(szbuf_ptr + (x << 1) + 16), _mm_unpackhi_epi8(sz, sp));
+			}
+
+			UINT32 *dst = dst_ptr + x;
+
+			for (INT32 i = 0; mask; i++, mask >>= 1)
+			{
+				if (!(mask & 1)) continue;
+
+				switch (drawmode)
+				{
+					case 0:
+					case 1:
+						dst[i] = pal_base[pens[i]];
+					break;
+
+					case 2:
+					case 3:
+						dst[i] = alpha_blend_r32(pal_base[pens[i]], dst[i], alpha);
+					break;
+
+					case 4:
+						if (highlight_enable) {
+							dst[i] = highlight_blend(dst[i]);
+						} else {
+							dst[i] = shadow_blend(dst[i], shadow_bank);
+						}
+					break;
+				}
+			}
+		}
+	}
+}
+#endif
+
 void zdrawgfxzoom32GP(UINT32 code, UINT32 color, INT32 flipx, INT32 flipy, INT32 sx, INT32 sy,
 		INT32 scalex, INT32 scaley, INT32 alpha, INT32 drawmode, INT32 zcode, INT32 pri, UINT8* gx_objzbuf, UINT8* gx_shdzbuf)
 {
@@ -676,8 +785,12 @@ void zdrawgfxzoom32GP(UINT32 code, UINT32 color, INT32 flipx, INT32 flipy, INT32
 	dst_x     = sx;
 	dst_y     = sy;
 
+	// rows this thread draws (the z-buffers are still addressed from dst_miny)
+	INT32 clip_miny = (gx_band_miny > dst_miny) ? gx_band_miny : dst_miny;
+	INT32 clip_maxy = (gx_band_maxy < dst_maxy) ? gx_band_maxy : dst_maxy;
+
 	// cull off-screen objects
-	if (dst_x > dst_maxx || dst_y > dst_maxy) return;
+	if (dst_x > dst_maxx || dst_y > clip_maxy) return;
 	nozoom = (scalex == 0x10000 && scaley == 0x10000);
 	if (nozoom)
 	{
@@ -698,15 +811,15 @@ void zdrawgfxzoom32GP(UINT32 code, UINT32 color, INT32 flipx, INT32 flipy, INT32
 	dst_lastx = dst_x + dst_w - 1;
 	if (dst_lastx < dst_minx) return;
 	dst_lasty = dst_y + dst_h - 1;
-	if (dst_lasty < dst_miny) return;
+	if (dst_lasty < clip_miny) return;
 
 	// clip destination
 	dst_skipx = 0;
 	eax = dst_minx;  if ((eax -= dst_x) > 0) { dst_skipx = eax;  dst_w -= eax;  dst_x = dst_minx; }
 	eax = dst_lastx; if ((eax -= dst_maxx) > 0) dst_w -= eax;
 	dst_skipy = 0;
-	eax = dst_miny;  if ((eax -= dst_y) > 0) { dst_skipy = eax;  dst_h -= eax;  dst_y = dst_miny; }
-	eax = dst_lasty; if ((eax -= dst_maxy) > 0) dst_h -= eax;
+	eax = clip_miny; if ((eax -= dst_y) > 0) { dst_skipy = eax;  dst_h -= eax;  dst_y = clip_miny; }
+	eax = dst_lasty; if ((eax -= clip_maxy) > 0) dst_h -= eax;
 
 	// calculate zoom factors and clip source
 	if (nozoom)
@@ -722,6 +835,18 @@ void zdrawgfxzoom32GP(UINT32 code, UINT32 color, INT32 flipx, INT32 flipy, INT32
 	src_fbx += dst_skipx * src_fdx;
 	src_fby += dst_skipy * src_fdy;
 
+#if defined BURN_SIMD_SSE2
+	if (zcode >= 0 && drawmode <= 4 && (dst_x - dst_minx) + ((dst_w + 15) & ~15) <= GX_ZBUFW)
+	{
+		eax = (dst_y - dst_miny) * GX_ZBUFW + (dst_x - dst_minx);
+
+		zdrawgfxspans32GP(src_base, src_fbx, src_fdx, src_fby, src_fdy, nozoom ? 0 : FP,
+				dst_ptr + dst_y * dst_pitch + dst_x, dst_pitch, ozbuf_ptr + eax, szbuf_ptr + (eax << 1), dst_w, dst_h,
+				pal_base, drawmode, shdpen, (UINT8)zcode, (UINT8)pri, alpha, highlight_enable, shadow_bank);
+		return;
+	}
+#endif
+
 	// adjust insertion points and pre-entry constants
 	eax = (dst_y - dst_miny) * GX_ZBUFW + (dst_x - dst_minx) + dst_w;
 	z8 = (UINT8)zcode;
@@ -3,6 +3,7 @@
 
 #include "tiles_generic.h"
 #include "konamiic.h"
+#include "burn_roz.h"
 
 #define MAX_K053936	2
 
@@ -252,67 +253,19 @@ static inline void copy_roz32(INT32 chip, INT32 minx, INT32 maxx, INT32 miny, IN
 
 	UINT8  *pri = konami_priority_bitmap;
 	UINT32 *dst = konami_bitmap32;
-	UINT32 *pal = konami_palette32;
-	UINT16 *src = tscreen[chip];
 
-	INT32 width = nWidth[chip];
-	INT32 hmask = nHeight[chip] - 1;
-	INT32 wmask = nWidth[chip] - 1;
+	BurnRozSource roz;
+	BurnRozSetSource(&roz, tscreen[chip], nWidth[chip], nWidth[chip], nHeight[chip], 16, K053936Wrap[chip]);
 
-	INT32 wrap = K053936Wrap[chip];
-	
 	dst += maxx * miny; // right?
-	
+	pri += maxx * miny;
+
 	for (INT32 sy = miny; sy < maxy; sy++, startx+=incyx, starty+=incyy)
 	{
-		UINT32 cx = startx;
-		UINT32 cy = starty;
+		BurnRozDrawSpan32(dst, pri, konami_palette32, &roz, startx, starty, incxx, incxy, maxx - minx, transp ? 0x8000 : 0, 0x8000, 0x7fff, priority);
 
-		if (transp) {
-			if (wrap) {
-				for (INT32 x = minx; x < maxx; x++, cx+=incxx, cy+=incxy, dst++, pri++)
-				{
-					INT32 pxl = src[(((cy >> 16) & hmask) * width) + ((cx >> 16) & wmask)];
-		
-					if (!(pxl & 0x8000)) {
-						*dst = pal[pxl];
-						*pri = priority;
-					}
-				}
-			} else {
-				for (INT32 x = minx; x < maxx; x++, cx+=incxx, cy+=incxy, dst++, pri++)
-				{
-					INT32 yy = cy >> 16;
-					if (yy > hmask || yy < 0) continue;
-					INT32 xx = cx >> 16;
-					if (xx > wmask || xx < 0) continue;
-
-					INT32 pxl = src[(yy * width) + xx];
-
-					if (!(pxl & 0x8000)) {
-						*dst = pal[pxl];
-						*pri = priority;
-					}
-				}
-			}
-		} else {
-			if (wrap) {
-				for (INT32 x = minx; x < maxx; x++, cx+=incxx, cy+=incxy, dst++, pri++) {
-					*dst = pal[src[(((cy >> 16) & hmask) * width) + ((cx >> 16) & wmask)] & 0x7fff];
-					*pri = priority;
-				}
-			} else {
-				for (INT32 x = minx; x < maxx; x++, cx+=incxx, cy+=incxy, dst++, pri++) {
-					INT32 yy = cy >> 16;
-					if (yy > hmask || yy < 0) continue;
-					INT32 xx = cx >> 16;
-					if (xx > wmask || xx < 0) continue;
-
-					*dst = pal[src[(yy * width) + xx] & 0x7fff];
-					*pri = priority;
-				}
-			}
-		}
+		dst += maxx - minx;
+		pri += maxx - minx;
 	}
 }
 
@@ -345,66 +298,20 @@ static inline void copy_roz16(INT32 chip, INT32 minx, INT32 maxx, INT32 miny, IN
 
 	UINT8  *pri = pPrioDraw;
 	UINT16 *dst = pTransDraw;
-	UINT16 *src = BurnBitmapGetBitmap(1);
 
-	INT32 width = clip_maxx;
-	INT32 hmask = clip_maxy - 1;
-	INT32 wmask = clip_maxx - 1;
+	BurnRozSource roz;
+	BurnRozSetSource(&roz, BurnBitmapGetBitmap(1), clip_maxx, clip_maxx, clip_maxy, 16, K053936Wrap[chip]);
 
-	INT32 wrap = K053936Wrap[chip];
-	
 	dst += maxx * miny; // right?
+	pri += maxx * miny;
 
 	for (INT32 sy = miny; sy < maxy; sy++, startx+=incyx, starty+=incyy)
 	{
-		UINT32 cx = startx;
-		UINT32 cy = starty;
+		// transparent pixels keep the 0x8000 bit, opaque ones have it stripped
+		BurnRozDrawSpan16(dst, pri, &roz, startx, starty, incxx, incxy, maxx - minx, transp_mask, transp, transp_mask ? 0xffff : 0x7fff, priority);
 
-		if (transp_mask) {
-			if (wrap) {
-				for (INT32 x = minx; x < maxx; x++, cx+=incxx, cy+=incxy, dst++, pri++)
-				{
-					INT32 pxl = src[(((cy >> 16) & hmask) * width) + ((cx >> 16) & wmask)];
-		
-					if ((pxl & transp_mask) != transp) {
-						*dst = pxl;
-						*pri = priority;
-					}
-				}
-			} else {
-				for (INT32 x = minx; x < maxx; x++, cx+=incxx, cy+=incxy, dst++, pri++)
-				{
-					INT32 yy = cy >> 16;
-					if (yy > hmask || yy < 0) continue;
-					INT32 xx = cx >> 16;
-					if (xx > wmask || xx < 0) continue;
-
-					INT32 pxl = src[(yy * width) + xx];
-
-					if ((pxl & transp_mask) != transp) {
-						*dst = pxl;
-						*pri = priority;
-					}
-				}
-			}
-		} else {
-			if (wrap) {
-				for (INT32 x = minx; x < maxx; x++, cx+=incxx, cy+=incxy, dst++, pri++) {
-					*dst = src[(((cy >> 16) & hmask) * width) + ((cx >> 16) & wmask)] & 0x7fff;
-					*pri = priority;
-				}
-			} else {
-				for (INT32 x = minx; x < maxx; x++, cx+=incxx, cy+=incxy, dst++, pri++) {
-					INT32 yy = cy >> 16;
-					if (yy > hmask || yy < 0) continue;
-					INT32 xx = cx >> 16;
-					if (xx > wmask || xx < 0) continue;
-
-					*dst = src[(yy * width) + xx] & 0x7fff;
-					*pri = priority;
-				}
-			}
-		}
+		dst += maxx - minx;
+		pri += maxx - minx;
 	}
 }
 
@@ -609,10 +516,8 @@ static inline void K053936GP_copyroz32clip(INT32 chip, UINT16 *src_bitmap, INT32
 	static const INT32 colormask[8]={1,3,7,0xf,0x1f,0x3f,0x7f,0xff};
 	INT32 cy, cx;
 	INT32 ecx;
-	INT32 src_pitch, incxy, incxx;
+	INT32 incxy, incxx;
 	INT32 src_minx, src_maxx, src_miny, src_maxy, cmask;
-	UINT16 *src_base;
-	INT32 src_size;
 
 	const UINT32 *pal_base;
 	INT32 dst_ptr;
@@ -657,40 +562,47 @@ static inline void K053936GP_copyroz32clip(INT32 chip, UINT16 *src_bitmap, INT32
 	pal_base = konami_palette32;
 	cmask = colormask[tilebpp];
 
-	src_pitch = 0x2000;
-	src_base = src_bitmap;
-	src_size = 0x2000 * 0x2000;
+	BurnRozSource roz;
+	BurnRozSetSource(&roz, src_bitmap, 0x2000, 0x2000, 0x2000, 16, 1);
+	roz.nMinX = src_minx;
+	roz.nMaxX = src_maxx;
+	roz.nMinY = src_miny;
+	roz.nMaxY = src_maxy;
+
+	UINT32 pixels[256];
+
 	dst_size = nScreenWidth * nScreenHeight;
 	dst_ptr = 0;//dst_base;
 	cy = starty;
 	cx = startx;
 
-	if (blend > 0)
-	{
-		dst_ptr += dst_pitch;      // draw blended
-		starty += incyy;
-		startx += incyx;
+	dst_ptr += dst_pitch;
+	starty += incyy;
+	startx += incyx;
 
-		do {
-			do {
-				INT32 srcx = (cx >> 16) & 0x1fff;
-				INT32 srcy = (cy >> 16) & 0x1fff;
-				INT32 pixel;
-				INT32 offs;
-				offs = srcy * src_pitch + srcx;
+	do {
+		// pixel doubling only advances over drawn pixels, so fetch as we go
+		INT32 fetched = 0, n = 0;
 
-				cx += incxx;
-				cy += incxy;
+		do {
+			if (n == fetched) {
+				fetched = (-ecx < 256) ? -ecx : 256;
+				BurnRozFetch(pixels, &roz, cx, cy, incxx, incxy, fetched);
+				cx += incxx * fetched;
+				cy += incxy * fetched;
+				n = 0;
+			}
 
-				if (offs>=src_size||offs<0)
-					continue;
+			UINT32 pxl = pixels[n++];
+			if (pxl & BURNROZ_OUTSIDE)
+				continue;
 
-				if (srcx < src_minx || srcx > src_maxx || srcy < src_miny || srcy > src_maxy)
-					continue;
+			INT32 pixel = BURN_ENDIAN_SWAP_INT16((UINT16)pxl)|color_base;
+			if (!(pixel & cmask))
+				continue;
 
-				pixel = BURN_ENDIAN_SWAP_INT16(src_base[offs])|color_base;
-				if (!(pixel & cmask))
-					continue;
+			if (blend > 0)    // draw blended
+			{
 // this one below is borked.
 				if ((dst_ptr+ecx+dst_base2)<dst_size) dst_base[dst_ptr+ecx+dst_base2] = alpha_blend(pal_base[pixel], dst_base[dst_ptr+ecx+dst_base2], alpha);
 
@@ -700,42 +612,8 @@ static inline void K053936GP_copyroz32clip(INT32 chip, UINT16 *src_bitmap, INT32
 					if ((dst_ptr+ecx+dst_base2)<dst_size) dst_base[dst_ptr+ecx+dst_base2] = alpha_blend(pal_base[pixel], dst_base[dst_ptr+ecx+dst_base2], alpha);
 				}
 			}
-			while (++ecx < 0);
-
-			ecx = tx;
-			dst_ptr += dst_pitch;
-			cy = starty; starty += incyy;
-			cx = startx; startx += incyx;
-		} while (--ty);
-	}
-	else    //  draw solid
-	{
-		dst_ptr += dst_pitch;
-		starty += incyy;
-		startx += incyx;
-
-		do {
-			do {
-				INT32 srcx = (cx >> 16) & 0x1fff;
-				INT32 srcy = (cy >> 16) & 0x1fff;
-				INT32 pixel;
-				INT32 offs;
-
-				offs = srcy * src_pitch + srcx;
-
-				cx += incxx;
-				cy += incxy;
-
-				if (offs>=src_size||offs<0)
-					continue;
-
-				if (srcx < src_minx || srcx > src_maxx || srcy < src_miny || srcy > src_maxy)
-					continue;
-
-				pixel = BURN_ENDIAN_SWAP_INT16(src_base[offs])|color_base;
-				if (!(pixel & cmask))
-					continue;
-
+			else    //  draw solid
+			{
 				if ((dst_ptr+ecx+dst_base2)<dst_size) dst_base[dst_ptr+ecx+dst_base2] = pal_base[pixel];
 
 				if (pixeldouble_output)
@@ -744,14 +622,14 @@ static inline void K053936GP_copyroz32clip(INT32 chip, UINT16 *src_bitmap, INT32
 					if ((dst_ptr+ecx+dst_base2)<dst_size) dst_base[dst_ptr+ecx+dst_base2] = pal_base[pixel];
 				}
 			}
-			while (++ecx < 0);
+		}
+		while (++ecx < 0);
 
-			ecx = tx;
-			dst_ptr += dst_pitch;
-			cy = starty; starty += incyy;
-			cx = startx; startx += incyx;
-		} while (--ty);
-	}
+		ecx = tx;
+		dst_ptr += dst_pitch;
+		cy = starty; starty += incyy;
+		cx = startx; startx += incyx;
+	} while (--ty);
 }
 
 static void K053936GP_zoom_draw(INT32 chip, UINT16 *ctrl, UINT16 *linectrl, UINT16 *src_bitmap,
@@ -333,6 +333,53 @@ extern void k053247_draw_single_sprite_gxcore(UINT8 *,UINT8 *gx_shdzbuf, INT32 c
 		INT32 color, INT32 alpha, INT32 drawmode, INT32 zcode, INT32 pri,
 		INT32 primask, INT32 shadow, UINT8 *drawmode_table, UINT8 *shadowmode_table, INT32 shdmask);
 
+// sprites between two layers in the draw list are collected and drawn together,
+// split into bands of lines on the worker pool when there is more than one thread
+#define GX_BAND_MAX			8
+#define GX_BAND_MIN_LINES	16
+
+struct GX_SPRITE_OP { INT32 code, offs, color, alpha, drawmode, zcode, pri; };
+
+static struct GX_SPRITE_OP gx_sprite_ops[GX_MAX_OBJECTS];
+static INT32 gx_sprite_nops = 0;
+
+static void gx_draw_sprite_ops(INT32 nStart, INT32 nEnd)
+{
+	K053247GXSetBand(nStart, nEnd);
+
+	for (INT32 i = 0; i < gx_sprite_nops; i++)
+	{
+		struct GX_SPRITE_OP *op = &gx_sprite_ops[i];
+		k053247_draw_single_sprite_gxcore(gx_objzbuf, gx_shdzbuf,op->code,gx_spriteram,op->offs,op->color,op->alpha,op->drawmode,op->zcode,op->pri,0,0,NULL,NULL,0);
+	}
+
+	K053247GXSetBand(0, nScreenHeight);
+}
+
+static void gx_sprite_band_job(INT32 nJob, void *pParam)
+{
+	INT32 nBands = *(INT32*)pParam;
+
+	gx_draw_sprite_ops(nScreenHeight * nJob / nBands, nScreenHeight * (nJob + 1) / nBands);
+}
+
+static void gx_flush_sprite_ops()
+{
+	if (gx_sprite_nops == 0) return;
+
+	INT32 nBands = nScreenHeight / GX_BAND_MIN_LINES;
+	if (nBands > BurnPoolGetThreads()) nBands = BurnPoolGetThreads();
+	if (nBands > GX_BAND_MAX) nBands = GX_BAND_MAX;
+
+	if (nBands <= 1) {
+		gx_draw_sprite_ops(0, nScreenHeight);
+	} else {
+		BurnPoolRun(gx_sprite_band_job, &nBands, nBands);
+	}
+
+	gx_sprite_nops = 0;
+}
+
 
 static void konamigx_mixer_draw(INT32 sub1, INT32 sub1flags,INT32 sub2, INT32 sub2flags,INT32 mixerflags,  INT32 extra_bitmap, INT32 rushingheroes_hack,struct GX_OBJ *objpool,INT32 *objbuf,INT32 nobj)
 {
@@ -380,10 +427,22 @@ static void konamigx_mixer_draw(INT32 sub1, INT32 sub1flags,INT32 sub2, INT32 su
 			}
 
 			if (nSpriteEnable & 1)
-				k053247_draw_single_sprite_gxcore(gx_objzbuf, gx_shdzbuf,code,gx_spriteram,offs,color,alpha,drawmode,zcode,pri,0,0,NULL,NULL,0);
+			{
+				struct GX_SPRITE_OP *op = &gx_sprite_ops[gx_sprite_nops++];
+				op->code = code;
+				op->offs = offs;
+				op->color = color;
+				op->alpha = alpha;
+				op->drawmode = drawmode;
+				op->zcode = zcode;
+				op->pri = pri;
+			}
 		}
 		else
 		{
+			// layers draw over (or under) everything before them
+			gx_flush_sprite_ops();
+
 			switch (offs)
 			{
 				case -1:
@@ -401,6 +460,41 @@ static void konamigx_mixer_draw(INT32 sub1, INT32 sub1flags,INT32 sub2, INT32 su
 			continue;
 		}
 	}
+
+	gx_flush_sprite_ops();
+}
+
+// radix sort of objbuf on the (unsigned) order key, decending. Objects with the same key
+// come out last added first, which is what the old exchange sort did with them.
+static void gx_sort_objects(struct GX_OBJ *objpool, INT32 *objbuf, INT32 nobj)
+{
+	INT32 tmpbuf[GX_MAX_OBJECTS];
+	INT32 *src = objbuf, *dst = tmpbuf;
+
+	if (nobj < 2) return;
+
+	for (INT32 shift = 0; shift < 32; shift += 8)
+	{
+		INT32 count[256];
+		memset(count, 0, sizeof(count));
+
+		for (INT32 i = 0; i < nobj; i++) count[((UINT32)objpool[src[i]].order >> shift) & 0xff]++;
+
+		if (count[((UINT32)objpool[src[0]].order >> shift) & 0xff] == nobj) continue; // same byte everywhere
+
+		// stable and ascending, reversed at the end
+		for (INT32 i = 0, pos = 0; i < 256; i++) { INT32 n = count[i]; count[i] = pos; pos += n; }
+
+		for (INT32 i = 0; i < nobj; i++) dst[count[((UINT32)objpool[src[i]].order >> shift) & 0xff]++] = src[i];
+
+		INT32 *temp = src; src = dst; dst = temp;
+	}
+
+	if (src == objbuf) {
+		for (INT32 i = 0, j = nobj - 1; i < j; i++, j--) { INT32 temp = objbuf[i]; objbuf[i] = objbuf[j]; objbuf[j] = temp; }
+	} else {
+		for (INT32 i = 0; i < nobj; i++) objbuf[i] = src[nobj - 1 - i];
+	}
 }
 
 void konamigx_mixer(INT32 sub1 /*extra tilemap 1*/, INT32 sub1flags, INT32 sub2 /*extra tilemap 2*/, INT32 sub2flags, INT32 mixerflags, INT32 extra_bitmap /*extra tilemap 3*/, INT32 rushingheroes_hack)
@@ -563,7 +657,6 @@ void konamigx_mixer(INT32 sub1 /*extra tilemap 1*/, INT32 sub1flags, INT32 sub2
 	}
 
 //  i = j = 0xff;
-	INT32 l = 0;
 
 	for (INT32 offs=0; offs<0x800; offs+=8)
 	{
@@ -578,7 +671,6 @@ void konamigx_mixer(INT32 sub1 /*extra tilemap 1*/, INT32 sub1flags, INT32 sub2
 
 		INT32 code  = BURN_ENDIAN_SWAP_INT16(gx_spriteram[offs+1]);
 		INT32 color = k = BURN_ENDIAN_SWAP_INT16(gx_spriteram[offs+6]);
-		l     = BURN_ENDIAN_SWAP_INT16(gx_spriteram[offs+7]);
 
 		K053247Callback(&code, &color, &pri);
 
@@ -715,21 +807,8 @@ void konamigx_mixer(INT32 sub1 /*extra tilemap 1*/, INT32 sub1flags, INT32 sub2
 		}
 	}
 
-	// sort objects in decending order (SLOW)
-	k = nobj;
-	l = nobj - 1;
-
-	for (INT32 j=0; j<l; j++)
-	{
-		INT32 temp1 = objbuf[j];
-		INT32 temp2 = objpool[temp1].order;
-		for (INT32 i=j+1; i<k; i++)
-		{
-			INT32 temp3 = objbuf[i];
-			INT32 temp4 = objpool[temp3].order;
-			if ((UINT32)temp2 <= (UINT32)temp4) { temp2 = temp4; objbuf[i] = temp1; objbuf[j] = temp1 = temp3; }
-		}
-	}
+	// sort objects in decending order
+	gx_sort_objects(objpool, objbuf, nobj);
 
 	konamigx_mixer_draw(sub1,sub1flags,sub2,sub2flags,mixerflags,extra_bitmap,rushingheroes_hack,objpool,objbuf,nobj);
 }
@@ -306,6 +306,7 @@ UINT16 K053247ReadRegs(INT32 offset);
 UINT16 K053246ReadRegs(INT32 offset);
 
 void K053247SpritesRender();
+void K053247GXSetBand(INT32 nStart, INT32 nEnd); // rows the konamigx sprite drawing may touch on this thread
 
 UINT16 K053247ReadWord(INT32 offset);
 void K053247WriteWord(INT32 offset, UINT16 data);
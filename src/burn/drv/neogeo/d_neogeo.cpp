@@ -1954,6 +1954,8 @@ static void PCM2DecryptP()
 
 static void PCM2DecryptV(INT32 size, INT32 bit)
 {
+	NeoADPCMFixup();
+
 	for (INT32 i = 0; i < (size / 2) - (2 << bit); i += (2 << bit)) {
 		UINT16 buffer[8];
 		memcpy(buffer, ((UINT16*)(YM2610ADPCMAROM[nNeoActiveSlot])) + i, (2 << bit) * 2);
@@ -1965,6 +1967,8 @@ static void PCM2DecryptV(INT32 size, INT32 bit)
 
 static void PCM2DecryptV2(const PCM2DecryptV2Info* const pInfo)
 {
+	NeoADPCMFixup();
+
 	// Decrypt V-ROMs
 
 	UINT8* pTemp = (UINT8*)BurnMalloc(0x01000000);
@@ -9992,6 +9996,7 @@ static INT32 svcbootInit()
 	nRet = NeoPVCInit();
 
 	if (nRet == 0) {
+		NeoADPCMFixup();
 		BurnByteswap(YM2610ADPCMAROM[nNeoActiveSlot], 0x1000000);
 	}
 
@@ -10079,6 +10084,7 @@ static INT32 svcplusInit()
 	nRet = NeoInit();
 
 	if (nRet == 0) {
+		NeoADPCMFixup();
 		BurnByteswap(YM2610ADPCMAROM[nNeoActiveSlot], 0x1000000);
 	}
 
@@ -10151,6 +10157,7 @@ static INT32 svcplusaInit()
 	nRet = NeoInit();
 
 	if (nRet == 0) {
+		NeoADPCMFixup();
 		BurnByteswap(YM2610ADPCMAROM[nNeoActiveSlot], 0x1000000);
 	}
 
@@ -10237,6 +10244,7 @@ static INT32 svcsplusInit()
 	nRet = NeoPVCInit();
 
 	if (nRet == 0) {
+		NeoADPCMFixup();
 		BurnByteswap(YM2610ADPCMAROM[nNeoActiveSlot], 0x1000000);
 	}
 
@@ -10443,6 +10451,8 @@ static void samsho5b_sx_decode()
 
 static void samsho5b_vx_decode()
 {
+	NeoADPCMFixup();
+
 	for (INT32 i = 0; i < 0x400000 * 4; i++)
 		YM2610ADPCMAROM[nNeoActiveSlot][i] = BITSWAP08(YM2610ADPCMAROM[nNeoActiveSlot][i], 0, 1, 5, 4, 3, 2, 6, 7);
 }
@@ -13429,6 +13439,7 @@ static INT32 lans2004Init()
  	nRet = NeoInit();
 
 	if (nRet == 0) {
+		NeoADPCMFixup();
 		for (INT32 i = 0; i < 0xa00000; i++)
 			YM2610ADPCMAROM[nNeoActiveSlot][i] = BITSWAP08(YM2610ADPCMAROM[nNeoActiveSlot][i], 0, 1, 5, 4, 3, 2, 6, 7);
 	}
@@ -14877,6 +14888,7 @@ static INT32 matrimblInit()
 	nRet = NeoInit();
 
 	if (nRet == 0) {
+		NeoADPCMFixup();
 		BurnByteswap(YM2610ADPCMAROM[nNeoActiveSlot] + 0x400000, 0x400000);
 		BurnByteswap(YM2610ADPCMAROM[nNeoActiveSlot] + 0xc00000, 0x400000);
 	}
@@ -16173,6 +16185,8 @@ static void mslug5b_cx_decode()
 
 static void mslug5b_vx_decrypt()
 {
+	NeoADPCMFixup();
+
 	for (INT32 i = 0; i < 0x1000000; i += 2)
 		YM2610ADPCMAROM[nNeoActiveSlot][i + 1] = BITSWAP08(YM2610ADPCMAROM[nNeoActiveSlot][i + 1], 3, 2, 4, 1, 5, 0, 6, 7);
 }
@@ -22064,6 +22078,7 @@ static INT32 kof96aeInit()
 	INT32 nRet = NeoInit();
 
 	if ((0 == nRet) && nBurnDrvSubActive) {
+		NeoADPCMFixup();
 		RomDiffPatch(YM2610ADPCMAROM[nNeoActiveSlot] + 0x800000, 29, 0x400000, 1);
 	}
 
@@ -23813,6 +23828,7 @@ static INT32 kof98eckInit()
 	if ((0 == nRet) && (nBurnDrvSubActive)) {
 		INT32 nIndex = (0x01 == nBurnDrvSubActive) ? 28 : 44;
 
+		NeoADPCMFixup();
 		for (INT32 nNum = 0; nNum < 4; nNum++, nIndex++) {
 			RomDiffPatch(YM2610ADPCMAROM[nNeoActiveSlot] + 0x400000 * nNum, nIndex, 0x400000, 1);
 		}
@@ -27955,6 +27971,7 @@ static INT32 mslug3xInit()
 	INT32 nRet = NeoInit();
 
 	if ((0 == nRet) && (VerSwitcher & 0x1e)) {
+		NeoADPCMFixup();
 		for (INT32 i = 0x02, nIndex = 14; i <= 0x10; i <<= 1, nIndex += 5) {
 			if (VerSwitcher & i) {
 				RomDiffPatch(YM2610ADPCMAROM[nNeoActiveSlot], nIndex, 0, 1);
@@ -504,29 +504,43 @@ inline static void cmc_xor(UINT8 *r0, UINT8 *r1,
 	}
 }
 
-void NeoCMCDecrypt(INT32 extra_xor, UINT8* rom, UINT8* buf, INT32 offset, INT32 block_size, INT32 rom_size)
+// The decryption is split into runs of longwords for the worker pool. Each
+// run does its data xor and then moves the result to its decrypted address.
+// The address scramble is a permutation, so no two runs ever write the same
+// longword and the result doesn't depend on the order they finish in.
+#define CMC_DECRYPT_RUN		0x10000
+
+struct cmc_decrypt_params {
+	INT32 extra_xor;
+	UINT8 *rom;
+	UINT8 *buf;
+	INT32 offset;
+	INT32 block_size;
+	INT32 clamp_size;
+};
+
+static void NeoCMCDecryptRun(INT32 nJob, void *pParam)
 {
-	INT32 clamp_size, rpos;
+	cmc_decrypt_params *p = (cmc_decrypt_params*)pParam;
 
-	if (rom_size > 0x04000000) rom_size = 0x04000000;
+	UINT8 *buf = p->buf;
+	INT32 offset = p->offset;
+	INT32 clamp_size = p->clamp_size;
+	INT32 start = nJob * CMC_DECRYPT_RUN;
+	INT32 end = start + CMC_DECRYPT_RUN;
+	INT32 rpos;
 
-	// Adjust variables for addressing 32bit words
-	rom_size   >>= 2;
-	block_size >>= 2;
-	offset     >>= 2;
-
-	// special handling for games with 6 C ROMs
-	for (clamp_size = 1 << 30; clamp_size > rom_size; clamp_size >>= 1) { }
+	if (end > p->block_size) end = p->block_size;
 
 	// Data xor
-	for (rpos = 0; rpos < block_size; rpos++)
+	for (rpos = start; rpos < end; rpos++)
 	{
 		cmc_xor(buf+4*rpos+0, buf+4*rpos+3, type0_t03, type0_t12, type1_t03, rpos, (rpos>>8) & 1);
 		cmc_xor(buf+4*rpos+1, buf+4*rpos+2, type0_t12, type0_t03, type1_t12, rpos, (((rpos + offset)>>16) ^ address_16_23_xor2[(rpos>>8) & 0xff]) & 1);
 	}
 
 	// Address xor
-	for (rpos = 0; rpos < block_size; rpos++)
+	for (rpos = start; rpos < end; rpos++)
 	{
 		INT32 baser = rpos + offset;
 
@@ -542,12 +556,39 @@ void NeoCMCDecrypt(INT32 extra_xor, UINT8* rom, UINT8* buf, INT32 offset, INT32
 		baser ^= address_8_15_xor2[baser & 0xff] << 8;
 		baser ^= address_8_15_xor1[(baser >> 16) & 0xff] << 8;
 
-		baser ^= extra_xor;
+		baser ^= p->extra_xor;
 
-		((UINT32*)rom)[baser] = ((UINT32*)buf)[rpos];
+		((UINT32*)p->rom)[baser] = ((UINT32*)buf)[rpos];
 	}
 }
 
+void NeoCMCDecrypt(INT32 extra_xor, UINT8* rom, UINT8* buf, INT32 offset, INT32 block_size, INT32 rom_size)
+{
+	BURN_PROFILE_PHASE(DECRYPT);
+
+	cmc_decrypt_params p;
+	INT32 clamp_size;
+
+	if (rom_size > 0x04000000) rom_size = 0x04000000;
+
+	// Adjust variables for addressing 32bit words
+	rom_size   >>= 2;
+	block_size >>= 2;
+	offset     >>= 2;
+
+	// special handling for games with 6 C ROMs
+	for (clamp_size = 1 << 30; clamp_size > rom_size; clamp_size >>= 1) { }
+
+	p.extra_xor = extra_xor;
+	p.rom = rom;
+	p.buf = buf;
+	p.offset = offset;
+	p.block_size = block_size;
+	p.clamp_size = clamp_size;
+
+	BurnPoolRun(NeoCMCDecryptRun, &p, (block_size + CMC_DECRYPT_RUN - 1) / CMC_DECRYPT_RUN);
+}
+
 /* CMC42 protection chip */
 void NeoCMC42Init()
 {
@@ -659,6 +700,8 @@ static INT32 m1_address_scramble(INT32 address, UINT16 key)
 
 void neogeo_cmc50_m1_decrypt()
 {
+	BURN_PROFILE_PHASE(DECRYPT);
+
 	UINT8 *rom = NeoZ80ROMActive;
 	UINT8 *buffer = (UINT8*)BurnMalloc(0x80000);
 	
@@ -215,6 +215,10 @@ static UINT32 nAnalogAxis[2] = { 0, 0 };
 static UINT32 nIRQOffset;
 
 #define NO_IRQ_PENDING (0x7FFFFFFF)
+
+// bump when NeoLoadSprites() / NeoCMCDecrypt() / NeoDecodeSprites() output changes
+#define NEO_SPRITE_CACHE_VERSION	1
+
 static INT32 nIRQCycles;
 
 #if defined EMULATE_WATCHDOG
@@ -540,6 +544,11 @@ static INT32 FindROMs(UINT32 nType, INT32* pOffset, INT32* pNum)
 	return 0;
 }
 
+// BurnShareMemory() keys for the V roms. Drivers may still decrypt or patch them
+// after NeoInit() returns, so they're only shared on the first frame (NeoShareADPCM())
+static UINT64 nNeoADPCMShareKey[MAX_SLOT];
+static INT32 bNeoADPCMSharePending = 0;
+
 static INT32 LoadRoms()
 {
 	NeoGameInfo info;
@@ -728,7 +737,20 @@ static INT32 LoadRoms()
 
 	// Load sprite data
 	// nSpriteRomSize - Make sure the 6C ROMs are decrypted correctly (NeoCMCDecrypt).
-	NeoLoadSprites(pInfo->nSpriteOffset, pInfo->nSpriteNum, NeoSpriteROM[nNeoActiveSlot], nSpriteRomSize);
+	// Decrypted CMC sprites are kept in the cache, the decryption is the slow part of loading
+	// these sets. The cached data is taken before pInitialise() patches it and NeoDecodeSprites().
+	{
+		UINT64 nCacheKey = 0;
+
+		if (BurnDrvGetHardwareCode() & (HARDWARE_SNK_CMC42 | HARDWARE_SNK_CMC50)) {
+			nCacheKey = BurnCacheRomKey(pInfo->nSpriteOffset, pInfo->nSpriteNum, NEO_SPRITE_CACHE_VERSION | (nNeoProtectionXor << 8) | ((nNeoSystemType & NEO_SYS_PCB) ? 0x10000 : 0));
+		}
+
+		if (BurnCacheLoadAsset("c", nCacheKey, NeoSpriteROM[nNeoActiveSlot], nSpriteSize[nNeoActiveSlot])) {
+			NeoLoadSprites(pInfo->nSpriteOffset, pInfo->nSpriteNum, NeoSpriteROM[nNeoActiveSlot], nSpriteRomSize);
+			BurnCacheSaveAsset("c", nCacheKey, NeoSpriteROM[nNeoActiveSlot], nSpriteSize[nNeoActiveSlot]);
+		}
+	}
 
 	NeoTextROM[nNeoActiveSlot] = (UINT8*)BurnMalloc(nNeoTextROMSize[nNeoActiveSlot]);
 	if (NeoTextROM[nNeoActiveSlot] == NULL) {
@@ -812,6 +834,10 @@ static INT32 LoadRoms()
 	// Decode sprite data
 	NeoDecodeSprites(NeoSpriteROM[nNeoActiveSlot], nSpriteSize[nNeoActiveSlot]);
 
+	// The sprites don't change from here on, share them with other instances
+	UINT64 nShareKey = BurnCacheRomKey(0, -1, NEO_SPRITE_CACHE_VERSION);
+	NeoSpriteROM[nNeoActiveSlot] = BurnShareMemory(NeoSpriteROM[nNeoActiveSlot], "spr", nShareKey);
+
 	if (pInfo->nADPCMANum) {
 		struct BurnRomInfo ri;
 		UINT8* pADPCMData;
@@ -832,7 +858,12 @@ static INT32 LoadRoms()
 			pADPCMData = YM2610ADPCMAROM[nNeoActiveSlot] + 0x200000;
  		}
 
-		NeoLoadADPCM(pInfo->nADPCMOffset, pInfo->nADPCMANum, pADPCMData);
+		// the samples are loaded as the YM2610 plays them (burn_lazy.cpp), unless they need fixing up first
+		if (pADPCMData != YM2610ADPCMAROM[nNeoActiveSlot] || (BurnDrvGetHardwareCode() & HARDWARE_SNK_SWAPV) ||
+			BurnLazyAddRoms(pADPCMData, nYM2610ADPCMASize[nNeoActiveSlot], pInfo->nADPCMOffset, pInfo->nADPCMANum, ri.nLen))
+		{
+			NeoLoadADPCM(pInfo->nADPCMOffset, pInfo->nADPCMANum, pADPCMData);
+		}
 
 		if (BurnDrvGetHardwareCode() & HARDWARE_SNK_SWAPV) {
 			for (INT32 i = 0; i < 0x00200000; i++) {
@@ -849,12 +880,21 @@ static INT32 LoadRoms()
 			return 1;
 		}
 
-		NeoLoadADPCM(pInfo->nADPCMOffset + pInfo->nADPCMANum, pInfo->nADPCMBNum, YM2610ADPCMBROM[nNeoActiveSlot]);
+		struct BurnRomInfo ri;
+		ri.nLen = 0;
+		BurnDrvGetRomInfo(&ri, pInfo->nADPCMOffset + pInfo->nADPCMANum);
+
+		if (BurnLazyAddRoms(YM2610ADPCMBROM[nNeoActiveSlot], nYM2610ADPCMBSize[nNeoActiveSlot], pInfo->nADPCMOffset + pInfo->nADPCMANum, pInfo->nADPCMBNum, ri.nLen)) {
+			NeoLoadADPCM(pInfo->nADPCMOffset + pInfo->nADPCMANum, pInfo->nADPCMBNum, YM2610ADPCMBROM[nNeoActiveSlot]);
+		}
 	} else {
 		YM2610ADPCMBROM[nNeoActiveSlot] = YM2610ADPCMAROM[nNeoActiveSlot];
 		nYM2610ADPCMBSize[nNeoActiveSlot] = nYM2610ADPCMASize[nNeoActiveSlot];
 	}
 
+	nNeoADPCMShareKey[nNeoActiveSlot] = nShareKey;
+	if (nShareKey) bNeoADPCMSharePending = 1;
+
 	// All reset to 0
 	memset(pNRI, 0, sizeof(NeoReallocInfo));
 
@@ -1142,6 +1182,29 @@ static UINT8 __fastcall vliner_timing(UINT32 sekAddress)
 
 // -----------------------------------------------------------------------------
 
+static void NeoShareADPCM()
+{
+	for (INT32 nSlot = 0; nSlot < MAX_SLOT; nSlot++) {
+		UINT64 nKey = nNeoADPCMShareKey[nSlot];
+		if (nKey == 0) continue;
+
+		UINT8 *pADPCMA = YM2610ADPCMAROM[nSlot];
+
+		YM2610ADPCMAROM[nSlot] = BurnShareMemory(pADPCMA, "v1", nKey);
+		if (YM2610ADPCMBROM[nSlot] == pADPCMA) {
+			YM2610ADPCMBROM[nSlot] = YM2610ADPCMAROM[nSlot];	// no separate ADPCM-B roms
+		} else {
+			YM2610ADPCMBROM[nSlot] = BurnShareMemory(YM2610ADPCMBROM[nSlot], "v2", nKey);
+		}
+
+		nNeoADPCMShareKey[nSlot] = 0;
+	}
+
+	bNeoADPCMSharePending = 0;
+
+	BurnYM2610MapADPCMROM(YM2610ADPCMAROM[nNeoActiveSlot], nYM2610ADPCMASize[nNeoActiveSlot], YM2610ADPCMBROM[nNeoActiveSlot], nYM2610ADPCMBSize[nNeoActiveSlot]);
+}
+
 static void NeoMapActiveCartridge()
 {
 	if (!(nNeoSystemType & NEO_SYS_CART)) {
@@ -4385,6 +4448,9 @@ INT32 NeoExit()
 
 	recursing = true;
 
+	memset(nNeoADPCMShareKey, 0, sizeof(nNeoADPCMShareKey));
+	bNeoADPCMSharePending = 0;
+
 	if ((BurnDrvGetHardwareCode() & HARDWARE_PUBLIC_MASK) == HARDWARE_SNK_MVS) {
 		UINT32 nDriver = nBurnDrvActive;
 
@@ -4594,6 +4660,10 @@ INT32 NeoFrame()
 {
 	//bprintf(0, _T("%X,"), SekReadWord(0x108)); // show game-id
 
+	if (bNeoADPCMSharePending) {
+		NeoShareADPCM();
+	}
+
 	if (NeoReset) {							   						// Reset machine
 		if (nNeoSystemType & NEO_SYS_CART) {
 			memset(Neo68KRAM, 0, 0x010000);
@@ -4890,7 +4960,7 @@ INT32 NeoFrame()
 		bRenderLineByLine = /*(!bNeoCDIRQEnabled) &&*/ bRenderMode;
 	}
 
-	bRenderImage = bNeoEnableGraphics;
+	bRenderImage = bNeoEnableGraphics && !bBurnSoundOnly;	// sound-only: no raster slicing either
 	bForceUpdateOnStatusRead = bRenderImage && bRenderLineByLine;
 	bForcePartialRender = false;
 
@@ -1,4 +1,5 @@
 #include "neogeo.h"
+#include "burn_simd.h"
 
 UINT8* NeoZoomROM;
 
@@ -14,31 +15,47 @@ static INT32 nNeoMaxTileActive;
 static UINT8* NeoTileAttrib[MAX_SLOT] = { NULL, };
 static UINT8* NeoTileAttribActive;
 
+// per tile, bit n = row n has something on it
+static UINT16* NeoTileRows[MAX_SLOT] = { NULL, };
+static UINT16* NeoTileRowsActive;
+
 INT32 nSliceStart, nSliceEnd, nSliceSize;
 static INT32 nNeoEnforceSpriteLimit[MAX_SLOT] = { 0, };
 
-static UINT32* pTileData;
-static UINT32* pTilePalette;
+// Where the sprite list walk is and which lines it draws on. A chained strip takes
+// its position from the one before it, so the state carries over from one call
+// (raster slice) to the next, as on the real thing.
+struct sprite_band {
+	UINT16* pBank;
+
+	INT32 nBankSize;
+	INT32 nBankXPos, nBankYPos;
+	INT32 nBankXZoom, nBankYZoom;
+
+	INT32 nSliceStart, nSliceEnd;
+};
 
-static UINT16* pBank;
+static sprite_band SpriteState;
 
-static INT32 nBankSize;
-static INT32 nBankXPos, nBankYPos;
-static INT32 nBankXZoom, nBankYZoom;
+// Slices at least this tall are split into bands that are drawn on the worker
+// pool. Each band walks the whole sprite list with its own copy of the state and
+// only draws its own lines, so the picture is the same as drawing it in one go.
+#define SPRITE_BAND_MAX			8
+#define SPRITE_BAND_MIN_LINES	16
+
+static sprite_band SpriteBands[SPRITE_BAND_MAX];
 
 static INT32 nNeoSpriteFrame04, nNeoSpriteFrame08;
 
 static INT32 nLastBPP = -1;
 
-typedef void (*RenderBankFunction)();
+typedef void (*RenderBankFunction)(sprite_band *pBand);
 static RenderBankFunction* RenderBank;
 
 static const INT32 MAX_SPRITEBANK = 0x17d;
 static const INT32 MAX_SPRITEBANK_LINE = 0x60;
 static INT32 nMaxSpriteBank;
 
-static UINT16 BankAttrib01, BankAttrib02, BankAttrib03;
-
 static inline UINT32 alpha_blend(UINT32 d, UINT32 s, UINT32 p)
 {
 	INT32 a = 255 - p;
@@ -56,10 +73,13 @@ void NeoSpriteCalcLimit()
 
 	nMaxSpriteBank = 0;
 
+	INT32 &nBankYPos = SpriteState.nBankYPos;
+	INT32 &nBankSize = SpriteState.nBankSize;
+
 	for (INT32 nYLine = 0; nYLine < 240; nYLine++) {
 		INT32 nYCount = 0;
 		for (INT32 nBank = 0; nBank < MAX_SPRITEBANK; nBank++) {
-			BankAttrib02 = *((UINT16*)(NeoGraphicsRAM + 0x010400 + (nBank << 1)));
+			UINT16 BankAttrib02 = *((UINT16*)(NeoGraphicsRAM + 0x010400 + (nBank << 1)));
 
 			if (~BankAttrib02 & 0x40) {
 				nBankYPos = (0x0200 - (BankAttrib02 >> 7)) & 0x01FF;
@@ -86,6 +106,96 @@ void NeoSpriteCalcLimit()
 
 static UINT8 nSpriteDisableLut[0x200];
 
+// walks the sprite list from nStart, drawing the lines in b
+static void NeoRenderSpriteBand(sprite_band *b, INT32 nStart)
+{
+	INT32 &nBankSize  = b->nBankSize;
+	INT32 &nBankXPos  = b->nBankXPos;
+	INT32 &nBankYPos  = b->nBankYPos;
+	INT32 &nBankXZoom = b->nBankXZoom;
+	INT32 &nBankYZoom = b->nBankYZoom;
+
+	for (INT32 nBank = 0; nBank < nMaxSpriteBank; nBank++) {
+		INT32 zBank = (nBank + nStart) % MAX_SPRITEBANK;
+		UINT16 BankAttrib01 = *((UINT16*)(NeoGraphicsRAM + 0x010000 + (zBank << 1)));
+		UINT16 BankAttrib02 = *((UINT16*)(NeoGraphicsRAM + 0x010400 + (zBank << 1)));
+		UINT16 BankAttrib03 = *((UINT16*)(NeoGraphicsRAM + 0x010800 + (zBank << 1)));
+
+		b->pBank = (UINT16*)(NeoGraphicsRAM + (zBank << 7));
+
+		if (BankAttrib02 & 0x40) {
+			nBankXPos += nBankXZoom + 1;
+		} else {
+			nBankYPos = (0x0200 - (BankAttrib02 >> 7)) & 0x01FF;
+			nBankXPos = (BankAttrib03 >> 7);
+			if (nNeoScreenWidth == 304) {
+				nBankXPos -= 8;
+			}
+
+			nBankYZoom = BankAttrib01 & 0xFF;
+			nBankSize  = BankAttrib02 & 0x3F;
+
+//			if (nBankSize > 0x10 && nSliceStart == 0x10) bprintf(PRINT_NORMAL, _T("bank: %04X, x: %04X, y: %04X, zoom: %02X, size: %02X.\n"), zBank, nBankXPos, nBankYPos, nBankYZoom, nBankSize);
+		}
+
+		if (nSpriteEnable != 0xff)
+		{
+			if (nSpriteDisableLut[nBank] < 8)
+			{
+				if ((nSpriteEnable & (1 << nSpriteDisableLut[nBank])) == 0)
+				{
+		//			bprintf (0, _T("Bank Type1 %d [%d] disabled\n"), nBank, nSpriteDisableLut[nBank]);
+					continue;
+				}
+			}
+		}
+
+		if ((nBurnLayer & 0x04) == 0)
+		{
+			if (nSpriteDisableLut[nBank] == 0xff)
+			{
+		//		bprintf (0, _T("Bank Type2 %d [%d] disabled\n"), nBank, nSpriteDisableLut[nBank]);
+				continue;
+			}
+		}
+
+		if (nBankSize) {
+			nBankXZoom = (BankAttrib01 >> 8) & 0x0F;
+			if (nBankXPos >= 0x01E0) {
+				nBankXPos -= 0x200;
+			}
+
+			if (nBankXPos >= 0 && nBankXPos < (nNeoScreenWidth - nBankXZoom - 1)) {
+				RenderBank[nBankXZoom](b);
+			} else {
+				if (nBankXPos >= -nBankXZoom && nBankXPos < nNeoScreenWidth) {
+					RenderBank[nBankXZoom + 16](b);
+				}
+			}
+		}
+	}
+}
+
+static void NeoRenderSpriteBandJob(INT32 nJob, void *pParam)
+{
+	NeoRenderSpriteBand(&SpriteBands[nJob], *((INT32*)pParam));
+}
+
+// Strips taller than 0x20 tiles wrap around on themselves, the way that's drawn
+// depends on where the slice starts, so those can't be cut into bands.
+static INT32 NeoSpriteFullWrap()
+{
+	if (SpriteState.nBankSize > 0x20) return 1;		// carried over into a chain
+
+	UINT16 *SizeAttribute = (UINT16*)(NeoGraphicsRAM + 0x010400);
+
+	for (INT32 nBank = 0; nBank < MAX_SPRITEBANK; nBank++) {
+		if ((~SizeAttribute[nBank] & 0x40) && (SizeAttribute[nBank] & 0x3f) > 0x20) return 1;
+	}
+
+	return 0;
+}
+
 INT32 NeoRenderSprites()
 {
 	if (nLastBPP != nBurnBpp ) {
@@ -98,8 +208,6 @@ INT32 NeoRenderSprites()
 		return 0;
 	}
 
-//	UINT16 BankAttrib01, BankAttrib02, BankAttrib03;
-
 	nNeoSpriteFrame04 = nNeoSpriteFrame & 3;
 	nNeoSpriteFrame08 = nNeoSpriteFrame & 7;
 	
@@ -155,94 +263,88 @@ INT32 NeoRenderSprites()
 		}
 	}
 
-	for (INT32 nBank = 0; nBank < nMaxSpriteBank; nBank++) {
-		INT32 zBank = (nBank + nStart) % MAX_SPRITEBANK;
-		BankAttrib01 = *((UINT16*)(NeoGraphicsRAM + 0x010000 + (zBank << 1)));
-		BankAttrib02 = *((UINT16*)(NeoGraphicsRAM + 0x010400 + (zBank << 1)));
-		BankAttrib03 = *((UINT16*)(NeoGraphicsRAM + 0x010800 + (zBank << 1)));
+	INT32 nLines = nSliceEnd - nSliceStart;
+	INT32 nBands = nLines / SPRITE_BAND_MIN_LINES;
+	if (nBands > BurnPoolGetThreads()) nBands = BurnPoolGetThreads();
+	if (nBands > SPRITE_BAND_MAX) nBands = SPRITE_BAND_MAX;
 
-		pBank = (UINT16*)(NeoGraphicsRAM + (zBank << 7));
+	if (nBands <= 1 || NeoSpriteFullWrap()) {
+		SpriteState.nSliceStart = nSliceStart;
+		SpriteState.nSliceEnd = nSliceEnd;
 
-		if (BankAttrib02 & 0x40) {
-			nBankXPos += nBankXZoom + 1;
-		} else {
-			nBankYPos = (0x0200 - (BankAttrib02 >> 7)) & 0x01FF;
-			nBankXPos = (BankAttrib03 >> 7);
-			if (nNeoScreenWidth == 304) {
-				nBankXPos -= 8;
-			}
+		NeoRenderSpriteBand(&SpriteState, nStart);
 
-			nBankYZoom = BankAttrib01 & 0xFF;
-			nBankSize  = BankAttrib02 & 0x3F;
+		return 0;
+	}
 
-//			if (nBankSize > 0x10 && nSliceStart == 0x10) bprintf(PRINT_NORMAL, _T("bank: %04X, x: %04X, y: %04X, zoom: %02X, size: %02X.\n"), zBank, nBankXPos, nBankYPos, nBankYZoom, nBankSize);
-		}
+	for (INT32 i = 0; i < nBands; i++) {
+		SpriteBands[i] = SpriteState;
+		SpriteBands[i].nSliceStart = nSliceStart + nLines * i / nBands;
+		SpriteBands[i].nSliceEnd = nSliceStart + nLines * (i + 1) / nBands;
+	}
 
-		if (nSpriteEnable != 0xff)
-		{
-			if (nSpriteDisableLut[nBank] < 8)
-			{
-				if ((nSpriteEnable & (1 << nSpriteDisableLut[nBank])) == 0)
-				{
-		//			bprintf (0, _T("Bank Type1 %d [%d] disabled\n"), nBank, nSpriteDisableLut[nBank]);
-					continue;
-				}
-			}
-		}
+	BurnPoolRun(NeoRenderSpriteBandJob, &nStart, nBands);
 
-		if ((nBurnLayer & 0x04) == 0)
-		{
-			if (nSpriteDisableLut[nBank] == 0xff)
-			{
-		//		bprintf (0, _T("Bank Type2 %d [%d] disabled\n"), nBank, nSpriteDisableLut[nBank]);
-				continue;
-			}
-		}
+	SpriteState = SpriteBands[0];				// every band ends the walk in the same state
 
-		if (nBankSize) {
-			nBankXZoom = (BankAttrib01 >> 8) & 0x0F;
-			if (nBankXPos >= 0x01E0) {
-				nBankXPos -= 0x200;
-			}
+	return 0;
+}
 
-			if (nBankXPos >= 0 && nBankXPos < (nNeoScreenWidth - nBankXZoom - 1)) {
-				RenderBank[nBankXZoom]();
-			} else {
-				if (nBankXPos >= -nBankXZoom && nBankXPos < nNeoScreenWidth) {
-					RenderBank[nBankXZoom + 16]();
-				}
-			}
-		}
+// see NeoTileRows, a tile is 16 rows of 8 bytes (16 pixels)
+static UINT16 NeoSpriteRowMask(const UINT8 *pTile)
+{
+	UINT16 nRows = 0;
+
+#if defined BURN_SIMD_SSE2
+	const __m128i zero = _mm_setzero_si128();
+
+	for (INT32 i = 0; i < 8; i++) {
+		// one bit per byte that's 0, two rows at a time
+		INT32 nEmpty = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(pTile + (i << 4))), zero));
+
+		if ((nEmpty & 0x00FF) != 0x00FF) nRows |= 1 << ((i << 1) + 0);
+		if ((nEmpty & 0xFF00) != 0xFF00) nRows |= 1 << ((i << 1) + 1);
 	}
+#else
+	const UINT32 *pRow = (const UINT32*)pTile;
 
-//	bprintf(PRINT_NORMAL, _T("\n"));
+	for (INT32 nRow = 0; nRow < 16; nRow++, pRow += 2) {
+		if (pRow[0] | pRow[1]) nRows |= 1 << nRow;
+	}
+#endif
 
-	return 0;
+	return nRows;
+}
+
+struct sprite_rows_params {
+	const UINT8 *pROM;
+	UINT16 *pRows;
+	UINT8 *pAttrib;
+};
+
+static void NeoSpriteRowsRange(INT32 nStart, INT32 nEnd, void *pParam)
+{
+	sprite_rows_params *p = (sprite_rows_params*)pParam;
+
+	for (INT32 i = nStart; i < nEnd; i++) {
+		p->pRows[i] = NeoSpriteRowMask(p->pROM + (i << 7));
+		p->pAttrib[i] = p->pRows[i] ? 0 : 1;					// 1 = nothing to draw
+	}
 }
 
 void NeoUpdateSprites(INT32 nOffset, INT32 nSize)
 {
 	if (!NeoSpriteROMActive) return;
 
-	for (INT32 i = nOffset & ~127; i < nOffset + nSize; i += 128) {
-		bool bTransparent = true;
-		for (INT32 j = i; j < i + 128; j++) {
-			if (NeoSpriteROMActive[j]) {
-				bTransparent = false;
-				break;
-			}
-		}
-		if (bTransparent) {
-			NeoTileAttribActive[i >> 7] = 1;
-		} else {
-			NeoTileAttribActive[i >> 7] = 0;
-		}
-	}
+	sprite_rows_params p = { NeoSpriteROMActive, NeoTileRowsActive, NeoTileAttribActive };
+
+	NeoSpriteRowsRange(nOffset >> 7, (nOffset + nSize + 127) >> 7, &p);
 }
 
 void NeoSetSpriteSlot(INT32 nSlot)
 {
 	NeoTileAttribActive = NeoTileAttrib[nSlot];
+	NeoTileRowsActive   = NeoTileRows[nSlot];
 	NeoSpriteROMActive  = NeoSpriteROM[nSlot];
 	nNeoTileMaskActive  = nNeoTileMask[nSlot];
 	nNeoMaxTileActive   = nNeoMaxTile[nSlot];
@@ -306,30 +408,23 @@ static void NeoBlendInit(INT32 nSlot)
 
 INT32 NeoInitSprites(INT32 nSlot)
 {
-	// Create a table that indicates if a tile is transparent
+	// Create tables that indicate if a tile is transparent and which of its rows are empty
 	NeoTileAttrib[nSlot] = (UINT8*)BurnMalloc(nNeoTileMask[nSlot] + 1);
+	NeoTileRows[nSlot] = (UINT16*)BurnMalloc((nNeoTileMask[nSlot] + 1) * sizeof(UINT16));
+
+	sprite_rows_params p = { NeoSpriteROM[nSlot], NeoTileRows[nSlot], NeoTileAttrib[nSlot] };
+
+	BurnPoolFor(NeoSpriteRowsRange, &p, 0, nNeoMaxTile[nSlot], 0x1000);
 
-	for (INT32 i = 0; i < nNeoMaxTile[nSlot]; i++) {
-		bool bTransparent = true;
-		for (INT32 j = i << 7; j < (i + 1) << 7; j++) {
-			if (NeoSpriteROM[nSlot][j]) {
-				bTransparent = false;
-				break;
-			}
-		}
-		if (bTransparent) {
-			NeoTileAttrib[nSlot][i] = 1;
-		} else {
-			NeoTileAttrib[nSlot][i] = 0;
-		}
-	}
 	for (UINT32 i = nNeoMaxTile[nSlot]; i < nNeoTileMask[nSlot] + 1; i++) {
 		NeoTileAttrib[nSlot][i] = 1;
+		NeoTileRows[nSlot][i] = 0;
 	}
 
 	if (bBurnUseBlend) NeoBlendInit(nSlot);
 
 	NeoTileAttribActive = NeoTileAttrib[nSlot];
+	NeoTileRowsActive   = NeoTileRows[nSlot];
 	NeoSpriteROMActive  = NeoSpriteROM[nSlot];
 	nNeoTileMaskActive  = nNeoTileMask[nSlot];
 	nNeoMaxTileActive   = nNeoMaxTile[nSlot];
@@ -346,5 +441,7 @@ INT32 NeoInitSprites(INT32 nSlot)
 void NeoExitSprites(INT32 nSlot)
 {
 	BurnFree(NeoTileAttrib[nSlot]);
+	BurnFree(NeoTileRows[nSlot]);
 	NeoTileAttribActive = NULL;
+	NeoTileRowsActive = NULL;
 }
@@ -479,8 +479,19 @@
 
 // #undef USE_SPEEDHACKS
 
-static void FUNCTIONNAME(BPP,XZOOM,CLIP,OPACITY)()
+static void FUNCTIONNAME(BPP,XZOOM,CLIP,OPACITY)(sprite_band *pBand)
 {
+	// the strip being drawn and the lines to draw it on (see NeoRenderSpriteBand())
+	UINT16* pBank = pBand->pBank;
+	INT32 nBankSize = pBand->nBankSize;
+	INT32 nBankXPos = pBand->nBankXPos, nBankYPos = pBand->nBankYPos;
+	INT32 nBankYZoom = pBand->nBankYZoom;
+	INT32 nSliceStart = pBand->nSliceStart, nSliceEnd = pBand->nSliceEnd;
+
+	UINT32* pTileData = NULL;
+	UINT32* pTilePalette = NULL;
+	UINT32 nTileRows = 0;
+
 	UINT8 *pTileRow, *pPixel;
 	INT32 nColour = 0, nTransparent = 0;
 	INT32 nTileNumber, nTileAttrib = 0;
@@ -624,6 +635,7 @@ static void FUNCTIONNAME(BPP,XZOOM,CLIP,OPACITY)()
 					if (nTransparent != 1) {
 						pTileData = (UINT32*)(NeoSpriteROMActive + (nTileNumber << 7));
 						pTilePalette = &NeoPalette[(nTileAttrib & 0xFF00) >> 4];
+						nTileRows = NeoTileRowsActive[nTileNumber];
 					}
 				}
 
@@ -633,12 +645,14 @@ static void FUNCTIONNAME(BPP,XZOOM,CLIP,OPACITY)()
 						nLine ^= 0x1E;
 					}
 
-					if (nTileAttrib & 1) {							// Flip X
-						pPixel = pTileRow + XZOOM * (BPP >> 3);
-						PLOTLINE(MIRROROFFSET,pPixel -= (BPP >> 3));
-					} else {
-						pPixel = pTileRow;
-						PLOTLINE(NORMALOFFSET,pPixel += (BPP >> 3));
+					if (nTileRows & (1 << (nLine >> 1))) {			// nothing to do on empty rows
+						if (nTileAttrib & 1) {						// Flip X
+							pPixel = pTileRow + XZOOM * (BPP >> 3);
+							PLOTLINE(MIRROROFFSET,pPixel -= (BPP >> 3));
+						} else {
+							pPixel = pTileRow;
+							PLOTLINE(NORMALOFFSET,pPixel += (BPP >> 3));
+						}
 					}
 				}
 
@@ -252,8 +252,59 @@ INT32 NeoLoadSprites(INT32 nOffset, INT32 nNum, UINT8* pDest, UINT32 nSpriteSize
 // ----------------------------------------------------------------------------
 // Graphics decoding for MVS/AES
 
+// Tiles are converted in runs of this many bytes, one job per run for the worker pool
+#define NEO_DECODE_RUN		0x40000
+
+struct neo_decode_params {
+	UINT8* pStart;
+	UINT8* pEnd;
+};
+
+static void NeoDecodeSpritesRun(INT32 nJob, void *pParam)
+{
+	neo_decode_params *p = (neo_decode_params*)pParam;
+
+	UINT8* pStart = p->pStart + nJob * NEO_DECODE_RUN;
+	UINT8* pEnd = pStart + NEO_DECODE_RUN;
+	if (pEnd > p->pEnd) pEnd = p->pEnd;
+
+	// Pre-process the sprite graphics
+	for (UINT8* pTile = pStart; pTile < pEnd; pTile += 128) {
+		UINT32 data[32];
+
+		for (INT32 y = 0; y < 16; y++) {
+			UINT32 n = 0;
+			for (INT32 x = 0; x < 8; x++) {
+				UINT32 m = ((pTile[67 + (y << 2)] >> x) & 1) << 3;
+				m |= ((pTile[65 + (y << 2)] >> x) & 1) << 2;
+				m |= ((pTile[66 + (y << 2)] >> x) & 1) << 1;
+				m |= ((pTile[64 + (y << 2)] >> x) & 1) << 0;
+
+				n |= m << (x << 2);
+			}
+			data[(y << 1) + 0] = n;
+
+			n = 0;
+			for (INT32 x = 0; x < 8; x++) {
+				UINT32 m = ((pTile[3 + (y << 2)] >> x) & 1) << 3;
+				m |= ((pTile[1 + (y << 2)] >> x) & 1) << 2;
+				m |= ((pTile[2 + (y << 2)] >> x) & 1) << 1;
+				m |= ((pTile[0 + (y << 2)] >> x) & 1) << 0;
+
+				n |= m << (x << 2);
+			}
+			data[(y << 1) + 1] = n;
+		}
+		for (INT32 n = 0; n < 32; n++) {
+			((UINT32*)pTile)[n] = data[n];
+		}
+	}
+}
+
 void NeoDecodeSprites(UINT8* pDest, INT32 nSize)
 {
+	BURN_PROFILE_PHASE(GFXDECODE);
+
 //	double dProgress = 0.0;
 
 //	if (nSize > 0x04000000) {
@@ -281,37 +332,9 @@ void NeoDecodeSprites(UINT8* pDest, INT32 nSize)
 		}
 		BurnUpdateProgress(1.0 / nStep, i ? NULL : _T("Preprocessing graphics..."), 0);
 
-		// Pre-process the sprite graphics
-		for (UINT8* pTile = pStart; pTile < pEnd; pTile += 128) {
-			UINT32 data[32];
-
-			for (INT32 y = 0; y < 16; y++) {
-				UINT32 n = 0;
-				for (INT32 x = 0; x < 8; x++) {
-					UINT32 m = ((pTile[67 + (y << 2)] >> x) & 1) << 3;
-					m |= ((pTile[65 + (y << 2)] >> x) & 1) << 2;
-					m |= ((pTile[66 + (y << 2)] >> x) & 1) << 1;
-					m |= ((pTile[64 + (y << 2)] >> x) & 1) << 0;
-
-					n |= m << (x << 2);
-				}
-				data[(y << 1) + 0] = n;
-
-				n = 0;
-				for (INT32 x = 0; x < 8; x++) {
-					UINT32 m = ((pTile[3 + (y << 2)] >> x) & 1) << 3;
-					m |= ((pTile[1 + (y << 2)] >> x) & 1) << 2;
-					m |= ((pTile[2 + (y << 2)] >> x) & 1) << 1;
-					m |= ((pTile[0 + (y << 2)] >> x) & 1) << 0;
-
-					n |= m << (x << 2);
-				}
-				data[(y << 1) + 1] = n;
-			}
-			for (INT32 n = 0; n < 32; n++) {
-				((UINT32*)pTile)[n] = data[n];
-			}
-		}
+		// Pre-process the sprite graphics, the tiles are independent so they're spread over the worker pool
+		neo_decode_params p = { pStart, pEnd };
+		BurnPoolRun(NeoDecodeSpritesRun, &p, (INT32)((pEnd - pStart + NEO_DECODE_RUN - 1) / NEO_DECODE_RUN));
 	}
 }
 
@@ -394,6 +417,14 @@ INT32 NeoLoadADPCM(INT32 nOffset, INT32 nNum, UINT8* pDest)
 	return 0;
 }
 
+// Call before changing the ADPCM-A data after NeoInit() (decryption, byteswaps, patches).
+// With -lazyroms the samples may not have been loaded yet, load them now so the change
+// doesn't act on zeroes and later loads don't bring in the unchanged data.
+void NeoADPCMFixup()
+{
+	BurnLazyLoadAll(YM2610ADPCMAROM[nNeoActiveSlot]);
+}
+
 // This function fills the screen with the first palette entry
 void NeoClearScreen()
 {
@@ -53,6 +53,7 @@ void NeoClearScreen();
 INT32 NeoLoadCode(INT32 nOffset, INT32 nNum, UINT8* pDest);
 INT32 NeoLoadSprites(INT32 nOffset, INT32 nNum, UINT8* pDest, UINT32 nSpriteSize);
 INT32 NeoLoadADPCM(INT32 nOffset, INT32 nNum, UINT8* pDest);
+void NeoADPCMFixup();
 
 void NeoDecodeSprites(UINT8* pDest, INT32 nSize);
 void NeoDecodeSpritesCD(UINT8* pData, UINT8* pDest, INT32 nSize);
@@ -3,52 +3,78 @@
 #include "pgm.h"
 #include "bitswap.h"
 
-void pgm_decrypt_dw2()
-{
-	UINT16 *src = (UINT16 *)PGM68KROM;
+// Every word is decrypted on its own, from its address and value, so the rom is
+// shared out over the worker pool
 
-	for (INT32 i = 0; i<nPGM68KROMLen/2; i++) {
-		UINT16 x = BURN_ENDIAN_SWAP_INT16(src[i]);
+struct pgm_decrypt_params {
+	UINT16 *src;
+	UINT16 (*decrypt)(INT32 i, UINT16 x);
+};
 
-		if ((i & 0x020890) == 0x000000)				      			  x ^= 0x0002;
-		if ((i & 0x020000) == 0x020000 && (i & 0x001500) != 0x001400) x ^= 0x0002;
-		if ((i & 0x020400) == 0x000000 && (i & 0x002010) != 0x002010) x ^= 0x0400;
-		if ((i & 0x020000) == 0x020000 && (i & 0x000148) != 0x000140) x ^= 0x0400;
+static void pgm_decrypt_range(INT32 nStart, INT32 nEnd, void *pParam)
+{
+	pgm_decrypt_params *p = (pgm_decrypt_params*)pParam;
 
-		src[i] = BURN_ENDIAN_SWAP_INT16(x);
+	for (INT32 i = nStart; i < nEnd; i++) {
+		p->src[i] = BURN_ENDIAN_SWAP_INT16(p->decrypt(i, BURN_ENDIAN_SWAP_INT16(p->src[i])));
 	}
 }
 
-void pgm_decrypt_dw3()
+static void pgm_decrypt_words(UINT16 *src, INT32 nWords, UINT16 (*decrypt)(INT32 i, UINT16 x))
 {
-	UINT16 *src = (UINT16 *)PGM68KROM;
+	BURN_PROFILE_PHASE(DECRYPT);
 
-	for (INT32 i = 0; i < nPGM68KROMLen/2; i++) {
-		UINT16 x = BURN_ENDIAN_SWAP_INT16(src[i]);
+	pgm_decrypt_params p;
 
-		if ((i & 0x005460) == 0x001400) x ^= 0x0100;
-		if ((i & 0x005450) == 0x001040) x ^= 0x0100;
-		if ((i & 0x005e00) == 0x001c00) x ^= 0x0040;
-		if ((i & 0x005580) == 0x001100) x ^= 0x0040;
+	p.src = src;
+	p.decrypt = decrypt;
 
-		src[i] = BURN_ENDIAN_SWAP_INT16(x);
-	}
+	BurnPoolFor(pgm_decrypt_range, &p, 0, nWords, 0x8000);
 }
 
-void pgm_decrypt_killbld()
+static UINT16 pgm_decrypt_dw2_word(INT32 i, UINT16 x)
 {
-	UINT16 *src = (UINT16 *)PGM68KROM;
+	if ((i & 0x020890) == 0x000000)				      			  x ^= 0x0002;
+	if ((i & 0x020000) == 0x020000 && (i & 0x001500) != 0x001400) x ^= 0x0002;
+	if ((i & 0x020400) == 0x000000 && (i & 0x002010) != 0x002010) x ^= 0x0400;
+	if ((i & 0x020000) == 0x020000 && (i & 0x000148) != 0x000140) x ^= 0x0400;
+
+	return x;
+}
+
+void pgm_decrypt_dw2()
+{
+	pgm_decrypt_words((UINT16 *)PGM68KROM, nPGM68KROMLen/2, pgm_decrypt_dw2_word);
+}
 
-	for (INT32 i = 0; i < nPGM68KROMLen/2; i++) {
-		UINT16 x = BURN_ENDIAN_SWAP_INT16(src[i]);
+static UINT16 pgm_decrypt_dw3_word(INT32 i, UINT16 x)
+{
+	if ((i & 0x005460) == 0x001400) x ^= 0x0100;
+	if ((i & 0x005450) == 0x001040) x ^= 0x0100;
+	if ((i & 0x005e00) == 0x001c00) x ^= 0x0040;
+	if ((i & 0x005580) == 0x001100) x ^= 0x0040;
 
-		if ((i & 0x006d00) == 0x000400) x ^= 0x0008;
-		if ((i & 0x006c80) == 0x000880) x ^= 0x0008;
-		if ((i & 0x007500) == 0x002400) x ^= 0x1000;
-		if ((i & 0x007600) == 0x003200) x ^= 0x1000;
+	return x;
+}
 
-		src[i] = BURN_ENDIAN_SWAP_INT16(x);
-	}
+void pgm_decrypt_dw3()
+{
+	pgm_decrypt_words((UINT16 *)PGM68KROM, nPGM68KROMLen/2, pgm_decrypt_dw3_word);
+}
+
+static UINT16 pgm_decrypt_killbld_word(INT32 i, UINT16 x)
+{
+	if ((i & 0x006d00) == 0x000400) x ^= 0x0008;
+	if ((i & 0x006c80) == 0x000880) x ^= 0x0008;
+	if ((i & 0x007500) == 0x002400) x ^= 0x1000;
+	if ((i & 0x007600) == 0x003200) x ^= 0x1000;
+
+	return x;
+}
+
+void pgm_decrypt_killbld()
+{
+	pgm_decrypt_words((UINT16 *)PGM68KROM, nPGM68KROMLen/2, pgm_decrypt_killbld_word);
 }
 
 // ASIC27A Asic decrypt functions
@@ -77,26 +103,25 @@ static const UINT8 kov_tab[256] = {
 	0x80, 0xe6, 0xba, 0xb3, 0x08, 0xd8, 0x30, 0x5b, 0x5f, 0xf2, 0x5a, 0xfb, 0x63, 0xb0, 0xa4, 0x41
 };
 
-void pgm_decrypt_kov()
+static UINT16 pgm_decrypt_kov_word(INT32 i, UINT16 x)
 {
-	UINT16 *src = (UINT16 *)PGM68KROM;
-
-	for (INT32 i = 0; i < nPGM68KROMLen/2; i++) {
-		UINT16 x = BURN_ENDIAN_SWAP_INT16(src[i]);
-
-		if ((i & 0x040480) != 0x000080) x ^= 0x0001;
-		if ((i & 0x004008) == 0x004008) x ^= 0x0002;
-		if ((i & 0x000030) == 0x000010 && (i & 0x180000) != 0x080000) x ^= 0x0004;
-		if ((i & 0x000242) != 0x000042) x ^= 0x0008;
-		if ((i & 0x008100) == 0x008000) x ^= 0x0010;
-		if ((i & 0x022004) != 0x000004) x ^= 0x0020;
-		if ((i & 0x011800) != 0x010000) x ^= 0x0040;
-		if ((i & 0x004820) == 0x004820) x ^= 0x0080;
-
-		x ^= kov_tab[i & 0xff] << 8;
+	if ((i & 0x040480) != 0x000080) x ^= 0x0001;
+	if ((i & 0x004008) == 0x004008) x ^= 0x0002;
+	if ((i & 0x000030) == 0x000010 && (i & 0x180000) != 0x080000) x ^= 0x0004;
+	if ((i & 0x000242) != 0x000042) x ^= 0x0008;
+	if ((i & 0x008100) == 0x008000) x ^= 0x0010;
+	if ((i & 0x022004) != 0x000004) x ^= 0x0020;
+	if ((i & 0x011800) != 0x010000) x ^= 0x0040;
+	if ((i & 0x004820) == 0x004820) x ^= 0x0080;
+
+	x ^= kov_tab[i & 0xff] << 8;
+
+	return x;
+}
 
-		src[i] = BURN_ENDIAN_SWAP_INT16(x);
-	}
+void pgm_decrypt_kov()
+{
+	pgm_decrypt_words((UINT16 *)PGM68KROM, nPGM68KROMLen/2, pgm_decrypt_kov_word);
 }
 
 static const UINT8 kovsh_tab[256] = {
@@ -118,26 +143,25 @@ static const UINT8 kovsh_tab[256] = {
 	0xa7, 0xb8, 0x85, 0x8a, 0xa1, 0x1e, 0x4f, 0xb6, 0x75, 0x38, 0x65, 0x8a, 0xf9, 0x7c, 0x00, 0xa0
 };
 
-void pgm_decrypt_kovsh()
+static UINT16 pgm_decrypt_kovsh_word(INT32 i, UINT16 x)
 {
-	UINT16 *src = (UINT16 *)PGM68KROM;
-
-	for (INT32 i = 0; i < nPGM68KROMLen/2; i++) {
-		UINT16 x = BURN_ENDIAN_SWAP_INT16(src[i]);
-
-		if ((i & 0x040080) != 0x000080) x ^= 0x0001;
-		if ((i & 0x004008) == 0x004008 && (i & 0x180000) != 0x000000) x ^= 0x0002;
-		if ((i & 0x000030) == 0x000010) x ^= 0x0004;
-		if ((i & 0x000242) != 0x000042) x ^= 0x0008;
-		if ((i & 0x008100) == 0x008000) x ^= 0x0010;
-		if ((i & 0x002004) != 0x000004) x ^= 0x0020;
-		if ((i & 0x011800) != 0x010000) x ^= 0x0040;
-		if ((i & 0x000820) == 0x000820) x ^= 0x0080;
-
-		x ^= kovsh_tab[i & 0xff] << 8;
+	if ((i & 0x040080) != 0x000080) x ^= 0x0001;
+	if ((i & 0x004008) == 0x004008 && (i & 0x180000) != 0x000000) x ^= 0x0002;
+	if ((i & 0x000030) == 0x000010) x ^= 0x0004;
+	if ((i & 0x000242) != 0x000042) x ^= 0x0008;
+	if ((i & 0x008100) == 0x008000) x ^= 0x0010;
+	if ((i & 0x002004) != 0x000004) x ^= 0x0020;
+	if ((i & 0x011800) != 0x010000) x ^= 0x0040;
+	if ((i & 0x000820) == 0x000820) x ^= 0x0080;
+
+	x ^= kovsh_tab[i & 0xff] << 8;
+
+	return x;
+}
 
-		src[i] = BURN_ENDIAN_SWAP_INT16(x);
-	}
+void pgm_decrypt_kovsh()
+{
+	pgm_decrypt_words((UINT16 *)PGM68KROM, nPGM68KROMLen/2, pgm_decrypt_kovsh_word);
 }
 
 static const UINT8 kovshp_tab[256] = {
@@ -159,26 +183,25 @@ static const UINT8 kovshp_tab[256] = {
 	0x42, 0xe2, 0x4f, 0x3c, 0x25, 0x35, 0x93, 0x6c, 0x9b, 0x56, 0xbe, 0xc1, 0x5b, 0x65, 0xde, 0x27
 };
 
-void pgm_decrypt_kovshp()
+static UINT16 pgm_decrypt_kovshp_word(INT32 i, UINT16 x)
 {
-	UINT16 *src = (UINT16 *)PGM68KROM;
-
-	for (INT32 i = 0; i < nPGM68KROMLen/2; i++) {
-		UINT16 x = BURN_ENDIAN_SWAP_INT16(src[i]);
-
-		if ((i & 0x040080) != 0x000080) x ^= 0x0001;
-		if ((i & 0x004008) == 0x004008 && (i & 0x180000) != 0x000000) x ^= 0x0002;
-		if ((i & 0x000030) == 0x000010) x ^= 0x0004;
-		if ((i & 0x000042) != 0x000042) x ^= 0x0008;
-		if ((i & 0x008100) == 0x008000) x ^= 0x0010;
-		if ((i & 0x022004) != 0x000004) x ^= 0x0020;
-		if ((i & 0x011800) != 0x010000) x ^= 0x0040;
-		if ((i & 0x000820) == 0x000820) x ^= 0x0080;
-
-		x ^= kovshp_tab[i & 0xff] << 8;
+	if ((i & 0x040080) != 0x000080) x ^= 0x0001;
+	if ((i & 0x004008) == 0x004008 && (i & 0x180000) != 0x000000) x ^= 0x0002;
+	if ((i & 0x000030) == 0x000010) x ^= 0x0004;
+	if ((i & 0x000042) != 0x000042) x ^= 0x0008;
+	if ((i & 0x008100) == 0x008000) x ^= 0x0010;
+	if ((i & 0x022004) != 0x000004) x ^= 0x0020;
+	if ((i & 0x011800) != 0x010000) x ^= 0x0040;
+	if ((i & 0x000820) == 0x000820) x ^= 0x0080;
+
+	x ^= kovshp_tab[i & 0xff] << 8;
+
+	return x;
+}
 
-		src[i] = BURN_ENDIAN_SWAP_INT16(x);
-	}
+void pgm_decrypt_kovshp()
+{
+	pgm_decrypt_words((UINT16 *)PGM68KROM, nPGM68KROMLen/2, pgm_decrypt_kovshp_word);
 }
 
 static const UINT8 photoy2k_tab[256] = {
@@ -200,26 +223,25 @@ static const UINT8 photoy2k_tab[256] = {
 	0x92, 0x14, 0x23, 0xae, 0x4b, 0x80, 0xae, 0x6a, 0x56, 0x01, 0xac, 0x55, 0xf7, 0x6d, 0x9b, 0x6d
 };
 
-void pgm_decrypt_photoy2k()
+static UINT16 pgm_decrypt_photoy2k_word(INT32 i, UINT16 x)
 {
-	UINT16 *src = (UINT16 *)PGM68KROM;
-
-	for (INT32 i = 0; i < nPGM68KROMLen/2; i++) {
-		UINT16 x = BURN_ENDIAN_SWAP_INT16(src[i]);
-
-		if ((i & 0x40080) != 0x00080) x ^= 0x0001;
-		if ((i & 0x84008) == 0x84008) x ^= 0x0002;
-		if ((i & 0x00030) == 0x00010) x ^= 0x0004;
-		if ((i & 0x00242) != 0x00042) x ^= 0x0008;
-		if ((i & 0x48100) == 0x48000) x ^= 0x0010;
-		if ((i & 0x02004) != 0x00004) x ^= 0x0020;
-		if ((i & 0x01800) != 0x00000) x ^= 0x0040;
-		if ((i & 0x04820) == 0x04820) x ^= 0x0080;
-
-		x ^= photoy2k_tab[i & 0xff] << 8;
+	if ((i & 0x40080) != 0x00080) x ^= 0x0001;
+	if ((i & 0x84008) == 0x84008) x ^= 0x0002;
+	if ((i & 0x00030) == 0x00010) x ^= 0x0004;
+	if ((i & 0x00242) != 0x00042) x ^= 0x0008;
+	if ((i & 0x48100) == 0x48000) x ^= 0x0010;
+	if ((i & 0x02004) != 0x00004) x ^= 0x0020;
+	if ((i & 0x01800) != 0x00000) x ^= 0x0040;
+	if ((i & 0x04820) == 0x04820) x ^= 0x0080;
+
+	x ^= photoy2k_tab[i & 0xff] << 8;
+
+	return x;
+}
 
-		src[i] = BURN_ENDIAN_SWAP_INT16(x);
-	}
+void pgm_decrypt_photoy2k()
+{
+	pgm_decrypt_words((UINT16 *)PGM68KROM, nPGM68KROMLen/2, pgm_decrypt_photoy2k_word);
 }
 
 static const UINT8 puzlstar_tab[256] = {
@@ -241,25 +263,24 @@ static const UINT8 puzlstar_tab[256] = {
 	0x62, 0x51, 0xf6, 0xe3, 0xa6, 0xea, 0x32, 0x86, 0x67, 0xcc, 0x4a, 0x46, 0x4d, 0x37, 0x45, 0xd5
 };
 
-void pgm_decrypt_puzlstar()
+static UINT16 pgm_decrypt_puzlstar_word(INT32 i, UINT16 x)
 {
-	UINT16 *src = (UINT16 *)PGM68KROM;
+	if ((i & 0x40480) != 0x00080) x ^= 0x0001;
+	if ((i & 0x00030) == 0x00010) x ^= 0x0004;
+	if ((i & 0x00242) != 0x00042) x ^= 0x0008;
+	if ((i & 0x08100) == 0x08000) x ^= 0x0010;
+	if ((i & 0x22004) != 0x00004) x ^= 0x0020;
+	if ((i & 0x11800) != 0x10000) x ^= 0x0040;
+	if ((i & 0x04820) == 0x04820) x ^= 0x0080;
 
-	for (INT32 i = 0; i < nPGM68KROMLen/2; i++) {
-		UINT16 x = BURN_ENDIAN_SWAP_INT16(src[i]);
+	x ^= puzlstar_tab[i & 0xff] << 8;
 
-		if ((i & 0x40480) != 0x00080) x ^= 0x0001;
-		if ((i & 0x00030) == 0x00010) x ^= 0x0004;
-		if ((i & 0x00242) != 0x00042) x ^= 0x0008;
-		if ((i & 0x08100) == 0x08000) x ^= 0x0010;
-		if ((i & 0x22004) != 0x00004) x ^= 0x0020;
-		if ((i & 0x11800) != 0x10000) x ^= 0x0040;
-		if ((i & 0x04820) == 0x04820) x ^= 0x0080;
-
-		x ^= puzlstar_tab[i & 0xff] << 8;
+	return x;
+}
 
-		src[i] = BURN_ENDIAN_SWAP_INT16(x);
-	}
+void pgm_decrypt_puzlstar()
+{
+	pgm_decrypt_words((UINT16 *)PGM68KROM, nPGM68KROMLen/2, pgm_decrypt_puzlstar_word);
 }
 
 static const UINT8 puzzli2_tab[256] = {
@@ -281,26 +302,25 @@ static const UINT8 puzzli2_tab[256] = {
 	0x1d, 0x18, 0xa2, 0xb6, 0xb2, 0xa9, 0xac, 0xab, 0xae, 0x91, 0x98, 0x8d, 0x91, 0xbb, 0xb1, 0xc0
 };
 
-void pgm_decrypt_puzzli2()
+static UINT16 pgm_decrypt_puzzli2_word(INT32 i, UINT16 x)
 {
-	UINT16 *src = (UINT16 *)PGM68KROM;
-
-	for (INT32 i = 0; i < nPGM68KROMLen/2; i++) {
-		UINT16 x = BURN_ENDIAN_SWAP_INT16(src[i]);
-
-	    if ((i & 0x040080) != 0x000080) x ^= 0x0001;
-	    if ((i & 0x004008) == 0x004008) x ^= 0x0002;
-	    if ((i & 0x000030) == 0x000010) x ^= 0x0004;
-	    if ((i & 0x000242) != 0x000042) x ^= 0x0008;
-	    if ((i & 0x008100) == 0x008000) x ^= 0x0010;
-	    if ((i & 0x022004) != 0x000004) x ^= 0x0020;
-	    if ((i & 0x011800) != 0x010000) x ^= 0x0040;
-	    if ((i & 0x004820) == 0x004820) x ^= 0x0080;
+    if ((i & 0x040080) != 0x000080) x ^= 0x0001;
+    if ((i & 0x004008) == 0x004008) x ^= 0x0002;
+    if ((i & 0x000030) == 0x000010) x ^= 0x0004;
+    if ((i & 0x000242) != 0x000042) x ^= 0x0008;
+    if ((i & 0x008100) == 0x008000) x ^= 0x0010;
+    if ((i & 0x022004) != 0x000004) x ^= 0x0020;
+    if ((i & 0x011800) != 0x010000) x ^= 0x0040;
+    if ((i & 0x004820) == 0x004820) x ^= 0x0080;
 
     	x ^= puzzli2_tab[i & 0xff] << 8;
 
-		src[i] = BURN_ENDIAN_SWAP_INT16(x);
-	}
+	return x;
+}
+
+void pgm_decrypt_puzzli2()
+{
+	pgm_decrypt_words((UINT16 *)PGM68KROM, nPGM68KROMLen/2, pgm_decrypt_puzzli2_word);
 }
 
 static const UINT8 oldsplus_tab[256] = {
@@ -322,26 +342,25 @@ static const UINT8 oldsplus_tab[256] = {
 	0x55, 0x31, 0x96, 0xea, 0x78, 0x45, 0x3a, 0x33, 0x23, 0xc5, 0xd1, 0x3c, 0xa3, 0x86, 0x88, 0x38
 };
 
-void pgm_decrypt_oldsplus()
+static UINT16 pgm_decrypt_oldsplus_word(INT32 i, UINT16 x)
 {
-	UINT16 *src = (UINT16 *)PGM68KROM;
-
-	for (INT32 i = 0; i < nPGM68KROMLen/2; i++) {
-		UINT16 x = BURN_ENDIAN_SWAP_INT16(src[i]);
-
-		if ((i & 0x040480) != 0x000080) x ^= 0x0001;
-		if ((i & 0x004008) == 0x004008) x ^= 0x0002;
-		if ((i & 0x000030) == 0x000010) x ^= 0x0004;
-		if ((i & 0x000242) != 0x000042) x ^= 0x0008;
-		if ((i & 0x048100) == 0x048000) x ^= 0x0010;
-		if ((i & 0x002004) != 0x000004) x ^= 0x0020;
-		if ((i & 0x011800) != 0x010000) x ^= 0x0040;
-		if ((i & 0x000820) == 0x000820) x ^= 0x0080;
-
-		x ^= oldsplus_tab[i & 0xff] << 8;
+	if ((i & 0x040480) != 0x000080) x ^= 0x0001;
+	if ((i & 0x004008) == 0x004008) x ^= 0x0002;
+	if ((i & 0x000030) == 0x000010) x ^= 0x0004;
+	if ((i & 0x000242) != 0x000042) x ^= 0x0008;
+	if ((i & 0x048100) == 0x048000) x ^= 0x0010;
+	if ((i & 0x002004) != 0x000004) x ^= 0x0020;
+	if ((i & 0x011800) != 0x010000) x ^= 0x0040;
+	if ((i & 0x000820) == 0x000820) x ^= 0x0080;
+
+	x ^= oldsplus_tab[i & 0xff] << 8;
+
+	return x;
+}
 
-		src[i] = BURN_ENDIAN_SWAP_INT16(x);
-	}
+void pgm_decrypt_oldsplus()
+{
+	pgm_decrypt_words((UINT16 *)PGM68KROM, nPGM68KROMLen/2, pgm_decrypt_oldsplus_word);
 }
 
 static const UINT8 py2k2_tab[256] = {
@@ -363,26 +382,25 @@ static const UINT8 py2k2_tab[256] = {
 	0x19, 0xc6, 0x75, 0xe8, 0x6c, 0x54, 0x7e, 0x63, 0xdd, 0xae, 0x07, 0x5a, 0xb7, 0x00, 0xb5, 0x5e
 };
 
-void pgm_decrypt_py2k2() // and ddp3
+static UINT16 pgm_decrypt_py2k2_word(INT32 i, UINT16 x)
 {
-	UINT16 *src = (UINT16 *)PGM68KROM;
-
-	for (INT32 i = 0; i < nPGM68KROMLen/2; i++) {
-		UINT16 x = BURN_ENDIAN_SWAP_INT16(src[i]);
-
-		if ((i & 0x040480) != 0x000080) x ^= 0x0001;
-		if ((i & 0x084008) == 0x084008) x ^= 0x0002;
-		if ((i & 0x000030) == 0x000010 && (i & 0x180000) != 0x080000) x ^= 0x0004;
-		if ((i & 0x000042) != 0x000042) x ^= 0x0008;
-		if ((i & 0x008100) == 0x008000) x ^= 0x0010;
-		if ((i & 0x022004) != 0x000004) x ^= 0x0020;
-		if ((i & 0x011800) != 0x010000) x ^= 0x0040;
-		if ((i & 0x004820) == 0x004820) x ^= 0x0080;
-
-		x ^= py2k2_tab[i & 0xff] << 8;
+	if ((i & 0x040480) != 0x000080) x ^= 0x0001;
+	if ((i & 0x084008) == 0x084008) x ^= 0x0002;
+	if ((i & 0x000030) == 0x000010 && (i & 0x180000) != 0x080000) x ^= 0x0004;
+	if ((i & 0x000042) != 0x000042) x ^= 0x0008;
+	if ((i & 0x008100) == 0x008000) x ^= 0x0010;
+	if ((i & 0x022004) != 0x000004) x ^= 0x0020;
+	if ((i & 0x011800) != 0x010000) x ^= 0x0040;
+	if ((i & 0x004820) == 0x004820) x ^= 0x0080;
+
+	x ^= py2k2_tab[i & 0xff] << 8;
+
+	return x;
+}
 
-		src[i] = BURN_ENDIAN_SWAP_INT16(x);
-	}
+void pgm_decrypt_py2k2() // and ddp3
+{
+	pgm_decrypt_words((UINT16 *)PGM68KROM, nPGM68KROMLen/2, pgm_decrypt_py2k2_word);
 }
 
 static const UINT8 ketsui_tab[256] = {
@@ -404,26 +422,25 @@ static const UINT8 ketsui_tab[256] = {
 	0x55, 0x5a, 0xa1, 0xd7, 0x73, 0x2b, 0x76, 0xe9, 0x5b, 0xe4, 0x0c, 0x2e, 0x60, 0xcb, 0x4b, 0x72
 };
 
-void pgm_decrypt_ketsui()
+static UINT16 pgm_decrypt_ketsui_word(INT32 i, UINT16 x)
 {
-	UINT16 *src = (UINT16 *)PGM68KROM;
-
-	for (INT32 i = 0; i < nPGM68KROMLen/2; i++) {
-		UINT16 x = BURN_ENDIAN_SWAP_INT16(src[i]);
-
-		if ((i & 0x040480) != 0x000080) x ^= 0x0001;
-		if ((i & 0x004008) == 0x004008) x ^= 0x0002;
-		if ((i & 0x080030) == 0x000010) x ^= 0x0004; // address starts at 0 and not 100000/2!
-		if ((i & 0x000042) != 0x000042) x ^= 0x0008;
-		if ((i & 0x008100) == 0x008000) x ^= 0x0010;
-		if ((i & 0x002004) != 0x000004) x ^= 0x0020;
-		if ((i & 0x011800) != 0x010000) x ^= 0x0040;
-		if ((i & 0x000820) == 0x000820) x ^= 0x0080;
-
-		x ^= ketsui_tab[i & 0xff] << 8;
+	if ((i & 0x040480) != 0x000080) x ^= 0x0001;
+	if ((i & 0x004008) == 0x004008) x ^= 0x0002;
+	if ((i & 0x080030) == 0x000010) x ^= 0x0004; // address starts at 0 and not 100000/2!
+	if ((i & 0x000042) != 0x000042) x ^= 0x0008;
+	if ((i & 0x008100) == 0x008000) x ^= 0x0010;
+	if ((i & 0x002004) != 0x000004) x ^= 0x0020;
+	if ((i & 0x011800) != 0x010000) x ^= 0x0040;
+	if ((i & 0x000820) == 0x000820) x ^= 0x0080;
+
+	x ^= ketsui_tab[i & 0xff] << 8;
+
+	return x;
+}
 
-		src[i] = BURN_ENDIAN_SWAP_INT16(x);
-	}
+void pgm_decrypt_ketsui()
+{
+	pgm_decrypt_words((UINT16 *)PGM68KROM, nPGM68KROMLen/2, pgm_decrypt_ketsui_word);
 }
 
 static const UINT8 espgal_tab[256] = {
@@ -445,48 +462,46 @@ static const UINT8 espgal_tab[256] = {
         0xdc, 0x43, 0xcc, 0xc3, 0xc5, 0x25, 0xab, 0x45, 0x6e, 0x63, 0x7e, 0x45, 0x40, 0x63, 0x67, 0xd2
 };
 
-void pgm_decrypt_espgaluda()
+static UINT16 pgm_decrypt_espgaluda_word(INT32 i, UINT16 x)
 {
-	UINT16 *src = (UINT16 *)PGM68KROM;
-
-	for (INT32 i = 0; i < nPGM68KROMLen/2; i++) {
-		UINT16 x = BURN_ENDIAN_SWAP_INT16(src[i]);
-
-		if ((i & 0x040480) != 0x000080) x ^= 0x0001;
-		if ((i & 0x084008) == 0x084008) x ^= 0x0002;
-		if ((i & 0x000030) == 0x000010) x ^= 0x0004;
-		if ((i & 0x000042) != 0x000042) x ^= 0x0008;
-		if ((i & 0x048100) == 0x048000) x ^= 0x0010;
-		if ((i & 0x022004) != 0x000004) x ^= 0x0020;
-		if ((i & 0x011800) != 0x010000) x ^= 0x0040;
-		if ((i & 0x000820) == 0x000820) x ^= 0x0080;
+	if ((i & 0x040480) != 0x000080) x ^= 0x0001;
+	if ((i & 0x084008) == 0x084008) x ^= 0x0002;
+	if ((i & 0x000030) == 0x000010) x ^= 0x0004;
+	if ((i & 0x000042) != 0x000042) x ^= 0x0008;
+	if ((i & 0x048100) == 0x048000) x ^= 0x0010;
+	if ((i & 0x022004) != 0x000004) x ^= 0x0020;
+	if ((i & 0x011800) != 0x010000) x ^= 0x0040;
+	if ((i & 0x000820) == 0x000820) x ^= 0x0080;
+
+	x ^= espgal_tab[i & 0xff] << 8;
+
+	return x;
+}
 
-		x ^= espgal_tab[i & 0xff] << 8;
+void pgm_decrypt_espgaluda()
+{
+	pgm_decrypt_words((UINT16 *)PGM68KROM, nPGM68KROMLen/2, pgm_decrypt_espgaluda_word);
+}
 
-		src[i] = BURN_ENDIAN_SWAP_INT16(x);
-	}
+static UINT16 pgm_decrypt_svg_word(INT32 i, UINT16 x)
+{
+	if ((i & 0x040080) != 0x000080) x ^= 0x0001;
+	if ((i & 0x004008) == 0x004008) x ^= 0x0002;
+	if ((i & 0x080030) == 0x080010) x ^= 0x0004;
+	if ((i & 0x000042) != 0x000042) x ^= 0x0008;
+	if ((i & 0x048100) == 0x048000) x ^= 0x0010;
+	if ((i & 0x002004) != 0x000004) x ^= 0x0020;
+	if ((i & 0x011800) != 0x010000) x ^= 0x0040;
+	if ((i & 0x000820) == 0x000820) x ^= 0x0080;
+
+//	no xor table!
+
+	return x;
 }
 
 void pgm_decrypt_svg()
 {
-	UINT16 *src = (UINT16 *)PGMUSER0;
-
-	for (INT32 i = 0; i < nPGMExternalARMLen/2; i++) {
-		UINT16 x = BURN_ENDIAN_SWAP_INT16(src[i]);
-
-		if ((i & 0x040080) != 0x000080) x ^= 0x0001;
-		if ((i & 0x004008) == 0x004008) x ^= 0x0002;
-		if ((i & 0x080030) == 0x080010) x ^= 0x0004;
-		if ((i & 0x000042) != 0x000042) x ^= 0x0008;
-		if ((i & 0x048100) == 0x048000) x ^= 0x0010;
-		if ((i & 0x002004) != 0x000004) x ^= 0x0020;
-		if ((i & 0x011800) != 0x010000) x ^= 0x0040;
-		if ((i & 0x000820) == 0x000820) x ^= 0x0080;
-
-	//	no xor table!
-
-		src[i] = BURN_ENDIAN_SWAP_INT16(x);
-	}
+	pgm_decrypt_words((UINT16 *)PGMUSER0, nPGMExternalARMLen/2, pgm_decrypt_svg_word);
 }
 
 static const UINT8 svgpcb_tab[0x100] = {
@@ -508,26 +523,25 @@ static const UINT8 svgpcb_tab[0x100] = {
        0xD4, 0xFB, 0xA6, 0x65, 0x92, 0xD1, 0x0A, 0xFA, 0xC1, 0x63, 0x90, 0xE1, 0xD5, 0x07, 0x6D, 0x62
 };
 
-void pgm_decrypt_svgpcb()
+static UINT16 pgm_decrypt_svgpcb_word(INT32 i, UINT16 x)
 {
-	UINT16 *src = (UINT16 *)PGMUSER0;
-
-	for (INT32 i = 0; i < nPGMExternalARMLen/2; i++) {
-		UINT16 x = BURN_ENDIAN_SWAP_INT16(src[i]);
-
-		if ((i & 0x040080) != 0x000080) x ^= 0x0001;
-		if ((i & 0x104008) == 0x104008) x ^= 0x0002;
-		if ((i & 0x080030) == 0x080010) x ^= 0x0004;
-		if ((i & 0x000242) != 0x000042) x ^= 0x0008;
-		if ((i & 0x008100) == 0x008000) x ^= 0x0010;
-		if ((i & 0x022004) != 0x000004) x ^= 0x0020;
-		if ((i & 0x011800) != 0x010000) x ^= 0x0040;
-		if ((i & 0x000820) == 0x000820) x ^= 0x0080;
-
-		x ^= svgpcb_tab[(i >> 1) & 0xff] << 8;
+	if ((i & 0x040080) != 0x000080) x ^= 0x0001;
+	if ((i & 0x104008) == 0x104008) x ^= 0x0002;
+	if ((i & 0x080030) == 0x080010) x ^= 0x0004;
+	if ((i & 0x000242) != 0x000042) x ^= 0x0008;
+	if ((i & 0x008100) == 0x008000) x ^= 0x0010;
+	if ((i & 0x022004) != 0x000004) x ^= 0x0020;
+	if ((i & 0x011800) != 0x010000) x ^= 0x0040;
+	if ((i & 0x000820) == 0x000820) x ^= 0x0080;
+
+	x ^= svgpcb_tab[(i >> 1) & 0xff] << 8;
+
+	return x;
+}
 
-		src[i] = BURN_ENDIAN_SWAP_INT16(x);
-	}
+void pgm_decrypt_svgpcb()
+{
+	pgm_decrypt_words((UINT16 *)PGMUSER0, nPGMExternalARMLen/2, pgm_decrypt_svgpcb_word);
 }
 
 static UINT8 dfront_tab[256] = {
@@ -549,26 +563,25 @@ static UINT8 dfront_tab[256] = {
 	0x08, 0x75, 0xa1, 0x33, 0xab, 0xd2, 0xda, 0x81, 0xbf, 0x7a, 0x3b, 0x3f, 0x4a, 0xfd, 0x25, 0x36
 };
 
-void pgm_decrypt_dfront()
+static UINT16 pgm_decrypt_dfront_word(INT32 i, UINT16 x)
 {
-	UINT16 *src = (UINT16 *)PGMUSER0;
-
-	for (INT32 i = 0; i < nPGMExternalARMLen/2; i++) {
-	    UINT16 x = BURN_ENDIAN_SWAP_INT16(src[i]);
-
-		if ((i & 0x040080) != 0x000080) x ^= 0x0001;
-		if ((i & 0x104008) == 0x104008) x ^= 0x0002;
-		if ((i & 0x080030) == 0x080010) x ^= 0x0004;
-		if ((i & 0x000042) != 0x000042) x ^= 0x0008;
-		if ((i & 0x008100) == 0x008000) x ^= 0x0010;
-		if ((i & 0x002004) != 0x000004) x ^= 0x0020;
-		if ((i & 0x011800) != 0x010000) x ^= 0x0040;
-		if ((i & 0x004820) == 0x004820) x ^= 0x0080;
-
-		x ^= dfront_tab[(i >> 1) & 0xff] << 8;
+	if ((i & 0x040080) != 0x000080) x ^= 0x0001;
+	if ((i & 0x104008) == 0x104008) x ^= 0x0002;
+	if ((i & 0x080030) == 0x080010) x ^= 0x0004;
+	if ((i & 0x000042) != 0x000042) x ^= 0x0008;
+	if ((i & 0x008100) == 0x008000) x ^= 0x0010;
+	if ((i & 0x002004) != 0x000004) x ^= 0x0020;
+	if ((i & 0x011800) != 0x010000) x ^= 0x0040;
+	if ((i & 0x004820) == 0x004820) x ^= 0x0080;
+
+	x ^= dfront_tab[(i >> 1) & 0xff] << 8;
+
+	return x;
+}
 
-		src[i] = BURN_ENDIAN_SWAP_INT16(x);
-	}
+void pgm_decrypt_dfront()
+{
+	pgm_decrypt_words((UINT16 *)PGMUSER0, nPGMExternalARMLen/2, pgm_decrypt_dfront_word);
 }
 
 static UINT8 ddp2_tab[256] = {
@@ -590,24 +603,23 @@ static UINT8 ddp2_tab[256] = {
 	0xdc, 0xca, 0xd4, 0xda, 0xcd, 0xd2, 0x83, 0xca, 0xeb, 0x4f, 0xf2, 0x2f, 0x2d, 0x2a, 0xec, 0x1f
 };
 
-void pgm_decrypt_ddp2()
+static UINT16 pgm_decrypt_ddp2_word(INT32 i, UINT16 x)
 {
-	UINT16 *src = (UINT16 *)PGMUSER0;
+	if ((i & 0x0480) != 0x0080) x ^= 0x0001;
+	if ((i & 0x0042) != 0x0042) x ^= 0x0008;
+	if ((i & 0x8100) == 0x8000) x ^= 0x0010;
+	if ((i & 0x2004) != 0x0004) x ^= 0x0020;
+	if ((i & 0x1800) != 0x0000) x ^= 0x0040;
+	if ((i & 0x0820) == 0x0820) x ^= 0x0080;
 
-	for (INT32 i = 0; i < nPGMExternalARMLen/2; i++) {
-    	UINT16 x = BURN_ENDIAN_SWAP_INT16(src[i]);
+	x ^= ddp2_tab[(i >> 1) & 0xff] << 8;
 
-		if ((i & 0x0480) != 0x0080) x ^= 0x0001;
-		if ((i & 0x0042) != 0x0042) x ^= 0x0008;
-		if ((i & 0x8100) == 0x8000) x ^= 0x0010;
-		if ((i & 0x2004) != 0x0004) x ^= 0x0020;
-		if ((i & 0x1800) != 0x0000) x ^= 0x0040;
-		if ((i & 0x0820) == 0x0820) x ^= 0x0080;
-
-		x ^= ddp2_tab[(i >> 1) & 0xff] << 8;
+	return x;
+}
 
-		src[i] = BURN_ENDIAN_SWAP_INT16(x);
-	}
+void pgm_decrypt_ddp2()
+{
+	pgm_decrypt_words((UINT16 *)PGMUSER0, nPGMExternalARMLen/2, pgm_decrypt_ddp2_word);
 }
 
 static UINT8 mm_tab[256] = {
@@ -629,49 +641,47 @@ static UINT8 mm_tab[256] = {
 	0x7c, 0x01, 0x43, 0xdb, 0x53, 0x85, 0xfe, 0x78, 0x91, 0x40, 0xa3, 0xdf, 0x4f, 0xff, 0x10, 0x6c
 };
 
-void pgm_decrypt_martmast() // and dw2001
+static UINT16 pgm_decrypt_martmast_word(INT32 i, UINT16 x)
 {
-	UINT16 *src = (UINT16 *)PGMUSER0;
-
-	for (INT32 i = 0; i < nPGMExternalARMLen/2; i++) {
-    	UINT16 x = BURN_ENDIAN_SWAP_INT16(src[i]);
-
-		if ((i & 0x040480) != 0x000080) x ^= 0x0001;
-		if ((i & 0x004008) == 0x004008) x ^= 0x0002;
-		if ((i & 0x000030) == 0x000010) x ^= 0x0004;
-		if ((i & 0x000242) != 0x000042) x ^= 0x0008;
-		if ((i & 0x008100) == 0x008000) x ^= 0x0010;
-		if ((i & 0x022004) != 0x000004) x ^= 0x0020;
-		if ((i & 0x011800) != 0x010000) x ^= 0x0040;
-		if ((i & 0x000820) == 0x000820) x ^= 0x0080;
-
-		x ^= mm_tab[(i >> 1) & 0xff] << 8;
+	if ((i & 0x040480) != 0x000080) x ^= 0x0001;
+	if ((i & 0x004008) == 0x004008) x ^= 0x0002;
+	if ((i & 0x000030) == 0x000010) x ^= 0x0004;
+	if ((i & 0x000242) != 0x000042) x ^= 0x0008;
+	if ((i & 0x008100) == 0x008000) x ^= 0x0010;
+	if ((i & 0x022004) != 0x000004) x ^= 0x0020;
+	if ((i & 0x011800) != 0x010000) x ^= 0x0040;
+	if ((i & 0x000820) == 0x000820) x ^= 0x0080;
+
+	x ^= mm_tab[(i >> 1) & 0xff] << 8;
+
+	return x;
+}
 
-		src[i] = BURN_ENDIAN_SWAP_INT16(x);
-	}
+void pgm_decrypt_martmast() // and dw2001
+{
+	pgm_decrypt_words((UINT16 *)PGMUSER0, nPGMExternalARMLen/2, pgm_decrypt_martmast_word);
 }
 
 // conditional xors are all 'flipped' version of martmast/dw2001 conditionals
-void pgm_decrypt_dwpc()
+static UINT16 pgm_decrypt_dwpc_word(INT32 i, UINT16 x)
 {
-	UINT16 *src = (UINT16 *)PGMUSER0;
-
-	for (INT32 i = 0; i < nPGMExternalARMLen/2; i++) {
-    	UINT16 x = BURN_ENDIAN_SWAP_INT16(src[i]);
-
-		if ((i & 0x040080) != 0x000080) x ^= 0x0001;
-		if ((i & 0x104008) == 0x104008) x ^= 0x0002;
-		if ((i & 0x080030) == 0x080010) x ^= 0x0004;
-		if ((i & 0x000042) != 0x000042) x ^= 0x0008;
-		if ((i & 0x048100) == 0x048000) x ^= 0x0010;
-		if ((i & 0x002004) != 0x000004) x ^= 0x0020;
-	    if ((i & 0x001800) != 0x000000) x ^= 0x0040;
-		if ((i & 0x004820) == 0x004820) x ^= 0x0080;
-
-		x ^= mm_tab[(i >> 1) & 0xff] << 8;
+	if ((i & 0x040080) != 0x000080) x ^= 0x0001;
+	if ((i & 0x104008) == 0x104008) x ^= 0x0002;
+	if ((i & 0x080030) == 0x080010) x ^= 0x0004;
+	if ((i & 0x000042) != 0x000042) x ^= 0x0008;
+	if ((i & 0x048100) == 0x048000) x ^= 0x0010;
+	if ((i & 0x002004) != 0x000004) x ^= 0x0020;
+    if ((i & 0x001800) != 0x000000) x ^= 0x0040;
+	if ((i & 0x004820) == 0x004820) x ^= 0x0080;
+
+	x ^= mm_tab[(i >> 1) & 0xff] << 8;
+
+	return x;
+}
 
-		src[i] = BURN_ENDIAN_SWAP_INT16(x);
-	}
+void pgm_decrypt_dwpc()
+{
+	pgm_decrypt_words((UINT16 *)PGMUSER0, nPGMExternalARMLen/2, pgm_decrypt_dwpc_word);
 }
 
 static const UINT8 kov2_tab[256] = {
@@ -693,25 +703,24 @@ static const UINT8 kov2_tab[256] = {
 	0x9c, 0xc8, 0xd4, 0xda, 0xcd, 0xd2, 0x83, 0xca, 0xeb, 0x4f, 0xf2, 0x0f, 0x0d, 0x2a, 0xec, 0x1f
 };
 
-void pgm_decrypt_kov2()
+static UINT16 pgm_decrypt_kov2_word(INT32 i, UINT16 x)
 {
-	UINT16 *src = (UINT16 *)PGMUSER0;
-
-	for (INT32 i = 0; i < nPGMExternalARMLen/2; i++) {
-    	UINT16 x = BURN_ENDIAN_SWAP_INT16(src[i]);
+    if ((i & 0x40080) != 0x00080) x ^= 0x0001;
+    if ((i & 0x80030) == 0x80010) x ^= 0x0004;
+    if ((i & 0x00042) != 0x00042) x ^= 0x0008;
+    if ((i & 0x48100) == 0x48000) x ^= 0x0010;
+    if ((i & 0x22004) != 0x00004) x ^= 0x0020;
+    if ((i & 0x01800) != 0x00000) x ^= 0x0040;
+    if ((i & 0x00820) == 0x00820) x ^= 0x0080;
 
-	    if ((i & 0x40080) != 0x00080) x ^= 0x0001;
-	    if ((i & 0x80030) == 0x80010) x ^= 0x0004;
-	    if ((i & 0x00042) != 0x00042) x ^= 0x0008;
-	    if ((i & 0x48100) == 0x48000) x ^= 0x0010;
-	    if ((i & 0x22004) != 0x00004) x ^= 0x0020;
-	    if ((i & 0x01800) != 0x00000) x ^= 0x0040;
-	    if ((i & 0x00820) == 0x00820) x ^= 0x0080;
+    x ^= kov2_tab[(i >> 1) & 0xff] << 8;
 
-	    x ^= kov2_tab[(i >> 1) & 0xff] << 8;
+	return x;
+}
 
-	    src[i] = BURN_ENDIAN_SWAP_INT16(x);
-	}
+void pgm_decrypt_kov2()
+{
+	pgm_decrypt_words((UINT16 *)PGMUSER0, nPGMExternalARMLen/2, pgm_decrypt_kov2_word);
 }
 
 static const UINT8 kov2p_tab[256] = {
@@ -733,26 +742,25 @@ static const UINT8 kov2p_tab[256] = {
 	0x46, 0xdb, 0x30, 0x26, 0xd0, 0xdf, 0x7a, 0x86, 0x3e, 0x2e, 0x04, 0xbf, 0x49, 0x2a, 0xf9, 0x66
 };
 
-void pgm_decrypt_kov2p()
+static UINT16 pgm_decrypt_kov2p_word(INT32 i, UINT16 x)
 {
-	UINT16 *src = (UINT16*)PGMUSER0;
-
-	for (INT32 i = 0; i < nPGMExternalARMLen/2; i++) {
-		UINT16 x = BURN_ENDIAN_SWAP_INT16(src[i]);
-
-    	if ((i & 0x040080) != 0x000080) x ^= 0x0001;
-		if ((i & 0x004008) == 0x004008) x ^= 0x0002;
-		if ((i & 0x080030) == 0x080010) x ^= 0x0004;
-		if ((i & 0x000242) != 0x000042) x ^= 0x0008;
-		if ((i & 0x008100) == 0x008000) x ^= 0x0010;
-    	if ((i & 0x002004) != 0x000004) x ^= 0x0020;
-		if ((i & 0x011800) != 0x010000) x ^= 0x0040;
-		if ((i & 0x000820) == 0x000820) x ^= 0x0080;
-
-		x ^= kov2p_tab[(i >> 1) & 0xff] << 8;
+	if ((i & 0x040080) != 0x000080) x ^= 0x0001;
+	if ((i & 0x004008) == 0x004008) x ^= 0x0002;
+	if ((i & 0x080030) == 0x080010) x ^= 0x0004;
+	if ((i & 0x000242) != 0x000042) x ^= 0x0008;
+	if ((i & 0x008100) == 0x008000) x ^= 0x0010;
+	if ((i & 0x002004) != 0x000004) x ^= 0x0020;
+	if ((i & 0x011800) != 0x010000) x ^= 0x0040;
+	if ((i & 0x000820) == 0x000820) x ^= 0x0080;
+
+	x ^= kov2p_tab[(i >> 1) & 0xff] << 8;
+
+	return x;
+}
 
-		src[i] = BURN_ENDIAN_SWAP_INT16(x);
-	}
+void pgm_decrypt_kov2p()
+{
+	pgm_decrypt_words((UINT16 *)PGMUSER0, nPGMExternalARMLen/2, pgm_decrypt_kov2p_word);
 }
 
 static const UINT8 theglad_tab[256] = {
@@ -774,26 +782,25 @@ static const UINT8 theglad_tab[256] = {
 	0x19, 0x4c, 0xb0, 0x45, 0xde, 0x48, 0x55, 0xae, 0x82, 0xab, 0xbc, 0xab, 0x0c, 0x5e, 0xce, 0x07
 };
 
-void pgm_decrypt_theglad()
+static UINT16 pgm_decrypt_theglad_word(INT32 i, UINT16 x)
 {
-	UINT16 *src = (UINT16*)PGMUSER0;
-
-	for (INT32 i = 0; i < nPGMExternalARMLen/2; i++) {
-		UINT16 x = BURN_ENDIAN_SWAP_INT16(src[i]);
-
-		if ((i & 0x040080) != 0x000080) x ^= 0x0001;
-		if ((i & 0x104008) == 0x104008) x ^= 0x0002;
-		if ((i & 0x080030) == 0x080010) x ^= 0x0004;
-		if ((i & 0x000042) != 0x000042) x ^= 0x0008;
-		if ((i & 0x008100) == 0x008000) x ^= 0x0010;
-		if ((i & 0x022004) != 0x000004) x ^= 0x0020;
-		if ((i & 0x011800) != 0x010000) x ^= 0x0040;
-		if ((i & 0x000820) == 0x000820) x ^= 0x0080;
-
-		x ^= theglad_tab[(i >> 1) & 0xff] << 8;
+	if ((i & 0x040080) != 0x000080) x ^= 0x0001;
+	if ((i & 0x104008) == 0x104008) x ^= 0x0002;
+	if ((i & 0x080030) == 0x080010) x ^= 0x0004;
+	if ((i & 0x000042) != 0x000042) x ^= 0x0008;
+	if ((i & 0x008100) == 0x008000) x ^= 0x0010;
+	if ((i & 0x022004) != 0x000004) x ^= 0x0020;
+	if ((i & 0x011800) != 0x010000) x ^= 0x0040;
+	if ((i & 0x000820) == 0x000820) x ^= 0x0080;
+
+	x ^= theglad_tab[(i >> 1) & 0xff] << 8;
+
+	return x;
+}
 
-		src[i] = BURN_ENDIAN_SWAP_INT16(x);
-	}
+void pgm_decrypt_theglad()
+{
+	pgm_decrypt_words((UINT16 *)PGMUSER0, nPGMExternalARMLen/2, pgm_decrypt_theglad_word);
 }
 
 static const UINT8 killbldp_tab[] = {
@@ -815,26 +822,25 @@ static const UINT8 killbldp_tab[] = {
 	0xf0, 0xf3, 0x4a, 0x9f, 0x54, 0xb4, 0xb1, 0xcc, 0xd4, 0xff, 0xd6, 0xff, 0xc9, 0xee, 0x86, 0x39
 };
 
-void pgm_decrypt_killbldp()
+static UINT16 pgm_decrypt_killbldp_word(INT32 i, UINT16 x)
 {
-	UINT16 *src = (UINT16*)PGMUSER0;
-
-	for (INT32 i = 0; i< nPGMExternalARMLen/2; i++) {
-		UINT16 x = BURN_ENDIAN_SWAP_INT16(src[i]);
-
-		if ((i & 0x040480) != 0x000080) x ^= 0x0001;
-		if ((i & 0x104008) == 0x104008) x ^= 0x0002;
-		if ((i & 0x080030) == 0x080010) x ^= 0x0004;
-		if ((i & 0x000242) != 0x000042) x ^= 0x0008;
-		if ((i & 0x008100) == 0x008000) x ^= 0x0010;
-		if ((i & 0x002004) != 0x000004) x ^= 0x0020;
-		if ((i & 0x011800) != 0x010000) x ^= 0x0040;
-		if ((i & 0x000820) == 0x000820) x ^= 0x0080;
-
-		x ^= killbldp_tab[(i >> 1) & 0xff] << 8;
+	if ((i & 0x040480) != 0x000080) x ^= 0x0001;
+	if ((i & 0x104008) == 0x104008) x ^= 0x0002;
+	if ((i & 0x080030) == 0x080010) x ^= 0x0004;
+	if ((i & 0x000242) != 0x000042) x ^= 0x0008;
+	if ((i & 0x008100) == 0x008000) x ^= 0x0010;
+	if ((i & 0x002004) != 0x000004) x ^= 0x0020;
+	if ((i & 0x011800) != 0x010000) x ^= 0x0040;
+	if ((i & 0x000820) == 0x000820) x ^= 0x0080;
+
+	x ^= killbldp_tab[(i >> 1) & 0xff] << 8;
+
+	return x;
+}
 
-		src[i] = BURN_ENDIAN_SWAP_INT16(x);
-	}
+void pgm_decrypt_killbldp()
+{
+	pgm_decrypt_words((UINT16 *)PGMUSER0, nPGMExternalARMLen/2, pgm_decrypt_killbldp_word);
 }
 
 static const UINT8 happy6in1_tab[256] = {
@@ -856,26 +862,25 @@ static const UINT8 happy6in1_tab[256] = {
 	0x9f, 0xba, 0xa6, 0xd3, 0xb0, 0x5b, 0x3d, 0xdd, 0x22, 0x1f, 0x1b, 0x0e, 0x7f, 0x5a, 0xf4, 0x6a
 };
 
-void pgm_decrypt_happy6()
+static UINT16 pgm_decrypt_happy6_word(INT32 i, UINT16 x)
 {
-	UINT16 *src = (UINT16*)PGMUSER0;
-
-	for (INT32 i = 0; i < nPGMExternalARMLen/2; i++) {
-		UINT16 x = BURN_ENDIAN_SWAP_INT16(src[i]);
-
-		if ((i & 0x040480) != 0x000080) x ^= 0x0001;
-		if ((i & 0x104008) == 0x104008) x ^= 0x0002;
-		if ((i & 0x080030) == 0x080010) x ^= 0x0004;
-		if ((i & 0x000242) != 0x000042) x ^= 0x0008;
-		if ((i & 0x048100) == 0x048000) x ^= 0x0010;
-		if ((i & 0x002004) != 0x000004) x ^= 0x0020;
-		if ((i & 0x011800) != 0x010000) x ^= 0x0040;
-		if ((i & 0x000820) == 0x000820) x ^= 0x0080;
-
-		x ^= happy6in1_tab[(i >> 1) & 0xff] << 8;
+	if ((i & 0x040480) != 0x000080) x ^= 0x0001;
+	if ((i & 0x104008) == 0x104008) x ^= 0x0002;
+	if ((i & 0x080030) == 0x080010) x ^= 0x0004;
+	if ((i & 0x000242) != 0x000042) x ^= 0x0008;
+	if ((i & 0x048100) == 0x048000) x ^= 0x0010;
+	if ((i & 0x002004) != 0x000004) x ^= 0x0020;
+	if ((i & 0x011800) != 0x010000) x ^= 0x0040;
+	if ((i & 0x000820) == 0x000820) x ^= 0x0080;
+
+	x ^= happy6in1_tab[(i >> 1) & 0xff] << 8;
+
+	return x;
+}
 
-		src[i] = BURN_ENDIAN_SWAP_INT16(x);
-	}
+void pgm_decrypt_happy6()
+{
+	pgm_decrypt_words((UINT16 *)PGMUSER0, nPGMExternalARMLen/2, pgm_decrypt_happy6_word);
 }
 
 static const UINT8 pgm3in1_tab[256] = {
@@ -897,26 +902,25 @@ static const UINT8 pgm3in1_tab[256] = {
 	0x09, 0x29, 0xd6, 0x4d, 0x4a, 0xef, 0x71, 0xe1, 0x25, 0xf9, 0xb0, 0x87, 0xea, 0x0f, 0x1f, 0x6c,
 };
 
-void pgm_decrypt_pgm3in1()
+static UINT16 pgm_decrypt_pgm3in1_word(INT32 i, UINT16 x)
 {
-	UINT16 *src = (UINT16 *)PGM68KROM;
-
-	for (INT32 i = 0; i < nPGM68KROMLen/2; i++) {
-		UINT16 x = BURN_ENDIAN_SWAP_INT16(src[i]);
-
-		if ((i & 0x040480) != 0x000080) x ^= 0x0001;
-		if ((i & 0x084008) == 0x084008) x ^= 0x0002;
-		if ((i & 0x080030) == 0x000010) x ^= 0x0004;
-		if ((i & 0x000042) != 0x000042) x ^= 0x0008;
-		if ((i & 0x008100) == 0x008000) x ^= 0x0010;
-		if ((i & 0x002004) != 0x000004) x ^= 0x0020;
-		if ((i & 0x011800) != 0x010000) x ^= 0x0040;
-		if ((i & 0x000820) == 0x000820) x ^= 0x0080;
-
-		x ^= pgm3in1_tab[i & 0xff] << 8;
+	if ((i & 0x040480) != 0x000080) x ^= 0x0001;
+	if ((i & 0x084008) == 0x084008) x ^= 0x0002;
+	if ((i & 0x080030) == 0x000010) x ^= 0x0004;
+	if ((i & 0x000042) != 0x000042) x ^= 0x0008;
+	if ((i & 0x008100) == 0x008000) x ^= 0x0010;
+	if ((i & 0x002004) != 0x000004) x ^= 0x0020;
+	if ((i & 0x011800) != 0x010000) x ^= 0x0040;
+	if ((i & 0x000820) == 0x000820) x ^= 0x0080;
+
+	x ^= pgm3in1_tab[i & 0xff] << 8;
+
+	return x;
+}
 
-		src[i] = BURN_ENDIAN_SWAP_INT16(x);
-	}
+void pgm_decrypt_pgm3in1()
+{
+	pgm_decrypt_words((UINT16 *)PGM68KROM, nPGM68KROMLen/2, pgm_decrypt_pgm3in1_word);
 }
 
 void pgm_descramble_happy6_data(UINT8 *src, INT32 len)
@@ -772,6 +772,8 @@ static void expand_tile_gfx()
 	PGMTileROM = (UINT8*)BurnRealloc(PGMTileROM, 0x400000);
 }
 
+#define PGM_COLOUR_CACHE_VERSION	1	// bump when the expanded colour data changes
+
 static void expand_colourdata()
 {
 	// allocate 
@@ -791,6 +793,10 @@ static void expand_colourdata()
 		nPGMSPRColMaskLen -= 1;
 	}
 
+	// the expanded colour data comes from the cache if we've seen this set before
+	UINT64 nCacheKey = BurnCacheRomKey(0, -1, PGM_COLOUR_CACHE_VERSION);
+	if (BurnCacheLoadAsset("col", nCacheKey, PGMSPRColROM, (nPGMSPRColROMLen / 2) * 3) == 0) return;
+
 	UINT8 *tmp = (UINT8*)BurnMalloc(nPGMSPRColROMLen);
 	if (tmp == NULL) return;
 
@@ -835,6 +841,8 @@ static void expand_colourdata()
 		PGMSPRColROM[cnt*3+2] = (colpack >> 10) & 0x1f;
 	}
 
+	BurnCacheSaveAsset("col", nCacheKey, PGMSPRColROM, (nPGMSPRColROMLen / 2) * 3);
+
 	BurnFree (tmp);
 }
 
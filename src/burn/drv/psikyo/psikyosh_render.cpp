@@ -4,6 +4,7 @@
 // as well as some other valuable pointers.
 
 #include "tiles_generic.h" // nScreenWidth & nScreenHeight
+#include "burn_simd.h"
 #include "psikyosh_render.h" // contains loads of macros
 
 UINT8 *pPsikyoshTiles;
@@ -18,10 +19,25 @@ static UINT8 alphatable[0x100];
 
 static UINT16 *DrvPriBmp;
 static UINT8 *DrvZoomBmp;
-static INT32 nDrvZoomPrev = -1;
+static UINT32 nDrvZoomPrev = ~0;
 static UINT32  *DrvTmpDraw;
 static UINT32  *DrvTmpDraw_ptr;
 
+// zoomed sprites, resampled to their size on screen (flips applied) and kept LRU
+#define ZOOM_CACHE_ENTRIES	64
+#define ZOOM_CACHE_SIZE		0x10000		// pens per entry
+
+struct zoom_cache_entry {
+	UINT32 key;		// tile, depth, size and flips, 0 = unused
+	UINT32 zoom;
+	UINT32 last_used;
+	UINT8 *pens;
+};
+
+static struct zoom_cache_entry zoom_cache[ZOOM_CACHE_ENTRIES];
+static UINT8 *DrvZoomCache;
+static UINT32 nZoomCacheTick;
+
 static INT32 nGraphicsMin0;  // minimum tile number 4bpp
 static INT32 nGraphicsMin1;  // for 8bpp
 static INT32 nGraphicsSize;  // normal
@@ -42,6 +58,20 @@ static inline UINT32 alpha_blend(UINT32 d, UINT32 s, UINT32 p)
 
 //--------------------------------------------------------------------------------
 
+#if defined BURN_SIMD_SSE2
+// alpha_blend() on 4 pixels, plo / phi hold p for pixels 0-1 / 2-3 in every channel lane (p = 1 - 255)
+static inline __m128i alpha_blend4(__m128i d, __m128i s, __m128i plo, __m128i phi)
+{
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i full = _mm_set1_epi16(256);
+
+	__m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(s, zero), plo), _mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), _mm_sub_epi16(full, plo)));
+	__m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(s, zero), phi), _mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), _mm_sub_epi16(full, phi)));
+
+	return _mm_and_si128(_mm_packus_epi16(_mm_srli_epi16(lo, 8), _mm_srli_epi16(hi, 8)), _mm_set1_epi32(0x00ffffff));
+}
+#endif
+
 static void draw_blendy_tile(INT32 gfx, INT32 code, INT32 color, INT32 sx, INT32 sy, INT32 fx, INT32 fy, INT32 alpha, INT32 z)
 {
 	color <<= 4;
@@ -242,8 +272,9 @@ static void draw_prezoom(INT32 gfx, INT32 code, INT32 high, INT32 wide)
 	if (gfx) {
 		INT32 tileno = (code & 0x3ffff) - nGraphicsMin1;
 		if (tileno < 0 || tileno > nGraphicsSize1) tileno = 0;
-		if (nDrvZoomPrev == tileno) return;
-		nDrvZoomPrev = tileno;
+		UINT32 key = tileno | (1 << 20) | ((wide - 1) << 21) | ((high - 1) << 25);
+		if (nDrvZoomPrev == key) return;
+		nDrvZoomPrev = key;
 		UINT32 *gfxptr = (UINT32*)(pPsikyoshTiles + (tileno << 8));
 
 		for (INT32 ytile = 0; ytile < high; ytile++)
@@ -266,8 +297,9 @@ static void draw_prezoom(INT32 gfx, INT32 code, INT32 high, INT32 wide)
 	} else {
 		INT32 tileno = (code & 0x7ffff) - nGraphicsMin0;
 		if (tileno < 0 || tileno > nGraphicsSize0) tileno = 0;
-		if (nDrvZoomPrev == tileno) return;
-		nDrvZoomPrev = tileno;
+		UINT32 key = tileno | ((wide - 1) << 21) | ((high - 1) << 25);
+		if (nDrvZoomPrev == key) return;
+		nDrvZoomPrev = key;
 		UINT8 *gfxptr = pPsikyoshTiles + (tileno << 7);
 		for (INT32 ytile = 0; ytile < high; ytile++)
 		{
@@ -291,6 +323,133 @@ static void draw_prezoom(INT32 gfx, INT32 code, INT32 high, INT32 wide)
 	}
 }
 
+// one row of a zoomed sprite, sampled from the tiles put together by draw_prezoom
+static void zoom_row(UINT8 *dest, INT32 y_index, INT32 x_index, INT32 dx, INT32 count)
+{
+	UINT8 *source = DrvZoomBmp + (y_index >> 10) * 256;
+
+	for (INT32 x = 0; x < count; x++, x_index += dx) {
+		dest[x] = source[x_index >> 10];
+	}
+}
+
+// returns the whole sprite (width x height pens) at its zoomed size, NULL if it's too big to keep
+static UINT8 *zoom_cache_get(INT32 gfx, UINT32 code, INT32 flipx, INT32 flipy, INT32 zoomx, INT32 zoomy, INT32 wide, INT32 high, INT32 width, INT32 height)
+{
+	if (width * height > ZOOM_CACHE_SIZE) return NULL;
+
+	INT32 tileno = gfx ? ((code & 0x3ffff) - nGraphicsMin1) : ((code & 0x7ffff) - nGraphicsMin0);
+	if (tileno < 0 || tileno > (gfx ? nGraphicsSize1 : nGraphicsSize0)) tileno = 0;
+
+	UINT32 key = tileno | (gfx ? (1 << 20) : 0) | ((wide - 1) << 21) | ((high - 1) << 25) | (flipx << 29) | (flipy << 30) | (1U << 31);
+	UINT32 zoom = (zoomy << 16) | zoomx;
+
+	struct zoom_cache_entry *entry = &zoom_cache[0];
+
+	for (INT32 i = 0; i < ZOOM_CACHE_ENTRIES; i++) {
+		if (zoom_cache[i].key == key && zoom_cache[i].zoom == zoom) {
+			zoom_cache[i].last_used = ++nZoomCacheTick;
+			return zoom_cache[i].pens;
+		}
+
+		if (zoom_cache[i].last_used < entry->last_used) entry = &zoom_cache[i];
+	}
+
+	// not there, resample over the least recently used one
+	draw_prezoom(gfx, code, high, wide);
+
+	INT32 x_index_base = flipx ? (width - 1) * zoomx : 0;
+	INT32 y_index = flipy ? (height - 1) * zoomy : 0;
+	INT32 dx = flipx ? -zoomx : zoomx;
+	INT32 dy = flipy ? -zoomy : zoomy;
+
+	for (INT32 y = 0; y < height; y++, y_index += dy) {
+		zoom_row(entry->pens + y * width, y_index, x_index_base, dx, width);
+	}
+
+	entry->key = key;
+	entry->zoom = zoom;
+	entry->last_used = ++nZoomCacheTick;
+
+	return entry->pens;
+}
+
+// draw one row of sprite pens, pri is NULL when the sprite doesn't use priorities
+static void zoom_span(UINT32 *dest, UINT16 *pri, const UINT8 *src, INT32 count, const UINT32 *pal, INT32 alpha, INT32 z)
+{
+	INT32 x = 0;
+
+#if defined BURN_SIMD_SSE2
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i vz = _mm_set1_epi16(z);
+	const __m128i valpha = _mm_set1_epi16(alpha);
+
+	for (; x + 4 <= count; x += 4)
+	{
+		UINT32 pens = src[x] | (src[x + 1] << 8) | (src[x + 2] << 16) | (src[x + 3] << 24);
+		if (pens == 0) continue;
+
+		// skip = transparent pen, or (with priorities) something higher drawn already
+		__m128i skip16 = _mm_cmpeq_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(pens), zero), zero);
+		__m128i pr = zero;
+		if (pri) {
+			pr = _mm_loadl_epi64((__m128i*)(pri + x));
+			skip16 = _mm_or_si128(skip16, _mm_cmpgt_epi16(pr, vz));
+		}
+		if ((_mm_movemask_epi8(skip16) & 0xff) == 0xff) continue;
+
+		__m128i skip = _mm_unpacklo_epi16(skip16, skip16);
+		__m128i s = _mm_set_epi32(pal[src[x + 3]], pal[src[x + 2]], pal[src[x + 1]], pal[src[x]]);
+		__m128i d = _mm_loadu_si128((__m128i*)(dest + x));
+		__m128i r;
+
+		if (alpha == 0xff) {
+			r = s;
+		} else if (alpha >= 0) {
+			r = (alpha == 0) ? d : alpha_blend4(d, s, valpha, valpha);
+		} else {
+			INT32 p0 = alphatable[src[x + 0]], p1 = alphatable[src[x + 1]];
+			INT32 p2 = alphatable[src[x + 2]], p3 = alphatable[src[x + 3]];
+			__m128i p = _mm_set_epi32(p3, p2, p1, p0);
+
+			r = alpha_blend4(d, s, _mm_set_epi16(p1, p1, p1, p1, p0, p0, p0, p0), _mm_set_epi16(p3, p3, p3, p3, p2, p2, p2, p2));
+
+			// 0xff is a plain copy, 0 leaves the pixel alone
+			__m128i solid = _mm_cmpeq_epi32(p, _mm_set1_epi32(0xff));
+			__m128i none = _mm_cmpeq_epi32(p, zero);
+			r = _mm_or_si128(_mm_and_si128(solid, s), _mm_andnot_si128(solid, r));
+			r = _mm_or_si128(_mm_and_si128(none, d), _mm_andnot_si128(none, r));
+		}
+
+		_mm_storeu_si128((__m128i*)(dest + x), _mm_or_si128(_mm_and_si128(skip, d), _mm_andnot_si128(skip, r)));
+
+		if (pri) {
+			_mm_storel_epi64((__m128i*)(pri + x), _mm_or_si128(_mm_and_si128(skip16, pr), _mm_andnot_si128(skip16, vz)));
+		}
+	}
+#endif
+
+	for (; x < count; x++)
+	{
+		if (pri && z < pri[x]) continue;
+
+		INT32 c = src[x];
+		if (c == 0) continue;
+
+		if (alpha == 0xff) {
+			dest[x] = pal[c];
+		} else if (alpha >= 0) {
+			dest[x] = alpha_blend(dest[x], pal[c], alpha);
+		} else if (alphatable[c] == 0xff) {
+			dest[x] = pal[c];
+		} else {
+			dest[x] = alpha_blend(dest[x], pal[c], alphatable[c]);
+		}
+
+		if (pri) pri[x] = z;
+	}
+}
+
 static void psikyosh_drawgfxzoom(INT32 gfx, UINT32 code, INT32 color, INT32 flipx, INT32 flipy, INT32 offsx, 
 				 INT32 offsy, INT32 alpha, INT32 zoomx, INT32 zoomy, INT32 wide, INT32 high, INT32 z)
 {
@@ -320,74 +479,69 @@ static void psikyosh_drawgfxzoom(INT32 gfx, UINT32 code, INT32 color, INT32 flip
 	}
 	else
 	{
-		draw_prezoom(gfx, code, high, wide);
+		UINT32 *pal = pBurnDrvPalette + (color << 4);
+
+		INT32 sprite_screen_height = ((high << 24) / zoomy + 0x200) >> 10;
+		INT32 sprite_screen_width  = ((wide << 24) / zoomx + 0x200) >> 10;
 
+		if (sprite_screen_width && sprite_screen_height)
 		{
-			UINT32 *pal = pBurnDrvPalette + (color << 4);
+			INT32 sx = offsx;
+			INT32 sy = offsy;
+			INT32 ex = sx + sprite_screen_width;
+			INT32 ey = sy + sprite_screen_height;
 
-			INT32 sprite_screen_height = ((high << 24) / zoomy + 0x200) >> 10;
-			INT32 sprite_screen_width  = ((wide << 24) / zoomx + 0x200) >> 10;
+			INT32 x_index_base;
+			INT32 y_index;
 
-			if (sprite_screen_width && sprite_screen_height)
-			{
-				INT32 sx = offsx;
-				INT32 sy = offsy;
-				INT32 ex = sx + sprite_screen_width;
-				INT32 ey = sy + sprite_screen_height;
+			INT32 dx, dy;
 
-				INT32 x_index_base;
-				INT32 y_index;
+			if (flipx) { x_index_base = (sprite_screen_width-1)*zoomx; dx = -zoomx; }
+			else	   { x_index_base = 0; dx = zoomx; }
 
-				INT32 dx, dy;
+			if (flipy) { y_index = (sprite_screen_height-1)*zoomy; dy = -zoomy; }
+			else	   { y_index = 0; dy = zoomy; }
+
+			{
+				if (sx < 0) {
+					INT32 pixels = 0-sx;
+					sx += pixels;
+					x_index_base += pixels*dx;
+				}
+				if (sy < 0 ) {
+					INT32 pixels = 0-sy;
+					sy += pixels;
+					y_index += pixels*dy;
+				}
+				if (ex > nScreenWidth) {
+					INT32 pixels = ex-(nScreenWidth-1)-1;
+					ex -= pixels;
+				}
+				if (ey > nScreenHeight)	{
+					INT32 pixels = ey-(nScreenHeight-1)-1;
+					ey -= pixels;
+				}
+			}
 
-				if (flipx) { x_index_base = (sprite_screen_width-1)*zoomx; dx = -zoomx; }
-				else	   { x_index_base = 0; dx = zoomx; }
+			if (ex > sx)
+			{
+				UINT8 *zoomed = zoom_cache_get(gfx, code, flipx, flipy, zoomx, zoomy, wide, high, sprite_screen_width, sprite_screen_height);
+				UINT8 row[0x400];
 
-				if (flipy) { y_index = (sprite_screen_height-1)*zoomy; dy = -zoomy; }
-				else	   { y_index = 0; dy = zoomy; }
+				if (zoomed == NULL) draw_prezoom(gfx, code, high, wide);
 
+				for (INT32 y = sy; y < ey; y++, y_index += dy)
 				{
-					if (sx < 0) {
-						INT32 pixels = 0-sx;
-						sx += pixels;
-						x_index_base += pixels*dx;
-					}
-					if (sy < 0 ) {
-						INT32 pixels = 0-sy;
-						sy += pixels;
-						y_index += pixels*dy;
-					}
-					if (ex > nScreenWidth) {
-						INT32 pixels = ex-(nScreenWidth-1)-1;
-						ex -= pixels;
-					}
-					if (ey > nScreenHeight)	{
-						INT32 pixels = ey-(nScreenHeight-1)-1;
-						ey -= pixels;
-					}
-				}
+					UINT8 *source;
 
-				if (ex > sx)
-				{
-					if (alpha == 0xff) {
-						if (z > 0) {
-							PUTPIXEL_ZOOM_NORMAL_PRIO()
-						} else {
-							PUTPIXEL_ZOOM_NORMAL()
-						}
-					} else if (alpha >= 0) {
-						if (z > 0) {
-							PUTPIXEL_ZOOM_ALPHA_PRIO()
-						} else {
-							PUTPIXEL_ZOOM_ALPHA()
-						}
+					if (zoomed) {
+						source = zoomed + (y - offsy) * sprite_screen_width + (sx - offsx);
 					} else {
-						if (z > 0) {
-							PUTPIXEL_ZOOM_ALPHATAB_PRIO()
-						} else {
-							PUTPIXEL_ZOOM_ALPHATAB()
-						}
+						zoom_row(row, y_index, x_index_base, dx, ex - sx);
+						source = row;
 					}
+
+					zoom_span(DrvTmpDraw + y * nScreenWidth + sx, (z > 0) ? (DrvPriBmp + y * nScreenWidth + sx) : NULL, source, ex - sx, pal, alpha, z);
 				}
 			}
 		}
@@ -620,7 +774,16 @@ static void postlineblend()
 			}
 		}
 		else if (lineblend[y] & 0x7f) {
-			for (INT32 x = 0; x < nScreenWidth; x++) {
+			INT32 x = 0;
+#if defined BURN_SIMD_SSE2
+			__m128i s = _mm_set1_epi32(lineblend[y] >> 8);
+			__m128i p = _mm_set1_epi16((lineblend[y] & 0x7f) << 1);
+			for (; x + 4 <= nScreenWidth; x += 4) {
+				__m128i *d = (__m128i*)(destline + x);
+				_mm_storeu_si128(d, alpha_blend4(_mm_loadu_si128(d), s, p, p));
+			}
+#endif
+			for (; x < nScreenWidth; x++) {
 				destline[x] = alpha_blend(destline[x], lineblend[y] >> 8, (lineblend[y] & 0x7f) << 1);
 			}
 		}
@@ -704,6 +867,7 @@ static void calculate_transtab()
 void PsikyoshVideoInit(INT32 gfx_max, INT32 gfx_min)
 {
 	DrvZoomBmp	= (UINT8 *)BurnMalloc(16 * 16 * 16 * 16);
+	DrvZoomCache	= (UINT8 *)BurnMalloc(ZOOM_CACHE_ENTRIES * ZOOM_CACHE_SIZE);
 	DrvPriBmp	= (UINT16*)BurnMalloc(320 * 240 * sizeof(INT16));
 	DrvTmpDraw_ptr	= (UINT32  *)BurnMalloc(320 * 240 * sizeof(UINT32));
 
@@ -721,17 +885,25 @@ void PsikyoshVideoInit(INT32 gfx_max, INT32 gfx_min)
 
 	calculate_transtab();
 	fill_alphatable();
+
+	for (INT32 i = 0; i < ZOOM_CACHE_ENTRIES; i++) {
+		zoom_cache[i].key = 0;
+		zoom_cache[i].last_used = 0;
+		zoom_cache[i].pens = DrvZoomCache + i * ZOOM_CACHE_SIZE;
+	}
+	nZoomCacheTick = 0;
 }
 
 void PsikyoshVideoExit()
 {
 	BurnFree (DrvZoomBmp);
+	BurnFree (DrvZoomCache);
 	BurnFree (DrvPriBmp);
 	BurnFree (DrvTmpDraw_ptr);
 	DrvTmpDraw = NULL;
 	BurnFree (DrvTransTab);
 	
-	nDrvZoomPrev		= -1;
+	nDrvZoomPrev		= ~0;
 	pPsikyoshTiles		= NULL;
 	pPsikyoshSpriteBuffer	= NULL;
 	pPsikyoshBgRAM		= NULL;
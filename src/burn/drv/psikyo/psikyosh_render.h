@@ -103,52 +103,6 @@ putpixel									\
 		sx -= 16;							\
 	}
 
-// Zoom drawing with priorities.
-//-----------------------------------------------------------------------
-#define ZOOMPIXEL_PRIO(putpixel)						\
-	for (INT32 y = sy; y < ey; y++)						\
-	{									\
-		UINT8 *source = DrvZoomBmp + (y_index >> 10) * 256;	\
-		UINT32  *dest = DrvTmpDraw + y * nScreenWidth;		\
-		UINT16 *pri = DrvPriBmp + y * nScreenWidth;		\
-										\
-		INT32 x_index = x_index_base;					\
-		for (INT32 x = sx; x < ex; x++)					\
-		{								\
-			if (z >= pri[x])					\
-			{							\
-				INT32 c = source[x_index>>10];			\
-				if (c)						\
-				{						\
-putpixel									\
-					pri[x] = z;				\
-				}						\
-			}							\
-			x_index += dx;						\
-		}								\
-		y_index += dy;							\
-	}
-
-// Standard Zoom drawing
-//-----------------------------------------------------------------------
-#define ZOOMPIXEL_NORMAL(putpixel)	\
-	for (INT32  y = sy; y < ey; y++)						\
-	{									\
-		UINT8 *source = DrvZoomBmp + (y_index >> 10) * 256;	\
-		UINT32  *dest = DrvTmpDraw + y * nScreenWidth;		\
-		INT32 x_index = x_index_base;					\
-										\
-		for (INT32 x = sx; x < ex; x++)					\
-		{								\
-			INT32 c = source[x_index>>10];				\
-			if(c) {							\
-putpixel									\
-			}							\
-			x_index += dx;						\
-		}								\
-		y_index += dy;							\
-	}
-
 //--------------------------------------------------------------------------------
 
 // split up a 4bpp pixel
@@ -178,18 +132,6 @@ putpixel									\
 
 #define FORLOOP_FLIPX	for (INT32 x = 15; x >= 0; x--, sx++)
 
-// set pixels for zoom routines
-#define ZSETNORMALPIXEL	dest[x] = pal[c];
-
-#define ZSETBLENDPIXEL	dest[x] = alpha_blend(dest[x], pal[c], alpha);
-
-#define ZSETVARIABLEPIXEL								\
-	if (alphatable[c] == 0xff) {							\
-		dest[x] = pal[c];						\
-	} else {									\
-		dest[x] = alpha_blend(dest[x], pal[c], alphatable[c]);			\
-	}
-
 //--------------------------------------------------------------------------------
 
 // these aren't really necessary, they just help me keep track of what things do...
@@ -258,13 +200,3 @@ putpixel									\
 #define PUTPIXEL_8BPP_NORMAL_PRIO_FLIPX()	PUTPIXEL_PRIO(FORLOOP_FLIPX, NORMALPIXEL, SETNORMALPIXEL)
 #define PUTPIXEL_8BPP_ALPHA_PRIO_FLIPX()	PUTPIXEL_PRIO(FORLOOP_FLIPX, NORMALPIXEL, SETBLENDPIXEL)
 #define PUTPIXEL_8BPP_ALPHATAB_PRIO_FLIPX()PUTPIXEL_PRIO(FORLOOP_FLIPX, NORMALPIXEL, SETVARIABLEPIXEL)
-
-
-#define PUTPIXEL_ZOOM_NORMAL_PRIO()		ZOOMPIXEL_PRIO(ZSETNORMALPIXEL)
-#define PUTPIXEL_ZOOM_NORMAL()			ZOOMPIXEL_NORMAL(ZSETNORMALPIXEL)
-
-#define PUTPIXEL_ZOOM_ALPHA_PRIO()		ZOOMPIXEL_PRIO(ZSETBLENDPIXEL)
-#define PUTPIXEL_ZOOM_ALPHA()			ZOOMPIXEL_NORMAL(ZSETBLENDPIXEL)
-
-#define PUTPIXEL_ZOOM_ALPHATAB_PRIO()		ZOOMPIXEL_PRIO(ZSETVARIABLEPIXEL)
-#define PUTPIXEL_ZOOM_ALPHATAB()		ZOOMPIXEL_NORMAL(ZSETVARIABLEPIXEL)
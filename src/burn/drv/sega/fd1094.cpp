@@ -283,10 +283,27 @@ static const UINT16 masked_opcodes[] =
 static UINT8 masked_opcodes_lookup[2][65536/8/2];
 static UINT8 masked_opcodes_created = FALSE;
 
-static INT32 final_decrypt(INT32 i,INT32 moreffff)
+static void masked_opcodes_init()
 {
 	UINT32 j;
 
+	for (j = 0; j < ARRAY_LENGTH(masked_opcodes); j++)
+	{
+		UINT16 opcode = masked_opcodes[j];
+		masked_opcodes_lookup[0][opcode >> 4] |= 1 << ((opcode >> 1) & 7);
+		masked_opcodes_lookup[1][opcode >> 4] |= 1 << ((opcode >> 1) & 7);
+	}
+	for (j = 0; j < 65536; j += 2)
+	{
+		if ((j & 0xff80) == 0x4e80 || (j & 0xf0f8) == 0x50c8 || (j & 0xf000) == 0x6000)
+			masked_opcodes_lookup[1][j >> 4] |= 1 << ((j >> 1) & 7);
+	}
+
+	masked_opcodes_created = TRUE;
+}
+
+static INT32 final_decrypt(INT32 i,INT32 moreffff)
+{
 	/* final "obfuscation": invert bits 7 and 14 following a fixed pattern */
 	INT32 dec = i;
 	if ((i & 0xf080) == 0x8000) dec ^= 0x0080;
@@ -296,20 +313,7 @@ static INT32 final_decrypt(INT32 i,INT32 moreffff)
 
 	/* mask out opcodes doing PC-relative addressing, replace them with FFFF */
 	if (!masked_opcodes_created)
-	{
-		masked_opcodes_created = TRUE;
-		for (j = 0; j < ARRAY_LENGTH(masked_opcodes); j++)
-		{
-			UINT16 opcode = masked_opcodes[j];
-			masked_opcodes_lookup[0][opcode >> 4] |= 1 << ((opcode >> 1) & 7);
-			masked_opcodes_lookup[1][opcode >> 4] |= 1 << ((opcode >> 1) & 7);
-		}
-		for (j = 0; j < 65536; j += 2)
-		{
-			if ((j & 0xff80) == 0x4e80 || (j & 0xf0f8) == 0x50c8 || (j & 0xf000) == 0x6000)
-				masked_opcodes_lookup[1][j >> 4] |= 1 << ((j >> 1) & 7);
-		}
-	}
+		masked_opcodes_init();
 
 	if ((masked_opcodes_lookup[moreffff][dec >> 4] >> ((dec >> 1) & 7)) & 1)
 		dec = 0xffff;
@@ -437,6 +441,63 @@ static INT32 decode(INT32 address,INT32 val,UINT8 *main_key,INT32 gkey1,INT32 gk
 }
 
 
+/* the 24-bit global key for a given state */
+static void global_keys(UINT8 *key,INT32 state,INT32 *gkey1,INT32 *gkey2,INT32 *gkey3)
+{
+	*gkey1 = key[1];
+	*gkey2 = key[2];
+	*gkey3 = key[3];
+
+	if (state & 0x0001)
+	{
+		*gkey1 ^= 0x04;	// global_xor1
+		*gkey2 ^= 0x80;	// key_1a invert
+		*gkey3 ^= 0x80;	// key_2a invert
+	}
+	if (state & 0x0002)
+	{
+		*gkey1 ^= 0x01;	// global_swap2
+		*gkey2 ^= 0x10;	// key_7a invert
+		*gkey3 ^= 0x01;	// key_4b invert
+	}
+	if (state & 0x0004)
+	{
+		*gkey1 ^= 0x80;	// key_0b invert - could be 0x20
+		*gkey2 ^= 0x40;	// key_6b invert
+		*gkey3 ^= 0x04;	// global_swap4
+	}
+	if (state & 0x0008)
+	{
+		*gkey1 ^= 0x20;	// global_xor0   - could be 0x80
+		*gkey2 ^= 0x02;	// key_6a invert
+		*gkey3 ^= 0x20;	// key_5a invert
+	}
+	if (state & 0x0010)
+	{
+		*gkey1 ^= 0x02;	// key_0c invert
+		*gkey1 ^= 0x40;	// key_5b invert
+		*gkey2 ^= 0x08;	// key_4a invert
+	}
+	if (state & 0x0020)
+	{
+		*gkey1 ^= 0x08;	// key_1b invert
+		*gkey3 ^= 0x08;	// key_3b invert
+		*gkey3 ^= 0x10;	// global_swap1
+	}
+	if (state & 0x0040)
+	{
+		*gkey1 ^= 0x10;	// key_2b invert
+		*gkey2 ^= 0x20;	// global_swap0a
+		*gkey2 ^= 0x04;	// global_swap0b
+	}
+	if (state & 0x0080)
+	{
+		*gkey2 ^= 0x01;	// key_3a invert
+		*gkey3 ^= 0x02;	// key_0a invert
+		*gkey3 ^= 0x40;	// global_swap3
+	}
+}
+
 static INT32 global_key1,global_key2,global_key3;
 
 INT32 fd1094_decode(INT32 address,INT32 val,UINT8 *key,INT32 vector_fetch)
@@ -477,57 +538,45 @@ INT32 fd1094_set_state(UINT8 *key,INT32 state)
 	else
 		state = selected_state;
 
-	global_key1 = key[1];
-	global_key2 = key[2];
-	global_key3 = key[3];
+	global_keys(key, state, &global_key1, &global_key2, &global_key3);
 
-	if (state & 0x0001)
-	{
-		global_key1 ^= 0x04;	// global_xor1
-		global_key2 ^= 0x80;	// key_1a invert
-		global_key3 ^= 0x80;	// key_2a invert
-	}
-	if (state & 0x0002)
-	{
-		global_key1 ^= 0x01;	// global_swap2
-		global_key2 ^= 0x10;	// key_7a invert
-		global_key3 ^= 0x01;	// key_4b invert
-	}
-	if (state & 0x0004)
-	{
-		global_key1 ^= 0x80;	// key_0b invert - could be 0x20
-		global_key2 ^= 0x40;	// key_6b invert
-		global_key3 ^= 0x04;	// global_swap4
-	}
-	if (state & 0x0008)
-	{
-		global_key1 ^= 0x20;	// global_xor0   - could be 0x80
-		global_key2 ^= 0x02;	// key_6a invert
-		global_key3 ^= 0x20;	// key_5a invert
-	}
-	if (state & 0x0010)
-	{
-		global_key1 ^= 0x02;	// key_0c invert
-		global_key1 ^= 0x40;	// key_5b invert
-		global_key2 ^= 0x08;	// key_4a invert
-	}
-	if (state & 0x0020)
-	{
-		global_key1 ^= 0x08;	// key_1b invert
-		global_key3 ^= 0x08;	// key_3b invert
-		global_key3 ^= 0x10;	// global_swap1
-	}
-	if (state & 0x0040)
-	{
-		global_key1 ^= 0x10;	// key_2b invert
-		global_key2 ^= 0x20;	// global_swap0a
-		global_key2 ^= 0x04;	// global_swap0b
-	}
-	if (state & 0x0080)
-	{
-		global_key2 ^= 0x01;	// key_3a invert
-		global_key3 ^= 0x02;	// key_0a invert
-		global_key3 ^= 0x40;	// global_swap3
-	}
 	return state & 0xff;
 }
+
+struct fd1094_region_params
+{
+	UINT16 *dest;
+	const UINT16 *src;
+	UINT8 *key;
+	INT32 gkey1,gkey2,gkey3;
+};
+
+static void fd1094_decode_range(INT32 start,INT32 end,void *param)
+{
+	fd1094_region_params *p = (fd1094_region_params *)param;
+
+	for (INT32 addr = start; addr < end; addr++)
+		p->dest[addr] = decode(addr,BURN_ENDIAN_SWAP_INT16(p->src[addr]),p->key,p->gkey1,p->gkey2,p->gkey3,0);
+}
+
+/* decrypt a whole region for a state (as returned by fd1094_set_state()), the
+   words are shared out over the worker pool. doesn't change the current state */
+void fd1094_decode_region(UINT16 *dest,const UINT16 *src,INT32 words,UINT8 *key,INT32 state)
+{
+	BURN_PROFILE_PHASE(DECRYPT);
+
+	fd1094_region_params p;
+
+	if (!key) return;
+
+	/* built here, not by whichever thread gets there first */
+	if (!masked_opcodes_created)
+		masked_opcodes_init();
+
+	p.dest = dest;
+	p.src = src;
+	p.key = key;
+	global_keys(key, state & 0xff, &p.gkey1, &p.gkey2, &p.gkey3);
+
+	BurnPoolFor(fd1094_decode_range, &p, 0, words, 0x4000);
+}
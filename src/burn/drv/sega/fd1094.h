@@ -4,3 +4,4 @@
 
 INT32 fd1094_set_state(UINT8 *key, INT32 state);
 INT32 fd1094_decode(INT32 address, INT32 val, UINT8 *key, INT32 vector_fetch);
+void fd1094_decode_region(UINT16 *dest, const UINT16 *src, INT32 words, UINT8 *key, INT32 state);
@@ -61,11 +61,7 @@ static void fd1094_setstate_and_decrypt(INT32 state)
 	/* mark it as cached (because it will be once we decrypt it) */
 	fd1094_cached_states[fd1094_current_cacheposition]=state;
 
-	for (UINT32 addr = 0; addr < fd1094_cpuregionsize / 2; addr++)
-	{
-		UINT16 dat = fd1094_decode(addr,fd1094_cpuregion[addr], fd1094_key, 0);
-		fd1094_cacheregion[fd1094_current_cacheposition][addr] = dat;
-	}
+	fd1094_decode_region(fd1094_cacheregion[fd1094_current_cacheposition], fd1094_cpuregion, fd1094_cpuregionsize / 2, fd1094_key, state);
 
 	/* copy newly decrypted data to user region */
 	s24_fd1094_userregion = fd1094_cacheregion[fd1094_current_cacheposition];
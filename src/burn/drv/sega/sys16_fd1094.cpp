@@ -34,7 +34,6 @@ static void *fd1094_get_decrypted_base(void)
 static void fd1094_setstate_and_decrypt(INT32 state)
 {
 	INT32 i;
-	UINT32 addr;
 	
 	switch (state & 0x300) {
 		case 0x000:
@@ -85,12 +84,7 @@ static void fd1094_setstate_and_decrypt(INT32 state)
 	/* mark it as cached (because it will be once we decrypt it) */
 	fd1094_cached_states[fd1094_current_cacheposition]=state;
 
-	for (addr=0;addr<fd1094_cpuregionsize/2;addr++)
-	{
-		UINT16 dat;
-		dat = fd1094_decode(addr,fd1094_cpuregion[addr],fd1094_key,0);
-		fd1094_cacheregion[fd1094_current_cacheposition][addr]=dat;
-	}
+	fd1094_decode_region(fd1094_cacheregion[fd1094_current_cacheposition], fd1094_cpuregion, fd1094_cpuregionsize / 2, fd1094_key, state);
 
 	/* copy newly decrypted data to user region */
 	fd1094_userregion=fd1094_cacheregion[fd1094_current_cacheposition];
@@ -125,6 +119,49 @@ static void fd1094_setstate_and_decrypt(INT32 state)
 	}
 }
 
+/* decrypts the states a game is going to use at startup, instead of the first
+   time the game switches to them: the reset state, the irq state, and every
+   state selected by a CMPI.L #$00xxFFFF,D0 in the code decrypted so far */
+static void fd1094_precache_states(void)
+{
+	INT32 words = fd1094_cpuregionsize / 2;
+	INT32 count = 0;
+	INT32 scanned = 0;
+
+	fd1094_cached_states[count++] = 0x00;
+	if (fd1094_key[0] != 0x00)
+		fd1094_cached_states[count++] = fd1094_key[0];
+
+	while (scanned < count)
+	{
+		UINT16 *region = fd1094_cacheregion[scanned];
+
+		fd1094_decode_region(region, fd1094_cpuregion, words, fd1094_key, fd1094_cached_states[scanned]);
+		scanned++;
+
+		for (INT32 addr = 0; addr < words - 2 && count < S16_NUMCACHE; addr++)
+		{
+			if (BURN_ENDIAN_SWAP_INT16(region[addr + 0]) != 0x0c80) continue;
+			if (BURN_ENDIAN_SWAP_INT16(region[addr + 2]) != 0xffff) continue;
+
+			UINT16 select = BURN_ENDIAN_SWAP_INT16(region[addr + 1]);
+			if (select & 0xfe00) continue; // not a 0x00xx or 0x01xx state select
+
+			INT32 state = select & 0xff;
+			INT32 i;
+
+			for (i = 0; i < count; i++)
+				if (fd1094_cached_states[i] == state) break;
+
+			if (i == count) fd1094_cached_states[count++] = state;
+		}
+	}
+
+	fd1094_current_cacheposition = count % S16_NUMCACHE;
+
+	bprintf(0, _T("FD1094: %d states decrypted at startup\n"), count);
+}
+
 /* Callback for CMP.L instructions (state change) */
 INT32 __fastcall fd1094_cmp_callback(UINT32 val, INT32 reg)
 {
@@ -226,6 +263,8 @@ void fd1094_driver_init(INT32 nCPU)
 	
 	fd1094_current_cacheposition = 0;
 	fd1094_state = -1;
+
+	fd1094_precache_states();
 	
 //	if (System16RomSize > 0x0fffff) System18Banking = true;
 }
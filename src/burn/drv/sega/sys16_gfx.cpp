@@ -1,4 +1,5 @@
 #include "sys16.h"
+#include "burn_roz.h"
 
 INT32 System16SpriteBanks[16];
 INT32 System16TileBanks[8];
@@ -3001,22 +3002,25 @@ void System16RotateDraw()
 	currx += dxx * (0 + 27) + dxy * 0;
 	curry += dyx * (0 + 27) + dyy * 0;
 
+	/* the source bitmap is 512x512 and wraps, coordinates are 18.14 */
+	BurnRozSource roz;
+	BurnRozSetSource(&roz, pTempDraw, 512, 512, 512, 14, 1);
+
+	UINT32 pixels[320];
+
 	/* loop over screen Y coordinates */
 	for (y = 0; y <= 223; y++)
 	{
 		UINT16* pPixel = pTransDraw + (y * 320);
-		UINT16* pSrc = pTempDraw;
 		UINT8* pPri = System16PriorityMap + (y * 320);
-		INT32 tx = currx;
-		INT32 ty = curry;
+
+		/* fetch the whole line from the source bitmap */
+		BurnRozFetch(pixels, &roz, currx, curry, dxx, dyx, 320);
 
 		/* loop over screen X coordinates */
 		for (x = 0; x <= 319; x++)
 		{
-			/* fetch the pixel from the source bitmap */
-			INT32 sx = (tx >> 14) & 0x1ff;
-			INT32 sy = (ty >> 14) & 0x1ff;
-			INT32 pix = pSrc[sy * 512 + (sx & 0x1ff)];
+			INT32 pix = pixels[x];
 
 			/* non-zero pixels get written; everything else is the scanline color */
 			if (pix != 0xffff)
@@ -3026,13 +3030,9 @@ void System16RotateDraw()
 			}
 			else
 			{
-				*pPixel++ = /*info->colorbase +*/ sy;
+				*pPixel++ = /*info->colorbase +*/ (((UINT32)curry + (UINT32)dyx * x) >> 14) & 0x1ff;
 				*pPri++ = 0xff;
 			}
-
-			/* advance the source X/Y pointers */
-			tx += dxx;
-			ty += dyx;
 		}
 
 		/* advance the source X/Y pointers */
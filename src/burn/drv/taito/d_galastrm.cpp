@@ -19,6 +19,8 @@ static poly_manager *poly = NULL;
 struct poly_extra_data
 {
 	UINT16 *texbase;
+	INT32 width;
+	INT32 height;
 };
 
 static INT32 sprite_count = 0;
@@ -402,6 +404,8 @@ static INT32 DrvInit()
 
 static INT32 DrvExit()
 {
+	poly_wait(poly, NULL); // still drawing into the bitmaps?
+
 	GenericTilesExit();
 
 	SekExit();
@@ -544,7 +548,9 @@ static void draw_sprites(INT32 priority)
 static void tc0610_draw_scanline(void *dest, INT32 scan_line, const poly_extent *extent, const void *extradata, INT32 threadid)
 {
 	const poly_extra_data *extra = (const poly_extra_data *)extradata;
-	UINT16 *framebuffer = ((UINT16*)dest) + scan_line * nScreenWidth;
+	const INT32 width = extra->width;
+	const INT32 height = extra->height;
+	UINT16 *framebuffer = ((UINT16*)dest) + scan_line * width;
 	UINT16 *texbase = extra->texbase;
 	INT32 startx = extent->startx;
 	INT32 stopx = extent->stopx;
@@ -558,9 +564,9 @@ static void tc0610_draw_scanline(void *dest, INT32 scan_line, const poly_extent
 		INT32 srcy = (v >> 16);
 		INT32 srcx = (u >> 16);
 
-		if (x >= 0 && x < nScreenWidth) {
-			if (srcy >= 0 && srcy < nScreenHeight && srcx >= 0 && srcx < nScreenWidth) {
-				framebuffer[x] = texbase[srcy * nScreenWidth + srcx];
+		if (x >= 0 && x < width) {
+			if (srcy >= 0 && srcy < height && srcx >= 0 && srcx < width) {
+				framebuffer[x] = texbase[srcy * width + srcx];
 			}
 		}
 		u += dudx;
@@ -749,14 +755,19 @@ static void tc0610_rotate_draw()
 	vert[3].p[1] = 0.0;
 
 	extra->texbase = BurnBitmapGetBitmap(1);
+	extra->width = nScreenWidth;
+	extra->height = nScreenHeight;
 	callback = tc0610_draw_scanline;
 
+	// drawn by the poly worker while the next frame runs, DrvDraw() waits for it
+	// before it touches bitmaps 1 and 2 again
 	poly_render_quad(poly, (void*)BurnBitmapGetBitmap(2), clip, callback, 2, &vert[0], &vert[1], &vert[2], &vert[3]);
-	poly_wait(poly, NULL);
 }
 
 static INT32 DrvDraw()
 {
+	poly_wait(poly, NULL); // last frame's rotation layer
+
 	if (DrvRecalc) {
 		TC0110PCRRecalcPaletteStep1RBSwap();
 		DrvRecalc = 0;
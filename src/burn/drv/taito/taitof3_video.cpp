@@ -3,6 +3,7 @@
 #include "tiles_generic.h"
 #include "taitof3_video.h"
 #include "taito.h"
+#include "burn_simd.h"
 
 UINT32 sprite_lag;
 UINT32 extended_layers;
@@ -68,62 +69,15 @@ static INT32 m_twidth_mask_bit=7;
 #define ORIENTATION_FLIP_Y	1
 
 
-static UINT16 *m_src0;
-static UINT16 *m_src_s0;
-static UINT16 *m_src_e0;
-static UINT16 m_clip_al0;
-static UINT16 m_clip_ar0;
-static UINT16 m_clip_bl0;
-static UINT16 m_clip_br0;
-static UINT8 *m_tsrc0;
-static UINT8 *m_tsrc_s0;
-static UINT32 m_x_count0;
-static UINT32 m_x_zoom0;
-static UINT16 *m_src1;
-static UINT16 *m_src_s1;
-static UINT16 *m_src_e1;
-static UINT16 m_clip_al1;
-static UINT16 m_clip_ar1;
-static UINT16 m_clip_bl1;
-static UINT16 m_clip_br1;
-static UINT8 *m_tsrc1;
-static UINT8 *m_tsrc_s1;
-static UINT32 m_x_count1;
-static UINT32 m_x_zoom1;
-static UINT16 *m_src2;
-static UINT16 *m_src_s2;
-static UINT16 *m_src_e2;
-static UINT16 m_clip_al2;
-static UINT16 m_clip_ar2;
-static UINT16 m_clip_bl2;
-static UINT16 m_clip_br2;
-static UINT8 *m_tsrc2;
-static UINT8 *m_tsrc_s2;
-static UINT32 m_x_count2;
-static UINT32 m_x_zoom2;
-static UINT16 *m_src3;
-static UINT16 *m_src_s3;
-static UINT16 *m_src_e3;
-static UINT16 m_clip_al3;
-static UINT16 m_clip_ar3;
-static UINT16 m_clip_bl3;
-static UINT16 m_clip_br3;
-static UINT8 *m_tsrc3;
-static UINT8 *m_tsrc_s3;
-static UINT32 m_x_count3;
-static UINT32 m_x_zoom3;
-static UINT16 *m_src4;
-static UINT16 *m_src_s4;
-static UINT16 *m_src_e4;
-static UINT16 m_clip_al4;
-static UINT16 m_clip_ar4;
-static UINT16 m_clip_bl4;
-static UINT16 m_clip_br4;
-static UINT8 *m_tsrc4;
-static UINT8 *m_tsrc_s4;
-static UINT32 m_x_count4;
-static UINT32 m_x_zoom4;
-static UINT16 m_pal_add[5];
+// source walk state of one playfield for the line being mixed
+struct f3_pixmap
+{
+	UINT16 *src, *src_s, *src_e;
+	UINT8 *tsrc, *tsrc_s;
+	UINT32 x_count, x_zoom;
+	UINT16 clip_al, clip_ar, clip_bl, clip_br;
+	UINT16 pal_add;
+};
 
 static UINT8 m_add_sat[256][256];
 
@@ -137,37 +91,31 @@ static INT32 m_f3_alpha_level_3bs;
 static INT32 m_f3_alpha_level_3bd;
 static INT32 m_alpha_level_last;
 
-static INT32 m_alpha_s_1_1;
-static INT32 m_alpha_s_1_2;
-static INT32 m_alpha_s_1_4;
-static INT32 m_alpha_s_1_5;
-static INT32 m_alpha_s_1_6;
-static INT32 m_alpha_s_1_8;
-static INT32 m_alpha_s_1_9;
-static INT32 m_alpha_s_1_a;
-static INT32 m_alpha_s_2a_0;
-static INT32 m_alpha_s_2a_4;
-static INT32 m_alpha_s_2a_8;
-static INT32 m_alpha_s_2b_0;
-static INT32 m_alpha_s_2b_4;
-static INT32 m_alpha_s_2b_8;
-static INT32 m_alpha_s_3a_0;
-static INT32 m_alpha_s_3a_1;
-static INT32 m_alpha_s_3a_2;
-static INT32 m_alpha_s_3b_0;
-static INT32 m_alpha_s_3b_1;
-static INT32 m_alpha_s_3b_2;
-static UINT32 m_dval;
-static UINT8 m_pval;
-static UINT8 m_tval;
-static UINT8 m_pdest_2a;
-static UINT8 m_pdest_2b;
-static INT32 m_tr_2a;
-static INT32 m_tr_2b;
-static UINT8 m_pdest_3a;
-static UINT8 m_pdest_3b;
-static INT32 m_tr_3a;
-static INT32 m_tr_3b;
+struct f3_alpha_s
+{
+	INT32 s_1_1;
+	INT32 s_1_2;
+	INT32 s_1_4;
+	INT32 s_1_5;
+	INT32 s_1_6;
+	INT32 s_1_8;
+	INT32 s_1_9;
+	INT32 s_1_a;
+	INT32 s_2a_0;
+	INT32 s_2a_4;
+	INT32 s_2a_8;
+	INT32 s_2b_0;
+	INT32 s_2b_4;
+	INT32 s_2b_8;
+	INT32 s_3a_0;
+	INT32 s_3a_1;
+	INT32 s_3a_2;
+	INT32 s_3b_0;
+	INT32 s_3b_1;
+	INT32 s_3b_2;
+};
+
+static struct f3_alpha_s m_alpha_s;
 
 #define BYTE4_XOR_LE(x)	x
 
@@ -211,8 +159,30 @@ static void clear_f3_stuff()
 
 
 static INT32 (*m_dpix_n[8][16])(UINT32 s_pix);
-static INT32 (**m_dpix_lp[5])(UINT32 s_pix);
-static INT32 (**m_dpix_sp[9])(UINT32 s_pix);
+
+// everything the mixer needs for a group of scanlines with the same status,
+// filled in by scanline_draw() so the lines can be mixed in any order
+struct f3_line_mix
+{
+	const struct f3_playfield_line_inf *line_t[5];
+	INT32 sprite[6];
+	INT32 skip_layer_num;
+	UINT32 orient;
+	INT32 (**dpix_lp[5])(UINT32 s_pix);
+	INT32 (**dpix_sp[16])(UINT32 s_pix);
+	UINT8 pdest_2a, pdest_2b, pdest_3a, pdest_3b;
+	INT32 tr_2a, tr_2b, tr_3a, tr_3b;
+	struct f3_alpha_s alpha;
+};
+
+static struct f3_line_mix m_line_mix[256];
+static UINT8 m_line_mix_num[256];		// scanline -> m_line_mix entry
+
+// per thread, the dpix_* functions work on these
+static BURN_THREAD_LOCAL const struct f3_line_mix *m_mix;
+static BURN_THREAD_LOCAL UINT32 m_dval;
+static BURN_THREAD_LOCAL UINT8 m_pval;
+static BURN_THREAD_LOCAL UINT8 m_tval;
 
 
 static void draw_pf_layer(INT32 layer)
@@ -1038,36 +1008,36 @@ static void draw_sprites()
 
 static inline void f3_alpha_set_level()
 {
-//  SET_ALPHA_LEVEL(m_alpha_s_1_1, m_f3_alpha_level_2ad)
-	SET_ALPHA_LEVEL(m_alpha_s_1_1, 255-m_f3_alpha_level_2as)
-//  SET_ALPHA_LEVEL(m_alpha_s_1_2, m_f3_alpha_level_2bd)
-	SET_ALPHA_LEVEL(m_alpha_s_1_2, 255-m_f3_alpha_level_2bs)
-	SET_ALPHA_LEVEL(m_alpha_s_1_4, m_f3_alpha_level_3ad)
-//  SET_ALPHA_LEVEL(m_alpha_s_1_5, m_f3_alpha_level_3ad*m_f3_alpha_level_2ad/255)
-	SET_ALPHA_LEVEL(m_alpha_s_1_5, m_f3_alpha_level_3ad*(255-m_f3_alpha_level_2as)/255)
-//  SET_ALPHA_LEVEL(m_alpha_s_1_6, m_f3_alpha_level_3ad*m_f3_alpha_level_2bd/255)
-	SET_ALPHA_LEVEL(m_alpha_s_1_6, m_f3_alpha_level_3ad*(255-m_f3_alpha_level_2bs)/255)
-	SET_ALPHA_LEVEL(m_alpha_s_1_8, m_f3_alpha_level_3bd)
-//  SET_ALPHA_LEVEL(m_alpha_s_1_9, m_f3_alpha_level_3bd*m_f3_alpha_level_2ad/255)
-	SET_ALPHA_LEVEL(m_alpha_s_1_9, m_f3_alpha_level_3bd*(255-m_f3_alpha_level_2as)/255)
-//  SET_ALPHA_LEVEL(m_alpha_s_1_a, m_f3_alpha_level_3bd*m_f3_alpha_level_2bd/255)
-	SET_ALPHA_LEVEL(m_alpha_s_1_a, m_f3_alpha_level_3bd*(255-m_f3_alpha_level_2bs)/255)
-
-	SET_ALPHA_LEVEL(m_alpha_s_2a_0, m_f3_alpha_level_2as)
-	SET_ALPHA_LEVEL(m_alpha_s_2a_4, m_f3_alpha_level_2as*m_f3_alpha_level_3ad/255)
-	SET_ALPHA_LEVEL(m_alpha_s_2a_8, m_f3_alpha_level_2as*m_f3_alpha_level_3bd/255)
-
-	SET_ALPHA_LEVEL(m_alpha_s_2b_0, m_f3_alpha_level_2bs)
-	SET_ALPHA_LEVEL(m_alpha_s_2b_4, m_f3_alpha_level_2bs*m_f3_alpha_level_3ad/255)
-	SET_ALPHA_LEVEL(m_alpha_s_2b_8, m_f3_alpha_level_2bs*m_f3_alpha_level_3bd/255)
-
-	SET_ALPHA_LEVEL(m_alpha_s_3a_0, m_f3_alpha_level_3as)
-	SET_ALPHA_LEVEL(m_alpha_s_3a_1, m_f3_alpha_level_3as*m_f3_alpha_level_2ad/255)
-	SET_ALPHA_LEVEL(m_alpha_s_3a_2, m_f3_alpha_level_3as*m_f3_alpha_level_2bd/255)
-
-	SET_ALPHA_LEVEL(m_alpha_s_3b_0, m_f3_alpha_level_3bs)
-	SET_ALPHA_LEVEL(m_alpha_s_3b_1, m_f3_alpha_level_3bs*m_f3_alpha_level_2ad/255)
-	SET_ALPHA_LEVEL(m_alpha_s_3b_2, m_f3_alpha_level_3bs*m_f3_alpha_level_2bd/255)
+//  SET_ALPHA_LEVEL(m_alpha_s.s_1_1, m_f3_alpha_level_2ad)
+	SET_ALPHA_LEVEL(m_alpha_s.s_1_1, 255-m_f3_alpha_level_2as)
+//  SET_ALPHA_LEVEL(m_alpha_s.s_1_2, m_f3_alpha_level_2bd)
+	SET_ALPHA_LEVEL(m_alpha_s.s_1_2, 255-m_f3_alpha_level_2bs)
+	SET_ALPHA_LEVEL(m_alpha_s.s_1_4, m_f3_alpha_level_3ad)
+//  SET_ALPHA_LEVEL(m_alpha_s.s_1_5, m_f3_alpha_level_3ad*m_f3_alpha_level_2ad/255)
+	SET_ALPHA_LEVEL(m_alpha_s.s_1_5, m_f3_alpha_level_3ad*(255-m_f3_alpha_level_2as)/255)
+//  SET_ALPHA_LEVEL(m_alpha_s.s_1_6, m_f3_alpha_level_3ad*m_f3_alpha_level_2bd/255)
+	SET_ALPHA_LEVEL(m_alpha_s.s_1_6, m_f3_alpha_level_3ad*(255-m_f3_alpha_level_2bs)/255)
+	SET_ALPHA_LEVEL(m_alpha_s.s_1_8, m_f3_alpha_level_3bd)
+//  SET_ALPHA_LEVEL(m_alpha_s.s_1_9, m_f3_alpha_level_3bd*m_f3_alpha_level_2ad/255)
+	SET_ALPHA_LEVEL(m_alpha_s.s_1_9, m_f3_alpha_level_3bd*(255-m_f3_alpha_level_2as)/255)
+//  SET_ALPHA_LEVEL(m_alpha_s.s_1_a, m_f3_alpha_level_3bd*m_f3_alpha_level_2bd/255)
+	SET_ALPHA_LEVEL(m_alpha_s.s_1_a, m_f3_alpha_level_3bd*(255-m_f3_alpha_level_2bs)/255)
+
+	SET_ALPHA_LEVEL(m_alpha_s.s_2a_0, m_f3_alpha_level_2as)
+	SET_ALPHA_LEVEL(m_alpha_s.s_2a_4, m_f3_alpha_level_2as*m_f3_alpha_level_3ad/255)
+	SET_ALPHA_LEVEL(m_alpha_s.s_2a_8, m_f3_alpha_level_2as*m_f3_alpha_level_3bd/255)
+
+	SET_ALPHA_LEVEL(m_alpha_s.s_2b_0, m_f3_alpha_level_2bs)
+	SET_ALPHA_LEVEL(m_alpha_s.s_2b_4, m_f3_alpha_level_2bs*m_f3_alpha_level_3ad/255)
+	SET_ALPHA_LEVEL(m_alpha_s.s_2b_8, m_f3_alpha_level_2bs*m_f3_alpha_level_3bd/255)
+
+	SET_ALPHA_LEVEL(m_alpha_s.s_3a_0, m_f3_alpha_level_3as)
+	SET_ALPHA_LEVEL(m_alpha_s.s_3a_1, m_f3_alpha_level_3as*m_f3_alpha_level_2ad/255)
+	SET_ALPHA_LEVEL(m_alpha_s.s_3a_2, m_f3_alpha_level_3as*m_f3_alpha_level_2bd/255)
+
+	SET_ALPHA_LEVEL(m_alpha_s.s_3b_0, m_f3_alpha_level_3bs)
+	SET_ALPHA_LEVEL(m_alpha_s.s_3b_1, m_f3_alpha_level_3bs*m_f3_alpha_level_2ad/255)
+	SET_ALPHA_LEVEL(m_alpha_s.s_3b_2, m_f3_alpha_level_3bs*m_f3_alpha_level_2bd/255)
 }
 #undef SET_ALPHA_LEVEL
 
@@ -1075,50 +1045,69 @@ static inline void f3_alpha_set_level()
 #define COLOR2 BYTE4_XOR_LE(1)
 #define COLOR3 BYTE4_XOR_LE(2)
 
+#if defined BURN_SIMD_SSE2
+// the three colour bytes of s scaled by alphas (0 - 256), top byte 0
+static inline __m128i f3_alpha_scale32(INT32 alphas, UINT32 s)
+{
+	__m128i c = _mm_unpacklo_epi8(_mm_cvtsi32_si128(s & 0x00ffffff), _mm_setzero_si128());
+	c = _mm_srli_epi16(_mm_mullo_epi16(c, _mm_set1_epi16(alphas)), 8);
+	return _mm_packus_epi16(c, c);
+}
+#endif
+
 static inline void f3_alpha_blend32_s(INT32 alphas, UINT32 s)
 {
+#if defined BURN_SIMD_SSE2
+	m_dval = (m_dval & 0xff000000) | (UINT32)_mm_cvtsi128_si32(f3_alpha_scale32(alphas, s));
+#else
 	UINT8 *sc = (UINT8 *)&s;
 	UINT8 *dc = (UINT8 *)&m_dval;
 	dc[COLOR1] = (alphas * sc[COLOR1]) >> 8;
 	dc[COLOR2] = (alphas * sc[COLOR2]) >> 8;
 	dc[COLOR3] = (alphas * sc[COLOR3]) >> 8;
+#endif
 }
 
 static inline void f3_alpha_blend32_d(INT32 alphas, UINT32 s)
 {
+#if defined BURN_SIMD_SSE2
+	// saturating add, same as m_add_sat
+	m_dval = (UINT32)_mm_cvtsi128_si32(_mm_adds_epu8(_mm_cvtsi32_si128(m_dval), f3_alpha_scale32(alphas, s)));
+#else
 	UINT8 *sc = (UINT8 *)&s;
 	UINT8 *dc = (UINT8 *)&m_dval;
 	dc[COLOR1] = m_add_sat[dc[COLOR1]][(alphas * sc[COLOR1]) >> 8];
 	dc[COLOR2] = m_add_sat[dc[COLOR2]][(alphas * sc[COLOR2]) >> 8];
 	dc[COLOR3] = m_add_sat[dc[COLOR3]][(alphas * sc[COLOR3]) >> 8];
+#endif
 }
 
 /*============================================================================*/
 
-static inline void f3_alpha_blend_1_1(UINT32 s){f3_alpha_blend32_d(m_alpha_s_1_1,s);}
-static inline void f3_alpha_blend_1_2(UINT32 s){f3_alpha_blend32_d(m_alpha_s_1_2,s);}
-static inline void f3_alpha_blend_1_4(UINT32 s){f3_alpha_blend32_d(m_alpha_s_1_4,s);}
-static inline void f3_alpha_blend_1_5(UINT32 s){f3_alpha_blend32_d(m_alpha_s_1_5,s);}
-static inline void f3_alpha_blend_1_6(UINT32 s){f3_alpha_blend32_d(m_alpha_s_1_6,s);}
-static inline void f3_alpha_blend_1_8(UINT32 s){f3_alpha_blend32_d(m_alpha_s_1_8,s);}
-static inline void f3_alpha_blend_1_9(UINT32 s){f3_alpha_blend32_d(m_alpha_s_1_9,s);}
-static inline void f3_alpha_blend_1_a(UINT32 s){f3_alpha_blend32_d(m_alpha_s_1_a,s);}
+static inline void f3_alpha_blend_1_1(UINT32 s){f3_alpha_blend32_d(m_mix->alpha.s_1_1,s);}
+static inline void f3_alpha_blend_1_2(UINT32 s){f3_alpha_blend32_d(m_mix->alpha.s_1_2,s);}
+static inline void f3_alpha_blend_1_4(UINT32 s){f3_alpha_blend32_d(m_mix->alpha.s_1_4,s);}
+static inline void f3_alpha_blend_1_5(UINT32 s){f3_alpha_blend32_d(m_mix->alpha.s_1_5,s);}
+static inline void f3_alpha_blend_1_6(UINT32 s){f3_alpha_blend32_d(m_mix->alpha.s_1_6,s);}
+static inline void f3_alpha_blend_1_8(UINT32 s){f3_alpha_blend32_d(m_mix->alpha.s_1_8,s);}
+static inline void f3_alpha_blend_1_9(UINT32 s){f3_alpha_blend32_d(m_mix->alpha.s_1_9,s);}
+static inline void f3_alpha_blend_1_a(UINT32 s){f3_alpha_blend32_d(m_mix->alpha.s_1_a,s);}
 
-static inline void f3_alpha_blend_2a_0(UINT32 s){f3_alpha_blend32_s(m_alpha_s_2a_0,s);}
-static inline void f3_alpha_blend_2a_4(UINT32 s){f3_alpha_blend32_d(m_alpha_s_2a_4,s);}
-static inline void f3_alpha_blend_2a_8(UINT32 s){f3_alpha_blend32_d(m_alpha_s_2a_8,s);}
+static inline void f3_alpha_blend_2a_0(UINT32 s){f3_alpha_blend32_s(m_mix->alpha.s_2a_0,s);}
+static inline void f3_alpha_blend_2a_4(UINT32 s){f3_alpha_blend32_d(m_mix->alpha.s_2a_4,s);}
+static inline void f3_alpha_blend_2a_8(UINT32 s){f3_alpha_blend32_d(m_mix->alpha.s_2a_8,s);}
 
-static inline void f3_alpha_blend_2b_0(UINT32 s){f3_alpha_blend32_s(m_alpha_s_2b_0,s);}
-static inline void f3_alpha_blend_2b_4(UINT32 s){f3_alpha_blend32_d(m_alpha_s_2b_4,s);}
-static inline void f3_alpha_blend_2b_8(UINT32 s){f3_alpha_blend32_d(m_alpha_s_2b_8,s);}
+static inline void f3_alpha_blend_2b_0(UINT32 s){f3_alpha_blend32_s(m_mix->alpha.s_2b_0,s);}
+static inline void f3_alpha_blend_2b_4(UINT32 s){f3_alpha_blend32_d(m_mix->alpha.s_2b_4,s);}
+static inline void f3_alpha_blend_2b_8(UINT32 s){f3_alpha_blend32_d(m_mix->alpha.s_2b_8,s);}
 
-static inline void f3_alpha_blend_3a_0(UINT32 s){f3_alpha_blend32_s(m_alpha_s_3a_0,s);}
-static inline void f3_alpha_blend_3a_1(UINT32 s){f3_alpha_blend32_d(m_alpha_s_3a_1,s);}
-static inline void f3_alpha_blend_3a_2(UINT32 s){f3_alpha_blend32_d(m_alpha_s_3a_2,s);}
+static inline void f3_alpha_blend_3a_0(UINT32 s){f3_alpha_blend32_s(m_mix->alpha.s_3a_0,s);}
+static inline void f3_alpha_blend_3a_1(UINT32 s){f3_alpha_blend32_d(m_mix->alpha.s_3a_1,s);}
+static inline void f3_alpha_blend_3a_2(UINT32 s){f3_alpha_blend32_d(m_mix->alpha.s_3a_2,s);}
 
-static inline void f3_alpha_blend_3b_0(UINT32 s){f3_alpha_blend32_s(m_alpha_s_3b_0,s);}
-static inline void f3_alpha_blend_3b_1(UINT32 s){f3_alpha_blend32_d(m_alpha_s_3b_1,s);}
-static inline void f3_alpha_blend_3b_2(UINT32 s){f3_alpha_blend32_d(m_alpha_s_3b_2,s);}
+static inline void f3_alpha_blend_3b_0(UINT32 s){f3_alpha_blend32_s(m_mix->alpha.s_3b_0,s);}
+static inline void f3_alpha_blend_3b_1(UINT32 s){f3_alpha_blend32_d(m_mix->alpha.s_3b_1,s);}
+static inline void f3_alpha_blend_3b_2(UINT32 s){f3_alpha_blend32_d(m_mix->alpha.s_3b_2,s);}
 
 /*============================================================================*/
 
@@ -1138,19 +1127,19 @@ static INT32 dpix_2a_0(UINT32 s_pix)
 {
 	if(s_pix) f3_alpha_blend_2a_0(s_pix);
 	else      m_dval = 0;
-	if(m_pdest_2a) {m_pval |= m_pdest_2a;return 0;}
+	if(m_mix->pdest_2a) {m_pval |= m_mix->pdest_2a;return 0;}
 	return 1;
 }
 static INT32 dpix_2a_4(UINT32 s_pix)
 {
 	if(s_pix) f3_alpha_blend_2a_4(s_pix);
-	if(m_pdest_2a) {m_pval |= m_pdest_2a;return 0;}
+	if(m_mix->pdest_2a) {m_pval |= m_mix->pdest_2a;return 0;}
 	return 1;
 }
 static INT32 dpix_2a_8(UINT32 s_pix)
 {
 	if(s_pix) f3_alpha_blend_2a_8(s_pix);
-	if(m_pdest_2a) {m_pval |= m_pdest_2a;return 0;}
+	if(m_mix->pdest_2a) {m_pval |= m_mix->pdest_2a;return 0;}
 	return 1;
 }
 
@@ -1158,19 +1147,19 @@ static INT32 dpix_3a_0(UINT32 s_pix)
 {
 	if(s_pix) f3_alpha_blend_3a_0(s_pix);
 	else      m_dval = 0;
-	if(m_pdest_3a) {m_pval |= m_pdest_3a;return 0;}
+	if(m_mix->pdest_3a) {m_pval |= m_mix->pdest_3a;return 0;}
 	return 1;
 }
 static INT32 dpix_3a_1(UINT32 s_pix)
 {
 	if(s_pix) f3_alpha_blend_3a_1(s_pix);
-	if(m_pdest_3a) {m_pval |= m_pdest_3a;return 0;}
+	if(m_mix->pdest_3a) {m_pval |= m_mix->pdest_3a;return 0;}
 	return 1;
 }
 static INT32 dpix_3a_2(UINT32 s_pix)
 {
 	if(s_pix) f3_alpha_blend_3a_2(s_pix);
-	if(m_pdest_3a) {m_pval |= m_pdest_3a;return 0;}
+	if(m_mix->pdest_3a) {m_pval |= m_mix->pdest_3a;return 0;}
 	return 1;
 }
 
@@ -1178,19 +1167,19 @@ static INT32 dpix_2b_0(UINT32 s_pix)
 {
 	if(s_pix) f3_alpha_blend_2b_0(s_pix);
 	else      m_dval = 0;
-	if(m_pdest_2b) {m_pval |= m_pdest_2b;return 0;}
+	if(m_mix->pdest_2b) {m_pval |= m_mix->pdest_2b;return 0;}
 	return 1;
 }
 static INT32 dpix_2b_4(UINT32 s_pix)
 {
 	if(s_pix) f3_alpha_blend_2b_4(s_pix);
-	if(m_pdest_2b) {m_pval |= m_pdest_2b;return 0;}
+	if(m_mix->pdest_2b) {m_pval |= m_mix->pdest_2b;return 0;}
 	return 1;
 }
 static INT32 dpix_2b_8(UINT32 s_pix)
 {
 	if(s_pix) f3_alpha_blend_2b_8(s_pix);
-	if(m_pdest_2b) {m_pval |= m_pdest_2b;return 0;}
+	if(m_mix->pdest_2b) {m_pval |= m_mix->pdest_2b;return 0;}
 	return 1;
 }
 
@@ -1198,19 +1187,19 @@ static INT32 dpix_3b_0(UINT32 s_pix)
 {
 	if(s_pix) f3_alpha_blend_3b_0(s_pix);
 	else      m_dval = 0;
-	if(m_pdest_3b) {m_pval |= m_pdest_3b;return 0;}
+	if(m_mix->pdest_3b) {m_pval |= m_mix->pdest_3b;return 0;}
 	return 1;
 }
 static INT32 dpix_3b_1(UINT32 s_pix)
 {
 	if(s_pix) f3_alpha_blend_3b_1(s_pix);
-	if(m_pdest_3b) {m_pval |= m_pdest_3b;return 0;}
+	if(m_mix->pdest_3b) {m_pval |= m_mix->pdest_3b;return 0;}
 	return 1;
 }
 static INT32 dpix_3b_2(UINT32 s_pix)
 {
 	if(s_pix) f3_alpha_blend_3b_2(s_pix);
-	if(m_pdest_3b) {m_pval |= m_pdest_3b;return 0;}
+	if(m_mix->pdest_3b) {m_pval |= m_mix->pdest_3b;return 0;}
 	return 1;
 }
 
@@ -1219,13 +1208,13 @@ static INT32 dpix_2_0(UINT32 s_pix)
 	UINT8 tr2=m_tval&1;
 	if(s_pix)
 	{
-		if(tr2==m_tr_2b)     {f3_alpha_blend_2b_0(s_pix);if(m_pdest_2b) m_pval |= m_pdest_2b;else return 1;}
-		else if(tr2==m_tr_2a)    {f3_alpha_blend_2a_0(s_pix);if(m_pdest_2a) m_pval |= m_pdest_2a;else return 1;}
+		if(tr2==m_mix->tr_2b)     {f3_alpha_blend_2b_0(s_pix);if(m_mix->pdest_2b) m_pval |= m_mix->pdest_2b;else return 1;}
+		else if(tr2==m_mix->tr_2a)    {f3_alpha_blend_2a_0(s_pix);if(m_mix->pdest_2a) m_pval |= m_mix->pdest_2a;else return 1;}
 	}
 	else
 	{
-		if(tr2==m_tr_2b)     {m_dval = 0;if(m_pdest_2b) m_pval |= m_pdest_2b;else return 1;}
-		else if(tr2==m_tr_2a)    {m_dval = 0;if(m_pdest_2a) m_pval |= m_pdest_2a;else return 1;}
+		if(tr2==m_mix->tr_2b)     {m_dval = 0;if(m_mix->pdest_2b) m_pval |= m_mix->pdest_2b;else return 1;}
+		else if(tr2==m_mix->tr_2a)    {m_dval = 0;if(m_mix->pdest_2a) m_pval |= m_mix->pdest_2a;else return 1;}
 	}
 	return 0;
 }
@@ -1234,13 +1223,13 @@ static INT32 dpix_2_4(UINT32 s_pix)
 	UINT8 tr2=m_tval&1;
 	if(s_pix)
 	{
-		if(tr2==m_tr_2b)     {f3_alpha_blend_2b_4(s_pix);if(m_pdest_2b) m_pval |= m_pdest_2b;else return 1;}
-		else if(tr2==m_tr_2a)    {f3_alpha_blend_2a_4(s_pix);if(m_pdest_2a) m_pval |= m_pdest_2a;else return 1;}
+		if(tr2==m_mix->tr_2b)     {f3_alpha_blend_2b_4(s_pix);if(m_mix->pdest_2b) m_pval |= m_mix->pdest_2b;else return 1;}
+		else if(tr2==m_mix->tr_2a)    {f3_alpha_blend_2a_4(s_pix);if(m_mix->pdest_2a) m_pval |= m_mix->pdest_2a;else return 1;}
 	}
 	else
 	{
-		if(tr2==m_tr_2b)     {if(m_pdest_2b) m_pval |= m_pdest_2b;else return 1;}
-		else if(tr2==m_tr_2a)    {if(m_pdest_2a) m_pval |= m_pdest_2a;else return 1;}
+		if(tr2==m_mix->tr_2b)     {if(m_mix->pdest_2b) m_pval |= m_mix->pdest_2b;else return 1;}
+		else if(tr2==m_mix->tr_2a)    {if(m_mix->pdest_2a) m_pval |= m_mix->pdest_2a;else return 1;}
 	}
 	return 0;
 }
@@ -1249,13 +1238,13 @@ static INT32 dpix_2_8(UINT32 s_pix)
 	UINT8 tr2=m_tval&1;
 	if(s_pix)
 	{
-		if(tr2==m_tr_2b)     {f3_alpha_blend_2b_8(s_pix);if(m_pdest_2b) m_pval |= m_pdest_2b;else return 1;}
-		else if(tr2==m_tr_2a)    {f3_alpha_blend_2a_8(s_pix);if(m_pdest_2a) m_pval |= m_pdest_2a;else return 1;}
+		if(tr2==m_mix->tr_2b)     {f3_alpha_blend_2b_8(s_pix);if(m_mix->pdest_2b) m_pval |= m_mix->pdest_2b;else return 1;}
+		else if(tr2==m_mix->tr_2a)    {f3_alpha_blend_2a_8(s_pix);if(m_mix->pdest_2a) m_pval |= m_mix->pdest_2a;else return 1;}
 	}
 	else
 	{
-		if(tr2==m_tr_2b)     {if(m_pdest_2b) m_pval |= m_pdest_2b;else return 1;}
-		else if(tr2==m_tr_2a)    {if(m_pdest_2a) m_pval |= m_pdest_2a;else return 1;}
+		if(tr2==m_mix->tr_2b)     {if(m_mix->pdest_2b) m_pval |= m_mix->pdest_2b;else return 1;}
+		else if(tr2==m_mix->tr_2a)    {if(m_mix->pdest_2a) m_pval |= m_mix->pdest_2a;else return 1;}
 	}
 	return 0;
 }
@@ -1265,13 +1254,13 @@ static INT32 dpix_3_0(UINT32 s_pix)
 	UINT8 tr2=m_tval&1;
 	if(s_pix)
 	{
-		if(tr2==m_tr_3b)     {f3_alpha_blend_3b_0(s_pix);if(m_pdest_3b) m_pval |= m_pdest_3b;else return 1;}
-		else if(tr2==m_tr_3a)    {f3_alpha_blend_3a_0(s_pix);if(m_pdest_3a) m_pval |= m_pdest_3a;else return 1;}
+		if(tr2==m_mix->tr_3b)     {f3_alpha_blend_3b_0(s_pix);if(m_mix->pdest_3b) m_pval |= m_mix->pdest_3b;else return 1;}
+		else if(tr2==m_mix->tr_3a)    {f3_alpha_blend_3a_0(s_pix);if(m_mix->pdest_3a) m_pval |= m_mix->pdest_3a;else return 1;}
 	}
 	else
 	{
-		if(tr2==m_tr_3b)     {m_dval = 0;if(m_pdest_3b) m_pval |= m_pdest_3b;else return 1;}
-		else if(tr2==m_tr_3a)    {m_dval = 0;if(m_pdest_3a) m_pval |= m_pdest_3a;else return 1;}
+		if(tr2==m_mix->tr_3b)     {m_dval = 0;if(m_mix->pdest_3b) m_pval |= m_mix->pdest_3b;else return 1;}
+		else if(tr2==m_mix->tr_3a)    {m_dval = 0;if(m_mix->pdest_3a) m_pval |= m_mix->pdest_3a;else return 1;}
 	}
 	return 0;
 }
@@ -1280,13 +1269,13 @@ static INT32 dpix_3_1(UINT32 s_pix)
 	UINT8 tr2=m_tval&1;
 	if(s_pix)
 	{
-		if(tr2==m_tr_3b)     {f3_alpha_blend_3b_1(s_pix);if(m_pdest_3b) m_pval |= m_pdest_3b;else return 1;}
-		else if(tr2==m_tr_3a)    {f3_alpha_blend_3a_1(s_pix);if(m_pdest_3a) m_pval |= m_pdest_3a;else return 1;}
+		if(tr2==m_mix->tr_3b)     {f3_alpha_blend_3b_1(s_pix);if(m_mix->pdest_3b) m_pval |= m_mix->pdest_3b;else return 1;}
+		else if(tr2==m_mix->tr_3a)    {f3_alpha_blend_3a_1(s_pix);if(m_mix->pdest_3a) m_pval |= m_mix->pdest_3a;else return 1;}
 	}
 	else
 	{
-		if(tr2==m_tr_3b)     {if(m_pdest_3b) m_pval |= m_pdest_3b;else return 1;}
-		else if(tr2==m_tr_3a)    {if(m_pdest_3a) m_pval |= m_pdest_3a;else return 1;}
+		if(tr2==m_mix->tr_3b)     {if(m_mix->pdest_3b) m_pval |= m_mix->pdest_3b;else return 1;}
+		else if(tr2==m_mix->tr_3a)    {if(m_mix->pdest_3a) m_pval |= m_mix->pdest_3a;else return 1;}
 	}
 	return 0;
 }
@@ -1295,13 +1284,13 @@ static INT32 dpix_3_2(UINT32 s_pix)
 	UINT8 tr2=m_tval&1;
 	if(s_pix)
 	{
-		if(tr2==m_tr_3b)     {f3_alpha_blend_3b_2(s_pix);if(m_pdest_3b) m_pval |= m_pdest_3b;else return 1;}
-		else if(tr2==m_tr_3a)    {f3_alpha_blend_3a_2(s_pix);if(m_pdest_3a) m_pval |= m_pdest_3a;else return 1;}
+		if(tr2==m_mix->tr_3b)     {f3_alpha_blend_3b_2(s_pix);if(m_mix->pdest_3b) m_pval |= m_mix->pdest_3b;else return 1;}
+		else if(tr2==m_mix->tr_3a)    {f3_alpha_blend_3a_2(s_pix);if(m_mix->pdest_3a) m_pval |= m_mix->pdest_3a;else return 1;}
 	}
 	else
 	{
-		if(tr2==m_tr_3b)     {if(m_pdest_3b) m_pval |= m_pdest_3b;else return 1;}
-		else if(tr2==m_tr_3a)    {if(m_pdest_3a) m_pval |= m_pdest_3a;else return 1;}
+		if(tr2==m_mix->tr_3b)     {if(m_mix->pdest_3b) m_pval |= m_mix->pdest_3b;else return 1;}
+		else if(tr2==m_mix->tr_3a)    {if(m_mix->pdest_3a) m_pval |= m_mix->pdest_3a;else return 1;}
 	}
 	return 0;
 }
@@ -1490,29 +1479,31 @@ static void init_alpha_blend_func()
 #define GET_PIXMAP_POINTER(pf_num) \
 { \
 	const struct f3_playfield_line_inf *line_tmp=line_t[pf_num]; \
-	m_src##pf_num=line_tmp->src[y]; \
-	m_src_s##pf_num=line_tmp->src_s[y]; \
-	m_src_e##pf_num=line_tmp->src_e[y]; \
-	m_tsrc##pf_num=line_tmp->tsrc[y]; \
-	m_tsrc_s##pf_num=line_tmp->tsrc_s[y]; \
-	m_x_count##pf_num=line_tmp->x_count[y]; \
-	m_x_zoom##pf_num=line_tmp->x_zoom[y]; \
-	m_clip_al##pf_num=line_tmp->clip_in[y]&0xffff; \
-	m_clip_ar##pf_num=line_tmp->clip_in[y]>>16; \
-	m_clip_bl##pf_num=line_tmp->clip_ex[y]&0xffff; \
-	m_clip_br##pf_num=line_tmp->clip_ex[y]>>16; \
-	m_pal_add[pf_num] = line_tmp->pal_add[y]; \
+	struct f3_pixmap *pm=&pixmap[pf_num]; \
+	pm->src=line_tmp->src[y]; \
+	pm->src_s=line_tmp->src_s[y]; \
+	pm->src_e=line_tmp->src_e[y]; \
+	pm->tsrc=line_tmp->tsrc[y]; \
+	pm->tsrc_s=line_tmp->tsrc_s[y]; \
+	pm->x_count=line_tmp->x_count[y]; \
+	pm->x_zoom=line_tmp->x_zoom[y]; \
+	pm->clip_al=line_tmp->clip_in[y]&0xffff; \
+	pm->clip_ar=line_tmp->clip_in[y]>>16; \
+	pm->clip_bl=line_tmp->clip_ex[y]&0xffff; \
+	pm->clip_br=line_tmp->clip_ex[y]>>16; \
+	pm->pal_add=line_tmp->pal_add[y]; \
 }
 
 #define CULC_PIXMAP_POINTER(pf_num) \
 { \
-	m_x_count##pf_num += m_x_zoom##pf_num; \
-	if(m_x_count##pf_num>>16) \
+	struct f3_pixmap *pm=&pixmap[pf_num]; \
+	pm->x_count += pm->x_zoom; \
+	if(pm->x_count>>16) \
 	{ \
-		m_x_count##pf_num &= 0xffff; \
-		m_src##pf_num++; \
-		m_tsrc##pf_num++; \
-		if(m_src##pf_num==m_src_e##pf_num) {m_src##pf_num=m_src_s##pf_num; m_tsrc##pf_num=m_tsrc_s##pf_num;} \
+		pm->x_count &= 0xffff; \
+		pm->src++; \
+		pm->tsrc++; \
+		if(pm->src==pm->src_e) {pm->src=pm->src_s; pm->tsrc=pm->tsrc_s;} \
 	} \
 }
 
@@ -1523,29 +1514,25 @@ if(cx>=clip_als && cx<clip_ars-1 && !(cx>=clip_bls && cx<clip_brs)) \
 		if(sprite_pri) \
 		{ \
 			if(sprite[pf_num]&0x100) break; \
-			if(!m_dpix_sp[sprite_pri]) \
+			if(!mix->dpix_sp[sprite_pri]) \
 			{ \
 				if(!(m_pval&0xf0)) break; \
 				else {dpix_1_sprite(*dsti);*dsti=m_dval;break;} \
 			} \
-			if((*m_dpix_sp[sprite_pri][m_pval>>4])(*dsti)) {*dsti=m_dval;break;} \
+			if((*mix->dpix_sp[sprite_pri][m_pval>>4])(*dsti)) {*dsti=m_dval;break;} \
 		} \
 	}
 
 #define UPDATE_PIXMAP_LP(pf_num) \
-	if (cx>=m_clip_al##pf_num && cx<m_clip_ar##pf_num-1 && !(cx>=m_clip_bl##pf_num && cx<m_clip_br##pf_num)) 	\
+	if (cx>=pixmap[pf_num].clip_al && cx<pixmap[pf_num].clip_ar-1 && !(cx>=pixmap[pf_num].clip_bl && cx<pixmap[pf_num].clip_br)) 	\
 	{ \
-		m_tval=*m_tsrc##pf_num; \
+		m_tval=*pixmap[pf_num].tsrc; \
 		if(m_tval&0xf0) \
-			if((*m_dpix_lp[pf_num][m_pval>>4])(clut[(*m_src##pf_num + m_pal_add[pf_num]) & 0x1fff])) {*dsti=m_dval;break;} \
+			if((*mix->dpix_lp[pf_num][m_pval>>4])(clut[(*pixmap[pf_num].src + pixmap[pf_num].pal_add) & 0x1fff])) {*dsti=m_dval;break;} \
 	}
 
 
-static void draw_scanlines(INT32 xsize,INT16 *draw_line_num,
-							const struct f3_playfield_line_inf **line_t,
-							const INT32 *sprite,
-							UINT32 orient,
-							INT32 skip_layer_num)
+static void draw_scanline(INT32 xsize, INT32 y, const struct f3_line_mix *mix)
 {
 	UINT32 *clut = TaitoPalette;
 	UINT32 bgcolor=clut[0];
@@ -1553,116 +1540,91 @@ static void draw_scanlines(INT32 xsize,INT16 *draw_line_num,
 
 	const INT32 x=46;
 
+	const struct f3_playfield_line_inf *const *line_t = mix->line_t;
+	const INT32 *sprite = mix->sprite;
+	INT32 skip_layer_num = mix->skip_layer_num;
+	struct f3_pixmap pixmap[5] = { };	// zeroed, gcc can't tell the layers are set up before use
+
 	UINT16 clip_als=0, clip_ars=0, clip_bls=0, clip_brs=0;
 
-	UINT8 *dstp0,*dstp;
+	UINT32 *dsti;
+	UINT8 *dstp;
 
-	INT32 yadv = 512;
-	INT32 yadvp = 1024;
-	INT32 i=0,y=draw_line_num[0];
 	INT32 ty = y;
+	INT32 cx=0;
 
 #if 1
-	if (orient & ORIENTATION_FLIP_Y)
+	if (mix->orient & ORIENTATION_FLIP_Y)
 	{
 		ty = 512 - 1 - ty;
-		yadv = -yadv;
-		yadvp = -yadvp;
 	}
 #endif
 
-	dstp0 = TaitoPriorityMap + (ty * 1024) + x;
-
-	m_pdest_2a = m_f3_alpha_level_2ad ? 0x10 : 0;
-	m_pdest_2b = m_f3_alpha_level_2bd ? 0x20 : 0;
-	m_tr_2a =(m_f3_alpha_level_2as==0 && m_f3_alpha_level_2ad==255) ? -1 : 0;
-	m_tr_2b =(m_f3_alpha_level_2bs==0 && m_f3_alpha_level_2bd==255) ? -1 : 1;
-	m_pdest_3a = m_f3_alpha_level_3ad ? 0x40 : 0;
-	m_pdest_3b = m_f3_alpha_level_3bd ? 0x80 : 0;
-	m_tr_3a =(m_f3_alpha_level_3as==0 && m_f3_alpha_level_3ad==255) ? -1 : 0;
-	m_tr_3b =(m_f3_alpha_level_3bs==0 && m_f3_alpha_level_3bd==255) ? -1 : 1;
+	m_mix = mix;
 
-	{
-		UINT32 *dsti0,*dsti;
-		dsti0 = output_bitmap + (ty * 512) + x;
-		while(1)
-		{
-			INT32 cx=0;
+	clip_als=m_sa_line_inf[0].sprite_clip_in[y]&0xffff;
+	clip_ars=m_sa_line_inf[0].sprite_clip_in[y]>>16;
+	clip_bls=m_sa_line_inf[0].sprite_clip_ex[y]&0xffff;
+	clip_brs=m_sa_line_inf[0].sprite_clip_ex[y]>>16;
 
-			clip_als=m_sa_line_inf[0].sprite_clip_in[y]&0xffff;
-			clip_ars=m_sa_line_inf[0].sprite_clip_in[y]>>16;
-			clip_bls=m_sa_line_inf[0].sprite_clip_ex[y]&0xffff;
-			clip_brs=m_sa_line_inf[0].sprite_clip_ex[y]>>16;
+	length=xsize;
+	dsti = output_bitmap + (ty * 512) + x;
+	dstp = TaitoPriorityMap + (ty * 1024) + x;
 
-			length=xsize;
-			dsti = dsti0;
-			dstp = dstp0;
+	switch(skip_layer_num)
+	{
+		case 0: GET_PIXMAP_POINTER(0)
+		case 1: GET_PIXMAP_POINTER(1)
+		case 2: GET_PIXMAP_POINTER(2)
+		case 3: GET_PIXMAP_POINTER(3)
+		case 4: GET_PIXMAP_POINTER(4)
+	}
 
+	while (1)
+	{
+		m_pval=*dstp;
+		if (m_pval!=0xff)
+		{
+			UINT8 sprite_pri;
 			switch(skip_layer_num)
 			{
-				case 0: GET_PIXMAP_POINTER(0)
-				case 1: GET_PIXMAP_POINTER(1)
-				case 2: GET_PIXMAP_POINTER(2)
-				case 3: GET_PIXMAP_POINTER(3)
-				case 4: GET_PIXMAP_POINTER(4)
+				case 0: UPDATE_PIXMAP_SP(0) UPDATE_PIXMAP_LP(0)
+				case 1: UPDATE_PIXMAP_SP(1) UPDATE_PIXMAP_LP(1)
+				case 2: UPDATE_PIXMAP_SP(2) UPDATE_PIXMAP_LP(2)
+				case 3: UPDATE_PIXMAP_SP(3) UPDATE_PIXMAP_LP(3)
+				case 4: UPDATE_PIXMAP_SP(4) UPDATE_PIXMAP_LP(4)
+				case 5: UPDATE_PIXMAP_SP(5)
+						if(!bgcolor) {if(!(m_pval&0xf0)) {*dsti=0;break;}}
+						else dpix_bg(bgcolor);
+						*dsti=m_dval;
 			}
+		}
 
-			while (1)
-			{
-				m_pval=*dstp;
-				if (m_pval!=0xff)
-				{
-					UINT8 sprite_pri;
-					switch(skip_layer_num)
-					{
-						case 0: UPDATE_PIXMAP_SP(0) UPDATE_PIXMAP_LP(0)
-						case 1: UPDATE_PIXMAP_SP(1) UPDATE_PIXMAP_LP(1)
-						case 2: UPDATE_PIXMAP_SP(2) UPDATE_PIXMAP_LP(2)
-						case 3: UPDATE_PIXMAP_SP(3) UPDATE_PIXMAP_LP(3)
-						case 4: UPDATE_PIXMAP_SP(4) UPDATE_PIXMAP_LP(4)
-						case 5: UPDATE_PIXMAP_SP(5)
-								if(!bgcolor) {if(!(m_pval&0xf0)) {*dsti=0;break;}}
-								else dpix_bg(bgcolor);
-								*dsti=m_dval;
-					}
-				}
-
-				if(!(--length)) break;
-				dsti++;
-				dstp++;
-				cx++;
-
-				switch(skip_layer_num)
-				{
-					case 0: CULC_PIXMAP_POINTER(0)
-					case 1: CULC_PIXMAP_POINTER(1)
-					case 2: CULC_PIXMAP_POINTER(2)
-					case 3: CULC_PIXMAP_POINTER(3)
-					case 4: CULC_PIXMAP_POINTER(4)
-				}
-			}
+		if(!(--length)) break;
+		dsti++;
+		dstp++;
+		cx++;
 
-			i++;
-			if(draw_line_num[i]<0) break;
-			if(draw_line_num[i]==y+1)
-			{
-				dsti0 += yadv;
-				dstp0 += yadvp;
-				y++;
-				continue;
-			}
-			else
-			{
-				dsti0 += (draw_line_num[i]-y)*yadv;
-				dstp0 += (draw_line_num[i]-y)*yadvp;
-				y=draw_line_num[i];
-			}
+		switch(skip_layer_num)
+		{
+			case 0: CULC_PIXMAP_POINTER(0)
+			case 1: CULC_PIXMAP_POINTER(1)
+			case 2: CULC_PIXMAP_POINTER(2)
+			case 3: CULC_PIXMAP_POINTER(3)
+			case 4: CULC_PIXMAP_POINTER(4)
 		}
 	}
 }
 #undef GET_PIXMAP_POINTER
 #undef CULC_PIXMAP_POINTER
 
+static void draw_scanlines_range(INT32 nStart, INT32 nEnd, void *)
+{
+	for (INT32 y = nStart; y < nEnd; y++) {
+		draw_scanline(320, y, &m_line_mix[m_line_mix_num[y]]);
+	}
+}
+
 static void visible_tile_check(
 						struct f3_playfield_line_inf *line_t,
 						INT32 line,
@@ -2154,6 +2116,7 @@ static void scanline_draw()
 	INT16 draw_line_num[256];
 
 	UINT32 rot=0;
+	INT32 mix_num=0;
 
 	if (flipscreen)
 	{
@@ -2186,6 +2149,7 @@ static void scanline_draw()
 		INT32 count_skip_layer=0;
 		INT32 sprite[6]={0,0,0,0,0,0};
 		const struct f3_playfield_line_inf *line_t[5];
+		struct f3_line_mix *mix = &m_line_mix[mix_num];
 
 
 		/* find same status of scanlines */
@@ -2292,10 +2256,10 @@ static void scanline_draw()
 			/* set sprite alpha mode */
 			sprite_alpha_check=0;
 			sprite_alpha_all_2a=1;
-			m_dpix_sp[1]=NULL;
-			m_dpix_sp[2]=NULL;
-			m_dpix_sp[4]=NULL;
-			m_dpix_sp[8]=NULL;
+			mix->dpix_sp[1]=NULL;
+			mix->dpix_sp[2]=NULL;
+			mix->dpix_sp[4]=NULL;
+			mix->dpix_sp[8]=NULL;
 			for(i=0;i<4;i++)    /* i = sprite priority offset */
 			{
 				UINT8 sprite_alpha_mode=(sprite_alpha>>(i*2))&3;
@@ -2308,7 +2272,7 @@ static void scanline_draw()
 							sprite_pri_usage&=~sftbit;  // Disable sprite priority block
 						else
 						{
-							m_dpix_sp[sftbit]=m_dpix_n[2];
+							mix->dpix_sp[sftbit]=m_dpix_n[2];
 							sprite_alpha_check|=sftbit;
 						}
 					}
@@ -2319,7 +2283,7 @@ static void scanline_draw()
 							if(m_f3_alpha_level_3as==0 && m_f3_alpha_level_3ad==255) sprite_pri_usage&=~sftbit;
 							else
 							{
-								m_dpix_sp[sftbit]=m_dpix_n[3];
+								mix->dpix_sp[sftbit]=m_dpix_n[3];
 								sprite_alpha_check|=sftbit;
 								sprite_alpha_all_2a=0;
 							}
@@ -2329,7 +2293,7 @@ static void scanline_draw()
 							if(m_f3_alpha_level_3bs==0 && m_f3_alpha_level_3bd==255) sprite_pri_usage&=~sftbit;
 							else
 							{
-								m_dpix_sp[sftbit]=m_dpix_n[5];
+								mix->dpix_sp[sftbit]=m_dpix_n[5];
 								sprite_alpha_check|=sftbit;
 								sprite_alpha_all_2a=0;
 							}
@@ -2409,20 +2373,20 @@ static void scanline_draw()
 					if(alpha_mode[3]>1) alpha_mode[3]=1;
 					if(alpha_mode[4]>1) alpha_mode[4]=1;
 					sprite_alpha_check=0;
-					m_dpix_sp[1]=NULL;
-					m_dpix_sp[2]=NULL;
-					m_dpix_sp[4]=NULL;
-					m_dpix_sp[8]=NULL;
+					mix->dpix_sp[1]=NULL;
+					mix->dpix_sp[2]=NULL;
+					mix->dpix_sp[4]=NULL;
+					mix->dpix_sp[8]=NULL;
 				}
 			}
 		}
 		else
 		{
 			sprite_alpha_check=0;
-			m_dpix_sp[1]=NULL;
-			m_dpix_sp[2]=NULL;
-			m_dpix_sp[4]=NULL;
-			m_dpix_sp[8]=NULL;
+			mix->dpix_sp[1]=NULL;
+			mix->dpix_sp[2]=NULL;
+			mix->dpix_sp[4]=NULL;
+			mix->dpix_sp[8]=NULL;
 		}
 
 
@@ -2529,21 +2493,42 @@ static void scanline_draw()
 			if(alpha_mode[pos]>1)
 			{
 				INT32 alpha_type=(((alpha_mode_flag[pos]>>4)&3)-1)*2;
-				m_dpix_lp[i]=m_dpix_n[alpha_mode[pos]+alpha_type];
+				mix->dpix_lp[i]=m_dpix_n[alpha_mode[pos]+alpha_type];
 				alpha=1;
 			}
 			else
 			{
-				if(alpha) m_dpix_lp[i]=m_dpix_n[1];
-				else      m_dpix_lp[i]=m_dpix_n[0];
+				if(alpha) mix->dpix_lp[i]=m_dpix_n[1];
+				else      mix->dpix_lp[i]=m_dpix_n[0];
 			}
 		}
 		if(sprite[5]&sprite_alpha_check) alpha=1;
 		else if(!alpha) sprite[5]|=0x100;
 
-		draw_scanlines(320,draw_line_num,line_t,sprite,rot,count_skip_layer);
+		/* save the mixer state for these scanlines */
+		memcpy(mix->line_t, line_t, sizeof(line_t));
+		memcpy(mix->sprite, sprite, sizeof(sprite));
+		mix->skip_layer_num = count_skip_layer;
+		mix->orient = rot;
+		mix->pdest_2a = m_f3_alpha_level_2ad ? 0x10 : 0;
+		mix->pdest_2b = m_f3_alpha_level_2bd ? 0x20 : 0;
+		mix->tr_2a =(m_f3_alpha_level_2as==0 && m_f3_alpha_level_2ad==255) ? -1 : 0;
+		mix->tr_2b =(m_f3_alpha_level_2bs==0 && m_f3_alpha_level_2bd==255) ? -1 : 1;
+		mix->pdest_3a = m_f3_alpha_level_3ad ? 0x40 : 0;
+		mix->pdest_3b = m_f3_alpha_level_3bd ? 0x80 : 0;
+		mix->tr_3a =(m_f3_alpha_level_3as==0 && m_f3_alpha_level_3ad==255) ? -1 : 0;
+		mix->tr_3b =(m_f3_alpha_level_3bs==0 && m_f3_alpha_level_3bd==255) ? -1 : 1;
+		mix->alpha = m_alpha_s;
+
+		for(i=0;draw_line_num[i]>=0;i++)
+			m_line_mix_num[draw_line_num[i]]=mix_num;
+		mix_num++;
+
 		if(y_start<0) break;
 	}
+
+	/* every scanline from ys to ye now has its mixer state, mix them on the worker pool */
+	BurnPoolFor(draw_scanlines_range, NULL, ys, ye, 8);
 }
 
 
@@ -2668,15 +2653,6 @@ void TaitoF3VideoInit()
 	m_f3_alpha_level_3bd=127;
 	m_alpha_level_last = -1;
 
-	m_pdest_2a = 0x10;
-	m_pdest_2b = 0x20;
-	m_tr_2a = 0;
-	m_tr_2b = 1;
-	m_pdest_3a = 0x40;
-	m_pdest_3b = 0x80;
-	m_tr_3a = 0;
-	m_tr_3b = 1;
-
 	m_width_mask=(extended_layers) ? 0x3ff : 0x1ff;
 	m_twidth_mask=(extended_layers) ? 0x7f : 0x3f;
 	m_twidth_mask_bit=(extended_layers) ? 7 : 6;
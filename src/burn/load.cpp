@@ -10,6 +10,8 @@ INT32 BurnLoadRomExt(UINT8 *Dest, INT32 i, INT32 nGap, INT32 nFlags)
 
 	if (BurnExtLoadRom == NULL) return 1; // Load function was not defined by the application
 
+	BURN_PROFILE_PHASE(ROMLOAD);
+
 	// Find the length of the rom (as given by the current driver)
 	{
 		ri.nType = 0;
@@ -19,6 +21,8 @@ INT32 BurnLoadRomExt(UINT8 *Dest, INT32 i, INT32 nGap, INT32 nFlags)
 		nLen = ri.nLen;
 	}
 
+	BurnProfileAddBytes(BURN_PROFILE_ROMLOAD, nLen);
+
 	char* RomName = ""; //added by emufan
 	BurnDrvGetRomName(&RomName, i, 0);
 
@@ -109,6 +113,21 @@ INT32 BurnLoadRomExt(UINT8 *Dest, INT32 i, INT32 nGap, INT32 nFlags)
 	return 0;
 }
 
+// Load nLen bytes from nOffset in the rom, for lazily loaded regions (burn_lazy.cpp)
+INT32 BurnLoadRomPart(UINT8 *Dest, INT32 i, INT32 nOffset, INT32 nLen)
+{
+	if (BurnExtLoadRomPart == NULL) return 1; // the application can't do it
+
+	BURN_PROFILE_PHASE(ROMLOAD);
+	BurnProfileAddBytes(BURN_PROFILE_ROMLOAD, nLen);
+
+	INT32 nWrote = 0;
+
+	if (BurnExtLoadRomPart(Dest, &nWrote, i, nOffset, nLen)) return 1;
+
+	return (nWrote == nLen) ? 0 : 1;
+}
+
 INT32 BurnLoadRom(UINT8 *Dest, INT32 i, INT32 nGap)
 {
 	return BurnLoadRomExt(Dest, i, nGap, 0);
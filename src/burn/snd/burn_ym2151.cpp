@@ -251,6 +251,8 @@ INT32 BurnYM2151Init(INT32 nClockFrequency)
 
 INT32 BurnYM2151Init(INT32 nClockFrequency, INT32 use_timer)
 {
+	BURN_PROFILE_PHASE(SOUNDINIT);
+
 	DebugSnd_YM2151Initted = 1;
 
 	bBurnYM2151IsBuffered = 0; // Can I recommend BurnYM2151InitBuffered()? :)
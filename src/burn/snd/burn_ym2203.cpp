@@ -589,6 +589,8 @@ INT32 BurnYM2203Init(INT32 num, INT32 nClockFrequency, FM_IRQHANDLER IRQCallback
 
 INT32 BurnYM2203Init(INT32 num, INT32 nClockFrequency, FM_IRQHANDLER IRQCallback, INT32 (*StreamCallback)(INT32), double (*GetTimeCallback)(), INT32 bAddSignal)
 {
+	BURN_PROFILE_PHASE(SOUNDINIT);
+
 	DebugSnd_YM2203Initted = 1;
 	
 	if (num > MAX_YM2203) num = MAX_YM2203;
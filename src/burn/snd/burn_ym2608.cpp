@@ -341,6 +341,8 @@ INT32 BurnYM2608Init(INT32 nClockFrequency, UINT8* YM2608ADPCMROM, INT32* nYM260
 
 INT32 BurnYM2608Init(INT32 nClockFrequency, UINT8* YM2608ADPCMROM, INT32* nYM2608ADPCMSize, UINT8* YM2608IROM, FM_IRQHANDLER IRQCallback, INT32 (*StreamCallback)(INT32), double (*GetTimeCallback)(), INT32 bAddSignal)
 {
+	BURN_PROFILE_PHASE(SOUNDINIT);
+
 	DebugSnd_YM2608Initted = 1;
 	
 	INT32 timer_chipbase = BurnTimerInit(&YM2608TimerOver, GetTimeCallback);
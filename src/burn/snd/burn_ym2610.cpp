@@ -28,6 +28,16 @@ static double YM2610RightVolumes[3];
 
 INT32 bYM2610UseSeperateVolumes; // support custom Taito panning hardware
 
+extern "C" void (*YM_DELTAT_ROM_TOUCH)(UINT8 *rom, UINT32 start, UINT32 end);
+
+// the chip is about to play rom[start - end], make sure it's loaded (burn_lazy.cpp)
+static void BurnYM2610ROMTouch(UINT8 *rom, UINT32 start, UINT32 end)
+{
+	if (end < start) return;
+
+	BurnLazyTouch(rom, start, end - start + 1);
+}
+
 // ----------------------------------------------------------------------------
 // Execute YM2610 for part of a frame
 
@@ -382,6 +392,8 @@ void BurnYM2610Exit()
 	
 	bYM2610AddSignal = 0;
 	bYM2610UseSeperateVolumes = 0;
+
+	YM_DELTAT_ROM_TOUCH = NULL;
 	
 	DebugSnd_YM2610Initted = 0;
 }
@@ -402,6 +414,8 @@ INT32 BurnYM2610Init(INT32 nClockFrequency, UINT8* YM2610ADPCMAROM, INT32* nYM26
 
 INT32 BurnYM2610Init(INT32 nClockFrequency, UINT8* YM2610ADPCMAROM, INT32* nYM2610ADPCMASize, UINT8* YM2610ADPCMBROM, INT32* nYM2610ADPCMBSize, FM_IRQHANDLER IRQCallback, INT32 (*StreamCallback)(INT32), double (*GetTimeCallback)(), INT32 bAddSignal)
 {
+	BURN_PROFILE_PHASE(SOUNDINIT);
+
 	DebugSnd_YM2610Initted = 1;
 	
 	INT32 timer_chipbase = BurnTimerInit(&YM2610TimerOver, GetTimeCallback);
@@ -427,6 +441,8 @@ INT32 BurnYM2610Init(INT32 nClockFrequency, UINT8* YM2610ADPCMAROM, INT32* nYM26
 
 	if (!nBurnYM2610SoundRate) nBurnYM2610SoundRate = 44100;
 
+	YM_DELTAT_ROM_TOUCH = BurnYM2610ROMTouch;
+
 	AY8910InitYM(0, nClockFrequency, nBurnYM2610SoundRate, NULL, NULL, NULL, NULL, BurnAY8910UpdateRequest);
 	YM2610Init(1, timer_chipbase, nClockFrequency, nBurnYM2610SoundRate, (void**)(&YM2610ADPCMAROM), nYM2610ADPCMASize, (void**)(&YM2610ADPCMBROM), nYM2610ADPCMBSize, &BurnOPNTimerCallback, IRQCallback);
 
@@ -48,6 +48,7 @@ Unmapped registers:
 
 #include "burnint.h"
 #include "c140.h"
+#include "pcm_mix.h"
 
 // --- Future NOTE: if asic219 DOES NOT WORK, this is why!! (line below) -dink
 #define BYTE_XOR_BE(x) (x^1)
@@ -75,6 +76,7 @@ static INT32 m_banking_type;
 /* internal buffers */
 static INT16 *m_mixer_buffer_left;
 static INT16 *m_mixer_buffer_right;
+static INT16 *m_voice_buffer;
 
 static INT32 m_baserate;
 static INT8 *m_pRom;
@@ -177,6 +179,9 @@ void c140_init(INT32 clock, INT32 devtype, UINT8 *c140_rom)
 	m_mixer_buffer_right = m_mixer_buffer_left + m_sample_rate;
 	memset(m_mixer_buffer_left, 0, 2 * sizeof(INT16) * m_sample_rate);
 
+	/* and one for the voice currently being rendered, before it's mixed in */
+	m_voice_buffer = (INT16*)BurnMalloc(sizeof(INT16) * m_sample_rate);
+
 	// init stream/resampler
 	stream.init(m_sample_rate, nBurnSoundRate, 2, 1, c140_update_INT);
     stream.set_volume(1.00);
@@ -194,6 +199,7 @@ void c140_exit()
 		BurnFree(m_mixer_buffer_left);
 		m_mixer_buffer_left = m_mixer_buffer_right = NULL;
 	}
+	BurnFree(m_voice_buffer);
 	stream.exit();
 }
 
@@ -236,7 +242,7 @@ void c140_update_INT(INT16 **streams, INT32 samples_len)
 
 	INT8    *pSampleData;
 	INT32   frequency,delta,offset,pos;
-	INT32   cnt, voicecnt;
+	INT32   cnt, voicecnt, j;
 	INT32   lastdt,prevdt,dltdt;
 	float   pbase=(float)m_baserate*2.0 / (float)m_sample_rate;
 
@@ -298,7 +304,7 @@ void c140_update_INT(INT16 **streams, INT32 samples_len)
 			{
 				//compressed PCM (maybe correct...)
 				/* Loop for enough to fill sample buffer as requested */
-				for(INT32 j=0;j<(nSamplesNeeded);j++)
+				for(j=0;j<(nSamplesNeeded);j++)
 				{
 					offset += delta;
 					cnt = (offset>>16)&0x7fff;
@@ -335,17 +341,16 @@ void c140_update_INT(INT16 **streams, INT32 samples_len)
 					}
 
 					/* Caclulate the sample value */
-					dt=((dltdt*offset)>>16)+prevdt;
-
-					/* Write the data to the sample buffers */
-					*lmix++ +=(dt*lvol)>>(5+5);
-					*rmix++ +=(dt*rvol)>>(5+5);
+					m_voice_buffer[j]=((dltdt*offset)>>16)+prevdt;
 				}
+
+				/* Write the data to the sample buffers */
+				PcmMixAccumulate16(lmix, rmix, m_voice_buffer, j, lvol, rvol, 5+5);
 			}
 			else
 			{
 				/* linear 8bit signed PCM */
-				for(INT32 j=0;j<(nSamplesNeeded);j++)
+				for(j=0;j<(nSamplesNeeded);j++)
 				{
 					offset += delta;
 					cnt = (offset>>16)&0x7fff;
@@ -391,12 +396,11 @@ void c140_update_INT(INT16 **streams, INT32 samples_len)
 					}
 
 					/* Caclulate the sample value */
-					dt=((dltdt*offset)>>16)+prevdt;
-
-					/* Write the data to the sample buffers */
-					*lmix++ +=(dt*lvol)>>5;
-					*rmix++ +=(dt*rvol)>>5;
+					m_voice_buffer[j]=((dltdt*offset)>>16)+prevdt;
 				}
+
+				/* Write the data to the sample buffers */
+				PcmMixAccumulate16(lmix, rmix, m_voice_buffer, j, lvol, rvol, 5);
 			}
 
 			/* Save positional data for next callback */
@@ -2804,6 +2804,10 @@ static void FM_ADPCMAWrite(YM2610 *F2610,int r,int v)
 							logerror("YM2608-YM2610: ADPCM-A start out of range: $%08x\n",adpcm[c].start);
 							adpcm[c].flag = 0;
 						}
+						else if(YM_DELTAT_ROM_TOUCH)
+						{
+							YM_DELTAT_ROM_TOUCH(F2610->pcmbuf, adpcm[c].start, adpcm[c].end);
+						}
 					}
 				}
 			}
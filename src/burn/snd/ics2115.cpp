@@ -201,6 +201,8 @@ void ics_2115_set_volume(double volume)
 
 void ics2115_init(void (*cpu_irq_cb)(INT32), UINT8 *sample_rom, INT32 sample_rom_size)
 {
+	BURN_PROFILE_PHASE(SOUNDINIT);
+
 	DebugSnd_ICS2115Initted = 1;
 
 	m_irq_cb = cpu_irq_cb;
@@ -12,6 +12,7 @@
 
 #include <math.h>
 #include "burnint.h"
+#include "burn_simd.h"
 #include "mpeg_audio.h"
 
 mpeg_audio::mpeg_audio(const void *_base, unsigned int _accepted, bool lsb_first, int _position_align)
@@ -22,8 +23,10 @@ mpeg_audio::mpeg_audio(const void *_base, unsigned int _accepted, bool lsb_first
 	position_align = _position_align ? _position_align - 1 : 0;
 
 	for (int i = 0; i < 32; i++) {
-		for (int j = 0; j < 32; j++)
+		for (int j = 0; j < 32; j++) {
 			m_cos_cache[i][j] = cos(i*(2 * j + 1)*M_PI / 64);
+			m_cos_cache_t[j][i] = m_cos_cache[i][j];
+		}
 	}
 
 	clear();
@@ -756,8 +759,31 @@ void mpeg_audio::retrieve_subbuffer(int step)
 		memcpy(subbuffer[chan], bdata[chan][step], 32*sizeof(subbuffer[0][0]));
 }
 
+// The SIMD versions work across neighbouring outputs, each lane does the same
+// operations in the same order as the plain C loop, so the output is identical.
+
 void mpeg_audio::idct32(const double *input, double *output)
 {
+#if defined BURN_SIMD_SSE2
+	for (int i = 0; i < 32; i += 8) {
+		__m128d s0 = _mm_setzero_pd();
+		__m128d s1 = _mm_setzero_pd();
+		__m128d s2 = _mm_setzero_pd();
+		__m128d s3 = _mm_setzero_pd();
+		for (int j = 0; j < 32; j++) {
+			const __m128d in = _mm_set1_pd(input[j]);
+			const double *c = &m_cos_cache_t[j][i];
+			s0 = _mm_add_pd(s0, _mm_mul_pd(in, _mm_loadu_pd(c + 0)));
+			s1 = _mm_add_pd(s1, _mm_mul_pd(in, _mm_loadu_pd(c + 2)));
+			s2 = _mm_add_pd(s2, _mm_mul_pd(in, _mm_loadu_pd(c + 4)));
+			s3 = _mm_add_pd(s3, _mm_mul_pd(in, _mm_loadu_pd(c + 6)));
+		}
+		_mm_storeu_pd(output + i + 0, s0);
+		_mm_storeu_pd(output + i + 2, s1);
+		_mm_storeu_pd(output + i + 4, s2);
+		_mm_storeu_pd(output + i + 6, s3);
+	}
+#else
 	// Simplest idct32 ever, non-fast at all
 	for (int i = 0; i < 32; i++) {
 		double s = 0;
@@ -765,11 +791,31 @@ void mpeg_audio::idct32(const double *input, double *output)
 			s += input[j] * m_cos_cache[i][j];
 		output[i] = s;
 	}
+#endif
 }
 
 void mpeg_audio::resynthesis(const double *input, double *output)
 {
 	memset(output, 0, 32*sizeof(output[0]));
+#if defined BURN_SIMD_SSE2
+	for(int j=0; j<64*8; j+=64) {
+		for(int i=0; i<16; i+=2) {
+			// input[32-i+j], input[32-(i+1)+j]
+			const __m128d r = _mm_shuffle_pd(_mm_loadu_pd(input+31-i+j), _mm_loadu_pd(input+31-i+j), 1);
+			const __m128d a = _mm_mul_pd(_mm_loadu_pd(input+i+j), _mm_loadu_pd(synthesis_filter+i+j));
+			const __m128d b = _mm_mul_pd(r, _mm_loadu_pd(synthesis_filter+32+i+j));
+			_mm_storeu_pd(output+i, _mm_add_pd(_mm_loadu_pd(output+i), _mm_sub_pd(a, b)));
+		}
+		output[16] -= input[16+j]*synthesis_filter[32+16+j];
+		for(int i=17; i<31; i+=2) {
+			const __m128d r = _mm_shuffle_pd(_mm_loadu_pd(input+31-i+j), _mm_loadu_pd(input+31-i+j), 1);
+			const __m128d a = _mm_mul_pd(r, _mm_loadu_pd(synthesis_filter+i+j));
+			const __m128d b = _mm_mul_pd(_mm_loadu_pd(input+i+j), _mm_loadu_pd(synthesis_filter+32+i+j));
+			_mm_storeu_pd(output+i, _mm_sub_pd(_mm_loadu_pd(output+i), _mm_add_pd(a, b)));
+		}
+		output[31] -= input[1+j]*synthesis_filter[31+j] + input[31+j]*synthesis_filter[32+31+j];
+	}
+#else
 	for(int j=0; j<64*8; j+=64) {
 		for(int i=0; i<16; i++)
 			output[i] += input[   i+j]*synthesis_filter[i+j] - input[32-i+j]*synthesis_filter[32+i+j];
@@ -777,6 +823,7 @@ void mpeg_audio::resynthesis(const double *input, double *output)
 		for(int i=17; i<32; i++)
 			output[i] -= input[32-i+j]*synthesis_filter[i+j] + input[   i+j]*synthesis_filter[32+i+j];
 	}
+#endif
 }
 
 void mpeg_audio::scale_and_clamp(const double *input, short *output, int step)
@@ -96,6 +96,7 @@ private:
 	double audio_buffer[2][32*32];
 	int audio_buffer_pos[2];
 	double m_cos_cache[32][32];
+	double m_cos_cache_t[32][32];	// [j][i], for the SIMD idct32 (not scanned, it's constant)
 
 	int current_pos, current_limit;
 
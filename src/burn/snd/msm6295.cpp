@@ -550,6 +550,8 @@ void MSM6295SetSamplerate(INT32 nChip, INT32 nSamplerate)
 
 INT32 MSM6295Init(INT32 nChip, INT32 nSamplerate, bool bAddSignal)
 {
+	BURN_PROFILE_PHASE(SOUNDINIT);
+
 	DebugSnd_MSM6295Initted = 1;
 	
 	if (nBurnSoundRate > 0) {
@@ -0,0 +1,131 @@
+// pcm_mix.cpp - shared mixing kernel for the multi-voice PCM sample players
+// The fetch stage (position stepping, sample reads) is scalar, the volume/pan
+// stage works on whole runs and uses SSE2 where available.
+
+#include "burnint.h"
+#include "burn_simd.h"
+#include "pcm_mix.h"
+
+#define PCMMIX_CHUNK	256
+
+void PcmMixFetch8(INT16 *pDest, const UINT8 *pData, UINT32 *pPos, UINT32 nStep, INT32 nShift, INT32 nCount, INT32 nFlags)
+{
+	UINT32 nPos = *pPos;
+	const UINT8 nXor = (nFlags & PCMMIX_UNSIGNED8) ? 0x80 : 0x00;
+
+	for (INT32 i = 0; i < nCount; i++) {
+		pDest[i] = (INT8)(pData[nPos >> nShift] ^ nXor);
+		nPos += nStep;
+	}
+
+	*pPos = nPos;
+}
+
+void PcmMixAccumulate(INT32 *pLeft, INT32 *pRight, const INT16 *pSrc, INT32 nCount, INT32 nVolL, INT32 nVolR)
+{
+	INT32 i = 0;
+
+#if defined BURN_SIMD_SSE2
+	const __m128i vl = _mm_set1_epi16(nVolL);
+	const __m128i vr = _mm_set1_epi16(nVolR);
+
+	for (; i + 8 <= nCount; i += 8) {
+		const __m128i s = _mm_loadu_si128((const __m128i*)(pSrc + i));
+
+		// 16x16 -> 32 products, low/high halves interleaved back together
+		__m128i lo = _mm_mullo_epi16(s, vl);
+		__m128i hi = _mm_mulhi_epi16(s, vl);
+		__m128i *l = (__m128i*)(pLeft + i);
+		_mm_storeu_si128(l + 0, _mm_add_epi32(_mm_loadu_si128(l + 0), _mm_unpacklo_epi16(lo, hi)));
+		_mm_storeu_si128(l + 1, _mm_add_epi32(_mm_loadu_si128(l + 1), _mm_unpackhi_epi16(lo, hi)));
+
+		lo = _mm_mullo_epi16(s, vr);
+		hi = _mm_mulhi_epi16(s, vr);
+		__m128i *r = (__m128i*)(pRight + i);
+		_mm_storeu_si128(r + 0, _mm_add_epi32(_mm_loadu_si128(r + 0), _mm_unpacklo_epi16(lo, hi)));
+		_mm_storeu_si128(r + 1, _mm_add_epi32(_mm_loadu_si128(r + 1), _mm_unpackhi_epi16(lo, hi)));
+	}
+#endif
+
+	for (; i < nCount; i++) {
+		pLeft[i] += pSrc[i] * nVolL;
+		pRight[i] += pSrc[i] * nVolR;
+	}
+}
+
+void PcmMixAccumulate16(INT16 *pLeft, INT16 *pRight, const INT16 *pSrc, INT32 nCount, INT32 nVolL, INT32 nVolR, INT32 nShift)
+{
+	INT32 i = 0;
+
+#if defined BURN_SIMD_SSE2
+	const __m128i vl = _mm_set1_epi16(nVolL);
+	const __m128i vr = _mm_set1_epi16(nVolR);
+	const __m128i sh = _mm_cvtsi32_si128(nShift);
+
+	for (; i + 8 <= nCount; i += 8) {
+		const __m128i s = _mm_loadu_si128((const __m128i*)(pSrc + i));
+
+		for (INT32 ch = 0; ch < 2; ch++) {
+			const __m128i v = (ch == 0) ? vl : vr;
+			INT16 *pDest = (ch == 0) ? pLeft : pRight;
+
+			const __m128i lo = _mm_mullo_epi16(s, v);
+			const __m128i hi = _mm_mulhi_epi16(s, v);
+			__m128i p0 = _mm_sra_epi32(_mm_unpacklo_epi16(lo, hi), sh);
+			__m128i p1 = _mm_sra_epi32(_mm_unpackhi_epi16(lo, hi), sh);
+
+			// truncate to 16 bits (sign-extend the low half so the saturating pack can't clip)
+			p0 = _mm_srai_epi32(_mm_slli_epi32(p0, 16), 16);
+			p1 = _mm_srai_epi32(_mm_slli_epi32(p1, 16), 16);
+
+			__m128i *d = (__m128i*)(pDest + i);
+			_mm_storeu_si128(d, _mm_add_epi16(_mm_loadu_si128(d), _mm_packs_epi32(p0, p1)));
+		}
+	}
+#endif
+
+	for (; i < nCount; i++) {
+		pLeft[i] += (pSrc[i] * nVolL) >> nShift;
+		pRight[i] += (pSrc[i] * nVolR) >> nShift;
+	}
+}
+
+void PcmMixRun8(INT32 *pLeft, INT32 *pRight, const UINT8 *pData, UINT32 *pPos, UINT32 nStep, INT32 nShift, INT32 nCount, INT32 nVolL, INT32 nVolR, INT32 nFlags)
+{
+	INT16 nBuffer[PCMMIX_CHUNK];
+
+	while (nCount > 0) {
+		const INT32 nChunk = (nCount > PCMMIX_CHUNK) ? PCMMIX_CHUNK : nCount;
+
+		PcmMixFetch8(nBuffer, pData, pPos, nStep, nShift, nChunk, nFlags);
+		PcmMixAccumulate(pLeft, pRight, nBuffer, nChunk, nVolL, nVolR);
+
+		pLeft += nChunk;
+		pRight += nChunk;
+		nCount -= nChunk;
+	}
+}
+
+INT32 PcmMixDot(const INT16 *pA, const INT16 *pB, INT32 nCount)
+{
+	UINT32 nSum = 0;
+	INT32 i = 0;
+
+#if defined BURN_SIMD_SSE2
+	__m128i acc = _mm_setzero_si128();
+
+	for (; i + 8 <= nCount; i += 8) {
+		acc = _mm_add_epi32(acc, _mm_madd_epi16(_mm_loadu_si128((const __m128i*)(pA + i)), _mm_loadu_si128((const __m128i*)(pB + i))));
+	}
+
+	acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(1, 0, 3, 2)));
+	acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(2, 3, 0, 1)));
+	nSum = (UINT32)_mm_cvtsi128_si32(acc);
+#endif
+
+	for (; i < nCount; i++) {
+		nSum += (UINT32)(pA[i] * pB[i]);
+	}
+
+	return (INT32)nSum;
+}
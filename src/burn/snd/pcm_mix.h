@@ -0,0 +1,39 @@
+// pcm_mix.h - shared mixing kernel for the multi-voice PCM sample players
+// (SegaPCM, C140, QSound...)
+//
+// Voices are played in runs: the chip works out how many output samples it can
+// generate before its next loop/end/key-off event (PcmMixSteps), then hands the
+// whole run to the kernel. Positions are UINT32 fixed point, with nShift
+// fractional bits (sample index = nPos >> nShift).
+//
+// There's no interpolation stage: none of these chips interpolate per voice.
+// QSound resamples its mixed output instead (interpolate_buffer in qs_c.cpp),
+// and K054539 (double gains, per-sample delay line) keeps its own mixing loop.
+
+#define PCMMIX_UNSIGNED8	0x01	// UINT8 sample data, centred on 0x80
+
+// number of output samples that can be read before nPos reaches nLimit
+inline static INT32 PcmMixSteps(UINT32 nPos, UINT32 nStep, UINT32 nLimit)
+{
+	if (nPos >= nLimit) return 0;
+	if (nStep == 0) return 0x7fffffff;
+
+	UINT64 nSteps = ((UINT64)(nLimit - nPos) + nStep - 1) / nStep;
+
+	return (nSteps > 0x7fffffff) ? 0x7fffffff : (INT32)nSteps;
+}
+
+// read nCount samples (8-bit data) into pDest, advancing *pPos by nStep per sample
+void PcmMixFetch8(INT16 *pDest, const UINT8 *pData, UINT32 *pPos, UINT32 nStep, INT32 nShift, INT32 nCount, INT32 nFlags);
+
+// pLeft[i] += pSrc[i] * nVolL, pRight[i] += pSrc[i] * nVolR (volumes must fit in an INT16)
+void PcmMixAccumulate(INT32 *pLeft, INT32 *pRight, const INT16 *pSrc, INT32 nCount, INT32 nVolL, INT32 nVolR);
+
+// as above, into 16-bit mix buffers: pLeft[i] += (pSrc[i] * nVolL) >> nShift, wrapping like the INT16 adds it replaces
+void PcmMixAccumulate16(INT16 *pLeft, INT16 *pRight, const INT16 *pSrc, INT32 nCount, INT32 nVolL, INT32 nVolR, INT32 nShift);
+
+// fetch + accumulate of one voice run, nCount output samples
+void PcmMixRun8(INT32 *pLeft, INT32 *pRight, const UINT8 *pData, UINT32 *pPos, UINT32 nStep, INT32 nShift, INT32 nCount, INT32 nVolL, INT32 nVolR, INT32 nFlags);
+
+// sum of pA[i] * pB[i], wraps on overflow (same as the INT32 accumulate loops it replaces)
+INT32 PcmMixDot(const INT16 *pA, const INT16 *pB, INT32 nCount);
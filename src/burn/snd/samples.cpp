@@ -1,7 +1,16 @@
 // FB Alpha sample player module
 
+// Samples are decoded at init, so missing ones show up there and the zip is
+// never read from the render path. With the file cache (burn_cache.cpp) on, the
+// decoded (16-bit stereo, nBurnSoundRate) data is written there and mapped back,
+// later runs and other instances map it rather than decoding again.
+// nBurnSampleBudget caps how much mapped data is held, the least recently
+// triggered samples that aren't playing are unmapped and mapped again when
+// they're next triggered. Without the cache everything stays in memory.
+
 #include "burnint.h"
 #include "samples.h"
+#include <sys/stat.h>
 
 #define SAMPLE_DIRECTORY	szAppSamplesPath
 #define MAX_CHANNEL			32
@@ -18,6 +27,7 @@ static INT32 bNiceFadeVolume = 0;
 static INT32 bAddToStream = 0;
 static INT32 nTotalSamples = 0;
 INT32 bBurnSampleTrimSampleEnd = 0;
+INT32 nBurnSampleBudget = 32 * 1024 * 1024;
 
 struct sample_format
 {
@@ -31,11 +41,35 @@ struct sample_format
 	double gain[2];
 	double gain_target[2]; // ramp gain up or down to gain_target (see BurnSampleSetRouteFade())
 	INT32 output_dir[2];
+	UINT32 last_used;	// nSampleTick when last triggered (for the budget)
+	UINT32 data_size;	// bytes held at data
+	INT32 mapped_size;	// !0 if data is in a cache file mapping
+};
+
+// cache file header, the decoded data follows it
+struct sample_cache_header
+{
+	char magic[4];
+	UINT32 version;			// native byte order, so also catches endian mismatches
+	UINT32 archive_size;	// to notice the sample set being replaced
+	UINT32 archive_time;
+	UINT32 length;			// in stereo samples
+	UINT32 reserved[3];
 };
 
+#define SAMPLE_CACHE_VERSION	1
+
 static struct sample_format *samples		= NULL; // store samples
 static struct sample_format *sample_ptr		= NULL; // generic pointer for sample
 static INT32 sample_channels[MAX_CHANNEL];			// channel handling
+
+static UINT32 nSampleTick = 0;
+static UINT32 nSampleMemory = 0;					// bytes of decoded data held
+static INT32 nEnableSamples = 0;
+static char szSampleSetPath[MAX_PATH + 128];		// path + setname, without extension
+static char szSampleSetName[128];
+static UINT32 nSampleArchiveSize = 0;
+static UINT32 nSampleArchiveTime = 0;
 	
 static void make_raw(UINT8 *src, UINT32 len)
 {
@@ -234,7 +268,8 @@ void BurnSampleSetBuffered(INT32 (*pCPUCyclesCB)(), INT32 nCpuMHZ)
 	nDACCPUMHZ = nCpuMHZ;
 }
 
-void BurnSampleInitOne(INT32); // below...
+static INT32 BurnSampleLoad(INT32 sample); // below...
+static void BurnSampleFree(INT32 sample);
 
 INT32 BurnSampleGetChannelSample(INT32 channel)
 {
@@ -262,10 +297,11 @@ void BurnSamplePlay(INT32 sample)
 
 	if (sample_ptr->flags & SAMPLE_IGNORE) return;
 
-	if (sample_ptr->flags & SAMPLE_NOSTORE) {
-		BurnSampleInitOne(sample);
-	}
+	sample_ptr->last_used = ++nSampleTick;
+
+	if (BurnSampleLoad(sample)) return;
 
+	sample_ptr = &samples[sample];
 	sample_ptr->playing = 1;
 	sample_ptr->position = 0;
 }
@@ -488,7 +524,6 @@ void BurnSampleReset()
 	IN_RESET = 0;
 }
 
-INT32 __cdecl ZipLoadOneFile(char* arcName, const char* fileName, void** Dest, INT32* pnWrote);
 char* TCHARToANSI(const TCHAR* pszInString, char* pszOutString, INT32 nOutSize);
 #define _TtoA(a)	TCHARToANSI(a, NULL, 0)
 
@@ -497,6 +532,8 @@ void BurnSampleInit(INT32 bAdd /*add samples to stream?*/)
 	bAddToStream = bAdd;
 	nTotalSamples = 0;
 	bNiceFadeVolume = 0;
+	nSampleTick = 0;
+	nSampleMemory = 0;
 
 	DebugSnd_SamplesInitted = 1;
 
@@ -505,39 +542,42 @@ void BurnSampleInit(INT32 bAdd /*add samples to stream?*/)
 		return;
 	}
 
-	INT32 length;
 	char path[256*2];
-	char setname[128];
-	void *destination = NULL;
 	char szTempPath[MAX_PATH];
 	sprintf(szTempPath, "%s", _TtoA(SAMPLE_DIRECTORY));
 
 	// test to see if file exists
-	INT32 nEnableSamples = 0;
+	nEnableSamples = 0;
+	nSampleArchiveSize = 0;
+	nSampleArchiveTime = 0;
 
 	if (BurnDrvGetTextA(DRV_SAMPLENAME) == NULL) { // called with no samples
 		nTotalSamples = 0;
 		return;
 	}
 
-	strcpy(setname, BurnDrvGetTextA(DRV_SAMPLENAME));
-	sprintf(path, "%s%s.zip", szTempPath, setname);
-	
-	FILE *test = fopen(path, "rb");
-	if (test) 
+	strncpy(szSampleSetName, BurnDrvGetTextA(DRV_SAMPLENAME), sizeof(szSampleSetName) - 1);
+	szSampleSetName[sizeof(szSampleSetName) - 1] = 0;
+	sprintf(szSampleSetPath, "%s%s", szTempPath, szSampleSetName);
+
+	// the archive's size and date are kept to validate the cached samples
+	struct stat st;
+
+	sprintf(path, "%s.zip", szSampleSetPath);
+	if (stat(path, &st) == 0)
 	{
 		nEnableSamples = 1;
-		fclose(test);
+		nSampleArchiveSize = (UINT32)st.st_size;
+		nSampleArchiveTime = (UINT32)st.st_mtime;
 	}
-	
+
 #ifdef INCLUDE_7Z_SUPPORT
-	sprintf(path, "%s%s.7z", szTempPath, setname);
-	
-	test = fopen(path, "rb");
-	if (test)
-	{	
+	sprintf(path, "%s.7z", szSampleSetPath);
+	if (stat(path, &st) == 0)
+	{
 		nEnableSamples = 1;
-		fclose(test);
+		nSampleArchiveSize += (UINT32)st.st_size;
+		nSampleArchiveTime ^= (UINT32)st.st_mtime;
 	}
 #endif
 
@@ -553,50 +593,15 @@ void BurnSampleInit(INT32 bAdd /*add samples to stream?*/)
 	samples = (sample_format*)BurnMalloc(sizeof(sample_format) * nTotalSamples);
 	memset (samples, 0, sizeof(sample_format) * nTotalSamples);
 
-	BurnSetProgressRange(0.99); // Expand Progress bar
-	BurnUpdateProgress(0.0, _T("Loading samples..."), 0);
-
 	for (INT32 i = 0; i < nTotalSamples; i++) {
-		BurnUpdateProgress(1.0 / nTotalSamples, NULL, 0);
-
 		BurnDrvGetSampleInfo(&si, i);
-		char *szSampleNameTmp = NULL;
-		BurnDrvGetSampleName(&szSampleNameTmp, i, 0);
 
 		sample_ptr = &samples[i];
-		
-		// append .wav to filename
-		char szSampleName[1024];
-		memset(&szSampleName, 0, sizeof(szSampleName));
-		strncpy(&szSampleName[0], szSampleNameTmp, sizeof(szSampleName) - 5); // leave space for ".wav" + null, just incase!
-		strcat(&szSampleName[0], ".wav");
 
 		if (si.nFlags == 0) break;
 
-		if (si.nFlags & SAMPLE_NOSTORE) {
-			sample_ptr->flags = si.nFlags;
-			sample_ptr->data = NULL;
-			continue;
-		}
-
-		sprintf (path, "%s%s", szTempPath, setname);
-
-		destination = NULL;
-		length = 0;
-
-		if (nEnableSamples) {
-			ZipLoadOneFile((char*)path, (const char*)szSampleName, &destination, &length);
-		}
+		sample_ptr->flags = (nEnableSamples) ? si.nFlags : SAMPLE_IGNORE;
 
-		if (length) {
-			sample_ptr->flags = si.nFlags;
-			bprintf(0, _T("Loading \"%S\": "), szSampleName);
-			make_raw((UINT8*)destination, length);
-			free(destination); // ZipLoadOneFile uses malloc()
-		} else {
-			sample_ptr->flags = SAMPLE_IGNORE;
-		}
-		
 		sample_ptr->gain[BURN_SND_SAMPLE_ROUTE_1] = 1.00;
 		sample_ptr->gain_target[BURN_SND_SAMPLE_ROUTE_1] = 1.00;
 
@@ -607,73 +612,198 @@ void BurnSampleInit(INT32 bAdd /*add samples to stream?*/)
 		sample_ptr->output_dir[BURN_SND_SAMPLE_ROUTE_2] = BURN_SND_ROUTE_BOTH;
 		sample_ptr->playback_rate = 100;
 	}
+
+	if (nEnableSamples == 0) return;
+
+	BurnSetProgressRange(0.99); // Expand Progress bar
+	BurnUpdateProgress(0.0, _T("Loading samples..."), 0);
+
+	for (INT32 i = 0; i < nTotalSamples; i++) {
+		BurnUpdateProgress(1.0 / nTotalSamples, NULL, 0);
+
+		if (BurnSampleLoad(i)) continue;
+
+		// SAMPLE_NOSTORE: only kept while playing, BurnSamplePlay() maps it from the cache
+		// (or, with the cache off, decodes it again)
+		if (samples[i].flags & SAMPLE_NOSTORE) {
+			BurnSampleFree(i);
+		}
+	}
 }
 
-void BurnSampleInitOne(INT32 sample)
+static void BurnSampleFree(INT32 sample)
 {
-	if (sample >= nTotalSamples) {
-		return;
+	struct sample_format *ptr = &samples[sample];
+
+	if (ptr->data == NULL) return;
+
+	if (ptr->mapped_size) {
+		BurnCacheUnmap(ptr->data - sizeof(sample_cache_header), ptr->mapped_size);
+		ptr->data = NULL;
+	} else {
+		BurnFree(ptr->data);
 	}
 
-	{
-		struct sample_format *clr_ptr = &samples[0];
-
-		int i = 0;
-		while (i < nTotalSamples) {
-			
-			if (clr_ptr->data != NULL && i != sample && (clr_ptr->flags & SAMPLE_NOSTORE)) {
-				BurnFree(clr_ptr->data);
-				clr_ptr->playing = 0;
-				clr_ptr->playback_rate = 100;
-				clr_ptr->data = NULL;
-			}
+	nSampleMemory -= ptr->data_size;
+	ptr->data_size = 0;
+	ptr->mapped_size = 0;
+}
 
-			clr_ptr++, i++;
+// drop samples that aren't playing until nSize more bytes fit in the budget
+static void BurnSampleMakeRoom(INT32 sample, UINT32 nSize)
+{
+	for (INT32 i = 0; i < nTotalSamples; i++) {
+		struct sample_format *ptr = &samples[i];
+
+		// SAMPLE_NOSTORE: only kept while playing
+		if (i != sample && ptr->data != NULL && ptr->playing == 0 && (ptr->flags & SAMPLE_NOSTORE)) {
+			BurnSampleFree(i);
 		}
 	}
 
-	if ((sample_ptr->flags & SAMPLE_NOSTORE) == 0) {
-		return;
+	if (nBurnSampleBudget <= 0) return;
+
+	while (nSampleMemory + nSize > (UINT32)nBurnSampleBudget) {
+		INT32 nOldest = -1;
+
+		for (INT32 i = 0; i < nTotalSamples; i++) {
+			struct sample_format *ptr = &samples[i];
+
+			// only mappings, they come back cheaply. A private copy would have to be decoded again
+			if (i == sample || ptr->data == NULL || ptr->playing || ptr->mapped_size == 0) continue;
+
+			if (nOldest == -1 || (INT32)(ptr->last_used - samples[nOldest].last_used) < 0) {
+				nOldest = i;
+			}
+		}
+
+		if (nOldest == -1) break; // everything else is playing, go over budget
+
+		BurnSampleFree(nOldest);
 	}
+}
 
-	INT32 length;
-	char path[256];
-	char setname[128];
-	void *destination = NULL;
-	char szTempPath[MAX_PATH];
-	sprintf(szTempPath, "%s", _TtoA(SAMPLE_DIRECTORY));
+static void BurnSampleCacheName(char *szName, INT32 nLen, INT32 sample)
+{
+	snprintf(szName, nLen, "%s.%03d.%d%s.smp", szSampleSetName, sample, nBurnSoundRate, bBurnSampleTrimSampleEnd ? "t" : "");
+}
 
-	strcpy(setname, BurnDrvGetTextA(DRV_SAMPLENAME));
-	sprintf(path, "%s%s.zip", szTempPath, setname);
+static INT32 BurnSampleMapCached(INT32 sample)
+{
+	struct sample_format *ptr = &samples[sample];
+	char szName[256];
+	INT32 nSize = 0;
+
+	BurnSampleCacheName(szName, sizeof(szName), sample);
+
+	UINT8 *pMap = (UINT8*)BurnCacheMap(szName, &nSize);
+	if (pMap == NULL) return 1;
+
+	sample_cache_header *hdr = (sample_cache_header*)pMap;
+
+	if (nSize < (INT32)sizeof(sample_cache_header) || memcmp(hdr->magic, "FBSM", 4) || hdr->version != SAMPLE_CACHE_VERSION ||
+		hdr->archive_size != nSampleArchiveSize || hdr->archive_time != nSampleArchiveTime ||
+		hdr->length == 0 || (UINT32)nSize != sizeof(sample_cache_header) + hdr->length * 4)
+	{
+		BurnCacheUnmap(pMap, nSize);
+		return 1;
+	}
+
+	BurnSampleMakeRoom(sample, hdr->length * 4);
+
+	ptr->data = pMap + sizeof(sample_cache_header);
+	ptr->length = hdr->length;
+	ptr->data_size = hdr->length * 4;
+	ptr->mapped_size = nSize;
+	nSampleMemory += ptr->data_size;
+
+	return 0;
+}
+
+INT32 __cdecl ZipLoadOneFile(char* arcName, const char* fileName, void** Dest, INT32* pnWrote);
+
+// make sure the sample's data is there, returns 1 if it can't be played
+static INT32 BurnSampleLoad(INT32 sample)
+{
+	if (sample >= nTotalSamples) return 1;
+
+	struct sample_format *ptr = &samples[sample];
+
+	if (ptr->data != NULL) return 0;
+	if (ptr->flags & SAMPLE_IGNORE) return 1;
+
+	if (BurnSampleMapCached(sample) == 0) return 0;
 
-	struct BurnSampleInfo si;
-	BurnDrvGetSampleInfo(&si, sample);
 	char *szSampleNameTmp = NULL;
 	BurnDrvGetSampleName(&szSampleNameTmp, sample, 0);
 
-	sample_ptr = &samples[sample];
-
 	// append .wav to filename
 	char szSampleName[1024];
 	memset(&szSampleName, 0, sizeof(szSampleName));
 	strncpy(&szSampleName[0], szSampleNameTmp, sizeof(szSampleName) - 5); // leave space for ".wav" + null, just incase!
 	strcat(&szSampleName[0], ".wav");
 
-	if (sample_ptr->playing || sample_ptr->data != NULL || sample_ptr->flags == SAMPLE_IGNORE) {
-		return;
-	}
+	void *destination = NULL;
+	INT32 length = 0;
 
-	sprintf (path, "%s%s", szTempPath, setname);
+	ZipLoadOneFile(szSampleSetPath, (const char*)szSampleName, &destination, &length);
 
-	destination = NULL;
-	length = 0;
-	ZipLoadOneFile((char*)path, (const char*)szSampleName, &destination, &length);
-		
 	if (length) {
+		// make_raw() resets these, keep them for samples restored from a savestate
+		UINT8 playing = ptr->playing;
+		UINT64 position = ptr->position;
+
+		bprintf(0, _T("Loading \"%S\": "), szSampleName);
+		sample_ptr = ptr;
 		make_raw((UINT8*)destination, length);
+
+		ptr->playing = playing;
+		ptr->position = position;
+	}
+
+	if (destination) {
+		free(destination); // ZipLoadOneFile uses malloc()
+	}
+
+	if (ptr->data == NULL) {
+		bprintf(PRINT_ERROR, _T("Sample \"%S\" not found in %S\n"), szSampleName, szSampleSetName);
+		ptr->flags = SAMPLE_IGNORE;
+		ptr->playing = 0;
+		return 1;
+	}
+
+	ptr->data_size = ptr->length * 4;
+	BurnSampleMakeRoom(sample, ptr->data_size);
+	nSampleMemory += ptr->data_size;
+
+	// hand it to the cache, then swap the private copy for the shared mapping
+	sample_cache_header hdr;
+	memset(&hdr, 0, sizeof(hdr));
+	memcpy(hdr.magic, "FBSM", 4);
+	hdr.version = SAMPLE_CACHE_VERSION;
+	hdr.archive_size = nSampleArchiveSize;
+	hdr.archive_time = nSampleArchiveTime;
+	hdr.length = ptr->length;
+
+	char szName[256];
+	BurnSampleCacheName(szName, sizeof(szName), sample);
+
+	if (BurnCacheWrite(szName, &hdr, sizeof(hdr), ptr->data, ptr->length * 4) == 0) {
+		UINT8 *data = ptr->data;
+		UINT32 data_size = ptr->data_size;
+
+		ptr->data = NULL;
+		nSampleMemory -= data_size;
+
+		if (BurnSampleMapCached(sample)) {
+			ptr->data = data; // couldn't map it back, keep ours
+			nSampleMemory += data_size;
+		} else {
+			BurnFree(data);
+		}
 	}
 
-	free(destination); // ZipLoadOneFile uses malloc()
+	return 0;
 }
 
 // round ##.###### to ##.##
@@ -742,9 +872,7 @@ void BurnSampleExit()
 	if (!DebugSnd_SamplesInitted) return;
 
 	for (INT32 i = 0; i < nTotalSamples; i++) {
-		sample_ptr = &samples[i];
-		if (sample_ptr)
-			BurnFree (sample_ptr->data);
+		BurnSampleFree(i);
 	}
 
 	if (samples) {
@@ -822,6 +950,12 @@ static void BurnSampleRender_INT(UINT32 pLen)
 		sample_ptr = &samples[i];
 		if (sample_ptr->playing == 0) continue;
 
+		if (sample_ptr->data == NULL) {
+			// resumed or restored from a savestate before it was ever triggered
+			if (BurnSampleLoad(i)) continue;
+			sample_ptr = &samples[i];
+		}
+
 		INT32 playlen = pLen;
 		INT32 length = sample_ptr->length;
 		UINT64 pos = sample_ptr->position;
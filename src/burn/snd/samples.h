@@ -3,7 +3,8 @@
 #define SAMPLE_NOLOOP		(1<<2) // don't allow this to loop
 
 // Change this to 0 to 1 if using samples in a low-ram environment.
-// May cause momentary stutter while sample loads.
+// Samples are decoded at init either way, this drops them again until
+// they're played and as soon as they stop (see also nBurnSampleBudget).
 #define SAMPLE_NOSTORE		(0<<3) // only keep in memory while playing
 #define SAMPLE_NODUMP       (1<<4) // dump not available
 
@@ -52,6 +53,7 @@ void BurnSampleSync();
 
 
 extern INT32 bBurnSampleTrimSampleEnd; // set before BurnSampleInit();
+extern INT32 nBurnSampleBudget; // bytes of cache-mapped samples kept around, 0 = no limit
 
 #define BURN_SND_SAMPLE_ROUTE_1			0
 #define BURN_SND_SAMPLE_ROUTE_2			1
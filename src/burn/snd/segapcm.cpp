@@ -5,6 +5,7 @@
 
 #include "burnint.h"
 #include "segapcm.h"
+#include "pcm_mix.h"
 
 #define MAX_CHIPS		2
 
@@ -40,11 +41,10 @@ static void SegaPCMUpdateOne(INT32 nChip, INT32 nLength)
 			UINT32 Addr = (Regs[0x85] << 16) | (Regs[0x84] << 8) | Chip[nChip]->low[Channel];
 			UINT32 Loop = (Regs[0x05] << 16) | (Regs[0x04] << 8);
 			UINT8 End = Regs[6] + 1;
-			INT32 i;
-			
-			for (i = 0; i < nLength; i++) {
-				INT8 v = 0;
+			UINT32 Step = (Regs[7] * Chip[nChip]->UpdateStep) >> 16;
+			INT32 i = 0;
 
+			while (i < nLength) {
 				if ((Addr >> 16) == End) {
 					if (Regs[0x86] & 2) {
 						Regs[0x86] |= 1;
@@ -54,11 +54,15 @@ static void SegaPCMUpdateOne(INT32 nChip, INT32 nLength)
 					}
 				}
 
-				v = Rom[Addr >> 8] - 0x80;
+				// play up to the end page (or the 24-bit wrap, if the end page is behind us) in one run
+				UINT32 Page = Addr >> 16;
+				INT32 nRun = (Page == End) ? 1 : PcmMixSteps(Addr, Step, (Page < End) ? (End << 16) : 0x1000000);
+				if (nRun > nLength - i) nRun = nLength - i;
 
-				Left[nChip][i] += v * Regs[2];
-				Right[nChip][i] += v * Regs[3];
-				Addr = (Addr + ((Regs[7] * Chip[nChip]->UpdateStep) >> 16)) & 0xffffff;
+				PcmMixRun8(Left[nChip] + i, Right[nChip] + i, Rom, &Addr, Step, 8, nRun, Regs[2], Regs[3], PCMMIX_UNSIGNED8);
+
+				Addr &= 0xffffff;
+				i += nRun;
 			}
 
 			Regs[0x84] = Addr >> 8;
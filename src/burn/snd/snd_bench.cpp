@@ -0,0 +1,893 @@
+// snd_bench.cpp - sound core benchmark
+// Runs a sound core on its own (no driver, no roms), driven by a synthetic
+// register trace: a little sequencer that keys notes on/off every few frames
+// on rotating channels, like a sound driver would. The output is rendered a
+// frame at a time, exactly how the drivers call the cores, and timed.
+//
+// The checksum covers all the rendered output, so it can be used to check an
+// optimisation is bit-exact (same core, rate & length -> same checksum).
+
+#include "burnint.h"
+#include "timer.h"
+#include "burn_ym2151.h"
+#include "burn_ym2203.h"
+#include "burn_ym2608.h"
+#include "burn_ym2610.h"
+#include "burn_ym2612.h"
+#include "burn_ymf262.h"
+#include "burn_ymf278b.h"
+#include "c140.h"
+#include "k054539.h"
+#include "segapcm.h"
+#include "es5506.h"
+#include "ics2115.h"
+#include "cps.h"			// QSound, also brings in msm6295.h
+
+#define BENCH_ROM_SIZE		0x200000
+#define BENCH_NOTE_FRAMES	6			// a new note every 6 frames (10 a second)
+#define BENCH_BATCH_FRAMES	60			// frames rendered per timed pass (nFrames is a multiple)
+
+static UINT8 *BenchROM = NULL;
+static UINT32 nBenchSeed;
+static INT32 nBenchNote;				// number of notes keyed so far
+
+static UINT32 BenchRand()
+{
+	nBenchSeed = nBenchSeed * 1103515245 + 12345;
+
+	return nBenchSeed >> 16;
+}
+
+// sample data: a few cycles of a (slightly noisy) triangle wave every 256 bytes, at
+// different pitches. 0x80 and 0x88 are used as end markers by some chips, keep them out
+static void BenchROMInit()
+{
+	for (INT32 i = 0; i < BENCH_ROM_SIZE; i++) {
+		INT32 nPeriod = 16 << ((i >> 8) & 3);
+		INT32 nPhase = i & (nPeriod - 1);
+		INT32 nValue = ((nPhase < (nPeriod / 2)) ? nPhase : (nPeriod - nPhase)) * 0xe0 / nPeriod - 0x38;
+
+		nValue += (BenchRand() & 7) - 4;
+
+		UINT8 d = nValue & 0xff;
+		if (d == 0x80 || d == 0x88) d++;
+
+		BenchROM[i] = d;
+	}
+}
+
+// FM callbacks: the register writes all happen at the start of the frame
+static INT32 BenchSynchroniseStream(INT32)
+{
+	return 0;
+}
+
+static double BenchGetTime()
+{
+	return 0.0;
+}
+
+// ----------------------------------------------------------------------------
+// OPM (YM2151)
+
+static const UINT8 OPMNotes[12] = { 0x0, 0x1, 0x2, 0x4, 0x5, 0x6, 0x8, 0x9, 0xa, 0xc, 0xd, 0xe };
+
+static void OPMWrite(UINT8 nReg, UINT8 nData)
+{
+	BurnYM2151Write(0, nReg);
+	BurnYM2151Write(1, nData);
+}
+
+static void YM2151BenchInit()
+{
+	BurnYM2151Init(3579545);
+
+	OPMWrite(0x18, 0xc0);									// LFO
+	OPMWrite(0x19, 0x90);
+	OPMWrite(0x1b, 0x02);
+
+	for (INT32 ch = 0; ch < 8; ch++) {
+		OPMWrite(0x20 + ch, 0xc0 | ((ch & 7) << 3) | (ch & 7));	// L+R, feedback, algorithm
+		OPMWrite(0x38 + ch, 0x21);
+
+		for (INT32 op = 0; op < 4; op++) {
+			INT32 r = (op << 3) + ch;
+			OPMWrite(0x40 + r, 0x01 + op);						// DT1/MUL
+			OPMWrite(0x60 + r, (op == 3) ? 0x04 : 0x20);		// TL
+			OPMWrite(0x80 + r, 0x1f);							// KS/AR
+			OPMWrite(0xa0 + r, 0x85);							// AMS-EN/D1R
+			OPMWrite(0xc0 + r, 0x02);							// DT2/D2R
+			OPMWrite(0xe0 + r, 0x47);							// D1L/RR
+		}
+	}
+}
+
+static void YM2151BenchNote()
+{
+	INT32 ch = nBenchNote & 7;
+	INT32 nNote = BenchRand() % 60;
+
+	OPMWrite(0x08, ch);										// key off
+	OPMWrite(0x28 + ch, ((2 + nNote / 12) << 4) | OPMNotes[nNote % 12]);
+	OPMWrite(0x30 + ch, (BenchRand() & 0x3f) << 2);
+	OPMWrite(0x08, 0x78 | ch);								// key on, all operators
+}
+
+static void YM2151BenchRender()
+{
+	BurnYM2151Render(pBurnSoundOut, nBurnSoundLen);
+}
+
+static void YM2151BenchExit()
+{
+	BurnYM2151Exit();
+}
+
+// ----------------------------------------------------------------------------
+// OPN family (YM2203, YM2608, YM2610, YM2612)
+
+static const UINT16 OPNFNums[12] = { 617, 654, 693, 734, 778, 824, 873, 925, 980, 1038, 1100, 1165 };
+
+static INT32 nOPNChip;									// 2203, 2608, 2610 or 2612
+
+static void OPNWrite(INT32 nPort, UINT8 nReg, UINT8 nData)
+{
+	switch (nOPNChip) {
+		case 2203:
+			BurnYM2203Write(0, 0, nReg);
+			BurnYM2203Write(0, 1, nData);
+			break;
+
+		case 2608:
+			BurnYM2608Write((nPort << 1) + 0, nReg);
+			BurnYM2608Write((nPort << 1) + 1, nData);
+			break;
+
+		case 2610:
+			BurnYM2610Write((nPort << 1) + 0, nReg);
+			BurnYM2610Write((nPort << 1) + 1, nData);
+			break;
+
+		case 2612:
+			BurnYM2612Write(0, (nPort << 1) + 0, nReg);
+			BurnYM2612Write(0, (nPort << 1) + 1, nData);
+			break;
+	}
+}
+
+// FM channels as (port << 2) | channel, in key-on register order
+static INT32 OPNChannel(INT32 n)
+{
+	switch (nOPNChip) {
+		case 2203: return n % 3;
+		case 2610: return ((n & 2) << 1) | (1 + (n & 1));		// only 1, 2, 5 & 6 are connected
+	}
+
+	n %= 6;
+	return ((n / 3) << 2) | (n % 3);
+}
+
+static void OPNSetup()
+{
+	INT32 nPorts = (nOPNChip == 2203) ? 1 : 2;
+
+	if (nOPNChip != 2203) OPNWrite(0, 0x22, 0x0b);			// LFO
+	if (nOPNChip == 2612) OPNWrite(0, 0x2b, 0x00);			// DAC off
+
+	for (INT32 p = 0; p < nPorts; p++) {
+		for (INT32 c = 0; c < 3; c++) {
+			OPNWrite(p, 0xb0 + c, 0x32);						// feedback/algorithm
+			OPNWrite(p, 0xb4 + c, 0xc0 | (p << 4) | c);			// L+R, AMS/PMS
+
+			for (INT32 op = 0; op < 4; op++) {
+				INT32 r = (op << 2) + c;
+				OPNWrite(p, 0x30 + r, 0x01 + op);				// DT/MUL
+				OPNWrite(p, 0x40 + r, (op == 3) ? 0x04 : 0x1c);	// TL
+				OPNWrite(p, 0x50 + r, 0x1f);					// KS/AR
+				OPNWrite(p, 0x60 + r, 0x85);					// AM/DR
+				OPNWrite(p, 0x70 + r, 0x02);					// SR
+				OPNWrite(p, 0x80 + r, 0x47);					// SL/RR
+			}
+		}
+	}
+
+	if (nOPNChip != 2612) {									// SSG, 3 tones
+		OPNWrite(0, 0x07, 0x38);
+		for (INT32 c = 0; c < 3; c++) {
+			OPNWrite(0, 0x08 + c, 0x0a);
+		}
+	}
+}
+
+static void OPNNote()
+{
+	INT32 ch = OPNChannel(nBenchNote);
+	INT32 p = ch >> 2, c = ch & 3;
+	INT32 nNote = BenchRand() % 60;
+	INT32 nFNum = OPNFNums[nNote % 12];
+
+	OPNWrite(0, 0x28, ch);									// key off
+	OPNWrite(p, 0xa4 + c, ((2 + nNote / 12) << 3) | (nFNum >> 8));
+	OPNWrite(p, 0xa0 + c, nFNum & 0xff);
+	OPNWrite(0, 0x28, 0xf0 | ch);							// key on
+
+	if (nOPNChip != 2612) {
+		INT32 nPeriod = 0x40 + (BenchRand() & 0x3ff);
+		OPNWrite(0, 0x00 + ((nBenchNote % 3) << 1), nPeriod & 0xff);
+		OPNWrite(0, 0x01 + ((nBenchNote % 3) << 1), nPeriod >> 8);
+	}
+}
+
+static void YM2203BenchInit()
+{
+	nOPNChip = 2203;
+	BurnYM2203Init(1, 3000000, NULL, BenchSynchroniseStream, BenchGetTime, 0);
+	OPNSetup();
+}
+
+static void YM2203BenchRender()
+{
+	BurnYM2203Update(pBurnSoundOut, nBurnSoundLen);
+}
+
+static void YM2203BenchExit()
+{
+	BurnYM2203Exit();
+}
+
+static INT32 nYM2608ADPCMSize;
+
+static void YM2608BenchInit()
+{
+	nOPNChip = 2608;
+	nYM2608ADPCMSize = 0x40000;
+	BurnYM2608Init(8000000, BenchROM, &nYM2608ADPCMSize, BenchROM + 0x40000, NULL, BenchSynchroniseStream, BenchGetTime, 0);
+	OPNSetup();
+
+	OPNWrite(0, 0x11, 0x3f);								// rhythm total level
+	for (INT32 i = 0; i < 6; i++) {
+		OPNWrite(0, 0x18 + i, 0xdf);
+	}
+}
+
+static void YM2608BenchNote()
+{
+	OPNNote();
+
+	static const UINT8 Rhythm[4] = { 0x01, 0x08, 0x03, 0x28 };	// bass drum, hi-hat, snare, tom
+	OPNWrite(0, 0x10, Rhythm[nBenchNote & 3]);
+}
+
+static void YM2608BenchRender()
+{
+	BurnYM2608Update(pBurnSoundOut, nBurnSoundLen);
+}
+
+static void YM2608BenchExit()
+{
+	BurnYM2608Exit();
+}
+
+static INT32 nYM2610ADPCMASize, nYM2610ADPCMBSize;
+
+static void YM2610BenchInit()
+{
+	nOPNChip = 2610;
+	nYM2610ADPCMASize = nYM2610ADPCMBSize = 0x100000;
+	BurnYM2610Init(8000000, BenchROM, &nYM2610ADPCMASize, BenchROM + 0x100000, &nYM2610ADPCMBSize, NULL, BenchSynchroniseStream, BenchGetTime, 0);
+	OPNSetup();
+
+	OPNWrite(1, 0x01, 0x3f);								// ADPCM-A total level
+	for (INT32 i = 0; i < 6; i++) {
+		OPNWrite(1, 0x08 + i, 0xdf);						// L+R, level
+		OPNWrite(1, 0x10 + i, 0x00);						// start (256 byte units), 128kb each
+		OPNWrite(1, 0x18 + i, i << 1);
+		OPNWrite(1, 0x20 + i, 0xff);						// end
+		OPNWrite(1, 0x28 + i, (i << 1) + 1);
+	}
+
+	OPNWrite(0, 0x11, 0xc0);								// ADPCM-B, looping in the background
+	OPNWrite(0, 0x12, 0x00);
+	OPNWrite(0, 0x13, 0x00);
+	OPNWrite(0, 0x14, 0xff);
+	OPNWrite(0, 0x15, 0x0f);
+	OPNWrite(0, 0x19, 0x00);
+	OPNWrite(0, 0x1a, 0x60);
+	OPNWrite(0, 0x1b, 0xc0);
+	OPNWrite(0, 0x10, 0x90);
+}
+
+static void YM2610BenchNote()
+{
+	OPNNote();
+
+	INT32 c = nBenchNote % 6;
+	OPNWrite(1, 0x00, 0x80 | (1 << c));						// ADPCM-A dump/key on
+	OPNWrite(1, 0x00, 1 << c);
+}
+
+static void YM2610BenchRender()
+{
+	BurnYM2610Update(pBurnSoundOut, nBurnSoundLen);
+}
+
+static void YM2610BenchExit()
+{
+	BurnYM2610Exit();
+}
+
+static void YM2612BenchInit()
+{
+	nOPNChip = 2612;
+	BurnYM2612Init(1, 7670454, NULL, BenchSynchroniseStream, BenchGetTime, 0);
+	OPNSetup();
+}
+
+static void YM2612BenchRender()
+{
+	BurnYM2612Update(pBurnSoundOut, nBurnSoundLen);
+}
+
+static void YM2612BenchExit()
+{
+	BurnYM2612Exit();
+}
+
+// ----------------------------------------------------------------------------
+// OPL3 (YMF262)
+
+static const UINT16 OPLFNums[12] = { 0x157, 0x16b, 0x181, 0x198, 0x1b0, 0x1ca, 0x1e5, 0x202, 0x220, 0x241, 0x263, 0x287 };
+static const UINT8 OPLSlots[9] = { 0x00, 0x01, 0x02, 0x08, 0x09, 0x0a, 0x10, 0x11, 0x12 };
+
+static void OPL3Write(INT32 nBank, UINT8 nReg, UINT8 nData)
+{
+	BurnYMF262Write((nBank << 1) + 0, nReg);
+	BurnYMF262Write((nBank << 1) + 1, nData);
+}
+
+static void YMF262BenchInit()
+{
+	BurnYMF262Init(14318180, NULL, BenchSynchroniseStream, 0);
+
+	OPL3Write(1, 0x05, 0x01);								// OPL3 mode
+	OPL3Write(1, 0x04, 0x00);
+	OPL3Write(0, 0xbd, 0xc0);								// deep AM/vibrato
+
+	for (INT32 b = 0; b < 2; b++) {
+		for (INT32 c = 0; c < 9; c++) {
+			INT32 m = OPLSlots[c], k = m + 3;
+
+			OPL3Write(b, 0x20 + m, 0x61);					// AM/VIB/EG/KSR/MUL
+			OPL3Write(b, 0x20 + k, 0x21);
+			OPL3Write(b, 0x40 + m, 0x18);					// KSL/TL
+			OPL3Write(b, 0x40 + k, 0x00);
+			OPL3Write(b, 0x60 + m, 0xf4);					// AR/DR
+			OPL3Write(b, 0x60 + k, 0xf3);
+			OPL3Write(b, 0x80 + m, 0x27);					// SL/RR
+			OPL3Write(b, 0x80 + k, 0x27);
+			OPL3Write(b, 0xe0 + m, c & 7);					// waveform
+			OPL3Write(b, 0xe0 + k, 0);
+			OPL3Write(b, 0xc0 + c, 0x3a);					// L+R, feedback, FM
+		}
+	}
+}
+
+static void YMF262BenchNote()
+{
+	INT32 b = (nBenchNote / 9) & 1, c = nBenchNote % 9;
+	INT32 nNote = BenchRand() % 60;
+	INT32 nFNum = OPLFNums[nNote % 12];
+	INT32 nBlock = (2 + nNote / 12) << 2;
+
+	OPL3Write(b, 0xb0 + c, nBlock | (nFNum >> 8));			// key off
+	OPL3Write(b, 0xa0 + c, nFNum & 0xff);
+	OPL3Write(b, 0xb0 + c, 0x20 | nBlock | (nFNum >> 8));	// key on
+}
+
+static void YMF262BenchRender()
+{
+	BurnYMF262Update(nBurnSoundLen);
+}
+
+static void YMF262BenchExit()
+{
+	BurnYMF262Exit();
+}
+
+// ----------------------------------------------------------------------------
+// OPL4 wavetable (YMF278B)
+
+static void OPL4Write(UINT8 nReg, UINT8 nData)
+{
+	BurnYMF278BSelectRegister(2, nReg);
+	BurnYMF278BWriteRegister(2, nData);
+}
+
+static void YMF278BBenchInit()
+{
+	// wave headers for waves 0 - 15, 8-bit samples of 0x7000 bytes, looping
+	for (INT32 w = 0; w < 16; w++) {
+		UINT8 *p = BenchROM + w * 12;
+		UINT32 nStart = 0x10000 + w * 0x8000;
+		UINT32 nLen = 0x7000;
+
+		p[0] = (nStart >> 16) & 0x3f;
+		p[1] = nStart >> 8;
+		p[2] = nStart;
+		p[3] = 0x00;											// loop point
+		p[4] = 0x00;
+		p[5] = (0x10000 - nLen) >> 8;							// end, two's complement
+		p[6] = (0x10000 - nLen);
+		p[7] = 0x00;											// LFO/VIB
+		p[8] = 0xf0;											// AR/D1R
+		p[9] = 0x00;											// DL/D2R
+		p[10] = 0x05;											// RC/RR
+		p[11] = 0x00;											// AM
+	}
+
+	BurnYMF278BInit(33868800, BenchROM, BENCH_ROM_SIZE, NULL, BenchSynchroniseStream);
+}
+
+static void YMF278BBenchNote()
+{
+	static const UINT8 Octaves[3] = { 0xf0, 0x00, 0x10 };	// -1, 0, +1
+
+	INT32 s = nBenchNote % 24;
+	INT32 nFNum = BenchRand() & 0x3ff;
+
+	OPL4Write(0x68 + s, 0x00);								// key off
+	OPL4Write(0x08 + s, nBenchNote & 0x0f);					// wave number (loads the header)
+	OPL4Write(0x20 + s, (nFNum & 0x7f) << 1);
+	OPL4Write(0x38 + s, Octaves[BenchRand() % 3] | (nFNum >> 7));
+	OPL4Write(0x50 + s, 0x10);								// TL
+	OPL4Write(0x68 + s, 0x80 | (s & 0x0f));					// key on, pan
+}
+
+static void YMF278BBenchRender()
+{
+	BurnYMF278BUpdate(nBurnSoundLen);
+}
+
+static void YMF278BBenchExit()
+{
+	BurnYMF278BExit();
+}
+
+// ----------------------------------------------------------------------------
+// MSM6295
+
+static void MSM6295BenchInit()
+{
+	// sample table: 127 samples of 4kb each
+	for (INT32 i = 1; i < 128; i++) {
+		UINT32 nStart = i * 0x1000, nEnd = nStart + 0xfff;
+		UINT8 *p = BenchROM + i * 8;
+
+		p[0] = nStart >> 16; p[1] = nStart >> 8; p[2] = nStart;
+		p[3] = nEnd >> 16;   p[4] = nEnd >> 8;   p[5] = nEnd;
+	}
+
+	MSM6295ROM = BenchROM;
+	MSM6295Init(0, 1000000 / 132, 0);
+	MSM6295SetBank(0, BenchROM, 0, 0x3ffff);
+	MSM6295SetRoute(0, 1.00, BURN_SND_ROUTE_BOTH);
+}
+
+static void MSM6295BenchNote()
+{
+	INT32 c = nBenchNote & 3;
+
+	MSM6295Write(0, 0x08 << c);								// stop
+	MSM6295Write(0, 0x80 | (1 + BenchRand() % 127));		// sample
+	MSM6295Write(0, (0x10 << c) | (c << 1));				// channel, attenuation
+}
+
+static void MSM6295BenchRender()
+{
+	MSM6295Render(0, pBurnSoundOut, nBurnSoundLen);
+}
+
+static void MSM6295BenchExit()
+{
+	MSM6295Exit(0);
+	MSM6295ROM = NULL;
+}
+
+// ----------------------------------------------------------------------------
+// QSound
+
+static void QSoundBenchInit()
+{
+	CpsQSam = (INT8*)BenchROM;
+	nCpsQSamLen = BENCH_ROM_SIZE;
+
+	QscInit(nBurnSoundRate);
+}
+
+static void QSoundBenchNote()
+{
+	INT32 v = nBenchNote & 15;
+	INT32 nStart = (BenchRand() & 0x7f) << 8;
+
+	// the DSP clears its voice state when it starts up, so pan/echo go with each note
+	QscWrite(0x80 + v, 0x110 + (v << 1));					// pan
+	QscWrite(0xba + v, (v & 1) ? 0x0800 : 0);				// echo
+	QscWrite(((v - 1) & 15) << 3, 0x8000 | (v & 0x1f));		// bank (for the next voice, bit 15 = sample rom)
+	QscWrite((v << 3) + 1, nStart);							// address
+	QscWrite((v << 3) + 2, 0x0800 + (BenchRand() & 0x0fff));	// rate
+	QscWrite((v << 3) + 3, 0x8000);							// phase
+	QscWrite((v << 3) + 4, 0x1000);							// loop length
+	QscWrite((v << 3) + 5, nStart + 0x2000);				// end
+	QscWrite((v << 3) + 6, 0x2000);							// volume
+}
+
+static void QSoundBenchFrame()
+{
+	QscNewFrame();
+}
+
+static void QSoundBenchRender()
+{
+	QscUpdate(nBurnSoundLen);
+}
+
+static void QSoundBenchExit()
+{
+	QscExit();
+
+	CpsQSam = NULL;
+	nCpsQSamLen = 0;
+}
+
+// ----------------------------------------------------------------------------
+// C140
+
+static void C140BenchInit()
+{
+	c140_init(21390, C140_TYPE_SYSTEM21, BenchROM);
+}
+
+static void C140BenchNote()
+{
+	INT32 v = nBenchNote % 24;
+	INT32 nStart = (BenchRand() & 0x3f) << 8;
+	INT32 nFreq = 0x2000 + (BenchRand() & 0x3fff);
+	INT32 r = v << 4;
+
+	c140_write(r + 5, 0x00);									// key off
+	c140_write(r + 0, 0x40 + (v & 0x1f));						// volume right
+	c140_write(r + 1, 0x60 - (v & 0x1f));						// volume left
+	c140_write(r + 2, nFreq >> 8);
+	c140_write(r + 3, nFreq & 0xff);
+	c140_write(r + 4, v & 3);									// bank
+	c140_write(r + 6, nStart >> 8);
+	c140_write(r + 7, nStart & 0xff);
+	c140_write(r + 8, (nStart + 0x3000) >> 8);
+	c140_write(r + 9, (nStart + 0x3000) & 0xff);
+	c140_write(r + 10, (nStart + 0x1000) >> 8);
+	c140_write(r + 11, (nStart + 0x1000) & 0xff);
+	c140_write(r + 5, 0x80 | 0x10 | ((v & 1) << 3));			// key on, loop, odd voices compressed
+}
+
+static void C140BenchRender()
+{
+	c140_update(pBurnSoundOut, nBurnSoundLen);
+}
+
+static void C140BenchExit()
+{
+	c140_exit();
+}
+
+// ----------------------------------------------------------------------------
+// K054539
+
+static void K054539BenchInit()
+{
+	// 8 samples of 0x8000 bytes at 0x100000, with end markers (0x80 for 8-bit, 0x88 for dpcm)
+	for (INT32 ch = 0; ch < 8; ch++) {
+		BenchROM[0x100000 + ch * 0x8000 + 0x7fff] = (ch == 7) ? 0x88 : 0x80;
+	}
+
+	K054539Init(0, 48000, BenchROM, BENCH_ROM_SIZE);
+	K054539Write(0, 0x22f, 0x01);							// enable
+}
+
+static void K054539BenchNote()
+{
+	INT32 ch = nBenchNote & 7;
+	INT32 nDelta = 0x8000 + (BenchRand() & 0xffff);
+	INT32 nStart = 0x100000 + ch * 0x8000;
+	INT32 r = ch << 5;
+
+	K054539Write(0, 0x215, 1 << ch);						// key off
+	K054539Write(0, r + 0x00, nDelta);
+	K054539Write(0, r + 0x01, nDelta >> 8);
+	K054539Write(0, r + 0x02, nDelta >> 16);
+	K054539Write(0, r + 0x03, 0x10 + ch);					// volume
+	K054539Write(0, r + 0x04, (ch & 1) ? 0x20 : 0x80);		// reverb (odd channels)
+	K054539Write(0, r + 0x05, 0x11 + (ch << 1));			// pan
+	K054539Write(0, r + 0x08, 0x00);						// loop
+	K054539Write(0, r + 0x09, (nStart >> 8) & 0xff);
+	K054539Write(0, r + 0x0a, nStart >> 16);
+	K054539Write(0, r + 0x0c, 0x00);						// start
+	K054539Write(0, r + 0x0d, (nStart >> 8) & 0xff);
+	K054539Write(0, r + 0x0e, nStart >> 16);
+	K054539Write(0, 0x200 + (ch << 1), (ch == 7) ? 0x08 : 0x00);	// 8-bit pcm, one dpcm
+	K054539Write(0, 0x201 + (ch << 1), 0x01);				// loop
+	K054539Write(0, 0x214, 1 << ch);						// key on
+}
+
+static void K054539BenchRender()
+{
+	K054539Update(0, pBurnSoundOut, nBurnSoundLen);
+}
+
+static void K054539BenchExit()
+{
+	K054539Exit();
+}
+
+// ----------------------------------------------------------------------------
+// SegaPCM
+
+static void SegaPCMBenchInit()
+{
+	SegaPCMInit(0, 15800000, BANK_512, BenchROM, 0x80000);
+}
+
+static void SegaPCMBenchNote()
+{
+	INT32 ch = nBenchNote & 15;
+	INT32 nStart = BenchRand() & 0x07;
+	INT32 r = ch << 3;
+
+	SegaPCMWrite(0, 0x86 + r, 0x01);						// off
+	SegaPCMWrite(0, 0x02 + r, 0x40 + (ch << 1));			// volume left
+	SegaPCMWrite(0, 0x03 + r, 0x60 - (ch << 1));			// volume right
+	SegaPCMWrite(0, 0x04 + r, 0x00);						// loop
+	SegaPCMWrite(0, 0x05 + r, nStart);
+	SegaPCMWrite(0, 0x06 + r, nStart + 0x01);				// end page
+	SegaPCMWrite(0, 0x07 + r, 0x40 + (BenchRand() & 0x7f));	// delta
+	SegaPCMWrite(0, 0x84 + r, 0x00);						// address
+	SegaPCMWrite(0, 0x85 + r, nStart);
+	SegaPCMWrite(0, 0x86 + r, 0x00);						// on, looping
+}
+
+static void SegaPCMBenchRender()
+{
+	SegaPCMUpdate(pBurnSoundOut, nBurnSoundLen);
+}
+
+static void SegaPCMBenchExit()
+{
+	SegaPCMExit();
+}
+
+// ----------------------------------------------------------------------------
+// ES5506
+
+static void ES5506WriteReg(INT32 nReg, UINT32 nData)
+{
+	for (INT32 b = 0; b < 4; b++) {
+		ES5506Write((nReg << 2) + b, nData >> (24 - (b << 3)));	// msb first, latched on the last byte
+	}
+}
+
+static void ES5506BenchInit()
+{
+	ES5506Init(16000000, BenchROM, NULL, NULL, NULL, NULL);
+
+	ES5506WriteReg(0x78 / 8, 0x00);							// page 0
+	ES5506WriteReg(0x58 / 8, 0x1f);							// 32 active voices
+}
+
+static void ES5506BenchNote()
+{
+	INT32 v = nBenchNote & 15;
+	UINT32 nStart = (v << 15) + ((BenchRand() & 0x0f) << 8);	// 16-bit words
+
+	ES5506WriteReg(0x78 / 8, v);								// low page
+	ES5506WriteReg(0x00 / 8, 0x0001);							// CR: stop
+	ES5506WriteReg(0x08 / 8, 0x0400 + (BenchRand() & 0x0fff));	// FC
+	ES5506WriteReg(0x10 / 8, 0xc000 - (v << 10));				// LVOL
+	ES5506WriteReg(0x20 / 8, 0x8000 + (v << 10));				// RVOL
+	ES5506WriteReg(0x30 / 8, 0x0000);							// ECOUNT
+	ES5506WriteReg(0x48 / 8, 0x8000 + (BenchRand() & 0x7fff));	// K1
+	ES5506WriteReg(0x38 / 8, 0xffff);							// K2
+
+	ES5506WriteReg(0x78 / 8, 0x20 | v);						// high page
+	ES5506WriteReg(0x08 / 8, nStart << 11);						// START
+	ES5506WriteReg(0x10 / 8, (nStart + 0x2000) << 11);			// END
+	ES5506WriteReg(0x18 / 8, nStart << 11);						// ACCUM
+
+	ES5506WriteReg(0x78 / 8, v);
+	ES5506WriteReg(0x00 / 8, 0x0300 | 0x0008);					// CR: LP3/LP4 filter, loop, go
+}
+
+static void ES5506BenchRender()
+{
+	ES5506Update(pBurnSoundOut, nBurnSoundLen);
+}
+
+static void ES5506BenchExit()
+{
+	ES5506Exit();
+}
+
+// ----------------------------------------------------------------------------
+// ICS2115
+
+static void ICS2115WriteReg(UINT8 nReg, UINT16 nData)
+{
+	ics2115write(1, nReg);
+	ics2115write(2, nData & 0xff);
+	ics2115write(3, nData >> 8);
+}
+
+// 12.4 byte address, as written to the high/low address register pairs
+static void ICS2115WriteAddress(UINT8 nReg, UINT32 nAddress)
+{
+	ICS2115WriteReg(nReg + 0, nAddress >> 4);
+	ICS2115WriteReg(nReg + 1, (nAddress & 0x0f) << 12);
+}
+
+static void ICS2115BenchInit()
+{
+	ics2115_init(NULL, BenchROM, BENCH_ROM_SIZE);
+	ics2115_reset();
+
+	ICS2115WriteReg(0x0e, 0x1700);							// 24 active voices
+}
+
+static void ICS2115BenchNote()
+{
+	INT32 v = nBenchNote % 24;
+	UINT32 nStart = (v << 14) + ((BenchRand() & 0x0f) << 8);
+
+	ICS2115WriteReg(0x4f, v);								// voice select
+	ICS2115WriteReg(0x10, 0x0f00);							// stop
+	ICS2115WriteReg(0x00, 0x0c00);							// 8-bit, looping
+	ICS2115WriteReg(0x01, 0x0200 + (BenchRand() & 0x03fe));	// fc
+	ICS2115WriteAddress(0x02, nStart);						// loop start
+	ICS2115WriteAddress(0x04, nStart + 0x2000);				// loop end
+	ICS2115WriteAddress(0x0a, nStart);						// address
+	ICS2115WriteReg(0x09, 0xe000);							// volume
+	ICS2115WriteReg(0x0c, (0x40 + (v << 2)) << 8);			// pan
+	ICS2115WriteReg(0x0d, 0x0300);							// envelope off
+	ICS2115WriteReg(0x10, 0x0000);							// start
+}
+
+static void ICS2115BenchRender()
+{
+	ics2115_update(nBurnSoundLen);
+}
+
+static void ICS2115BenchExit()
+{
+	ics2115_exit();
+}
+
+// ----------------------------------------------------------------------------
+
+struct SndBenchCore {
+	const char *szName;
+	void (*pInit)();
+	void (*pNote)();										// key the next note
+	void (*pFrame)();										// start of frame (can be NULL)
+	void (*pRender)();										// render nBurnSoundLen samples to pBurnSoundOut
+	void (*pExit)();
+};
+
+static const SndBenchCore SndBenchCores[] = {
+	{ "YM2151",		YM2151BenchInit,	YM2151BenchNote,	NULL,				YM2151BenchRender,	YM2151BenchExit		},
+	{ "YM2203",		YM2203BenchInit,	OPNNote,			NULL,				YM2203BenchRender,	YM2203BenchExit		},
+	{ "YM2608",		YM2608BenchInit,	YM2608BenchNote,	NULL,				YM2608BenchRender,	YM2608BenchExit		},
+	{ "YM2610",		YM2610BenchInit,	YM2610BenchNote,	NULL,				YM2610BenchRender,	YM2610BenchExit		},
+	{ "YM2612",		YM2612BenchInit,	OPNNote,			NULL,				YM2612BenchRender,	YM2612BenchExit		},
+	{ "YMF262",		YMF262BenchInit,	YMF262BenchNote,	NULL,				YMF262BenchRender,	YMF262BenchExit		},
+	{ "YMF278B",	YMF278BBenchInit,	YMF278BBenchNote,	NULL,				YMF278BBenchRender,	YMF278BBenchExit	},
+	{ "MSM6295",	MSM6295BenchInit,	MSM6295BenchNote,	NULL,				MSM6295BenchRender,	MSM6295BenchExit	},
+	{ "QSound",		QSoundBenchInit,	QSoundBenchNote,	QSoundBenchFrame,	QSoundBenchRender,	QSoundBenchExit		},
+	{ "C140",		C140BenchInit,		C140BenchNote,		NULL,				C140BenchRender,	C140BenchExit		},
+	{ "K054539",	K054539BenchInit,	K054539BenchNote,	NULL,				K054539BenchRender,	K054539BenchExit	},
+	{ "SegaPCM",	SegaPCMBenchInit,	SegaPCMBenchNote,	NULL,				SegaPCMBenchRender,	SegaPCMBenchExit	},
+	{ "ES5506",		ES5506BenchInit,	ES5506BenchNote,	NULL,				ES5506BenchRender,	ES5506BenchExit		},
+	{ "ICS2115",	ICS2115BenchInit,	ICS2115BenchNote,	NULL,				ICS2115BenchRender,	ICS2115BenchExit	},
+};
+
+INT32 BurnSoundBenchCount()
+{
+	return sizeof(SndBenchCores) / sizeof(SndBenchCores[0]);
+}
+
+// Must not be called while a driver is running, the cores are all single instance
+INT32 BurnSoundBenchRun(INT32 nCore, INT32 nRate, INT32 nSeconds, BurnSoundBenchInfo *pInfo)
+{
+	if (nCore < 0 || nCore >= BurnSoundBenchCount() || nRate < 8000 || nSeconds < 1 || pInfo == NULL) {
+		return 1;
+	}
+
+	const SndBenchCore *pCore = &SndBenchCores[nCore];
+
+	INT32 nPrevSoundRate = nBurnSoundRate;
+	INT32 nPrevSoundLen = nBurnSoundLen;
+	INT16 *pPrevSoundOut = pBurnSoundOut;
+	INT32 nPrevFPS = nBurnFPS;
+
+	BurnInitMemoryManager();
+	BurnTimerPreInit();
+
+	nBurnFPS = 6000;
+	nBurnSoundRate = nRate;
+	nBurnSoundLen = (nBurnSoundRate * 100 + (nBurnFPS >> 1)) / nBurnFPS;
+
+	// one batch of frames is rendered per timed pass, clearing it and
+	// checksumming it are kept out of the timing
+	const INT32 nFrameLen = nBurnSoundLen * 2;
+	INT16 *pBuffer = (INT16*)BurnMalloc(nFrameLen * BENCH_BATCH_FRAMES * sizeof(INT16));
+	BenchROM = BurnMalloc(BENCH_ROM_SIZE);
+
+	nBenchSeed = 0x5eed;
+	nBenchNote = 0;
+	BenchROMInit();
+
+	// register writes are done with no output buffer, like the drivers do them
+	// outside of the sound update (some cores would otherwise try to sync to a cpu)
+	pBurnSoundOut = NULL;
+	pCore->pInit();
+
+	INT32 nFrames = nSeconds * 60;
+	UINT32 nChecksum = 2166136261U;							// FNV-1a
+
+	clock_t nTicks = 0;
+
+	for (INT32 i = 0; i < nFrames; i += BENCH_BATCH_FRAMES) {
+		memset(pBuffer, 0, nFrameLen * BENCH_BATCH_FRAMES * sizeof(INT16));
+
+		clock_t nStart = clock();
+
+		for (INT32 f = 0; f < BENCH_BATCH_FRAMES; f++) {
+			pBurnSoundOut = NULL;
+
+			if (pCore->pFrame) {
+				pCore->pFrame();
+			}
+
+			if (((i + f) % BENCH_NOTE_FRAMES) == 0) {
+				pCore->pNote();
+				nBenchNote++;
+			}
+
+			pBurnSoundOut = pBuffer + f * nFrameLen;
+
+			pCore->pRender();
+		}
+
+		nTicks += clock() - nStart;
+
+		for (INT32 j = 0; j < nFrameLen * BENCH_BATCH_FRAMES; j++) {
+			nChecksum = (nChecksum ^ (UINT16)pBuffer[j]) * 16777619U;
+		}
+	}
+
+	pBurnSoundOut = NULL;
+	pCore->pExit();
+	BurnTimerExit();
+
+	pInfo->szName = pCore->szName;
+	pInfo->nSamples = nFrames * nBurnSoundLen;
+	pInfo->dSeconds = (double)nTicks / CLOCKS_PER_SEC;
+	pInfo->nChecksum = nChecksum;
+
+	BurnFree(BenchROM);
+	BurnFree(pBuffer);
+	BurnExitMemoryManager();
+
+	nBurnSoundRate = nPrevSoundRate;
+	nBurnSoundLen = nPrevSoundLen;
+	pBurnSoundOut = pPrevSoundOut;
+	nBurnFPS = nPrevFPS;
+
+	return 0;
+}
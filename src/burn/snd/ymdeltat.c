@@ -101,6 +101,8 @@ void YM_DELTAT_BRDY_callback(YM_DELTAT *DELTAT)
 }
 #endif
 
+void (*YM_DELTAT_ROM_TOUCH)(UINT8 *rom, UINT32 start, UINT32 end) = NULL;
+
 UINT8 YM_DELTAT_ADPCM_Read(YM_DELTAT *DELTAT)
 {
 	UINT8 v = 0;
@@ -245,6 +247,10 @@ value:   START, REC, MEMDAT, REPEAT, SPOFF, x,x,RESET   meaning:
 					DELTAT->portstate = 0x00;
 					DELTAT->PCM_BSY = 0;
 				}
+				else if( YM_DELTAT_ROM_TOUCH )
+				{
+					YM_DELTAT_ROM_TOUCH(DELTAT->memory, DELTAT->start, DELTAT->end);
+				}
 			}
 		}
 		else	/* we access CPU memory (ADPCM data register $08) so we only reset now_addr here */
@@ -71,6 +71,10 @@ typedef struct deltat_adpcm_state {     /* AT: rearranged and tigntened structur
 
 /*void YM_DELTAT_BRDY_callback(YM_DELTAT *DELTAT);*/
 
+/* called with the rom range a sample is about to be played from (ADPCM-A too),
+   so the host can load it first if it's loaded lazily. NULL = not needed */
+extern void (*YM_DELTAT_ROM_TOUCH)(UINT8 *rom, UINT32 start, UINT32 end);
+
 UINT8 YM_DELTAT_ADPCM_Read(YM_DELTAT *DELTAT);
 void YM_DELTAT_ADPCM_Write(YM_DELTAT *DELTAT,int r,int v);
 void YM_DELTAT_ADPCM_Reset(YM_DELTAT *DELTAT,int pan,int emulation_mode);
@@ -126,6 +126,8 @@ void YMZ280BScan(INT32 , INT32 *)
 
 INT32 YMZ280BInit(INT32 nClock, void (*IRQCallback)(INT32))
 {
+	BURN_PROFILE_PHASE(SOUNDINIT);
+
 	DebugSnd_YMZ280BInitted = 1;
 	
 	nYMZ280BFrequency = nClock;
@@ -40,6 +40,7 @@ TODO:
 #include "ymz770.h"
 #include "stream.h"
 #include "mpeg_audio.h"
+#include "thready.h"
 
 #define logerror
 
@@ -59,6 +60,7 @@ static void ymz774_internal_reg_write(UINT8 reg, UINT8 data);
 static void ymz770_sequencer();
 static void ymz774_sequencer();
 static void ymz770_stream_update(INT16 **streams, INT32 samples);
+static void ymz770_prefetch_cb();
 
 static UINT32 ymz770_get_phrase_offs(int phrase) { return m_rom[(4 * phrase) + 1] << 16 | m_rom[(4 * phrase) + 2] << 8 | m_rom[(4 * phrase) + 3]; }
 static UINT32 ymz770_get_seq_offs(int sqn) { return m_rom[(4 * sqn) + 1 + 0x400] << 16 | m_rom[(4 * sqn) + 2 + 0x400] << 8 | m_rom[(4 * sqn) + 3 + 0x400]; }
@@ -105,6 +107,31 @@ struct ymz_channel
 
 static mpeg_audio *mpeg_decoder[16];
 
+// Decode-ahead: when a channel starts a block, its next block is decoded on the
+// thready worker (while the cpu runs) from a copy of the channel's decoder.
+// It is only used if the channel reaches exactly that point with the decoder
+// untouched, otherwise the block is decoded in-line as usual - so the output
+// doesn't depend on the worker or its timing.
+enum { PREFETCH_IDLE = 0, PREFETCH_QUEUED, PREFETCH_DONE };
+
+struct ymz_prefetch
+{
+	mpeg_audio *decoder;	// copy of the channel's decoder, then its state after the block
+	INT16 output_data[0x1000];
+	int output_remaining;
+	int pptr;				// block position
+	int pptr_next;			// position after decoding
+	UINT32 generation;
+	bool result;
+	int state;
+};
+
+static ymz_prefetch *m_prefetch = NULL;
+static UINT32 m_generation[16];	// bumped whenever a decoder is cleared or loaded from a state
+static INT32 m_prefetch_enable = 0;
+static INT32 m_prefetch_queued = 0;
+static INT32 m_thready_initted = 0;	// the worker is only started once decode-ahead is turned on
+
 struct ymz_sequence
 {
 	INT32 delay;
@@ -143,6 +170,18 @@ static void init_common()
 		m_channels[i].is_playing = false;
 		mpeg_decoder[i] = new mpeg_audio(m_rom, mpeg_audio::AMM, false, 0);
 	}
+
+	m_prefetch = (ymz_prefetch*)BurnMalloc(16 * sizeof(ymz_prefetch));
+	for (int i = 0; i < 16; i++)
+	{
+		m_prefetch[i].decoder = new mpeg_audio(m_rom, mpeg_audio::AMM, false, 0);
+		m_prefetch[i].state = PREFETCH_IDLE;
+		m_generation[i] = 0;
+	}
+	m_prefetch_enable = 0;
+	m_prefetch_queued = 0;
+	m_thready_initted = 0;
+
 	for (int i = 0; i < 8; i++)
 		m_sequences[i].is_playing = false;
 	for (int i = 0; i < 8; i++)
@@ -157,10 +196,18 @@ void ymz770_exit()
 		ymz_initted = 0;
 		stream.exit();
 
+		if (m_thready_initted) {
+			thready.notify_wait();
+			thready.exit();
+			m_thready_initted = 0;
+		}
+
 		for (int i = 0; i < 16; i++)
 		{
 			delete mpeg_decoder[i];
+			delete m_prefetch[i].decoder;
 		}
+		BurnFree(m_prefetch);
 	}
 }
 
@@ -169,6 +216,88 @@ void ymz770_set_buffered(INT32 (*pCPUCyclesCB)(), INT32 nCPUMhz)
 	stream.set_buffered(pCPUCyclesCB, nCPUMhz);
 }
 
+void ymz770_set_threading(INT32 value)
+{
+	value = value ? 1 : 0;
+	if (value == m_prefetch_enable) return;
+
+	if (m_thready_initted) {
+		thready.notify_wait();
+	} else {
+		thready.init(ymz770_prefetch_cb);
+		m_thready_initted = 1;
+	}
+	thready.set_threading(value);
+
+	m_prefetch_enable = value;
+}
+
+// mpeg_decoder[ch] is about to change other than by decoding the next block
+static void decoder_clear(int ch)
+{
+	mpeg_decoder[ch]->clear();
+	m_generation[ch]++;
+}
+
+static void ymz770_prefetch_cb()
+{
+	for (int ch = 0; ch < 16; ch++)
+	{
+		ymz_prefetch &pf = m_prefetch[ch];
+
+		if (pf.state != PREFETCH_QUEUED) continue;
+
+		int sample_rate, channel_count;
+		pf.pptr_next = pf.pptr;
+		pf.output_remaining = 0;
+		pf.result = pf.decoder->decode_buffer(pf.pptr_next, m_rom_size*8, pf.output_data, pf.output_remaining, sample_rate, channel_count);
+		pf.state = PREFETCH_DONE;
+	}
+}
+
+static void prefetch_queue(int ch)
+{
+	ymz_prefetch &pf = m_prefetch[ch];
+
+	ymz_channel &channel = m_channels[ch];
+
+	*pf.decoder = *mpeg_decoder[ch];
+	pf.pptr = (channel.last_block) ? 8 * get_phrase_offs(channel.phrase) : channel.pptr; // looping or next block
+	pf.generation = m_generation[ch];
+	pf.state = PREFETCH_QUEUED;
+
+	m_prefetch_queued = 1;
+}
+
+// decode the channel's next block, or take it from the worker if it has it
+static bool decode_block(int ch)
+{
+	ymz_channel &channel = m_channels[ch];
+	ymz_prefetch &pf = m_prefetch[ch];
+	bool result;
+
+	if (pf.state == PREFETCH_DONE && pf.pptr == channel.pptr && pf.generation == m_generation[ch])
+	{
+		mpeg_audio *decoder = mpeg_decoder[ch];
+		mpeg_decoder[ch] = pf.decoder;
+		pf.decoder = decoder;
+
+		memcpy(channel.output_data, pf.output_data, sizeof(channel.output_data));
+		channel.output_remaining = pf.output_remaining;
+		channel.pptr = pf.pptr_next;
+		result = pf.result;
+	}
+	else
+	{
+		int sample_rate, channel_count;
+		result = mpeg_decoder[ch]->decode_buffer(channel.pptr, m_rom_size*8, channel.output_data, channel.output_remaining, sample_rate, channel_count);
+	}
+
+	pf.state = PREFETCH_IDLE;
+
+	return result;
+}
+
 void ymz770_init(UINT8 *rom, INT32 rom_length)
 {
 	// create the stream
@@ -239,7 +368,7 @@ void ymz770_reset()
 		m_channels[i].is_paused = false;
 		m_channels[i].output_remaining = 0;
 
-		mpeg_decoder[i]->clear();
+		decoder_clear(i);
 	}
 	memset(&m_sequences, 0, sizeof(m_sequences));
 	for (int i = 0; i < 8; i++)
@@ -289,6 +418,12 @@ void ymz770_scan(INT32 nAction, INT32 *pnMin)
 		for (int i = 0; i < 16; i++) {
 			mpeg_decoder[i]->scan(); // mpeg/amm2 decoder state
 		}
+
+		if (nAction & ACB_WRITE) {
+			for (int i = 0; i < 16; i++) {
+				m_generation[i]++; // drop anything decoded ahead
+			}
+		}
 	}
 }
 
@@ -303,6 +438,8 @@ static void ymz770_stream_update(INT16 **streams, INT32 samples)
 	INT16 *outL = streams[0];
 	INT16 *outR = streams[1];
 
+	thready.notify_wait(); // the worker must be done with m_prefetch
+
 	for (int i = 0; i < samples; i++)
 	{
 		sequencer();
@@ -325,7 +462,7 @@ static void ymz770_stream_update(INT16 **streams, INT32 samples)
 				channel.output_remaining--;
 
 				if (channel.output_remaining == 0 && !channel.is_playing)
-					mpeg_decoder[ch]->clear();
+					decoder_clear(ch);
 			}
 
 			if (channel.output_remaining == 0 && channel.is_playing && !channel.is_paused)
@@ -346,15 +483,14 @@ retry:
 					{
 						channel.is_playing = false;
 						channel.output_remaining = 0;
-						mpeg_decoder[ch]->clear();
+						decoder_clear(ch);
 					}
 				}
 
 				if (channel.is_playing)
 				{
 					// next block
-					int sample_rate, channel_count;
-					if (!mpeg_decoder[ch]->decode_buffer(channel.pptr, m_rom_size*8, channel.output_data, channel.output_remaining, sample_rate, channel_count) || channel.output_remaining == 0)
+					if (!decode_block(ch) || channel.output_remaining == 0)
 					{
 						channel.is_playing = !channel.last_block; // detect infinite retry loop
 						channel.last_block = true;
@@ -364,6 +500,9 @@ retry:
 
 					channel.last_block = channel.output_remaining < 1152;
 					channel.output_ptr = 0;
+
+					if (m_prefetch_enable && (!channel.last_block || channel.loop))
+						prefetch_queue(ch);
 				}
 			}
 		}
@@ -396,6 +535,12 @@ retry:
 		outL[i] = mixl;
 		outR[i] = mixr;
 	}
+
+	if (m_prefetch_queued)
+	{
+		m_prefetch_queued = 0;
+		thready.notify(); // decode the queued blocks while the cpu runs
+	}
 }
 
 static void ymz770_sequencer()
@@ -388,6 +388,8 @@ inline static INT32 readbit(const UINT8 *src, INT32 bitnum)
 
 void GfxDecode(INT32 num, INT32 numPlanes, INT32 xSize, INT32 ySize, INT32 planeoffsets[], INT32 xoffsets[], INT32 yoffsets[], INT32 modulo, UINT8 *pSrc, UINT8 *pDest)
 {
+	BURN_PROFILE_PHASE(GFXDECODE);
+
 	INT32 c;
 
 	for (c = 0; c < num; c++) {
@@ -0,0 +1,426 @@
+// Rom audit, for the command line: checks the roms of every driver against the
+// archives in the rom paths, without starting any of them, and writes a report
+// that is easy to parse.
+//
+// Every archive is read once, however many clones share it, and the archives
+// are read on the libburn worker pool. Roms are matched the same way bzip.cpp
+// does it (crc first, then name, archives in BurnDrvGetZipName() order, which
+// takes care of parents and BIOS sets).
+//
+// The report is tab separated, one line per driver:
+//   game <name> <status> <parent>
+// followed by a line for each of its roms that isn't right:
+//   rom <name> <crc> <length> <flags> <problem> [<crc found> <length found>]
+// status is good, partial (only optional roms missing), bad (an essential rom
+// has the wrong crc or size), missing (an essential rom wasn't found) or absent
+// (none of its roms were found, no rom lines).
+
+#include "burner.h"
+
+struct AuditArchive {
+	char szName[MAX_PATH];			// full path, with extension
+	INT32 b7z;
+	struct ZipEntry* List;
+	INT32 nCount;
+};
+
+struct AuditName {
+	char* szName;					// as BurnDrvGetZipName() has it
+	INT32 nFirst;					// its archives, one per rom path it's in
+	INT32 nCount;
+};
+
+static struct AuditArchive* Archive = NULL;
+static INT32 nArchiveCount = 0;
+static INT32 nArchiveAlloc = 0;
+
+static struct AuditName* Name = NULL;	// open addressing, szName NULL = empty
+static UINT32 nNameMask = 0;
+static INT32 nNameCount = 0;
+
+static INT32* pZipJob = NULL;		// the zip archive each pool job reads
+static INT32 bAuditVerify = 0;
+
+static INT32 AuditFileExists(const char* szName)
+{
+	FILE* h = fopen(szName, "rb");
+	if (h == NULL) return 0;
+
+	fclose(h);
+
+	return 1;
+}
+
+static INT32 AuditAddArchive(const char* szFileName, INT32 b7z)
+{
+	if (nArchiveCount == nArchiveAlloc) {
+		INT32 nNewAlloc = nArchiveAlloc ? nArchiveAlloc * 2 : 1024;
+		struct AuditArchive* pNew = (struct AuditArchive*)realloc(Archive, nNewAlloc * sizeof(struct AuditArchive));
+		if (pNew == NULL) return 1;
+		Archive = pNew;
+		nArchiveAlloc = nNewAlloc;
+	}
+
+	struct AuditArchive* pa = &Archive[nArchiveCount++];
+	memset(pa, 0, sizeof(struct AuditArchive));
+	strncpy(pa->szName, szFileName, MAX_PATH - 1);
+	pa->b7z = b7z;
+
+	return 0;
+}
+
+static struct AuditName* AuditFindName(const char* szName)
+{
+	if (Name == NULL) return NULL;
+
+	for (UINT32 j = BurnHashString(szName) & nNameMask; Name[j].szName; j = (j + 1) & nNameMask) {
+		if (strcmp(Name[j].szName, szName) == 0) return &Name[j];
+	}
+
+	return NULL;
+}
+
+static INT32 AuditGrowNames()
+{
+	UINT32 nOldSize = Name ? nNameMask + 1 : 0;
+	UINT32 nNewSize = nOldSize ? nOldSize * 2 : 4096;
+
+	struct AuditName* pNew = (struct AuditName*)calloc(nNewSize, sizeof(struct AuditName));
+	if (pNew == NULL) return 1;
+
+	for (UINT32 i = 0; i < nOldSize; i++) {
+		if (Name[i].szName == NULL) continue;
+
+		UINT32 j = BurnHashString(Name[i].szName) & (nNewSize - 1);
+		while (pNew[j].szName) j = (j + 1) & (nNewSize - 1);
+		pNew[j] = Name[i];
+	}
+
+	free(Name);
+	Name = pNew;
+	nNameMask = nNewSize - 1;
+
+	return 0;
+}
+
+// find the archives called szName in the rom paths, once per name
+static INT32 AuditAddName(const char* szName)
+{
+	if (AuditFindName(szName)) return 0;
+
+	if ((UINT32)(nNameCount + 1) * 2 > nNameMask + 1) {
+		if (AuditGrowNames()) return 1;
+	}
+
+	UINT32 j = BurnHashString(szName) & nNameMask;
+	while (Name[j].szName) j = (j + 1) & nNameMask;
+
+	struct AuditName* pn = &Name[j];
+	pn->szName = strdup(szName);
+	if (pn->szName == NULL) return 1;
+	pn->nFirst = nArchiveCount;
+	nNameCount++;
+
+	for (INT32 d = 0; d < DIRS_MAX; d++) {
+		char szPath[MAX_PATH];
+		char szFileName[MAX_PATH + 16];
+
+		TCHARToANSI(szAppRomPaths[d], szPath, MAX_PATH);
+		if (szPath[0] == 0) continue;
+
+		// same order as ZipOpen()
+		snprintf(szFileName, sizeof(szFileName), "%s%s.zip", szPath, szName);
+		if (AuditFileExists(szFileName)) {
+			if (AuditAddArchive(szFileName, 0)) return 1;
+			continue;
+		}
+
+#ifdef INCLUDE_7Z_SUPPORT
+		snprintf(szFileName, sizeof(szFileName), "%s%s.7z", szPath, szName);
+		if (AuditFileExists(szFileName)) {
+			if (AuditAddArchive(szFileName, 1)) return 1;
+		}
+#endif
+	}
+
+	pn->nCount = nArchiveCount - pn->nFirst;
+
+	return 0;
+}
+
+// every zip archive gets a job of its own, the 7z ones all share the last one
+static void AuditScanJob(INT32 nJob, void*)
+{
+	if (pZipJob[nJob] >= 0) {
+		struct AuditArchive* pa = &Archive[pZipJob[nJob]];
+		ZipScan(pa->szName, &pa->List, &pa->nCount, bAuditVerify);
+		return;
+	}
+
+	for (INT32 i = 0; i < nArchiveCount; i++) {
+		if (Archive[i].b7z) {
+			ZipScan(Archive[i].szName, &Archive[i].List, &Archive[i].nCount, bAuditVerify);
+		}
+	}
+}
+
+static const char* AuditFilename(const char* szFull)
+{
+	const char* p = szFull;
+
+	for (; *szFull; szFull++) {
+		if (*szFull == '/' || *szFull == '\\') p = szFull + 1;
+	}
+
+	return p;
+}
+
+// rom i of the active driver in archive pa, -1 if it isn't there
+static INT32 AuditFindRom(struct AuditArchive* pa, INT32 i, struct BurnRomInfo* pri)
+{
+	if (pri->nCrc) {
+		for (INT32 j = 0; j < pa->nCount; j++) {
+			if (pa->List[j].szName && pa->List[j].nCrc == pri->nCrc) return j;
+		}
+	}
+
+	for (INT32 nAka = 0; nAka < 0x10000; nAka++) {
+		char* szPossibleName = NULL;
+
+		if (BurnDrvGetRomName(&szPossibleName, i, nAka)) break;
+
+		for (INT32 j = 0; j < pa->nCount; j++) {
+			if (pa->List[j].szName && stricmp(szPossibleName, AuditFilename(pa->List[j].szName)) == 0) return j;
+		}
+	}
+
+	return -1;
+}
+
+#define AUDIT_MISSING		0
+#define AUDIT_OK			1
+#define AUDIT_CRC			2
+#define AUDIT_SHORT			3
+#define AUDIT_LONG			4
+
+static const char* szAuditProblem[] = { "missing", "ok", "crc", "short", "long" };
+
+// 0 good, 1 partial, 2 bad, 3 missing, 4 absent
+static INT32 AuditDriver(FILE* h)
+{
+	static const char* szStatus[] = { "good", "partial", "bad", "missing", "absent" };
+
+	INT32 nArchives[BZIP_MAX];
+	INT32 nArchiveNum = 0;
+
+	for (INT32 y = 0; y < BZIP_MAX; y++) {
+		char* szName = NULL;
+		if (BurnDrvGetZipName(&szName, y)) break;
+
+		struct AuditName* pn = AuditFindName(szName);
+		if (pn == NULL) continue;
+
+		for (INT32 k = 0; k < pn->nCount && nArchiveNum < BZIP_MAX; k++) {
+			nArchives[nArchiveNum++] = pn->nFirst + k;
+		}
+	}
+
+	struct BurnRomInfo ri;
+	INT32 nRoms = 0;
+	while (BurnDrvGetRomInfo(&ri, nRoms) == 0) nRoms++;
+
+	INT32* nState = (INT32*)calloc(nRoms ? nRoms : 1, sizeof(INT32));
+	struct ZipEntry** pFound = (struct ZipEntry**)calloc(nRoms ? nRoms : 1, sizeof(struct ZipEntry*));
+	if (nState == NULL || pFound == NULL) {
+		free(nState);
+		free(pFound);
+		return -1;
+	}
+
+	for (INT32 a = 0; a < nArchiveNum; a++) {
+		struct AuditArchive* pa = &Archive[nArchives[a]];
+
+		for (INT32 i = 0; i < nRoms; i++) {
+			if (nState[i] == AUDIT_OK) continue;
+
+			memset(&ri, 0, sizeof(ri));
+			BurnDrvGetRomInfo(&ri, i);
+
+			INT32 nFind = AuditFindRom(pa, i, &ri);
+			if (nFind < 0) continue;
+
+			struct ZipEntry* pe = &pa->List[nFind];
+			pFound[i] = pe;
+
+			if (pe->nLen < ri.nLen) {
+				nState[i] = AUDIT_SHORT;
+			} else if (pe->nLen > ri.nLen) {
+				nState[i] = AUDIT_LONG;
+			} else if (ri.nCrc && pe->nCrc != ri.nCrc) {
+				nState[i] = AUDIT_CRC;
+			} else {
+				nState[i] = AUDIT_OK;
+			}
+		}
+	}
+
+	INT32 nStatus = 0;
+	INT32 bAny = 0;
+
+	for (INT32 i = 0; i < nRoms; i++) {
+		memset(&ri, 0, sizeof(ri));
+		BurnDrvGetRomInfo(&ri, i);
+
+		if (ri.nType == 0 || ri.nLen == 0) continue;	// empty slot
+		if (nState[i] != AUDIT_MISSING) bAny = 1;
+		if (nState[i] == AUDIT_OK || ri.nCrc == 0) continue;
+
+		if ((ri.nType & BRF_OPT) || (ri.nType & BRF_NODUMP)) {
+			if (nStatus < 1) nStatus = 1;
+		} else {
+			if (nState[i] == AUDIT_MISSING) {
+				nStatus = 3;
+			} else if (nStatus < 2) {
+				nStatus = 2;
+			}
+		}
+	}
+
+	if (nStatus == 3 && !bAny) nStatus = 4;
+
+	fprintf(h, "game\t%s\t%s\t%s\n", BurnDrvGetTextA(DRV_NAME), szStatus[nStatus], BurnDrvGetTextA(DRV_PARENT) ? BurnDrvGetTextA(DRV_PARENT) : "-");
+
+	for (INT32 i = 0; i < nRoms && nStatus != 0 && nStatus != 4; i++) {
+		char* szRomName = NULL;
+
+		memset(&ri, 0, sizeof(ri));
+		BurnDrvGetRomInfo(&ri, i);
+
+		if (ri.nType == 0 || ri.nLen == 0 || nState[i] == AUDIT_OK || ri.nCrc == 0) continue;
+		if (BurnDrvGetRomName(&szRomName, i, 0)) continue;
+
+		char szFlags[16] = "";
+		if (ri.nType & BRF_OPT) strcat(szFlags, "o");
+		if (ri.nType & BRF_NODUMP) strcat(szFlags, "n");
+		if (ri.nType & BRF_ESS) strcat(szFlags, "e");
+		if (ri.nType & BRF_BIOS) strcat(szFlags, "b");
+		if (szFlags[0] == 0) strcpy(szFlags, "-");
+
+		fprintf(h, "rom\t%s\t%08x\t%d\t%s\t%s", szRomName, ri.nCrc, ri.nLen, szFlags, szAuditProblem[nState[i]]);
+		if (pFound[i]) {
+			fprintf(h, "\t%08x\t%d", pFound[i]->nCrc, pFound[i]->nLen);
+		}
+		fprintf(h, "\n");
+	}
+
+	free(nState);
+	free(pFound);
+
+	return nStatus;
+}
+
+static void AuditExit()
+{
+	for (INT32 i = 0; i < nArchiveCount; i++) {
+		if (Archive[i].List) {
+			for (INT32 j = 0; j < Archive[i].nCount; j++) {
+				free(Archive[i].List[j].szName);
+			}
+			free(Archive[i].List);
+		}
+	}
+
+	for (UINT32 i = 0; Name && i <= nNameMask; i++) {
+		free(Name[i].szName);
+	}
+
+	free(Archive);
+	free(Name);
+	free(pZipJob);
+
+	Archive = NULL;
+	Name = NULL;
+	pZipJob = NULL;
+	nArchiveCount = nArchiveAlloc = 0;
+	nNameMask = 0;
+	nNameCount = 0;
+}
+
+// szFile: where the report goes, "-" = stdout. bVerify: inflate every member
+// and check its data, not just the crc in the archive's directory.
+INT32 AuditRomsets(const char* szFile, INT32 bVerify)
+{
+	FILE* h = (strcmp(szFile, "-") == 0) ? stdout : fopen(szFile, "wt");
+	if (h == NULL) return 1;
+
+	UINT32 nOldDrvActive = nBurnDrvActive;
+	INT32 nRet = 0;
+	INT32 nCount[5] = { 0, 0, 0, 0, 0 };
+
+	bAuditVerify = bVerify;
+
+	// find every archive any driver wants
+	for (UINT32 i = 0; i < nBurnDrvCount && nRet == 0; i++) {
+		nBurnDrvActive = i;
+
+		for (INT32 y = 0; y < BZIP_MAX; y++) {
+			char* szName = NULL;
+			if (BurnDrvGetZipName(&szName, y)) break;
+
+			if (AuditAddName(szName)) {
+				nRet = 1;
+				break;
+			}
+		}
+	}
+
+	// read them all
+	if (nRet == 0) {
+		INT32 nJobs = 0;
+		INT32 b7z = 0;
+
+		pZipJob = (INT32*)malloc((nArchiveCount + 1) * sizeof(INT32));
+		if (pZipJob == NULL) nRet = 1;
+
+		for (INT32 i = 0; i < nArchiveCount && nRet == 0; i++) {
+			if (Archive[i].b7z) {
+				b7z = 1;
+			} else {
+				pZipJob[nJobs++] = i;
+			}
+		}
+
+		if (nRet == 0) {
+			if (b7z) pZipJob[nJobs++] = -1;
+
+			BurnPoolRun(AuditScanJob, NULL, nJobs);
+		}
+	}
+
+	// and check every driver against them
+	if (nRet == 0) {
+		fprintf(h, "# " APP_TITLE " v%s rom audit%s\n", TCHARToANSI(szAppBurnVer, NULL, 0), bVerify ? " (data verified)" : "");
+
+		for (UINT32 i = 0; i < nBurnDrvCount; i++) {
+			nBurnDrvActive = i;
+
+			INT32 nStatus = AuditDriver(h);
+			if (nStatus < 0) {
+				nRet = 1;
+				break;
+			}
+
+			nCount[nStatus]++;
+		}
+
+		fprintf(h, "# %d archives, %d good, %d partial, %d bad, %d missing, %d absent\n", nArchiveCount, nCount[0], nCount[1], nCount[2], nCount[3], nCount[4]);
+	}
+
+	if (h != stdout) fclose(h);
+
+	nBurnDrvActive = nOldDrvActive;
+
+	AuditExit();
+
+	return nRet;
+}
@@ -253,6 +253,19 @@ INT32 ZipClose();
 INT32 ZipGetList(struct ZipEntry** pList, INT32* pnListCount);
 INT32 ZipLoadFile(UINT8* Dest, INT32 nLen, INT32* pnWrote, INT32 nEntry);
 INT32 __cdecl ZipLoadOneFile(char* arcName, const char* fileName, void** Dest, INT32* pnWrote);
+INT32 ZipPrefetchAdd(char* szZip, INT32 nEntry, UINT32 nCrc, INT32 nLen);
+INT32 ZipPrefetchRun();
+INT32 ZipPrefetchLoad(UINT8* Dest, INT32 nLen, INT32* pnWrote, UINT32 nCrc);
+void ZipPrefetchExit();
+INT32 ZipLoadPart(char* szZip, INT32 nEntry, UINT8* Dest, INT32 nOffset, INT32 nLen, INT32* pnWrote);
+void ZipLoadPartExit();
+INT32 ZipIndexInit(const char* szFile);
+INT32 ZipIndexSave();
+void ZipIndexExit();
+INT32 ZipScan(char* szFileName, struct ZipEntry** pList, INT32* pnListCount, INT32 bVerify);
+
+// audit.cpp
+INT32 AuditRomsets(const char* szFile, INT32 bVerify);
 
 // romdata.cpp
 
@@ -266,7 +279,9 @@ void IpsPatchExit();
 #define BZIP_STATUS_ERROR	(2)
 
 INT32 BzipOpen(bool);
+INT32 BzipPrefetch();
 INT32 BzipClose();
+void BzipPartExit();
 INT32 BzipInit();
 INT32 BzipExit();
 INT32 BzipStatus();
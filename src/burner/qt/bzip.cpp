@@ -7,7 +7,7 @@ int nBzipError = 0;												// non-zero if there is a problem with the opened
 
 static TCHAR* szBzipName[BZIP_MAX] = { NULL, };					// Zip files to search through
 
-struct RomFind { int nState; int nZip; int nPos; };				// State is non-zero if found. 1 = found totally okay.
+struct RomFind { int nState; int nZip; int nPos; unsigned int nCrc; };		// State is non-zero if found. 1 = found totally okay.
 static struct RomFind* RomFind = NULL;
 static int nRomCount = 0; static int nTotalSize = 0;
 static struct ZipEntry* List = NULL; static int nListCount = 0;	// List of entries for current zip file
@@ -317,6 +317,21 @@ static int __cdecl BzipBurnLoadRom(unsigned char* Dest, int* pnWrote, int i)
 	return 0;
 }
 
+// The crc each rom really has in the romset, used for the cache keys (burn_cache.cpp)
+static int __cdecl BzipBurnRomCrc(unsigned int* pnCrc, int i)
+{
+	if (RomFind == NULL || i < 0 || i >= nRomCount) {
+		return 1;
+	}
+	if (RomFind[i].nState != 1 && RomFind[i].nState != 2) {	// Not there, or the wrong size
+		return 1;
+	}
+
+	*pnCrc = RomFind[i].nCrc;
+
+	return 0;
+}
+
 int BzipOpen(bool bootApp)
 {
 	int nMemLen;											// Zip name number
@@ -397,6 +412,7 @@ int BzipOpen(bool bootApp)
 
 				RomFind[i].nZip = z;							// Remember which zip file it is in
 				RomFind[i].nPos = nFind;
+				RomFind[i].nCrc = List[nFind].nCrc;
 				RomFind[i].nState = 1;							// Set to found okay
 
 				BurnDrvGetRomInfo(&ri, i);						// Get info about the rom
@@ -489,6 +505,7 @@ int BzipOpen(bool bootApp)
 		}
 
 		BurnExtLoadRom = BzipBurnLoadRom;						// Okay to call our function to load each rom
+		BurnExtRomCrc = BzipBurnRomCrc;
 
 	} else {
 		return CheckRomsBoot();
@@ -503,6 +520,7 @@ int BzipClose()
 	nCurrentZip = -1;											// Close the last zip file if open
 
 	BurnExtLoadRom = NULL;										// Can't call our function to load each rom anymore
+	BurnExtRomCrc = NULL;
 	nBzipError = 0;												// reset romset errors
 
 	free(RomFind);
@@ -5,7 +5,7 @@ int nBzipError = 0;
 
 static TCHAR* szBzipName[BZIP_MAX] = { NULL, };                                 // Zip files to search through
 
-struct RomFind { int nState; int nZip; int nPos; };                             // State is non-zero if found. 1 = found totally okay.
+struct RomFind { int nState; int nZip; int nPos; unsigned int nCrc; };          // State is non-zero if found. 1 = found totally okay.
 static struct RomFind* RomFind = NULL;
 static int              nRomCount = 0; static int nTotalSize = 0;
 static struct ZipEntry* List = NULL; static int nListCount = 0; // List of entries for current zip file
@@ -390,6 +390,13 @@ static int __cdecl BzipBurnLoadRom(unsigned char* Dest, int* pnWrote, int i)
 		return 1;
 	}
 
+	// Already inflated by BzipPrefetch()?
+	if (ZipPrefetchLoad(Dest, ri.nLen, pnWrote, ri.nCrc) == 0)
+	{
+		fprintf(stderr, "%s (OK)\n", szText);
+		return 0;
+	}
+
 	nWantZip = RomFind[i].nZip;                                                          // Which zip file it is in
 	if (nCurrentZip != nWantZip)                                                         // If we haven't got the right zip file currently open
 	{
@@ -417,6 +424,21 @@ static int __cdecl BzipBurnLoadRom(unsigned char* Dest, int* pnWrote, int i)
 	return 0;
 }
 
+// The crc each rom really has in the romset, used for the cache keys (burn_cache.cpp)
+static int __cdecl BzipBurnRomCrc(unsigned int* pnCrc, int i)
+{
+	if (RomFind == NULL || i < 0 || i >= nRomCount) {
+		return 1;
+	}
+	if (RomFind[i].nState != 1 && RomFind[i].nState != 2) {	// Not there, or the wrong size
+		return 1;
+	}
+
+	*pnCrc = RomFind[i].nCrc;
+
+	return 0;
+}
+
 // ----------------------------------------------------------------------------
 
 int BzipStatus()
@@ -566,6 +588,7 @@ int BzipOpen(bool bootApp)
 
 				RomFind[i].nZip = z;                                                                                      // Remember which zip file it is in
 				RomFind[i].nPos = nFind;
+				RomFind[i].nCrc = List[nFind].nCrc;
 				RomFind[i].nState = 1;                                                                                      // Set to found okay
 
 				BurnDrvGetRomInfo(&ri, i);                                                                                  // Get info about the rom
@@ -742,6 +765,7 @@ int BzipOpen(bool bootApp)
 		}
 
 		BurnExtLoadRom = BzipBurnLoadRom;                                                                         // Okay to call our function to load each rom
+		BurnExtRomCrc = BzipBurnRomCrc;
 	}
 	else
 	{
@@ -782,12 +806,101 @@ int BzipOpen(bool bootApp)
 	return 0;
 }
 
+// Part loads for libburn's lazily loaded roms. These happen while the game runs,
+// long after BzipClose(), so we keep our own copy of where each rom is.
+struct RomPart { char szZip[MAX_PATH]; int nPos; };
+static struct RomPart* RomPart = NULL;
+static int nRomPartCount = 0;
+
+static int __cdecl BzipBurnLoadRomPart(unsigned char* Dest, int* pnWrote, int i, int nOffset, int nLen)
+{
+	if (i < 0 || i >= nRomPartCount || RomPart[i].szZip[0] == 0)
+	{
+		return 1;
+	}
+
+	return ZipLoadPart(RomPart[i].szZip, RomPart[i].nPos, Dest, nOffset, nLen, pnWrote);
+}
+
+static int BzipPartInit()
+{
+	BzipPartExit();
+
+	RomPart = (struct RomPart*)malloc(nRomCount * sizeof(struct RomPart));
+	if (RomPart == NULL)
+	{
+		return 1;
+	}
+	memset(RomPart, 0, nRomCount * sizeof(struct RomPart));
+	nRomPartCount = nRomCount;
+
+	for (int i = 0; i < nRomCount; i++)
+	{
+		if (RomFind[i].nState == 1)
+		{
+			strncpy(RomPart[i].szZip, TCHARToANSI(szBzipName[RomFind[i].nZip], NULL, 0), MAX_PATH - 1);
+			RomPart[i].nPos = RomFind[i].nPos;
+		}
+	}
+
+	BurnExtLoadRomPart = BzipBurnLoadRomPart;
+
+	return 0;
+}
+
+void BzipPartExit()
+{
+	ZipLoadPartExit();
+	BurnExtLoadRomPart = NULL;
+
+	if (RomPart)
+	{
+		free(RomPart);
+		RomPart = NULL;
+	}
+	nRomPartCount = 0;
+}
+
+// Inflate every rom of the set on the worker pool, ahead of the driver's loads
+int BzipPrefetch()
+{
+	if (RomFind == NULL)
+	{
+		return 1;
+	}
+
+	if (bBurnLazyRoms)
+	{
+		// the driver only loads part of the set now, the rest as the game needs it
+		return BzipPartInit();
+	}
+
+	for (int i = 0; i < nRomCount; i++)
+	{
+		struct BurnRomInfo ri;
+
+		if (RomFind[i].nState != 1)
+		{
+			continue;
+		}
+
+		memset(&ri, 0, sizeof(ri));
+		BurnDrvGetRomInfo(&ri, i);
+
+		ZipPrefetchAdd(TCHARToANSI(szBzipName[RomFind[i].nZip], NULL, 0), RomFind[i].nPos, ri.nCrc, ri.nLen);
+	}
+
+	return ZipPrefetchRun();
+}
+
 int BzipClose()
 {
 	ZipClose();
+	ZipPrefetchExit();
 	nCurrentZip = -1;                                                                                                    // Close the last zip file if open
 
 	BurnExtLoadRom = NULL;                                                                                               // Can't call our function to load each rom anymore
+	BurnExtRomCrc = NULL;
 	nBzipError = 0;                                                                                                  // reset romset errors
 
 	if (RomFind)
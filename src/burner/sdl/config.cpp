@@ -8,6 +8,8 @@ void FixAndCreateSupportPath(TCHAR *pSupportFolderPath, TCHAR *pBaseFolderName)
 {
 	TCHAR *szSupportFolderFixedPath = NULL;
 
+	if (pSupportFolderPath[0] == '\0') return;	// left empty on purpose (e.g. no cache)
+
 	if (strstr(pSupportFolderPath, pBaseFolderName) == NULL) {
 		if (pSupportFolderPath[strlen(pSupportFolderPath) - 1] == '/') pSupportFolderPath[strlen(pSupportFolderPath) - 1] = '\0';
 		szSupportFolderFixedPath = SDL_GetPrefPath("fbneo", pSupportFolderPath);
@@ -42,6 +44,7 @@ void InitSupportPaths()
 	FixAndCreateSupportPath(szAppPCBsPath, szBaseFolderName);
 	FixAndCreateSupportPath(szAppHistoryPath, szBaseFolderName);
 	FixAndCreateSupportPath(szAppEEPROMPath, szBaseFolderName);
+	FixAndCreateSupportPath(szBurnCachePath, szBaseFolderName);
 	FixAndCreateSupportPath(szAppListsPath, szBaseFolderName);
 	FixAndCreateSupportPath(szAppDatListsPath, szBaseFolderName);
 	FixAndCreateSupportPath(szAppArchivesPath, szBaseFolderName);
@@ -167,6 +170,7 @@ int ConfigAppLoad()
 		STR(szAppPCBsPath);
 		STR(szAppHistoryPath);
 		STR(szAppEEPROMPath);
+		STR(szBurnCachePath);
 		STR(szAppListsPath);
 		STR(szAppDatListsPath);
 		STR(szAppArchivesPath);
@@ -274,6 +278,8 @@ int ConfigAppSave()
 	STR(szAppHDDPath);
 	fprintf(f, "\n// EEPROM save path (include trailing slash)\n");
 	STR(szAppEEPROMPath);
+	fprintf(f, "\n// Decoded data shared between runs, e.g. samples (include trailing slash, empty = don't cache)\n");
+	STR(szBurnCachePath);
 	fprintf(f, "\n// UNUSED CURRENTLY (include trailing slash)\n");
 	STR(szAppIpsPath);
 	fprintf(f, "\n// UNUSED CURRENTLY (include trailing slash)\n");
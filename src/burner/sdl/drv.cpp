@@ -32,6 +32,8 @@ static int DoLibInit()                  // Do Init of Burn library driver
 	int nRet;
 
 	BzipOpen(false);
+	BurnProfileBegin();
+	BzipPrefetch();
 
 	//ProgressCreate();
 
@@ -159,6 +161,7 @@ int DrvExit()
 	}
 
 	BurnExtLoadRom = NULL;
+	BzipPartExit();
 
 	bDrvOkay = 0;                   // Stop using the BurnDrv functions
 //	nBurnDrvActive = ~0U;                 // no driver selected
@@ -22,6 +22,12 @@ bool bRunPause = 0;
 bool bAppFullscreen = 0;
 bool bAlwaysProcessKeyboardInput = 0;
 int usemenu = 0, usejoy = 0, vsync = 1, dat = 0;
+int sndbench = 0, nSndBenchRate = 44100, nSndBenchSeconds = 10;
+const char* wavfile = NULL;
+int nWavSeconds = 60;
+const char* auditfile = NULL;
+const char* cachedir = NULL;
+int auditverify = 0;
 bool bSaveconfig = 1;
 bool bIntegerScale = false;
 bool bAlwaysMenu = false;
@@ -99,10 +105,143 @@ int parseSwitches(int argc, char* argv[])
 			i++;
 			_tcscpy(CDEmuImage, argv[i]);
 		}
+		else if (strcmp(argv[i], "-sndbench") == 0)
+		{
+			set_commandline_option_not_config(sndbench, 1);
+			// optional [rate] [seconds]
+			if (i + 1 < argc && isdigit(*argv[i + 1]))
+			{
+				nSndBenchRate = atoi(argv[++i]);
+				if (i + 1 < argc && isdigit(*argv[i + 1]))
+				{
+					nSndBenchSeconds = atoi(argv[++i]);
+				}
+			}
+		}
+		else if (strcmp(argv[i], "-sharedroms") == 0)
+		{
+			bBurnShareRoms = 1;
+		}
+		else if (strcmp(argv[i], "-cache") == 0)
+		{
+			// -cache <dir>, keep decoded data (and -sharedroms regions) there between runs
+			if (i + 1 < argc)
+			{
+				cachedir = argv[++i];
+			}
+		}
+		else if (strcmp(argv[i], "-lazyroms") == 0)
+		{
+			bBurnLazyRoms = 1;
+		}
+		else if (strcmp(argv[i], "-bootprofile") == 0)
+		{
+			bBurnBootProfile = 1;
+		}
+		else if (strcmp(argv[i], "-audit") == 0)
+		{
+			// -audit <file> [-verify], check every romset and write a report ("-" = stdout), no window
+			if (i + 1 < argc)
+			{
+				auditfile = argv[++i];
+			}
+		}
+		else if (strcmp(argv[i], "-verify") == 0)
+		{
+			auditverify = 1;
+		}
+		else if (strcmp(argv[i], "-wav") == 0)
+		{
+			// -wav <file> [seconds], sound-only, no window
+			if (i + 1 < argc)
+			{
+				wavfile = argv[++i];
+				if (i + 1 < argc && isdigit(*argv[i + 1]))
+				{
+					nWavSeconds = atoi(argv[++i]);
+				}
+			}
+		}
+	}
+	return 0;
+}
+
+int runSoundBench()
+{
+	BurnLibInit();
+
+	printf("Sound core benchmark, %d Hz, %d seconds per core\n", nSndBenchRate, nSndBenchSeconds);
+	printf("%-10s %12s %10s %10s\n", "core", "samples/s", "realtime", "checksum");
+
+	for (INT32 i = 0; i < BurnSoundBenchCount(); i++)
+	{
+		BurnSoundBenchInfo info;
+
+		if (BurnSoundBenchRun(i, nSndBenchRate, nSndBenchSeconds, &info))
+		{
+			printf("benchmark %d failed\n", i);
+			continue;
+		}
+
+		double samplespersec = (info.dSeconds > 0.0) ? info.nSamples / info.dSeconds : 0.0;
+		printf("%-10s %12.0f %9.1fx %08x\n", info.szName, samplespersec, samplespersec / nSndBenchRate, info.nChecksum);
 	}
+
+	BurnLibExit();
+
 	return 0;
 }
 
+int runSoundOnly(int nDrvNum)
+{
+	int nRet;
+
+	bBurnSoundOnly = 1;
+	nBurnSoundRate = nAudSampleRate[nAudSelect];
+	nBurnSoundLen = (nBurnSoundRate * 100 + (nBurnFPS >> 1)) / nBurnFPS;	// sound cores size their buffers from this at init
+	nBurnDrvActive = nDrvNum;
+
+	nMaxPlayers = BurnDrvGetMaxPlayers();
+	GameInpInit();                           // for the default dips
+
+	BzipOpen(false);
+	BurnProfileBegin();
+	BzipPrefetch();
+	nRet = BurnDrvInit();
+	BzipClose();
+
+	if (nRet)
+	{
+		printf("There was an error loading your selected game.\n");
+		BurnDrvExit();
+	}
+	else
+	{
+		printf("Writing %d seconds of %s audio to %s\n", nWavSeconds, BurnDrvGetTextA(DRV_NAME), wavfile);
+
+		clock_t starttime = clock();
+		nRet = BurnDrvRenderWav(wavfile, nWavSeconds);
+		double elapsed = (double)(clock() - starttime) / CLOCKS_PER_SEC;
+
+		if (nRet)
+		{
+			printf("Couldn't write %s\n", wavfile);
+		}
+		else
+		{
+			printf("Done in %.2f seconds (%.1fx realtime)\n", elapsed, (elapsed > 0.0) ? nWavSeconds / elapsed : 0.0);
+		}
+
+		BurnDrvExit();
+	}
+
+	BzipPartExit();
+	GameInpExit();
+	bBurnSoundOnly = 0;
+
+	return nRet;
+}
+
 void generateDats()
 {
 	char filename[1024] = { 0 };
@@ -248,6 +387,7 @@ void bye(void)
 
 	DrvExit();
 	MediaExit();
+	ZipIndexExit();
 	BurnLibExit();
 	SDL_Quit();
 }
@@ -292,19 +432,34 @@ int main(int argc, char* argv[])
 
 	parseSwitches(argc, argv);
 
+	if (sndbench)
+	{
+		return runSoundBench();
+	}
+
 	// Do these bits before override via ConfigAppLoad
 	bCheatsAllowed = 1;
 	nAudDSPModule[0] = 0;
 	EnableHiscores = 1;
 
-	if ((romname == NULL) && !usemenu && !bAlwaysMenu && !dat)
+	if ((romname == NULL) && !usemenu && !bAlwaysMenu && !dat && !auditfile)
 	{
-		printf("Usage: %s [-cd] [-joy] [-menu] [-novsync] [-integerscale] [-fullscreen] [-dat] [-autosave] [-nearest] [-linear] [-best] <romname>\n", argv[0]);
+		printf("Usage: %s [-cd] [-joy] [-menu] [-novsync] [-integerscale] [-fullscreen] [-dat] [-autosave] [-nearest] [-linear] [-best] [-sndbench [rate] [seconds]] [-wav <file> [seconds]] [-cache <dir>] [-sharedroms] [-lazyroms] [-bootprofile] [-audit <file> [-verify]] <romname>\n", argv[0]);
 		printf("Note the -menu switch does not require a romname\n");
 		printf("e.g.: %s mslug\n", argv[0]);
 		printf("e.g.: %s -menu -joy\n", argv[0]);
 		printf("For NeoCD games:\n");
 		printf("%s neocdz -cd path/to/ccd/filename.cue (or .ccd)\n", argv[0]);
+		printf("To benchmark the sound cores (no romname needed):\n");
+		printf("%s -sndbench 44100 10\n", argv[0]);
+		printf("To record the audio of a game without video (as fast as possible):\n");
+		printf("%s -wav mslug.wav 60 mslug\n", argv[0]);
+		printf("To check every romset and write a report (- for the console):\n");
+		printf("%s -audit audit.txt\n", argv[0]);
+		printf("To keep decoded samples between runs and share the rom regions of several instances:\n");
+		printf("%s -cache ~/.cache/fbneo -sharedroms mslug\n", argv[0]);
+		printf("To see where the time to the first frame goes:\n");
+		printf("%s -bootprofile mslug\n", argv[0]);
 		printf("Usage is restricted by the license at https://raw.githubusercontent.com/finalburnneo/FBNeo/master/src/license.txt\n");
 		return 0;
 	}
@@ -368,22 +523,36 @@ int main(int argc, char* argv[])
 		#endif
 		ConfigAppSave();		// for SDL2 this will also create folders in ~/.local/share/fbneo/
 	}
+	if (cachedir)
+	{
+		snprintf(szBurnCachePath, MAX_PATH, "%s%s", cachedir, (*cachedir && cachedir[strlen(cachedir) - 1] != '/') ? "/" : "");
+	}
 	ComputeGammaLUT();
 #if defined(BUILD_SDL2) && !defined(SDL_WINDOWS)
 	bprintf = AppDebugPrintf;
 #endif
 	BurnLibInit();
 
+	// Remember what's in the rom archives, so they're only read again when they change
+	char szRomIndex[MAX_PATH];
+#if defined(BUILD_SDL2) && !defined(SDL_WINDOWS)
+	TCHAR *szSDLindexPath = SDL_GetPrefPath("fbneo", "config");
+	snprintf(szRomIndex, MAX_PATH, "%sroms.index", szSDLindexPath);
+	SDL_free(szSDLindexPath);
+#else
+	snprintf(szRomIndex, MAX_PATH, "config/roms.index");
+#endif
+	ZipIndexInit(szRomIndex);
+
 	// Search for a game now, for use in the menu and loading a games
 	if (romname != NULL)
 	{
-		for (i = 0; i < nBurnDrvCount; i++)
+		INT32 nIndex = BurnDrvGetIndex(romname);
+
+		i = (nIndex < 0) ? nBurnDrvCount : nIndex;
+		if (i < nBurnDrvCount)
 		{
 			nBurnDrvActive = i;
-			if (strcmp(BurnDrvGetTextA(DRV_NAME), romname) == 0)
-			{
-				break;
-			}
 		}
 	}
 
@@ -391,6 +560,10 @@ int main(int argc, char* argv[])
 	{
 		generateDats();
 	}
+	else if (auditfile)
+	{
+		return AuditRomsets(auditfile, auditverify);
+	}
 #ifdef BUILD_SDL2
 	else if (usemenu || bAlwaysMenu)
 	{
@@ -423,6 +596,11 @@ int main(int argc, char* argv[])
 			return 1;
 		}
 
+		if (wavfile)
+		{
+			return runSoundOnly(i);
+		}
+
 		DoGame(i);
 	}
 	return 0;
@@ -815,6 +815,7 @@ void RefreshRomList(bool force_rescan)
 		}
 	}
 	WriteGameAvb();
+	ZipIndexSave();
 	nBurnDrvActive = tempgame;
 	reset_filters(); // reset filterss after a full rescan
 	DoFilterGames();
@@ -50,6 +50,7 @@
 
 #include <ctype.h>
 #include <stdlib.h>
+#include <sys/stat.h>
 #include "zlib.h"
 
 /***************************************************************************
@@ -199,6 +200,27 @@ void FileOutStream_CreateVTable(CFileOutStream *p)
 /* number of open files to cache */
 #define _7Z_CACHE_SIZE	8
 
+/* unpacked solid blocks to keep around, and how much memory they may use */
+#define _7Z_BLOCK_CACHE_SIZE	16
+#define _7Z_BLOCK_CACHE_BYTES	((size_t)128 << 20)
+
+
+/***************************************************************************
+    TYPE DEFINITIONS
+***************************************************************************/
+
+/* an unpacked solid block, keyed by archive name, size, date and block number */
+struct _7z_block
+{
+	char *			filename;
+	UINT64			length;
+	time_t			mtime;
+	UInt32			index;
+	Byte *			data;
+	size_t			size;
+	UINT32			lastused;
+};
+
 
 /***************************************************************************
     GLOBAL VARIABLES
@@ -206,12 +228,18 @@ void FileOutStream_CreateVTable(CFileOutStream *p)
 
 static _7z_file *_7z_cache[_7Z_CACHE_SIZE];
 
+static _7z_block _7z_block_cache[_7Z_BLOCK_CACHE_SIZE];
+static size_t _7z_block_cache_bytes = 0;
+static UINT32 _7z_block_cache_clock = 0;
+
 /***************************************************************************
     FUNCTION PROTOTYPES
 ***************************************************************************/
 
 /* cache management */
 static void free__7z_file(_7z_file *_7z);
+static int _7z_file_stat(const char *filename, UINT64 *length, time_t *mtime);
+static void _7z_block_free(_7z_block *block);
 
 
 /***************************************************************************
@@ -324,6 +352,11 @@ _7z_error _7z_file_open(const char *filename, _7z_file **_7z)
 	/* ensure we start with a NULL result */
 	*_7z = NULL;
 
+	UINT64 length = 0;
+	time_t mtime = 0;
+	if (_7z_file_stat(filename, &length, &mtime))
+		return _7ZERR_FILE_ERROR;
+
 	/* see if we are in the cache, and reopen if so */
 	for (cachenum = 0; cachenum < ARRAY_LENGTH(_7z_cache); cachenum++)
 	{
@@ -332,8 +365,16 @@ _7z_error _7z_file_open(const char *filename, _7z_file **_7z)
 		/* if we have a valid entry and it matches our filename, use it and remove from the cache */
 		if (cached != NULL && cached->filename != NULL && strcmp(filename, cached->filename) == 0)
 		{
-			*_7z = cached;
 			_7z_cache[cachenum] = NULL;
+
+			/* the archive changed since we parsed it, start over */
+			if (cached->archiveStream.file._7z_length != length || cached->mtime != mtime)
+			{
+				free__7z_file(cached);
+				break;
+			}
+
+			*_7z = cached;
 			return _7ZERR_NONE;
 		}
 	}
@@ -356,6 +397,7 @@ _7z_error _7z_file_open(const char *filename, _7z_file **_7z)
 	fseek(new_7z->archiveStream.file._7z_osdfile, 0, SEEK_END);
 	new_7z->archiveStream.file._7z_length = ftell(new_7z->archiveStream.file._7z_osdfile);
 	fseek(new_7z->archiveStream.file._7z_osdfile, 0, SEEK_SET);
+	new_7z->mtime = mtime;
 
 	new_7z->allocImp.Alloc = SZipAlloc;
 	new_7z->allocImp.Free = SZipFree;
@@ -393,10 +435,6 @@ _7z_error _7z_file_open(const char *filename, _7z_file **_7z)
 		goto error;
 	}
 
-	new_7z->blockIndex = 0xFFFFFFFF; /* it can have any value before first call (if outBuffer = 0) */
-	new_7z->outBuffer = 0; /* it must be 0 before first call for each new archive. */
-	new_7z->outBufferSize = 0;  /* it can have any value before first call (if outBuffer = 0) */
-
 	/* make a copy of the filename for caching purposes */
 	string = (char *)malloc(strlen(filename) + 1);
 	if (string == NULL)
@@ -461,18 +499,57 @@ void _7z_file_cache_clear(void)
 			free__7z_file(_7z_cache[cachenum]);
 			_7z_cache[cachenum] = NULL;
 		}
+
+	/* and the unpacked blocks */
+	for (cachenum = 0; cachenum < ARRAY_LENGTH(_7z_block_cache); cachenum++)
+		_7z_block_free(&_7z_block_cache[cachenum]);
 }
 
 
 /*-------------------------------------------------
-    _7z_file_decompress - decompress a file
-    from a _7Z into the target buffer
+    _7z_file_get_block - find the unpacked solid
+    block holding the most recently found file,
+    unpacking it (and caching the result) if it
+    isn't in the block cache yet. *unpacked is
+    set if it was, SzArEx_Extract() checked the
+    file's crc then
 -------------------------------------------------*/
 
-_7z_error _7z_file_decompress(_7z_file *new_7z, void *buffer, UINT32 length, UINT32 *Processed)
+static _7z_error _7z_file_get_block(_7z_file *new_7z, _7z_block **block, size_t *offset, size_t *size, bool *unpacked)
 {
-	SRes res;
+	CSzArEx *db = &new_7z->db;
 	int index = new_7z->curr_file_idx;
+	UInt32 folder = db->FileToFolder[index];
+	unsigned int cachenum;
+
+	*block = NULL;
+	*offset = 0;
+	*size = 0;
+	*unpacked = false;
+
+	/* empty file, nothing to unpack */
+	if (folder == (UInt32)-1)
+		return _7ZERR_NONE;
+
+	for (cachenum = 0; cachenum < ARRAY_LENGTH(_7z_block_cache); cachenum++)
+	{
+		_7z_block *cached = &_7z_block_cache[cachenum];
+
+		if (cached->data != NULL && cached->index == folder && cached->length == new_7z->archiveStream.file._7z_length &&
+			cached->mtime == new_7z->mtime && strcmp(cached->filename, new_7z->filename) == 0)
+		{
+			UINT64 start = db->UnpackPositions[db->FolderToFile[folder]];
+
+			*offset = (size_t)(db->UnpackPositions[index] - start);
+			*size = (size_t)(db->UnpackPositions[index + 1] - db->UnpackPositions[index]);
+			if (*offset + *size > cached->size)
+				return _7ZERR_FILE_CORRUPT;
+
+			cached->lastused = ++_7z_block_cache_clock;
+			*block = cached;
+			return _7ZERR_NONE;
+		}
+	}
 
 	/* make sure the file is open.. */
 	if (new_7z->archiveStream.file._7z_osdfile==NULL)
@@ -484,20 +561,144 @@ _7z_error _7z_file_decompress(_7z_file *new_7z, void *buffer, UINT32 length, UIN
 		}
 	}
 
-	size_t offset = 0;
-	size_t outSizeProcessed = 0;
+	UInt32 blockIndex = 0xFFFFFFFF;
+	Byte *outBuffer = NULL; /* it must be 0, SzArEx_Extract() allocates it */
+	size_t outBufferSize = 0;
 
-	res = SzArEx_Extract(&new_7z->db, &new_7z->lookStream.vt, index,
-		&new_7z->blockIndex, &new_7z->outBuffer, &new_7z->outBufferSize,
-		&offset, &outSizeProcessed,
+	SRes res = SzArEx_Extract(db, &new_7z->lookStream.vt, index,
+		&blockIndex, &outBuffer, &outBufferSize,
+		offset, size,
 		&new_7z->allocImp, &new_7z->allocTempImp);
 
 	if (res != SZ_OK)
+	{
+		IAlloc_Free(&new_7z->allocImp, outBuffer);
 		return _7ZERR_FILE_ERROR;
+	}
+
+	char *filename = (char *)malloc(strlen(new_7z->filename) + 1);
+	if (filename == NULL)
+	{
+		IAlloc_Free(&new_7z->allocImp, outBuffer);
+		return _7ZERR_OUT_OF_MEMORY;
+	}
+	strcpy(filename, new_7z->filename);
+
+	/* make room, dropping the least recently used blocks. the new block is always
+	   kept, even on its own over the limit, so reading a big file a piece at a
+	   time doesn't unpack it over and over */
+	while (1)
+	{
+		_7z_block *oldest = NULL;
+		unsigned int used = 0;
+
+		for (cachenum = 0; cachenum < ARRAY_LENGTH(_7z_block_cache); cachenum++)
+		{
+			_7z_block *cached = &_7z_block_cache[cachenum];
+
+			if (cached->data == NULL) continue;
+			used++;
+
+			if (oldest == NULL || (INT32)(cached->lastused - oldest->lastused) < 0)
+				oldest = cached;
+		}
+
+		if (oldest == NULL) break;
+		if (used < ARRAY_LENGTH(_7z_block_cache) && _7z_block_cache_bytes + outBufferSize <= _7Z_BLOCK_CACHE_BYTES) break;
+
+		_7z_block_free(oldest);
+	}
+
+	for (cachenum = 0; cachenum < ARRAY_LENGTH(_7z_block_cache); cachenum++)
+		if (_7z_block_cache[cachenum].data == NULL)
+			break;
+
+	_7z_block *cached = &_7z_block_cache[cachenum];
+
+	cached->filename = filename;
+	cached->length = new_7z->archiveStream.file._7z_length;
+	cached->mtime = new_7z->mtime;
+	cached->index = folder;
+	cached->data = outBuffer;
+	cached->size = outBufferSize;
+	cached->lastused = ++_7z_block_cache_clock;
+
+	_7z_block_cache_bytes += outBufferSize;
+
+	*block = cached;
+	*unpacked = true;
+	return _7ZERR_NONE;
+}
+
+
+/*-------------------------------------------------
+    _7z_file_decompress - decompress a file
+    from a _7Z into the target buffer
+-------------------------------------------------*/
+
+_7z_error _7z_file_decompress(_7z_file *new_7z, void *buffer, UINT32 length, UINT32 *Processed)
+{
+	_7z_block *block;
+	size_t offset = 0;
+	size_t outSizeProcessed = 0;
+	int index = new_7z->curr_file_idx;
+	bool unpacked;
+
+	*Processed = 0;
+
+	_7z_error err = _7z_file_get_block(new_7z, &block, &offset, &outSizeProcessed, &unpacked);
+	if (err != _7ZERR_NONE)
+		return err;
+
+	if (block == NULL)
+		return _7ZERR_NONE;
+
+	if (length > outSizeProcessed)
+		length = outSizeProcessed;
+
+	/* the block may have been unpacked for another file, check this one */
+	if (!unpacked && SzBitWithVals_Check(&new_7z->db.CRCs, index))
+		if (CrcCalc(block->data + offset, outSizeProcessed) != new_7z->db.CRCs.Vals[index])
+			return _7ZERR_FILE_CORRUPT;
 
 	*Processed = outSizeProcessed;
 
-	memcpy(buffer, new_7z->outBuffer + offset, length);
+	memcpy(buffer, block->data + offset, length);
+
+	return _7ZERR_NONE;
+}
+
+
+/*-------------------------------------------------
+    _7z_file_decompress_part - decompress part of
+    the most recently found file. The solid block
+    stays in the block cache, so reading the rest
+    of the file piece by piece doesn't unpack it
+    again
+-------------------------------------------------*/
+
+_7z_error _7z_file_decompress_part(_7z_file *new_7z, void *buffer, UINT32 start, UINT32 length, UINT32 *Processed)
+{
+	_7z_block *block;
+	size_t offset = 0;
+	size_t outSizeProcessed = 0;
+	bool unpacked;
+
+	*Processed = 0;
+
+	_7z_error err = _7z_file_get_block(new_7z, &block, &offset, &outSizeProcessed, &unpacked);
+	if (err != _7ZERR_NONE)
+		return err;
+
+	if (block == NULL || start >= outSizeProcessed)
+		return _7ZERR_NONE;
+
+	if (length > outSizeProcessed - start)
+		length = outSizeProcessed - start;
+
+	memcpy(buffer, block->data + offset + start, length);
+
+	*Processed = length;
 
 	return _7ZERR_NONE;
 }
@@ -522,10 +723,48 @@ static void free__7z_file(_7z_file *_7z)
 		if (_7z->filename != NULL)
 			free((void *)_7z->filename);
 
-		if (_7z->outBuffer) IAlloc_Free(&_7z->allocImp, _7z->outBuffer);
 		if (_7z->inited) SzArEx_Free(&_7z->db, &_7z->allocImp);
 		if (_7z->lookStream.buf) free(_7z->lookStream.buf);
 
 		free(_7z);
 	}
 }
+
+
+/*-------------------------------------------------
+    _7z_block_free - free an unpacked block and
+    empty its slot in the block cache
+-------------------------------------------------*/
+
+static void _7z_block_free(_7z_block *block)
+{
+	if (block->data != NULL)
+	{
+		SZipFree(NULL, block->data);
+		_7z_block_cache_bytes -= block->size;
+	}
+	if (block->filename != NULL)
+		free(block->filename);
+
+	memset(block, 0, sizeof(*block));
+}
+
+
+/*-------------------------------------------------
+    _7z_file_stat - get the size and date of a
+    file, so cached data of a changed archive
+    isn't used
+-------------------------------------------------*/
+
+static int _7z_file_stat(const char *filename, UINT64 *length, time_t *mtime)
+{
+	struct stat st;
+
+	if (stat(filename, &st) != 0)
+		return 1;
+
+	*length = (UINT64)st.st_size;
+	*mtime = st.st_mtime;
+
+	return 0;
+}
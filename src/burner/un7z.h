@@ -52,6 +52,7 @@
 #define __UN_7Z_H__
 
 #include "driver.h"
+#include <time.h>
 
 #ifdef __LIBRETRO__
  #include <streams/file_stream_transforms.h>
@@ -148,10 +149,8 @@ struct __7z_file
 	ISzAlloc allocTempImp;
 	bool inited;
 
-	// cached stuff for solid blocks
-	UInt32 blockIndex;// = 0xFFFFFFFF; /* it can have any value before first call (if outBuffer = 0) */
-	Byte *outBuffer;// = 0; /* it must be 0 before first call for each new archive. */
-	size_t outBufferSize;// = 0;  /* it can have any value before first call (if outBuffer = 0) */
+	time_t mtime;							/* modification time when opened (for caching) */
+	// unpacked solid blocks live in the block cache (un7z.cpp), shared by every _7z_file
 };
 
 
@@ -169,7 +168,7 @@ _7z_error _7z_file_open(const char *filename, _7z_file **_7z);
 /* close a _7Z file (may actually be left open due to caching) */
 void _7z_file_close(_7z_file *_7z);
 
-/* clear out all open _7Z files from the cache */
+/* clear out all open _7Z files and unpacked blocks from the cache */
 void _7z_file_cache_clear(void);
 
 
@@ -181,5 +180,8 @@ int _7z_search_crc_match(_7z_file *new_7z, UINT32 crc, const char *search_filena
 /* decompress the most recently found file in the _7Z */
 _7z_error _7z_file_decompress(_7z_file *new_7z, void *buffer, UINT32 length, UINT32 *Processed);
 
+/* decompress length bytes from start of the most recently found file */
+_7z_error _7z_file_decompress_part(_7z_file *new_7z, void *buffer, UINT32 start, UINT32 length, UINT32 *Processed);
+
 
 #endif	/* __UN_7Z_H__ */
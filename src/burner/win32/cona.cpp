@@ -257,6 +257,7 @@ int ConfigAppLoad()
 		STR(szAppPCBsPath);
 		STR(szAppHistoryPath);
 		STR(szAppEEPROMPath);
+		STR(szBurnCachePath);
 
 		VAR(bEnableHighResTimer);
 		VAR(bNoChangeNumLock);
@@ -663,6 +664,8 @@ int ConfigAppSave()
 	STR(szAppPCBsPath);
 	STR(szAppHistoryPath);
 	STR(szAppEEPROMPath);
+	_ftprintf(h, _T("\n// Decoded data shared between runs, e.g. samples (empty = don't cache)\n"));
+	STR(szBurnCachePath);
 
 	_ftprintf(h, _T("\n// The cartridges to use for emulation of an MVS system\n"));
 	DRV(nBurnDrvSelect[0]);
@@ -85,6 +85,9 @@ static int DoLibInit()					// Do Init of Burn library driver
 		}
 	}
 
+	BurnProfileBegin();
+	BzipPrefetch();
+
 	nRet = BurnDrvInit();
 
 	RomDataSetFullName();
@@ -332,6 +335,7 @@ int DrvExit()
 	}
 
 	BurnExtLoadRom = NULL;
+	BzipPartExit();
 
 	bDrvOkay = 0;					// Stop using the BurnDrv functions
 
@@ -1,6 +1,7 @@
 // Zip module
 #include "burner.h"
 #include "unzip.h"
+#include <sys/stat.h>
 
 #ifdef INCLUDE_7Z_SUPPORT
 #include "un7z.h"
@@ -19,15 +20,319 @@ static INT32 nCurrFile = 0; // The current file we are pointing to
 static _7z_file* _7ZipFile = NULL;
 #endif
 
+static char szZipName[MAX_PATH];		// the archive ZipOpen() found, with extension
+
+// ----------------------------------------------------------------------------
+// Archive index: the member list of every archive we've looked in, keyed by its
+// path, size and modification time and kept in a file between runs. ZipOpen()
+// of an archive that hasn't changed since doesn't read it at all, it is only
+// really opened once something is loaded from it. Scanning a whole romset then
+// only has to read the archives that are new or have changed.
+
+#define ZIP_INDEX_MAGIC			"FBZI"
+#define ZIP_INDEX_VERSION		1
+#define ZIP_INDEX_HASH			4096
+
+struct ZipIndexEntry {
+	struct ZipIndexEntry* pNext;
+	char* szName;
+	INT32 nFileType;
+	INT64 nSize;
+	INT64 nTime;
+	INT32 nCount;
+	struct ZipEntry* List;
+};
+
+static struct ZipIndexEntry* ZipIndex[ZIP_INDEX_HASH];
+static char szZipIndexFile[MAX_PATH] = "";	// empty = no index
+static INT32 bZipIndexDirty = 0;
+
+static struct ZipIndexEntry* pZipIndexed = NULL;	// ZipOpen() found the archive in the index, not opened yet
+
+static UINT32 ZipIndexHash(const char* szName)
+{
+	return BurnHashString(szName) & (ZIP_INDEX_HASH - 1);
+}
+
+static struct ZipIndexEntry* ZipIndexNew(const char* szName, INT32 nFileType, INT64 nSize, INT64 nTime, INT32 nCount)
+{
+	struct ZipIndexEntry* e = (struct ZipIndexEntry*)malloc(sizeof(struct ZipIndexEntry));
+	if (e == NULL) return NULL;
+
+	e->szName = strdup(szName);
+	e->nFileType = nFileType;
+	e->nSize = nSize;
+	e->nTime = nTime;
+	e->nCount = nCount;
+	e->List = (struct ZipEntry*)calloc(nCount ? nCount : 1, sizeof(struct ZipEntry));
+
+	if (e->szName == NULL || e->List == NULL) {
+		free(e->szName);
+		free(e->List);
+		free(e);
+		return NULL;
+	}
+
+	UINT32 nHash = ZipIndexHash(szName);
+	e->pNext = ZipIndex[nHash];
+	ZipIndex[nHash] = e;
+
+	return e;
+}
+
+static void ZipIndexRemove(const char* szName)
+{
+	for (struct ZipIndexEntry** pp = &ZipIndex[ZipIndexHash(szName)]; *pp; pp = &(*pp)->pNext) {
+		struct ZipIndexEntry* e = *pp;
+
+		if (strcmp(e->szName, szName) == 0) {
+			*pp = e->pNext;
+
+			for (INT32 i = 0; i < e->nCount; i++) {
+				free(e->List[i].szName);
+			}
+			free(e->List);
+			free(e->szName);
+			free(e);
+
+			return;
+		}
+	}
+}
+
+// the entry for szName, if the archive hasn't changed since it was indexed
+static struct ZipIndexEntry* ZipIndexFind(const char* szName, INT32 nFileType)
+{
+	if (szZipIndexFile[0] == 0) return NULL;
+
+	struct stat st;
+	if (stat(szName, &st)) return NULL;
+
+	for (struct ZipIndexEntry* e = ZipIndex[ZipIndexHash(szName)]; e; e = e->pNext) {
+		if (strcmp(e->szName, szName) == 0) {
+			if (e->nFileType == nFileType && e->nSize == (INT64)st.st_size && e->nTime == (INT64)st.st_mtime) return e;
+			break;
+		}
+	}
+
+	return NULL;
+}
+
+// remember the member list of an archive we've just read
+static void ZipIndexStore(const char* szName, INT32 nFileType, struct ZipEntry* List, INT32 nCount)
+{
+	if (szZipIndexFile[0] == 0) return;
+
+	struct stat st;
+	if (stat(szName, &st)) return;
+
+	ZipIndexRemove(szName);
+
+	struct ZipIndexEntry* e = ZipIndexNew(szName, nFileType, st.st_size, st.st_mtime, nCount);
+	if (e == NULL) return;
+
+	for (INT32 i = 0; i < nCount; i++) {
+		e->List[i].szName = List[i].szName ? strdup(List[i].szName) : NULL;
+		e->List[i].nLen = List[i].nLen;
+		e->List[i].nCrc = List[i].nCrc;
+	}
+
+	bZipIndexDirty = 1;
+}
+
+static char* ZipIndexReadString(FILE* h)
+{
+	UINT16 nLen = 0;
+	if (fread(&nLen, sizeof(nLen), 1, h) != 1 || nLen == 0) return NULL; // 0 = no string
+
+	char* szString = (char*)malloc(nLen);
+	if (szString == NULL) return NULL;
+
+	if (fread(szString, nLen - 1, 1, h) != 1) {
+		free(szString);
+		return NULL;
+	}
+	szString[nLen - 1] = 0;
+
+	return szString;
+}
+
+static INT32 ZipIndexWriteString(FILE* h, const char* szString)
+{
+	UINT16 nLen = szString ? strlen(szString) + 1 : 0;
+
+	if (fwrite(&nLen, sizeof(nLen), 1, h) != 1) return 1;
+	if (nLen > 1 && fwrite(szString, nLen - 1, 1, h) != 1) return 1;
+
+	return 0;
+}
+
+static INT32 ZipIndexLoad()
+{
+	FILE* h = fopen(szZipIndexFile, "rb");
+	if (h == NULL) return 1;
+
+	char szMagic[4];
+	UINT32 nHeader[2] = { 0, 0 }; // version, number of archives
+
+	if (fread(szMagic, 4, 1, h) != 1 || memcmp(szMagic, ZIP_INDEX_MAGIC, 4) || fread(nHeader, sizeof(nHeader), 1, h) != 1 || nHeader[0] != ZIP_INDEX_VERSION) {
+		fclose(h);
+		return 1;
+	}
+
+	for (UINT32 n = 0; n < nHeader[1]; n++) {
+		char* szName = ZipIndexReadString(h);
+		INT32 nFileType = 0, nCount = 0;
+		INT64 nSize = 0, nTime = 0;
+
+		if (szName == NULL || fread(&nFileType, sizeof(nFileType), 1, h) != 1 || fread(&nSize, sizeof(nSize), 1, h) != 1 ||
+			fread(&nTime, sizeof(nTime), 1, h) != 1 || fread(&nCount, sizeof(nCount), 1, h) != 1 || nCount < 0)
+		{
+			free(szName);
+			break;
+		}
+
+		struct ZipIndexEntry* e = ZipIndexNew(szName, nFileType, nSize, nTime, nCount);
+		free(szName);
+		if (e == NULL) break;
+
+		INT32 bOK = 1;
+		for (INT32 i = 0; i < nCount && bOK; i++) {
+			bOK = fread(&e->List[i].nCrc, sizeof(UINT32), 1, h) == 1 && fread(&e->List[i].nLen, sizeof(UINT32), 1, h) == 1;
+			e->List[i].szName = ZipIndexReadString(h);
+		}
+
+		if (!bOK) {
+			ZipIndexRemove(e->szName); // truncated file, keep what we've got so far
+			break;
+		}
+	}
+
+	fclose(h);
+
+	return 0;
+}
+
+INT32 ZipIndexSave()
+{
+	if (szZipIndexFile[0] == 0 || bZipIndexDirty == 0) return 0;
+
+	FILE* h = fopen(szZipIndexFile, "wb");
+	if (h == NULL) return 1;
+
+	UINT32 nHeader[2] = { ZIP_INDEX_VERSION, 0 };
+
+	for (INT32 i = 0; i < ZIP_INDEX_HASH; i++) {
+		for (struct ZipIndexEntry* e = ZipIndex[i]; e; e = e->pNext) {
+			nHeader[1]++;
+		}
+	}
+
+	INT32 nRet = 0;
+
+	if (fwrite(ZIP_INDEX_MAGIC, 4, 1, h) != 1 || fwrite(nHeader, sizeof(nHeader), 1, h) != 1) nRet = 1;
+
+	for (INT32 i = 0; i < ZIP_INDEX_HASH && nRet == 0; i++) {
+		for (struct ZipIndexEntry* e = ZipIndex[i]; e && nRet == 0; e = e->pNext) {
+			if (ZipIndexWriteString(h, e->szName) || fwrite(&e->nFileType, sizeof(e->nFileType), 1, h) != 1 || fwrite(&e->nSize, sizeof(e->nSize), 1, h) != 1 ||
+				fwrite(&e->nTime, sizeof(e->nTime), 1, h) != 1 || fwrite(&e->nCount, sizeof(e->nCount), 1, h) != 1)
+			{
+				nRet = 1;
+			}
+
+			for (INT32 j = 0; j < e->nCount && nRet == 0; j++) {
+				if (fwrite(&e->List[j].nCrc, sizeof(UINT32), 1, h) != 1 || fwrite(&e->List[j].nLen, sizeof(UINT32), 1, h) != 1 || ZipIndexWriteString(h, e->List[j].szName)) {
+					nRet = 1;
+				}
+			}
+		}
+	}
+
+	if (fclose(h)) nRet = 1;
+
+	if (nRet) {
+		remove(szZipIndexFile);		// better no index than half of one
+	} else {
+		bZipIndexDirty = 0;
+	}
+
+	return nRet;
+}
+
+// szFile: where the index is kept, it's loaded now and saved by ZipIndexSave()/ZipIndexExit()
+INT32 ZipIndexInit(const char* szFile)
+{
+	ZipIndexExit();
+
+	if (szFile == NULL || szFile[0] == 0) return 1;
+
+	strncpy(szZipIndexFile, szFile, MAX_PATH - 1);
+	szZipIndexFile[MAX_PATH - 1] = 0;
+
+	return ZipIndexLoad();
+}
+
+void ZipIndexExit()
+{
+	ZipIndexSave();
+
+	for (INT32 i = 0; i < ZIP_INDEX_HASH; i++) {
+		while (ZipIndex[i]) {
+			ZipIndexRemove(ZipIndex[i]->szName);
+		}
+	}
+
+	pZipIndexed = NULL;
+	szZipIndexFile[0] = 0;
+	bZipIndexDirty = 0;
+}
+
+// the archive was found in the index, open it for real
+static INT32 ZipOpenIndexed()
+{
+	pZipIndexed = NULL;
+
+	if (nFileType == ZIPFN_FILETYPE_ZIP) {
+		Zip = unzOpen(szZipName);
+		if (Zip == NULL) return 1;
+
+		unzGoToFirstFile(Zip);
+		nCurrFile = 0;
+	}
+
+#ifdef INCLUDE_7Z_SUPPORT
+	if (nFileType == ZIPFN_FILETYPE_7ZIP) {
+		if (_7z_file_open(szZipName, &_7ZipFile) != _7ZERR_NONE) {
+			_7ZipFile = NULL;
+			return 1;
+		}
+	}
+#endif
+
+	return 0;
+}
+
+// ----------------------------------------------------------------------------
+
 INT32 ZipOpen(char* szZip)
 {
 	nFileType = ZIPFN_FILETYPE_NONE;
+	pZipIndexed = NULL;
 
 	if (szZip == NULL) return 1;
 
 	char szFileName[MAX_PATH];
 
 	sprintf(szFileName, "%s.zip", szZip);
+	strcpy(szZipName, szFileName);
+
+	if ((pZipIndexed = ZipIndexFind(szFileName, ZIPFN_FILETYPE_ZIP)) != NULL) {
+		nFileType = ZIPFN_FILETYPE_ZIP;
+		nCurrFile = 0;
+
+		return 0;
+	}
+
 	Zip = unzOpen(szFileName);
 	if (Zip != NULL) {
 		nFileType = ZIPFN_FILETYPE_ZIP;
@@ -39,6 +344,15 @@ INT32 ZipOpen(char* szZip)
 
 #ifdef INCLUDE_7Z_SUPPORT
 	sprintf(szFileName, "%s.7z", szZip);
+	strcpy(szZipName, szFileName);
+
+	if ((pZipIndexed = ZipIndexFind(szFileName, ZIPFN_FILETYPE_7ZIP)) != NULL) {
+		nFileType = ZIPFN_FILETYPE_7ZIP;
+		nCurrFile = 0;
+
+		return 0;
+	}
+
 	_7z_error _7zerr = 	_7z_file_open(szFileName, &_7ZipFile);
 	if (_7zerr == _7ZERR_NONE) {
 		nFileType = ZIPFN_FILETYPE_7ZIP;
@@ -53,6 +367,8 @@ INT32 ZipOpen(char* szZip)
 
 INT32 ZipClose()
 {
+	pZipIndexed = NULL;
+
 	if (nFileType == ZIPFN_FILETYPE_ZIP) {
 		if (Zip != NULL) {
 			unzClose(Zip);
@@ -77,6 +393,24 @@ INT32 ZipClose()
 // Get the contents of a zip file into an array of ZipEntrys
 INT32 ZipGetList(struct ZipEntry** pList, INT32* pnListCount)
 {
+	if (pZipIndexed != NULL) {
+		if (pList == NULL) return 1;
+
+		struct ZipEntry* List = (struct ZipEntry *)malloc((pZipIndexed->nCount ? pZipIndexed->nCount : 1) * sizeof(struct ZipEntry));
+		if (List == NULL) return 1;
+
+		for (INT32 i = 0; i < pZipIndexed->nCount; i++) {
+			List[i].szName = pZipIndexed->List[i].szName ? strdup(pZipIndexed->List[i].szName) : NULL;
+			List[i].nLen = pZipIndexed->List[i].nLen;
+			List[i].nCrc = pZipIndexed->List[i].nCrc;
+		}
+
+		*pList = List;
+		if (pnListCount != NULL) *pnListCount = pZipIndexed->nCount;
+
+		return 0;
+	}
+
 	if (nFileType == ZIPFN_FILETYPE_ZIP && Zip == NULL) return 1;
 	if (pList == NULL) return 1;
 
@@ -130,6 +464,8 @@ INT32 ZipGetList(struct ZipEntry** pList, INT32* pnListCount)
 
 		unzGoToFirstFile(Zip);
 		nCurrFile = 0;
+
+		ZipIndexStore(szZipName, ZIPFN_FILETYPE_ZIP, List, nListLen);
 	}
 
 #ifdef INCLUDE_7Z_SUPPORT
@@ -190,6 +526,8 @@ INT32 ZipGetList(struct ZipEntry** pList, INT32* pnListCount)
 		nCurrFile = 0;
 
 		SZipFree(NULL, temp);
+
+		ZipIndexStore(szZipName, ZIPFN_FILETYPE_7ZIP, List, nListLen);
 	}
 #endif
 
@@ -198,6 +536,8 @@ INT32 ZipGetList(struct ZipEntry** pList, INT32* pnListCount)
 
 INT32 ZipLoadFile(UINT8* Dest, INT32 nLen, INT32* pnWrote, INT32 nEntry)
 {
+	if (pZipIndexed != NULL && ZipOpenIndexed()) return 1;
+
 	if (nFileType == ZIPFN_FILETYPE_ZIP && Zip == NULL) return 1;
 
 #ifdef INCLUDE_7Z_SUPPORT
@@ -264,6 +604,11 @@ INT32 __cdecl ZipLoadOneFile(char* arcName, const char* fileName, void** Dest, I
 		return 1;
 	}
 
+	if (pZipIndexed != NULL && ZipOpenIndexed()) {
+		ZipClose();
+		return 1;
+	}
+
 	if (nFileType == ZIPFN_FILETYPE_ZIP) {
 		unz_global_info ZipGlobalInfo;
 		memset(&ZipGlobalInfo, 0, sizeof(ZipGlobalInfo));
@@ -398,3 +743,551 @@ INT32 __cdecl ZipLoadOneFile(char* arcName, const char* fileName, void** Dest, I
 
 	return 0;
 }
+
+// ----------------------------------------------------------------------------
+// Scan: list an archive (szFileName with its extension) without touching the
+// state ZipOpen() keeps, so zip archives can be scanned from any thread. 7z
+// archives share un7z.cpp's file cache, only one thread may scan those at a
+// time. With bVerify every member is inflated, and nCrc and nLen describe what
+// actually came out rather than what the directory says.
+
+#define ZIP_SCAN_BUFFER			(64 << 10)
+
+static INT32 ZipScanZip(char* szFileName, struct ZipEntry** pList, INT32* pnListCount, INT32 bVerify)
+{
+	unzFile ZipScan = unzOpen(szFileName);
+	if (ZipScan == NULL) return 1;
+
+	unz_global_info ZipGlobalInfo;
+	memset(&ZipGlobalInfo, 0, sizeof(ZipGlobalInfo));
+	unzGetGlobalInfo(ZipScan, &ZipGlobalInfo);
+
+	INT32 nListLen = ZipGlobalInfo.number_entry;
+
+	struct ZipEntry* List = (struct ZipEntry *)calloc(nListLen ? nListLen : 1, sizeof(struct ZipEntry));
+	UINT8* pBuffer = bVerify ? (UINT8*)malloc(ZIP_SCAN_BUFFER) : NULL;
+
+	if (List == NULL || (bVerify && pBuffer == NULL)) {
+		free(List);
+		free(pBuffer);
+		unzClose(ZipScan);
+		return 1;
+	}
+
+	INT32 nRet = unzGoToFirstFile(ZipScan);
+
+	for (INT32 i = 0; i < nListLen && nRet == UNZ_OK; i++, nRet = unzGoToNextFile(ZipScan)) {
+		unz_file_info FileInfo;
+		char szName[MAX_PATH];
+
+		if (unzGetCurrentFileInfo(ZipScan, &FileInfo, szName, MAX_PATH, NULL, 0, NULL, 0) != UNZ_OK) continue;
+
+		List[i].szName = strdup(szName);
+		List[i].nLen = FileInfo.uncompressed_size;
+		List[i].nCrc = FileInfo.crc;
+
+		if (bVerify) {
+			UINT32 nCrc = 0;
+			UINT32 nLen = 0;
+
+			if (unzOpenCurrentFile(ZipScan) == UNZ_OK) {
+				INT32 nRead;
+				while ((nRead = unzReadCurrentFile(ZipScan, pBuffer, ZIP_SCAN_BUFFER)) > 0) {
+					nCrc = crc32(nCrc, pBuffer, nRead);
+					nLen += nRead;
+				}
+				unzCloseCurrentFile(ZipScan);
+			}
+
+			List[i].nLen = nLen;
+			List[i].nCrc = nCrc;
+		}
+	}
+
+	free(pBuffer);
+	unzClose(ZipScan);
+
+	*pList = List;
+	*pnListCount = nListLen;
+
+	return 0;
+}
+
+#ifdef INCLUDE_7Z_SUPPORT
+static INT32 ZipScan7z(char* szFileName, struct ZipEntry** pList, INT32* pnListCount, INT32 bVerify)
+{
+	_7z_file* _7zScan = NULL;
+	if (_7z_file_open(szFileName, &_7zScan) != _7ZERR_NONE) return 1;
+
+	INT32 nListLen = _7zScan->db.NumFiles;
+
+	struct ZipEntry* List = (struct ZipEntry *)calloc(nListLen ? nListLen : 1, sizeof(struct ZipEntry));
+	if (List == NULL) {
+		_7z_file_close(_7zScan);
+		return 1;
+	}
+
+	for (INT32 i = 0; i < nListLen; i++) {
+		if (SzArEx_IsDir(&_7zScan->db, i)) continue;
+
+		size_t len = SzArEx_GetFileNameUtf16(&_7zScan->db, i, NULL);
+		UInt16* temp = (UInt16 *)malloc(len * sizeof(UInt16));
+		char* szName = (char *)malloc(len + 1);
+
+		if (temp && szName) {
+			SzArEx_GetFileNameUtf16(&_7zScan->db, i, temp);
+
+			for (UINT32 j = 0; j < len; j++) {
+				szName[j] = temp[j] & 0xff;
+			}
+			szName[len] = 0;
+
+			List[i].szName = szName;
+			szName = NULL;
+		}
+
+		free(temp);
+		free(szName);
+
+		List[i].nLen = SzArEx_GetFileSize(&_7zScan->db, i);
+		List[i].nCrc = _7zScan->db.CRCs.Vals[i];
+
+		if (bVerify) {
+			UINT8* pData = (UINT8*)malloc(List[i].nLen ? List[i].nLen : 1);
+			UINT32 nWrote = 0;
+
+			_7zScan->curr_file_idx = i;
+
+			if (pData == NULL || _7z_file_decompress(_7zScan, pData, List[i].nLen, &nWrote) != _7ZERR_NONE) {
+				nWrote = 0;
+			}
+
+			List[i].nCrc = crc32(0, pData, nWrote);
+			List[i].nLen = nWrote;
+
+			free(pData);
+		}
+	}
+
+	_7z_file_close(_7zScan);
+
+	*pList = List;
+	*pnListCount = nListLen;
+
+	return 0;
+}
+#endif
+
+INT32 ZipScan(char* szFileName, struct ZipEntry** pList, INT32* pnListCount, INT32 bVerify)
+{
+	if (szFileName == NULL || pList == NULL || pnListCount == NULL) return 1;
+
+	*pList = NULL;
+	*pnListCount = 0;
+
+	INT32 nLen = strlen(szFileName);
+
+	if (nLen > 3 && stricmp(szFileName + nLen - 3, ".7z") == 0) {
+#ifdef INCLUDE_7Z_SUPPORT
+		return ZipScan7z(szFileName, pList, pnListCount, bVerify);
+#else
+		return 1;
+#endif
+	}
+
+	return ZipScanZip(szFileName, pList, pnListCount, bVerify);
+}
+
+// ----------------------------------------------------------------------------
+// Prefetch: once the romset has been matched, inflate every wanted member on the
+// libburn worker pool so the driver's BurnLoadRom() calls are just copies.
+// Entries are keyed by CRC (and length), so a rom which is loaded more than once
+// or shared between sets is only inflated once, and freed after its last load.
+
+#define ZIP_PREFETCH_LIMIT		(1024 << 20)	// never hold more than this inflated at once
+
+struct ZipPrefetchEntry {
+	char szZip[MAX_PATH];
+	INT32 nEntry;
+	UINT32 nCrc;
+	INT32 nLen;
+	INT32 nRefs;
+	INT32 nFileType;
+	unz_file_pos Pos;
+	UINT8* pData;
+	INT32 nWrote;
+	INT32 nRet;
+};
+
+static struct ZipPrefetchEntry* Prefetch = NULL;
+static INT32 nPrefetchCount = 0;
+static INT32 nPrefetchAlloc = 0;
+static INT32 nPrefetchSize = 0;
+
+INT32 ZipPrefetchAdd(char* szZip, INT32 nEntry, UINT32 nCrc, INT32 nLen)
+{
+	if (szZip == NULL || nCrc == 0 || nLen <= 0) return 1;
+
+	for (INT32 i = 0; i < nPrefetchCount; i++) {
+		if (Prefetch[i].nCrc == nCrc && Prefetch[i].nLen == nLen) {
+			Prefetch[i].nRefs++;
+			return 0;
+		}
+	}
+
+	if (nPrefetchSize + nLen > ZIP_PREFETCH_LIMIT) return 1;
+
+	if (nPrefetchCount == nPrefetchAlloc) {
+		INT32 nNewAlloc = nPrefetchAlloc ? nPrefetchAlloc * 2 : 64;
+		struct ZipPrefetchEntry* pNew = (struct ZipPrefetchEntry*)realloc(Prefetch, nNewAlloc * sizeof(struct ZipPrefetchEntry));
+		if (pNew == NULL) return 1;
+		Prefetch = pNew;
+		nPrefetchAlloc = nNewAlloc;
+	}
+
+	struct ZipPrefetchEntry* pe = &Prefetch[nPrefetchCount++];
+	memset(pe, 0, sizeof(struct ZipPrefetchEntry));
+	strncpy(pe->szZip, szZip, MAX_PATH - 1);
+	pe->nEntry = nEntry;
+	pe->nCrc = nCrc;
+	pe->nLen = nLen;
+	pe->nRefs = 1;
+	pe->nFileType = ZIPFN_FILETYPE_NONE;
+	pe->nRet = 1;
+
+	nPrefetchSize += nLen;
+
+	return 0;
+}
+
+// runs on the worker pool: every zip member gets its own job and file handle,
+// all the 7z members share one job (un7z.cpp's file cache isn't thread safe)
+static void ZipPrefetchJob(INT32 nJob, void*)
+{
+	for (INT32 i = 0; i < nPrefetchCount; i++) {
+		struct ZipPrefetchEntry* pe = &Prefetch[i];
+
+		if (pe->nFileType == ZIPFN_FILETYPE_ZIP && nJob-- == 0) {
+			char szFileName[MAX_PATH];
+			sprintf(szFileName, "%s.zip", pe->szZip);
+
+			unzFile ZipJob = unzOpen(szFileName);
+			if (ZipJob == NULL) return;
+
+			pe->pData = (UINT8*)malloc(pe->nLen);
+
+			if (pe->pData && unzGoToFilePos(ZipJob, &pe->Pos) == UNZ_OK && unzOpenCurrentFile(ZipJob) == UNZ_OK) {
+				pe->nWrote = unzReadCurrentFile(ZipJob, pe->pData, pe->nLen);
+				pe->nRet = (unzCloseCurrentFile(ZipJob) == UNZ_OK && pe->nWrote >= 0) ? 0 : 1;
+			}
+
+			unzClose(ZipJob);
+			return;
+		}
+	}
+
+#ifdef INCLUDE_7Z_SUPPORT
+	if (nJob != 0) return;
+
+	for (INT32 i = 0; i < nPrefetchCount; i++) {
+		struct ZipPrefetchEntry* pe = &Prefetch[i];
+		if (pe->nFileType != ZIPFN_FILETYPE_7ZIP) continue;
+
+		char szFileName[MAX_PATH];
+		sprintf(szFileName, "%s.7z", pe->szZip);
+
+		_7z_file* _7zJob = NULL;
+		if (_7z_file_open(szFileName, &_7zJob) != _7ZERR_NONE) continue;
+
+		pe->pData = (UINT8*)malloc(pe->nLen);
+
+		if (pe->pData) {
+			UINT32 nWrote = 0;
+			_7zJob->curr_file_idx = pe->nEntry;
+
+			if (_7z_file_decompress(_7zJob, pe->pData, pe->nLen, &nWrote) == _7ZERR_NONE && crc32(0, pe->pData, nWrote) == _7zJob->db.CRCs.Vals[pe->nEntry]) {
+				pe->nWrote = nWrote;
+				pe->nRet = 0;
+			}
+		}
+
+		_7z_file_close(_7zJob);
+	}
+#endif
+}
+
+INT32 ZipPrefetchRun()
+{
+	INT32 nJobs = 0;
+	INT32 b7z = 0;
+
+	BurnProfileStart(BURN_PROFILE_PREFETCH);
+
+	// find out which archive type each entry is in, and where it sits in a zip
+	for (INT32 i = 0; i < nPrefetchCount; i++) {
+		if (Prefetch[i].nFileType != ZIPFN_FILETYPE_NONE) continue;
+
+		char szFileName[MAX_PATH];
+		sprintf(szFileName, "%s.zip", Prefetch[i].szZip);
+
+		unzFile ZipList = unzOpen(szFileName);
+
+		if (ZipList == NULL) {
+#ifdef INCLUDE_7Z_SUPPORT
+			for (INT32 j = i; j < nPrefetchCount; j++) {
+				if (strcmp(Prefetch[j].szZip, Prefetch[i].szZip) == 0) {
+					Prefetch[j].nFileType = ZIPFN_FILETYPE_7ZIP;
+					b7z = 1;
+				}
+			}
+#endif
+			continue;
+		}
+
+		INT32 nEntry = 0;
+		INT32 nRet = unzGoToFirstFile(ZipList);
+
+		while (nRet == UNZ_OK) {
+			for (INT32 j = i; j < nPrefetchCount; j++) {
+				struct ZipPrefetchEntry* pe = &Prefetch[j];
+
+				if (pe->nFileType == ZIPFN_FILETYPE_NONE && pe->nEntry == nEntry && strcmp(pe->szZip, Prefetch[i].szZip) == 0) {
+					if (unzGetFilePos(ZipList, &pe->Pos) == UNZ_OK) {
+						pe->nFileType = ZIPFN_FILETYPE_ZIP;
+						nJobs++;
+					}
+				}
+			}
+
+			nEntry++;
+			nRet = unzGoToNextFile(ZipList);
+		}
+
+		unzClose(ZipList);
+	}
+
+	BurnPoolRun(ZipPrefetchJob, NULL, nJobs + b7z);
+
+	BurnProfileStop();
+
+	return 0;
+}
+
+// 0 = loaded from the prefetched data, otherwise the caller should load it itself
+INT32 ZipPrefetchLoad(UINT8* Dest, INT32 nLen, INT32* pnWrote, UINT32 nCrc)
+{
+	for (INT32 i = 0; i < nPrefetchCount; i++) {
+		struct ZipPrefetchEntry* pe = &Prefetch[i];
+
+		if (pe->nCrc != nCrc || pe->nLen != nLen || pe->pData == NULL) continue;
+
+		if (pe->nRet) return 1;
+
+		memcpy(Dest, pe->pData, pe->nWrote);
+		if (pnWrote != NULL) *pnWrote = pe->nWrote;
+
+		if (--pe->nRefs == 0) {
+			free(pe->pData);
+			pe->pData = NULL;
+		}
+
+		return 0;
+	}
+
+	return 1;
+}
+
+void ZipPrefetchExit()
+{
+	for (INT32 i = 0; i < nPrefetchCount; i++) {
+		if (Prefetch[i].pData) {
+			free(Prefetch[i].pData);
+		}
+	}
+
+	if (Prefetch) {
+		free(Prefetch);
+		Prefetch = NULL;
+	}
+
+	nPrefetchCount = 0;
+	nPrefetchAlloc = 0;
+	nPrefetchSize = 0;
+}
+
+// ----------------------------------------------------------------------------
+// Part loads, for the lazily loaded rom regions in libburn (BurnExtLoadRomPart).
+// A few members are kept open, so reading on from where the last read stopped
+// is cheap. Zip members can only be read forwards, going back means inflating
+// the member again from the start. 7z members come out of the solid block
+// un7z.cpp keeps unpacked.
+
+#define ZIP_PART_SLOTS			4
+
+struct ZipPartSlot {
+	char szZip[MAX_PATH];
+	INT32 nEntry;
+	unzFile Zip;
+	INT32 nPos;			// where the next unzReadCurrentFile() reads from
+	UINT32 nUsed;
+};
+
+static struct ZipPartSlot PartSlot[ZIP_PART_SLOTS];
+static UINT32 nPartClock = 0;
+
+#ifdef INCLUDE_7Z_SUPPORT
+static char szPart7z[MAX_PATH] = "";
+static _7z_file* _7zPartFile = NULL;
+#endif
+
+static void ZipPartSlotClose(struct ZipPartSlot* ps)
+{
+	if (ps->Zip != NULL) {
+		unzCloseCurrentFile(ps->Zip);
+		unzClose(ps->Zip);
+	}
+
+	memset(ps, 0, sizeof(struct ZipPartSlot));
+}
+
+static INT32 ZipLoadPartZip(char* szZip, INT32 nEntry, UINT8* Dest, INT32 nOffset, INT32 nLen, INT32* pnWrote)
+{
+	struct ZipPartSlot* ps = NULL;
+
+	// a slot already reading this member, from before the part we want
+	for (INT32 i = 0; i < ZIP_PART_SLOTS; i++) {
+		if (PartSlot[i].Zip != NULL && PartSlot[i].nEntry == nEntry && PartSlot[i].nPos <= nOffset && strcmp(PartSlot[i].szZip, szZip) == 0) {
+			ps = &PartSlot[i];
+			break;
+		}
+	}
+
+	if (ps == NULL) {
+		// otherwise reuse the least recently used one
+		ps = &PartSlot[0];
+		for (INT32 i = 1; i < ZIP_PART_SLOTS; i++) {
+			if (PartSlot[i].nUsed < ps->nUsed) ps = &PartSlot[i];
+		}
+
+		ZipPartSlotClose(ps);
+
+		char szFileName[MAX_PATH];
+		sprintf(szFileName, "%s.zip", szZip);
+
+		ps->Zip = unzOpen(szFileName);
+		if (ps->Zip == NULL) return 1;
+
+		INT32 nRet = unzGoToFirstFile(ps->Zip);
+		for (INT32 i = 0; i < nEntry && nRet == UNZ_OK; i++) {
+			nRet = unzGoToNextFile(ps->Zip);
+		}
+
+		if (nRet != UNZ_OK || unzOpenCurrentFile(ps->Zip) != UNZ_OK) {
+			unzClose(ps->Zip);
+			ps->Zip = NULL;
+			return 1;
+		}
+
+		strncpy(ps->szZip, szZip, MAX_PATH - 1);
+		ps->nEntry = nEntry;
+		ps->nPos = 0;
+	}
+
+	ps->nUsed = ++nPartClock;
+
+	// skip up to the part we want, Dest is big enough to inflate into as we go
+	while (ps->nPos < nOffset) {
+		INT32 nSkip = nOffset - ps->nPos;
+		if (nSkip > nLen) nSkip = nLen;
+
+		INT32 nRet = unzReadCurrentFile(ps->Zip, Dest, nSkip);
+		if (nRet <= 0) {
+			ZipPartSlotClose(ps);
+			return 1;
+		}
+
+		ps->nPos += nRet;
+	}
+
+	INT32 nRet = unzReadCurrentFile(ps->Zip, Dest, nLen);
+	if (nRet < 0) {
+		ZipPartSlotClose(ps);
+		return 1;
+	}
+
+	ps->nPos += nRet;
+	if (pnWrote != NULL) *pnWrote = nRet;
+
+	return 0;
+}
+
+#ifdef INCLUDE_7Z_SUPPORT
+static INT32 ZipLoadPart7z(char* szZip, INT32 nEntry, UINT8* Dest, INT32 nOffset, INT32 nLen, INT32* pnWrote)
+{
+	if (_7zPartFile == NULL || strcmp(szPart7z, szZip)) {
+		if (_7zPartFile != NULL) {
+			_7z_file_close(_7zPartFile);
+			_7zPartFile = NULL;
+		}
+
+		char szFileName[MAX_PATH];
+		sprintf(szFileName, "%s.7z", szZip);
+
+		if (_7z_file_open(szFileName, &_7zPartFile) != _7ZERR_NONE) {
+			_7zPartFile = NULL;
+			return 1;
+		}
+
+		strncpy(szPart7z, szZip, MAX_PATH - 1);
+	}
+
+	UINT32 nWrote = 0;
+	_7zPartFile->curr_file_idx = nEntry;
+
+	if (_7z_file_decompress_part(_7zPartFile, Dest, nOffset, nLen, &nWrote) != _7ZERR_NONE) return 1;
+
+	if (pnWrote != NULL) *pnWrote = (INT32)nWrote;
+
+	return 0;
+}
+#endif
+
+// Load nLen bytes from nOffset of member nEntry of szZip (without extension)
+INT32 ZipLoadPart(char* szZip, INT32 nEntry, UINT8* Dest, INT32 nOffset, INT32 nLen, INT32* pnWrote)
+{
+	if (szZip == NULL || Dest == NULL || nOffset < 0 || nLen <= 0) return 1;
+
+	if (pnWrote != NULL) *pnWrote = 0;
+
+#ifdef INCLUDE_7Z_SUPPORT
+	if (_7zPartFile != NULL && strcmp(szPart7z, szZip) == 0) {
+		return ZipLoadPart7z(szZip, nEntry, Dest, nOffset, nLen, pnWrote);
+	}
+#endif
+
+	if (ZipLoadPartZip(szZip, nEntry, Dest, nOffset, nLen, pnWrote) == 0) return 0;
+
+#ifdef INCLUDE_7Z_SUPPORT
+	return ZipLoadPart7z(szZip, nEntry, Dest, nOffset, nLen, pnWrote);
+#else
+	return 1;
+#endif
+}
+
+void ZipLoadPartExit()
+{
+	for (INT32 i = 0; i < ZIP_PART_SLOTS; i++) {
+		ZipPartSlotClose(&PartSlot[i]);
+	}
+
+	nPartClock = 0;
+
+#ifdef INCLUDE_7Z_SUPPORT
+	if (_7zPartFile != NULL) {
+		_7z_file_close(_7zPartFile);
+		_7zPartFile = NULL;
+	}
+
+	szPart7z[0] = 0;
+#endif
+}
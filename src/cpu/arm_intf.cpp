@@ -306,6 +306,8 @@ INT32 ArmGetActive()
 
 void ArmInit(INT32 /*CPU*/) // only one cpu supported
 {
+	BURN_PROFILE_PHASE(CPUINIT);
+
 	DebugCPU_ARMInitted = 1;
 	
 	for (INT32 i = 0; i < 3; i++) {
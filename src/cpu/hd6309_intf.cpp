@@ -185,6 +185,8 @@ void HD6309CheatWriteRom(UINT32 a, UINT8 d)
 
 INT32 HD6309Init(INT32 nCPU)
 {
+	BURN_PROFILE_PHASE(CPUINIT);
+
 	DebugCPU_HD6309Initted = 1;
 	
 	nActiveCPU = -1;
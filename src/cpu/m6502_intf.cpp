@@ -188,6 +188,8 @@ static UINT8 decocpu7Decode(UINT16 /*address*/,UINT8 op)
 
 INT32 M6502Init(INT32 cpu, INT32 type)
 {
+	BURN_PROFILE_PHASE(CPUINIT);
+
 	DebugCPU_M6502Initted = 1;
 	
 	nM6502Count++;
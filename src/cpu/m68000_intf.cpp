@@ -1079,6 +1079,8 @@ static void CallLuaExec(unsigned int newPC)
 
 INT32 SekInit(INT32 nCount, INT32 nCPUType)
 {
+	BURN_PROFILE_PHASE(CPUINIT);
+
 	DebugCPU_SekInitted = 1;
 	
 	struct SekExt* ps = NULL;
@@ -192,6 +192,8 @@ UINT8 M6809CheatRead(UINT32 a)
 
 INT32 M6809Init(INT32 cpu)
 {
+	BURN_PROFILE_PHASE(CPUINIT);
+
 	DebugCPU_M6809Initted = 1;
 
 	nActiveCPU = -1;
@@ -497,6 +497,8 @@ UINT8 Sh2CheatReadByte(UINT32 a)
 
 int Sh2Init(int nCount)
 {
+	BURN_PROFILE_PHASE(CPUINIT);
+
 	DebugCPU_SH2Initted = 1;
 
 	has_sh2 = 1;
@@ -211,6 +211,8 @@ UINT8 ZetCheatRead(UINT32 a)
 
 INT32 ZetInit(INT32 nCPU)
 {
+	BURN_PROFILE_PHASE(CPUINIT);
+
 	DebugCPU_ZetInitted = 1;
 
 	nOpenedCPU = -1;